@@ -0,0 +1,186 @@
+#include "Scene/Spatial/AabbTree.h"
+
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace KaputEngine;
+
+using KaputEngine::Rendering::Culling::BoundingBox;
+
+using LibMath::Cartesian3f;
+
+using std::cout;
+
+namespace
+{
+	constexpr size_t ObjectCounts[] { 1'000, 10'000, 100'000 };
+
+	// Space per object, the world growing with the count so queries find about as many objects at every size
+	constexpr float VolumePerObject = 64.f;
+
+	constexpr size_t QueryCount = 1'000;
+	constexpr float QuerySize = 4.f;
+	constexpr float RayLength = 20.f;
+
+	// Objects moved per frame, most of them staying in their fat box
+	constexpr size_t MoverDivisor = 10;
+	constexpr unsigned int FrameCount = 20;
+
+	_NODISCARD BoundingBox box(const Cartesian3f& center, const float halfSize)
+	{
+		return
+		{
+			{ center.x() - halfSize, center.y() - halfSize, center.z() - halfSize },
+			{ center.x() + halfSize, center.y() + halfSize, center.z() + halfSize }
+		};
+	}
+
+	/// <summary>
+	/// Times a function.
+	/// </summary>
+	/// <returns>Milliseconds taken</returns>
+	template <typename Func>
+	double measure(Func&& func)
+	{
+		const auto start = std::chrono::steady_clock::now();
+		func();
+
+		return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	}
+}
+
+/// <summary>
+/// Times the building, updating and querying of the bounding volume hierarchy against a brute force search as the object count grows.
+/// </summary>
+/// <remarks>Usage: KaputAabbTreeBench</remarks>
+int main()
+{
+	std::mt19937 random(42);
+	std::uniform_real_distribution<float> unit(0.f, 1.f), size(.25f, 1.f), velocity(-.05f, .05f);
+
+	cout << QueryCount << " box queries of size " << QuerySize << " and rays of length " << RayLength
+		<< ", 1 in " << MoverDivisor << " objects moved per frame\n\n";
+
+	cout << std::fixed << std::setprecision(3);
+	cout << std::setw(10) << "Objects" << std::setw(8) << "Height" << std::setw(12) << "Build (ms)" << std::setw(12) << "Move (ns)"
+		<< std::setw(14) << "Query (us)" << std::setw(14) << "Brute (us)" << std::setw(12) << "Ray (us)" << std::setw(10) << "Hits\n";
+
+	for (const size_t objectCount : ObjectCounts)
+	{
+		const float worldSize = std::cbrt(VolumePerObject * static_cast<float>(objectCount));
+
+		const auto position = [&]
+		{
+			return Cartesian3f { unit(random) * worldSize, unit(random) * worldSize, unit(random) * worldSize };
+		};
+
+		std::vector<Cartesian3f> centers(objectCount);
+		std::vector<float> sizes(objectCount);
+
+		for (size_t i = 0; i < objectCount; ++i)
+		{
+			centers[i] = position();
+			sizes[i] = size(random);
+		}
+
+		AabbTree tree;
+		std::vector<AabbTree::Proxy> proxies(objectCount);
+
+		const double build = measure([&]
+		{
+			for (size_t i = 0; i < objectCount; ++i)
+				proxies[i] = tree.insert(box(centers[i], sizes[i]), { static_cast<uint32_t>(i), 0 });
+		});
+
+		// Objects drifting a little every frame
+		const size_t moverCount = objectCount / MoverDivisor;
+		std::vector<float> velocities(moverCount * 3);
+
+		for (float& moverVelocity : velocities)
+			moverVelocity = velocity(random);
+
+		const double move = measure([&]
+		{
+			for (unsigned int frame = 0; frame < FrameCount; ++frame)
+				for (size_t i = 0; i < moverCount; ++i)
+				{
+					for (int axis = 0; axis < 3; ++axis)
+						centers[i].raw()[axis] += velocities[i * 3 + axis];
+
+					tree.move(proxies[i], box(centers[i], sizes[i]));
+				}
+		});
+
+		std::vector<BoundingBox> queries(QueryCount);
+
+		for (BoundingBox& query : queries)
+			query = box(position(), QuerySize / 2.f);
+
+		size_t hits = 0;
+
+		const double query = measure([&]
+		{
+			for (const BoundingBox& queryBox : queries)
+				tree.query(queryBox, [&hits](Handle<GameObject>)
+				{
+					++hits;
+					return true;
+				});
+		});
+
+		// Same test over the fat boxes the tree holds
+		size_t bruteHits = 0;
+
+		const double brute = measure([&]
+		{
+			for (const BoundingBox& queryBox : queries)
+				for (const AabbTree::Proxy proxy : proxies)
+					bruteHits += tree.box(proxy).intersects(queryBox);
+		});
+
+		if (bruteHits != hits)
+			std::cerr << "Tree found " << hits << " objects, brute force " << bruteHits << '\n';
+
+		std::vector<Ray> rays(QueryCount);
+
+		for (Ray& ray : rays)
+		{
+			float direction[3], length = 0.f;
+
+			for (float& component : direction)
+			{
+				component = unit(random) - .5f;
+				length += component * component;
+			}
+
+			length = std::sqrt(length);
+
+			ray = { position(), { direction[0] / length, direction[1] / length, direction[2] / length }, RayLength };
+		}
+
+		// Closest hit, each hit shortening the cast
+		const double ray = measure([&]
+		{
+			for (const Ray& cast : rays)
+				tree.raycast(cast, [](Handle<GameObject>, const float distance)
+				{
+					return distance;
+				});
+		});
+
+		cout << std::setw(10) << objectCount
+			<< std::setw(8) << tree.height()
+			<< std::setw(12) << build
+			<< std::setw(12) << move * 1e6 / static_cast<double>(FrameCount * moverCount)
+			<< std::setw(14) << query * 1e3 / QueryCount
+			<< std::setw(14) << brute * 1e3 / QueryCount
+			<< std::setw(12) << ray * 1e3 / QueryCount
+			<< std::setw(9) << static_cast<double>(hits) / QueryCount << '\n';
+	}
+
+	return 0;
+}
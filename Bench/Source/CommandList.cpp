@@ -0,0 +1,157 @@
+#include "Application.h"
+#include "Rendering/Buffer/ElementBuffer.h"
+#include "Rendering/Buffer/VertexAttributeBuffer.h"
+#include "Rendering/Buffer/VertexBuffer.h"
+#include "Rendering/Command/CommandList.h"
+#include "Rendering/ShaderProgram.h"
+
+#include <LibMath/Matrix.h>
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace KaputEngine;
+
+using KaputEngine::Rendering::ShaderProgram;
+using KaputEngine::Rendering::UniformHandle;
+using KaputEngine::Rendering::Buffer::ElementBuffer;
+using KaputEngine::Rendering::Buffer::VertexAttributeBuffer;
+using KaputEngine::Rendering::Buffer::VertexBuffer;
+using KaputEngine::Rendering::Command::CommandList;
+
+using LibMath::Cartesian3f;
+using LibMath::Matrix4f;
+using LibMath::Vector3f;
+
+using std::cout;
+
+namespace
+{
+	constexpr size_t DrawCounts[] { 1'000, 10'000, 100'000 };
+
+	// Consecutive draws sharing a mesh, as sorted by the draw queue
+	constexpr size_t DrawsPerMesh = 16;
+
+	constexpr unsigned int FrameCount = 100;
+
+	/// <summary>
+	/// Draw state of a sorted draw queue item, without the GL objects the list only references by id.
+	/// </summary>
+	struct Draw
+	{
+		Matrix4f model;
+		Cartesian3f worldPosition;
+	};
+
+	/// <summary>
+	/// Handles of the engine uniforms written per draw, at the locations a reflected program would give them.
+	/// </summary>
+	struct Uniforms
+	{
+		UniformHandle<Matrix4f> model { 0 };
+		UniformHandle<Cartesian3f> worldPosition { 4 };
+		UniformHandle<Vector3f> positionScale { 5 };
+		UniformHandle<Cartesian3f> positionOffset { 6 };
+	};
+
+	/// <summary>
+	/// Records the draws the way the draw queue does, binding the buffers of a mesh once for its run of draws.
+	/// </summary>
+	void record(CommandList& list, const ShaderProgram& program, const Uniforms& uniforms, const std::vector<Draw>& draws,
+		const VertexAttributeBuffer& attributes, const VertexBuffer& vertices, const ElementBuffer& elements)
+	{
+		list.useProgram(program);
+
+		for (size_t i = 0; i < draws.size(); ++i)
+		{
+			if (i % DrawsPerMesh == 0)
+			{
+				list.bindVertexArray(attributes, vertices, elements);
+				list.setUniform(uniforms.positionScale, Vector3f { 1, 1, 1 });
+				list.setUniform(uniforms.positionOffset, Cartesian3f { 0, 0, 0 });
+			}
+
+			list.setUniform(uniforms.worldPosition, draws[i].worldPosition);
+			list.setUniform(uniforms.model, draws[i].model);
+			list.drawBoundElements(elements);
+		}
+	}
+}
+
+/// <summary>
+/// Times the recording of draws into a command list, which needs no rendering context.
+/// </summary>
+/// <remarks>Usage: KaputCommandListBench</remarks>
+int main()
+{
+	if (!Application::initHeadless(0))
+		return 1;
+
+	{
+		// Never created, recording only copies their ids
+		const ShaderProgram program;
+		const VertexAttributeBuffer attributes;
+		const VertexBuffer vertices;
+		const ElementBuffer elements;
+
+		const Uniforms uniforms;
+
+		std::mt19937 random(42);
+		std::uniform_real_distribution<float> value(-10.f, 10.f);
+
+		cout << "Average of " << FrameCount << " frames, " << DrawsPerMesh << " draws per mesh\n\n";
+		cout << std::fixed << std::setprecision(3);
+		cout << std::setw(10) << "Draws" << std::setw(12) << "Commands"
+			<< std::setw(16) << "First (ms)" << std::setw(16) << "Frame (ms)" << std::setw(16) << "Draw (ns)\n";
+
+		for (const size_t drawCount : DrawCounts)
+		{
+			std::vector<Draw> draws(drawCount);
+
+			for (Draw& draw : draws)
+			{
+				draw.model = Matrix4f::Identity();
+
+				for (int row = 0; row < 3; ++row)
+					draw.model.raw2D()[3][row] = value(random);
+
+				draw.worldPosition = { draw.model.raw2D()[3][0], draw.model.raw2D()[3][1], draw.model.raw2D()[3][2] };
+			}
+
+			CommandList list;
+
+			// Grows the command and data blocks, later frames reuse them after a reset
+			auto start = std::chrono::steady_clock::now();
+			record(list, program, uniforms, draws, attributes, vertices, elements);
+
+			const double first = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+			std::chrono::duration<double, std::milli> total { };
+
+			for (unsigned int frame = 0; frame < FrameCount; ++frame)
+			{
+				start = std::chrono::steady_clock::now();
+
+				list.reset();
+				record(list, program, uniforms, draws, attributes, vertices, elements);
+
+				total += std::chrono::steady_clock::now() - start;
+			}
+
+			const double frameTime = total.count() / FrameCount;
+
+			cout << std::setw(10) << drawCount
+				<< std::setw(12) << list.size()
+				<< std::setw(16) << first
+				<< std::setw(16) << frameTime
+				<< std::setw(15) << frameTime * 1e6 / static_cast<double>(drawCount) << '\n';
+		}
+	}
+
+	Application::cleanup();
+
+	return 0;
+}
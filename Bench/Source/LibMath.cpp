@@ -0,0 +1,265 @@
+#include <LibMath/Matrix.h>
+#include <LibMath/Quaternion.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <span>
+#include <string_view>
+#include <vector>
+
+using LibMath::Matrix;
+using LibMath::Matrix4f;
+using LibMath::Quaternion;
+
+using std::cout;
+
+namespace
+{
+	using Vector4 = Matrix<1, 4, float>;
+
+	// Operands cycled through so the inputs do not stay in registers
+	constexpr size_t OperandCount = 1024;
+
+	constexpr size_t Iterations = 1 << 22;
+
+	// Vertices transformed per batch, the size of a typical occluder or skinned mesh
+	constexpr size_t BatchSize = 4096;
+	constexpr size_t BatchCount = Iterations / BatchSize;
+
+	// Reference implementations, the generic LibMath code a scalar build runs
+
+	Matrix4f multiplyScalar(const Matrix4f& left, const Matrix4f& right) noexcept
+	{
+		Matrix4f out;
+
+		for (int x = 0; x < 4; ++x)
+			for (int y = 0; y < 4; ++y)
+			{
+				float sum = 0.f;
+
+				for (int i = 0; i < 4; ++i)
+					sum += left.raw2D()[i][y] * right.raw2D()[x][i];
+
+				out.raw2D()[x][y] = sum;
+			}
+
+		return out;
+	}
+
+	Vector4 transformScalar(const Matrix4f& left, const Vector4& right) noexcept
+	{
+		Vector4 out;
+
+		for (int y = 0; y < 4; ++y)
+		{
+			float sum = 0.f;
+
+			for (int i = 0; i < 4; ++i)
+				sum += left.raw2D()[i][y] * right.raw2D()[0][i];
+
+			out.raw2D()[0][y] = sum;
+		}
+
+		return out;
+	}
+
+	Matrix4f transposeScalar(const Matrix4f& matrix) noexcept
+	{
+		Matrix4f out;
+
+		for (int x = 0; x < 4; ++x)
+			for (int y = 0; y < 4; ++y)
+				out.raw2D()[x][y] = matrix.raw2D()[y][x];
+
+		return out;
+	}
+
+	Matrix4f invertScalar(const Matrix4f& matrix)
+	{
+		return matrix.adjugate() * (1.f / matrix.determinant());
+	}
+
+	Quaternion<float> composeScalar(const Quaternion<float>& left, const Quaternion<float>& right)
+	{
+		return Quaternion<float>(
+			left.scalar() * right.vector() + right.scalar() * left.vector() + left.vector().cross(right.vector()),
+			left.scalar() * right.scalar() - left.vector().dot(right.vector()));
+	}
+
+	template <typename T>
+	float maxDifference(const T& a, const T& b) noexcept
+	{
+		float difference = 0.f;
+
+		for (size_t i = 0; i < std::size(a.raw()); ++i)
+			difference = std::max(difference, std::abs(a.raw()[i] - b.raw()[i]));
+
+		return difference;
+	}
+
+	/// <summary>
+	/// Times a function called once per iteration.
+	/// </summary>
+	/// <returns>Nanoseconds per call</returns>
+	template <typename Func>
+	double measure(const size_t count, Func&& func)
+	{
+		const auto start = std::chrono::steady_clock::now();
+
+		for (size_t i = 0; i < count; ++i)
+			func(i);
+
+		return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / static_cast<double>(count);
+	}
+
+	void report(const std::string_view name, const double scalar, const double simd, const float difference)
+	{
+		cout << std::setw(18) << name
+			<< std::setw(14) << scalar
+			<< std::setw(12) << simd
+			<< std::setw(10) << scalar / simd << 'x'
+			<< std::setw(14) << std::scientific << difference << std::fixed << '\n';
+	}
+}
+
+/// <summary>
+/// Compares the SIMD paths of LibMath with the generic scalar code they replace for 4x4 float matrices and quaternions.
+/// </summary>
+/// <remarks>Usage: KaputLibMathBench</remarks>
+int main()
+{
+	std::mt19937 random(42);
+	std::uniform_real_distribution<float> value(-2.f, 2.f);
+
+	std::vector<Matrix4f> matrices(OperandCount);
+	std::vector<Vector4> vectors(std::max(OperandCount, BatchSize));
+	std::vector<Quaternion<float>> quaternions(OperandCount);
+
+	for (Matrix4f& matrix : matrices)
+	{
+		for (float& component : matrix.raw())
+			component = value(random);
+
+		// Diagonally dominant, so always invertible
+		for (int i = 0; i < 4; ++i)
+			matrix.raw2D()[i][i] += 10.f;
+	}
+
+	for (Vector4& vector : vectors)
+		for (float& component : vector.raw())
+			component = value(random);
+
+	for (Quaternion<float>& quaternion : quaternions)
+		for (float& component : quaternion.raw())
+			component = value(random);
+
+	std::vector<Matrix4f> matrixOut(OperandCount);
+	std::vector<Vector4> vectorOut(std::max(OperandCount, BatchSize));
+	std::vector<Quaternion<float>> quaternionOut(OperandCount);
+
+	const auto at = [](const size_t i) { return i % OperandCount; };
+	const auto next = [](const size_t i) { return (i + 1) % OperandCount; };
+
+	cout << "SIMD path: " << LibMath::Simd::PathName << ", " << Iterations << " operations per run\n\n";
+	cout << std::fixed << std::setprecision(2);
+	cout << std::setw(18) << "Operation" << std::setw(14) << "Scalar (ns)" << std::setw(12) << "SIMD (ns)" << std::setw(11) << "Speedup" << std::setw(14) << "Max error\n";
+
+	// Each result is checked against the scalar one before timing
+	float difference = 0.f;
+
+	{
+		for (size_t i = 0; i < OperandCount; ++i)
+			difference = std::max(difference, maxDifference(matrices[i] * matrices[next(i)], multiplyScalar(matrices[i], matrices[next(i)])));
+
+		const double scalar = measure(Iterations, [&](const size_t i) { matrixOut[at(i)] = multiplyScalar(matrices[at(i)], matrices[next(i)]); });
+		const double simd = measure(Iterations, [&](const size_t i) { matrixOut[at(i)] = matrices[at(i)] * matrices[next(i)]; });
+
+		report("mat4 * mat4", scalar, simd, difference);
+	}
+
+	{
+		difference = 0.f;
+
+		for (size_t i = 0; i < OperandCount; ++i)
+			difference = std::max(difference, maxDifference(matrices[i] * vectors[i], transformScalar(matrices[i], vectors[i])));
+
+		const double scalar = measure(Iterations, [&](const size_t i) { vectorOut[at(i)] = transformScalar(matrices[at(i)], vectors[at(i)]); });
+		const double simd = measure(Iterations, [&](const size_t i) { vectorOut[at(i)] = matrices[at(i)] * vectors[at(i)]; });
+
+		report("mat4 * vec4", scalar, simd, difference);
+	}
+
+	{
+		const std::span<const Vector4> batch(vectors.data(), BatchSize);
+		const std::span<Vector4> batchOut(vectorOut.data(), BatchSize);
+
+		difference = 0.f;
+		matrices[0].transform(batch, batchOut);
+
+		for (size_t i = 0; i < BatchSize; ++i)
+			difference = std::max(difference, maxDifference(batchOut[i], transformScalar(matrices[0], batch[i])));
+
+		// Per vector
+		const double scalar = measure(BatchCount, [&](const size_t i)
+		{
+			for (size_t v = 0; v < BatchSize; ++v)
+				batchOut[v] = transformScalar(matrices[at(i)], batch[v]);
+		}) / BatchSize;
+
+		const double simd = measure(BatchCount, [&](const size_t i) { matrices[at(i)].transform(batch, batchOut); }) / BatchSize;
+
+		report("transform batch", scalar, simd, difference);
+	}
+
+	{
+		difference = 0.f;
+
+		for (size_t i = 0; i < OperandCount; ++i)
+			difference = std::max(difference, maxDifference(matrices[i].transpose(), transposeScalar(matrices[i])));
+
+		const double scalar = measure(Iterations, [&](const size_t i) { matrixOut[at(i)] = transposeScalar(matrices[at(i)]); });
+		const double simd = measure(Iterations, [&](const size_t i) { matrixOut[at(i)] = matrices[at(i)].transpose(); });
+
+		report("transpose", scalar, simd, difference);
+	}
+
+	{
+		difference = 0.f;
+
+		for (size_t i = 0; i < OperandCount; ++i)
+			difference = std::max(difference, maxDifference(matrices[i].invert(), invertScalar(matrices[i])));
+
+		// The cofactor expansion is slow, fewer runs keep the total time down
+		const double scalar = measure(Iterations / 16, [&](const size_t i) { matrixOut[at(i)] = invertScalar(matrices[at(i)]); });
+		const double simd = measure(Iterations / 16, [&](const size_t i) { matrixOut[at(i)] = matrices[at(i)].invert(); });
+
+		report("invert", scalar, simd, difference);
+	}
+
+	{
+		difference = 0.f;
+
+		for (size_t i = 0; i < OperandCount; ++i)
+			difference = std::max(difference, maxDifference(quaternions[i] * quaternions[next(i)], composeScalar(quaternions[i], quaternions[next(i)])));
+
+		const double scalar = measure(Iterations, [&](const size_t i) { quaternionOut[at(i)] = composeScalar(quaternions[at(i)], quaternions[next(i)]); });
+		const double simd = measure(Iterations, [&](const size_t i) { quaternionOut[at(i)] = quaternions[at(i)] * quaternions[next(i)]; });
+
+		report("quaternion * quat", scalar, simd, difference);
+	}
+
+	// Read back so the results cannot be optimised away
+	float checksum = 0.f;
+
+	for (size_t i = 0; i < OperandCount; ++i)
+		checksum += matrixOut[i].raw()[i % 16] + vectorOut[i].raw()[i % 4] + quaternionOut[i].raw()[i % 4];
+
+	cout << "\nChecksum " << checksum << '\n';
+
+	return 0;
+}
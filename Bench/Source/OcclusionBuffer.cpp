@@ -0,0 +1,211 @@
+#include "Application.h"
+#include "Job/JobSystem.h"
+#include "Rendering/Culling/OcclusionBuffer.h"
+#include "Rendering/Mesh.h"
+#include "Window/WindowConfig.h"
+
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace KaputEngine;
+
+using KaputEngine::Job::JobSystem;
+using KaputEngine::Rendering::Mesh;
+using KaputEngine::Rendering::Vertex;
+using KaputEngine::Rendering::Culling::BoundingBox;
+using KaputEngine::Rendering::Culling::Frustum;
+using KaputEngine::Rendering::Culling::OcclusionBuffer;
+using KaputEngine::Rendering::Culling::Occluder;
+
+using LibMath::Matrix4f;
+
+using std::cout;
+
+namespace
+{
+	// Buildings on a grid in front of the camera, rasterized as occluders
+	constexpr int BuildingsX = 16;
+	constexpr int BuildingsZ = 16;
+	constexpr float BuildingSpacing = 6.f;
+
+	// Boxes tested against the buffer every frame, as the renderables left by frustum culling
+	constexpr size_t BoxCount = 10'000;
+
+	constexpr unsigned int FrameCount = 200;
+
+	/// <summary>
+	/// Projection of the default camera placed at the origin and looking down -Z, so the view is the identity.
+	/// </summary>
+	Matrix4f viewProjection()
+	{
+		Matrix4f projection = Matrix4f::Identity();
+
+		const float
+			aspect        = static_cast<float>(WindowConfig::DEFAULT_WIDTH) / WindowConfig::DEFAULT_HEIGHT,
+			near          = WindowConfig::DEFAULT_NEAR,
+			far           = WindowConfig::DEFAULT_FAR,
+			tanHalfFovy   = std::tan(WindowConfig::DEFAULT_FOV / 2.f);
+
+		float (&data)[4][4] = projection.raw2D();
+
+		data[0][0] = 1.f / (aspect * tanHalfFovy);
+		data[1][1] = 1.f / tanHalfFovy;
+		data[2][2] = -(far + near) / (far - near);
+		data[2][3] = -1.f;
+		data[3][2] = -(2.f * far * near) / (far - near);
+		data[3][3] = 0.f;
+
+		return projection;
+	}
+
+	/// <summary>
+	/// Unit cube centered on the origin of the mesh.
+	/// </summary>
+	void initCube(Mesh& mesh)
+	{
+		std::vector<Vertex> vertices(8);
+
+		for (uint8_t corner = 0; corner < 8; ++corner)
+			vertices[corner].position =
+			{
+				corner & 1 ? .5f : -.5f,
+				corner & 2 ? .5f : -.5f,
+				corner & 4 ? .5f : -.5f
+			};
+
+		const unsigned int indices[]
+		{
+			0, 2, 1, 1, 2, 3, // -Z
+			4, 5, 6, 5, 7, 6, // +Z
+			0, 1, 4, 1, 5, 4, // -Y
+			2, 6, 3, 3, 6, 7, // +Y
+			0, 4, 2, 2, 4, 6, // -X
+			1, 3, 5, 3, 7, 5  // +X
+		};
+
+		mesh.init(vertices, indices);
+	}
+
+	Matrix4f scaleTranslation(const float sizeX, const float sizeY, const float sizeZ, const float x, const float y, const float z)
+	{
+		Matrix4f matrix = Matrix4f::Identity();
+		float (&data)[4][4] = matrix.raw2D();
+
+		data[0][0] = sizeX;
+		data[1][1] = sizeY;
+		data[2][2] = sizeZ;
+
+		data[3][0] = x;
+		data[3][1] = y;
+		data[3][2] = z;
+
+		return matrix;
+	}
+
+	/// <summary>
+	/// Times a function called once per frame.
+	/// </summary>
+	/// <returns>Average milliseconds per frame</returns>
+	template <typename Func>
+	double measure(Func&& func)
+	{
+		const auto start = std::chrono::steady_clock::now();
+
+		for (unsigned int frame = 0; frame < FrameCount; ++frame)
+			func();
+
+		return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / FrameCount;
+	}
+}
+
+/// <summary>
+/// Times the rasterization of the occlusion buffer, on the calling thread and on the job system, and the tests of the boxes hidden behind it.
+/// </summary>
+/// <remarks>Usage: KaputOcclusionBufferBench</remarks>
+int main()
+{
+	if (!Application::initHeadless(0))
+		return 1;
+
+	{
+		std::mt19937 random(42);
+		std::uniform_real_distribution<float> unit(0.f, 1.f);
+
+		Mesh cube;
+		initCube(cube);
+
+		std::vector<Occluder> occluders;
+		occluders.reserve(static_cast<size_t>(BuildingsX) * BuildingsZ);
+
+		for (int z = 0; z < BuildingsZ; ++z)
+			for (int x = 0; x < BuildingsX; ++x)
+			{
+				const float
+					width  = 2.f + 2.f * unit(random),
+					height = 4.f + 12.f * unit(random),
+					depth  = 2.f + 2.f * unit(random);
+
+				occluders.push_back(
+				{
+					&cube,
+					scaleTranslation(width, height, depth,
+						(static_cast<float>(x) - BuildingsX / 2.f) * BuildingSpacing,
+						height / 2.f - 2.f,
+						-5.f - static_cast<float>(z) * BuildingSpacing)
+				});
+			}
+
+		// Small props scattered between and behind the buildings
+		std::vector<BoundingBox> boxes(BoxCount);
+
+		for (BoundingBox& box : boxes)
+		{
+			const float
+				x    = (unit(random) - .5f) * BuildingsX * BuildingSpacing,
+				z    = -5.f - unit(random) * BuildingsZ * BuildingSpacing,
+				size = .25f + unit(random);
+
+			box.min = { x - size, -2.f, z - size };
+			box.max = { x + size, -2.f + 2.f * size, z + size };
+		}
+
+		const Matrix4f matrix = viewProjection();
+		const Frustum frustum(matrix);
+
+		OcclusionBuffer buffer;
+		JobSystem& jobs = JobSystem::instance();
+
+		const double now = measure([&] { buffer.rasterizeNow(matrix, frustum, occluders); });
+		const double scheduled = measure([&] { jobs.wait(buffer.rasterize(matrix, frustum, occluders)); });
+
+		size_t occluded = 0;
+
+		const double tests = measure([&]
+		{
+			occluded = 0;
+
+			for (const BoundingBox& box : boxes)
+				occluded += buffer.occluded(box);
+		});
+
+		cout << occluders.size() << " occluders, " << buffer.triangleCount() << " triangles after clipping, "
+			<< jobs.workerCount() << " workers, average of " << FrameCount << " frames\n\n";
+
+		cout << std::fixed << std::setprecision(3);
+		cout << std::setw(24) << "Pass" << std::setw(16) << "Frame (ms)\n";
+		cout << std::setw(24) << "rasterize, inline" << std::setw(15) << now << '\n';
+		cout << std::setw(24) << "rasterize, jobs" << std::setw(15) << scheduled << '\n';
+		cout << std::setw(24) << "test boxes" << std::setw(15) << tests << '\n';
+
+		cout << '\n' << occluded << " of " << BoxCount << " boxes occluded, "
+			<< tests * 1e6 / BoxCount << " ns per box\n";
+	}
+
+	Application::cleanup();
+
+	return 0;
+}
@@ -0,0 +1,157 @@
+#include "Queue/Concurrent.h"
+#include "Queue/Ring.h"
+#include "Utils/InlineFunction.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using KaputEngine::InlineFunction;
+using KaputEngine::Queue::ConcurrentQueue;
+using KaputEngine::Queue::RingQueue;
+
+using std::cout;
+
+namespace
+{
+	// Items pushed by all producers together for each run
+	constexpr size_t ItemCount = 1 << 20;
+
+	// Matches the default ActionQueue capacity
+	constexpr size_t RingCapacity = 4096;
+
+	constexpr unsigned int ProducerCounts[] { 1, 2, 4, 8, 16 };
+
+	/// <summary>
+	/// Capture of a typical queued GL call, larger than the std::function small buffer
+	/// </summary>
+	struct Payload
+	{
+		uint64_t* sum;
+		uint64_t value;
+		uint64_t padding[2];
+	};
+
+	/// <summary>
+	/// Pushes from producer threads while the calling thread pops and invokes, as the context thread does.
+	/// </summary>
+	/// <returns>Nanoseconds per item</returns>
+	template <typename Push, typename Pop>
+	double run(const unsigned int producers, Push&& push, Pop&& pop)
+	{
+		const size_t perProducer = ItemCount / producers;
+		const size_t total = perProducer * producers;
+
+		std::atomic<bool> go = false;
+		std::vector<std::thread> threads;
+		threads.reserve(producers);
+
+		for (unsigned int p = 0; p < producers; ++p)
+			threads.emplace_back([&go, &push, perProducer]
+			{
+				while (!go)
+					std::this_thread::yield();
+
+				for (size_t i = 0; i < perProducer; ++i)
+					push(i);
+			});
+
+		const auto start = std::chrono::steady_clock::now();
+		go = true;
+
+		for (size_t popped = 0; popped < total;)
+			if (pop())
+				++popped;
+			else
+				std::this_thread::yield();
+
+		const auto end = std::chrono::steady_clock::now();
+
+		for (std::thread& thread : threads)
+			thread.join();
+
+		return std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(total);
+	}
+
+	double benchConcurrent(const unsigned int producers, uint64_t& sum)
+	{
+		// Heap allocated, the queue holds a mutex and may be large
+		const std::unique_ptr queue = std::make_unique<ConcurrentQueue<std::function<void()>>>();
+
+		return run(producers,
+		[&queue, &sum](const size_t i)
+		{
+			queue->push(std::function<void()>([payload = Payload { &sum, i, { } }] { *payload.sum += payload.value; }));
+		},
+		[&queue]
+		{
+			std::function<void()> func;
+
+			if (!queue->pop(&func))
+				return false;
+
+			func();
+			return true;
+		});
+	}
+
+	double benchRing(const unsigned int producers, uint64_t& sum)
+	{
+		using Lambda = InlineFunction<void()>;
+
+		const std::unique_ptr queue = std::make_unique<RingQueue<Lambda, RingCapacity>>();
+
+		return run(producers,
+		[&queue, &sum](const size_t i)
+		{
+			// Producers wait for the consumer when the ring is full, as ActionQueue does
+			while (!queue->tryEmplace([payload = Payload { &sum, i, { } }] { *payload.sum += payload.value; }))
+				std::this_thread::yield();
+		},
+		[&queue]
+		{
+			alignas(Lambda) std::byte storage[sizeof(Lambda)];
+			Lambda* const func = reinterpret_cast<Lambda*>(storage);
+
+			if (!queue->pop(func))
+				return false;
+
+			(*func)();
+			func->~Lambda();
+
+			return true;
+		});
+	}
+}
+
+/// <summary>
+/// Compares the lock-free ring backing ActionQueue with the mutex-guarded ConcurrentQueue it replaced.
+/// </summary>
+/// <remarks>Usage: KaputQueueBench</remarks>
+int main()
+{
+	cout << "Multiple producers, single consumer invoking " << ItemCount << " callables per run\n\n";
+	cout << std::setw(10) << "Producers" << std::setw(20) << "Concurrent (ns)" << std::setw(16) << "Ring (ns)" << std::setw(10) << "Speedup\n";
+	cout << std::fixed << std::setprecision(1);
+
+	// Read back so the callables cannot be optimised away
+	uint64_t sum = 0;
+
+	for (const unsigned int producers : ProducerCounts)
+	{
+		const double concurrent = benchConcurrent(producers, sum);
+		const double ring = benchRing(producers, sum);
+
+		cout << std::setw(10) << producers << std::setw(20) << concurrent << std::setw(16) << ring << std::setw(8) << concurrent / ring << "x\n";
+	}
+
+	cout << "\nChecksum " << sum << '\n';
+
+	return 0;
+}
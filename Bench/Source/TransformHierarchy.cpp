@@ -0,0 +1,174 @@
+#include "Application.h"
+#include "GameObject/GameObject.h"
+#include "Scene/Scene.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace KaputEngine;
+
+using LibMath::Cartesian3f;
+
+using std::cout;
+
+namespace
+{
+	using Nodes = std::span<const std::shared_ptr<GameObject>>;
+
+	constexpr size_t NodeCount = 100'000;
+
+	// Share of the nodes given a new local transform every frame
+	constexpr double MoverRatio = 0.05;
+
+	constexpr unsigned int FrameCount = 200;
+
+	// Nodes attached straight to the scene root, the others pick a random earlier node as parent
+	constexpr size_t TopLevelCount = 1'000;
+
+	/// <summary>
+	/// Builds the benchmark hierarchy under a parent, the same for a given seed.
+	/// </summary>
+	/// <returns>Nodes in creation order, parents before children</returns>
+	std::vector<std::shared_ptr<GameObject>> build(GameObject& root, const std::mt19937::result_type seed)
+	{
+		std::mt19937 random(seed);
+
+		std::vector<std::shared_ptr<GameObject>> objects;
+		objects.reserve(NodeCount);
+
+		for (size_t i = 0; i < NodeCount; ++i)
+		{
+			std::shared_ptr<GameObject> object = GameObject::create<GameObject>();
+			object->setLocalPosition({ 1, 0, 0 });
+
+			GameObject& parent = i < TopLevelCount ?
+				root :
+				*objects[std::uniform_int_distribution<size_t>(0, i - 1)(random)];
+
+			object->attachTo(&parent, true);
+			objects.push_back(std::move(object));
+		}
+
+		return objects;
+	}
+
+	/// <summary>
+	/// Times frames where distinct random nodes among the candidates move, then the world transforms are brought up to date.
+	/// </summary>
+	/// <param name="pass">Updates the world transforms after the moves</param>
+	/// <returns>Average milliseconds per frame</returns>
+	template <typename Func>
+	double run(const Nodes candidates, const size_t moverCount, std::mt19937& random, Func&& pass)
+	{
+		std::uniform_real_distribution<float> offset(-1.f, 1.f);
+
+		std::vector<GameObject*> movers;
+		movers.reserve(candidates.size());
+
+		std::vector<Cartesian3f> positions(moverCount);
+		std::chrono::duration<double, std::milli> total { };
+
+		for (unsigned int frame = 0; frame < FrameCount; ++frame)
+		{
+			movers.clear();
+			std::ranges::transform(candidates, std::back_inserter(movers), [](const std::shared_ptr<GameObject>& object) { return object.get(); });
+			std::ranges::shuffle(movers, random);
+			movers.resize(moverCount);
+
+			for (Cartesian3f& position : positions)
+				position = { offset(random), offset(random), offset(random) };
+
+			// Moving includes flagging the moved nodes, which the lazy path does for their whole subtree
+			const auto start = std::chrono::steady_clock::now();
+
+			for (size_t i = 0; i < moverCount; ++i)
+				movers[i]->setLocalPosition(positions[i]);
+
+			pass();
+			total += std::chrono::steady_clock::now() - start;
+		}
+
+		return total.count() / FrameCount;
+	}
+}
+
+/// <summary>
+/// Times the flattened scene transform pass over a large hierarchy with a share of its nodes moving every frame,
+/// against the same hierarchy outside of a scene updated lazily through the parents.
+/// </summary>
+/// <remarks>Usage: KaputTransformHierarchyBench</remarks>
+int main()
+{
+	if (!Application::initHeadless(0))
+		return 1;
+
+	{
+		Scene scene;
+		TransformHierarchy& transforms = scene.transforms();
+
+		// Objects outside of a scene compute their world transform lazily through getParentTransform, as every object did before
+		const std::shared_ptr<GameObject> lazyRoot = GameObject::create<GameObject>();
+
+		const std::vector<std::shared_ptr<GameObject>> objects = build(scene.sceneRoot(), 42);
+		const std::vector<std::shared_ptr<GameObject>> lazyObjects = build(*lazyRoot, 42);
+
+		// Settle the initial transforms
+		transforms.update();
+
+		const auto flattened = [&transforms] { transforms.update(); };
+
+		// Every world matrix is read once per frame, as the renderer does
+		const auto lazy = [&lazyObjects]
+		{
+			for (const std::shared_ptr<GameObject>& object : lazyObjects)
+				(void)object->getWorldTransformMatrix();
+		};
+
+		lazy();
+
+		const auto moverCount = static_cast<size_t>(NodeCount * MoverRatio);
+
+		// Moving every top-level node recomputes the whole hierarchy
+		const Nodes topLevel(objects.data(), TopLevelCount);
+		const Nodes lazyTopLevel(lazyObjects.data(), TopLevelCount);
+
+		std::mt19937 random(42);
+
+		const auto row = [&](const std::string_view label, const Nodes candidates, const Nodes lazyCandidates, const size_t count)
+		{
+			const double flattenedTime = run(candidates, count, random, flattened);
+			const double lazyTime = run(lazyCandidates, count, random, lazy);
+
+			cout << std::setw(12) << label
+				<< std::setw(15) << flattenedTime
+				<< std::setw(15) << lazyTime;
+
+			// The pass returns at once when nothing moved
+			if (flattenedTime > 0.)
+				cout << std::setw(11) << lazyTime / flattenedTime << 'x';
+
+			cout << '\n';
+		};
+
+		cout << NodeCount << " nodes, average of " << FrameCount << " frames\n\n";
+		cout << std::fixed << std::setprecision(3);
+
+		cout << std::setw(12) << "Movers" << std::setw(15) << "Pass (ms)" << std::setw(15) << "Lazy (ms)" << std::setw(13) << "Speedup\n";
+
+		row("none", objects, lazyObjects, 0);
+		row(std::to_string(moverCount), objects, lazyObjects, moverCount);
+		row("top-level", topLevel, lazyTopLevel, TopLevelCount);
+	}
+
+	Application::cleanup();
+
+	return 0;
+}
@@ -1,15 +1,18 @@
-struct Camera
+// Data of the camera being rendered, mirrored by KaputEngine::Rendering::ViewData
+layout(std140, binding = 1) uniform ViewBlock
 {
-	vec3 position;
+	mat4 view;
+	mat4 projection;
 	mat4 viewProjection;
-};
+	vec3 position;
+} camera;
 
-vec4 cameraTransform(Camera camera, mat4 model, vec3 vertPos)
+vec4 cameraTransform(mat4 model, vec3 vertPos)
 {
 	return camera.viewProjection * model * vec4(vertPos, 1.0);
 }
 
-vec4 cameraTransformWorld(Camera camera, vec3 worldPos)
+vec4 cameraTransformWorld(vec3 worldPos)
 {
 	return camera.viewProjection * vec4(worldPos, 1.0);
 }
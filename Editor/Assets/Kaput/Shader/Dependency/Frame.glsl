@@ -0,0 +1,9 @@
+// Data shared by every draw of a frame, mirrored by KaputEngine::Rendering::FrameData
+layout(std140, binding = 0) uniform FrameBlock
+{
+	// Seconds since the start of the application
+	float time;
+	float deltaTime;
+	// Size of the primary window in pixels
+	vec2 resolution;
+} frame;
@@ -0,0 +1,15 @@
+// Model matrices of instanced draws, packed by batch
+layout(std430, binding = 2) readonly buffer instanceBuffer
+{
+	mat4 instanceModels[];
+};
+
+uniform mat4 model;
+
+// Index of the first matrix of the draw in instanceModels, negative if drawn with the model uniform
+uniform int instanceOffset = -1;
+
+mat4 getModel()
+{
+	return instanceOffset < 0 ? model : instanceModels[instanceOffset + gl_InstanceID];
+}
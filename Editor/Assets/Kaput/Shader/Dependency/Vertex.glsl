@@ -1,6 +1,41 @@
 layout (location = 0) in vec4 aAlbedo;
 layout (location = 1) in vec3 aPos;
 layout (location = 2) in vec2 aTexCoords;
-layout (location = 3) in vec3 aNormal;
-layout (location = 4) in vec3 aTangent;
-layout (location = 5) in vec3 aBitangent;
\ No newline at end of file
+
+// Octahedral encoding
+layout (location = 3) in vec2 aNormal;
+
+// Octahedral encoding in xy, sign of the bitangent in z
+layout (location = 4) in vec4 aTangent;
+
+// Maps quantized positions back to mesh space, identity for float positions
+uniform vec3 positionScale = vec3(1.0);
+uniform vec3 positionOffset = vec3(0.0);
+
+vec3 octDecode(vec2 e)
+{
+	vec3 v = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+	float t = max(-v.z, 0.0);
+	v.xy += vec2(v.x >= 0.0 ? -t : t, v.y >= 0.0 ? -t : t);
+	return normalize(v);
+}
+
+vec3 vertexPosition()
+{
+	return aPos * positionScale + positionOffset;
+}
+
+vec3 vertexNormal()
+{
+	return octDecode(aNormal);
+}
+
+vec3 vertexTangent()
+{
+	return octDecode(aTangent.xy);
+}
+
+vec3 vertexBitangent()
+{
+	return cross(vertexNormal(), vertexTangent()) * (aTangent.z < 0.0 ? -1.0 : 1.0);
+}
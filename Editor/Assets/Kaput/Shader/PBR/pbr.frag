@@ -3,7 +3,6 @@
 #include "../Dependency/PBR.glsl"
 
 layout(location = 0) uniform MaterialSampler materialSampler;
-uniform Camera camera;
 uniform mat4 model;
 
 in mat3 TBN;
@@ -2,11 +2,10 @@
 
 #include "../Dependency/Vertex.glsl"
 #include "../Dependency/Camera.glsl"
+#include "../Dependency/Instancing.glsl"
 #include "../Dependency/Sampler/Material.glsl"
 
 layout(location = 0) uniform MaterialSampler materialSampler;
-uniform mat4 model;
-uniform Camera camera;
 
 out vec3 worldPos;
 out MaterialData materialData;
@@ -14,17 +13,19 @@ out mat3 TBN;
 
 void main()
 {
+	mat4 world = getModel();
+
 	MaterialValues materialAttributes;
 	materialAttributes.albedo = aAlbedo;
-	materialAttributes.normal = aNormal;
+	materialAttributes.normal = vertexNormal();
 
 	// Push material info to frag based on each sampler mode
-	materialData = pushMaterial(model, materialSampler, materialAttributes, aTexCoords);
+	materialData = pushMaterial(world, materialSampler, materialAttributes, aTexCoords);
 
 	// Get tangent to world space matrix for normal mapping
 	if (materialSampler.normal.mode == 2)
-		TBN = getTBN(model, aNormal, aTangent, aBitangent);
+		TBN = getTBN(world, vertexNormal(), vertexTangent(), vertexBitangent());
 
-	worldPos = (model * vec4(aPos.xyz, 1.0)).xyz;
-	gl_Position = cameraTransformWorld(camera, worldPos);
+	worldPos = (world * vec4(vertexPosition(), 1.0)).xyz;
+	gl_Position = cameraTransformWorld(worldPos);
 }
@@ -98,8 +98,5 @@ namespace KaputEditor
 		//std::optional<std::shared_ptr<UIObject>> m_uiObject;
 		LibMath::Vector3f m_objEulerAngles;
 		EditorState m_state;
-
-		std::pair<bool, std::shared_ptr<KaputEngine::GameObject>> getGameObjectFromId(
-			const KaputEngine::Id& id, KaputEngine::GameObject& object);
 	};
 }
@@ -412,6 +412,20 @@ void DetailWindow::renderRenderComponent(RenderComponent& render)
 		this->changeRenderComponentMesh("Mesh", render);
 	this->m_window->onSameLine(0);
 	this->m_window->renderText("Mesh");
+
+	if (const std::shared_ptr<const Mesh>& mesh = render.mesh(); mesh && mesh->optimizationStats().verticesBefore)
+	{
+		const MeshOptimizationStats& stats = mesh->optimizationStats();
+
+		string lods = std::to_string(mesh->triangleCount());
+
+		for (uint8_t lod = 1; lod < mesh->lodCount(); ++lod)
+			lods += ", " + std::to_string(mesh->triangleCount(lod));
+
+		this->m_window->renderText(format("Vertices {} -> {}, ACMR {:.3f} -> {:.3f}",
+			stats.verticesBefore, stats.verticesAfter, stats.acmrBefore, stats.acmrAfter));
+		this->m_window->renderText(format("LOD triangles {}", lods));
+	}
 	/*Mesh*/
 
 	/*Material*/
@@ -89,9 +89,7 @@ std::shared_ptr<GameObject> Editor::idToGameObject(const Id& id, Scene& scene)
 	if (id == Id { } || id == scene.sceneRoot().id())
 		return nullptr;
 
-	std::pair<bool, std::shared_ptr<GameObject>> result = getGameObjectFromId(id, scene.sceneRoot());
-
-	return result.first ? result.second : nullptr;
+	return scene.findObject(id);
 }
 
 Vector3f& Editor::getObjectAngles() noexcept
@@ -194,38 +192,3 @@ void Editor::unselectObject()
 	this->m_selectedId = NO_ID;
 	this->m_object = nullptr;
 }
-
-// TODO Consider returning optional or nullable pointer
-std::pair<bool, std::shared_ptr<GameObject>> Editor::getGameObjectFromId(const Id& id, GameObject& object)
-{
-	std::pair<bool, std::shared_ptr<GameObject>> result;
-
-	result.first = false;
-	result.second = nullptr;
-
-	if (id == object.id())
-	{
-		result.second = object.shared_from_this();
-		m_selectedId = id;
-		result.first = true;
-		return result;
-	}
-
-	for (GameObject& obj : object.children())
-	{
-		if (id == obj.id())
-		{
-			result.second = obj.shared_from_this();
-			m_selectedId = id;
-			result.first = true;
-			return result;
-		}
-
-		result = getGameObjectFromId(id, obj);
-
-		if (result.first)
-			return result;
-	}
-
-	return result;
-}
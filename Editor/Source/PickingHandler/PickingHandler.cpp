@@ -21,7 +21,9 @@ using KaputEditor::PicklingHandler;
 using KaputEditor::SceneCamera;
 
 using KaputEngine::Rendering::Color;
+using KaputEngine::Rendering::EngineUniforms;
 using KaputEngine::Rendering::Mesh;
+using KaputEngine::Rendering::VertexQuantization;
 
 using std::cout;
 
@@ -609,8 +611,10 @@ void PicklingHandler::renderSceneView(GameObject& object)
 
 			const Matrix4f MVP = projview * model;
 
-			this->m_program->setUniform("MVP", MVP);
-			this->m_program->setUniform("PickingColor", Color::Black);
+			const EngineUniforms& uniforms = this->m_program->engineUniforms();
+
+			this->m_program->setUniform(uniforms.mvp, MVP);
+			this->m_program->setUniform(uniforms.pickingColor, Color::Black);
 
 			this->m_defaultMesh.draw();
 		}
@@ -627,22 +631,21 @@ void PicklingHandler::sendPositions(const GameObject& object, const Color& col)
 
 	Matrix4f MVP = projview * model;
 
-	this->m_program->setUniform("MVP", MVP);
-	this->m_program->setUniform("PickingColor", col);
+	const EngineUniforms& uniforms = this->m_program->engineUniforms();
+
+	this->m_program->setUniform(uniforms.mvp, MVP);
+	this->m_program->setUniform(uniforms.pickingColor, col);
 
 	const RenderComponent* render = object.getComponent<RenderComponent>();
+	const std::shared_ptr<const Mesh> mesh = render ? render->mesh() : nullptr;
+	const Mesh& drawn = mesh ? *mesh : m_defaultMesh;
 
-	if (render)
-	{
-		std::shared_ptr<const Mesh> mesh = render->mesh();
+	const VertexQuantization& quantization = drawn.quantization();
 
-		if (mesh)
-			mesh->draw();
-		else
-			m_defaultMesh.draw();
-	}
-	else
-		m_defaultMesh.draw();
+	this->m_program->setUniform(uniforms.positionScale, quantization.scale);
+	this->m_program->setUniform(uniforms.positionOffset, quantization.offset);
+
+	drawn.draw();
 
 	for (const GameObject& obj : object.children())
 		this->sendPositions(obj, toPickingColor(obj.id()));
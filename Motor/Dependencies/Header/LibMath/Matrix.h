@@ -1,8 +1,11 @@
 #pragma once
 
 #include "MathArray/MathArray.h"
+#include "Simd.h"
 
 #include <sal.h>
+#include <span>
+#include <type_traits>
 
 namespace LibMath
 {
@@ -22,6 +25,9 @@ namespace LibMath
 		template <ArrIndex WR>
 		using Multiplied = Matrix<WR, H, TData>;
 
+		// 4x4 float matrices go through the SIMD kernels when the target has them
+		static constexpr bool IsSimd4 = W == 4 && H == 4 && std::is_same_v<TData, float> && Simd::HasMatrix4;
+
 		template <IsMathArray<W, H, TData> T>
 		static consteval bool CanDefaultMultiplyArray([[maybe_unused]] bool rValue)
 		{
@@ -60,6 +66,12 @@ namespace LibMath
 			
 			Transposed out;
 
+			if constexpr (IsSimd4)
+			{
+				Simd::transpose4(this->raw2D(), out.raw2D());
+				return out;
+			}
+
 			// Navigate the matrix with x and y swapped
 			for (ArrIndex x = 0; x < H; ++x)
 				for (ArrIndex y = 0; y < W; ++y)
@@ -236,7 +248,15 @@ namespace LibMath
 		_NODISCARD Matrix invert(bool superior = false) const
 			requires (W == H)
 		{
-			return adjugate() * (TData(1) / determinant(superior));
+			if constexpr (IsSimd4 && Simd::HasInverse4)
+			{
+				Matrix out;
+				Simd::invert4(this->raw2D(), out.raw2D());
+
+				return out;
+			}
+			else
+				return adjugate() * (TData(1) / determinant(superior));
 		}
 		
 #ifdef STATICASSERT_FALLBACKS
@@ -250,6 +270,17 @@ namespace LibMath
 		_NODISCARD Multiplied<WR> operator*(const Matrix<WR, W, TData>& right) const
 		{
 			Multiplied<WR> out;
+
+			if constexpr (IsSimd4 && WR == 4)
+			{
+				Simd::multiply4(this->raw2D(), right.raw2D(), out.raw2D());
+				return out;
+			}
+			else if constexpr (IsSimd4 && WR == 1)
+			{
+				Simd::transform4(this->raw2D(), right.raw2D()[0], out.raw2D()[0]);
+				return out;
+			}
 	
 			for (ArrIndex x = 0; x < Multiplied<WR>::Width; ++x)
 				for (ArrIndex y = 0; y < Multiplied<WR>::Height; ++y)
@@ -273,6 +304,28 @@ namespace LibMath
 		}
 #endif
 		
+		/// <summary>
+		/// Multiplies each column vector of a batch by the matrix.
+		/// </summary>
+		/// <remarks>Same results as operator* on each vector. The output may be the input and must hold at least as many vectors.</remarks>
+		void transform(const std::span<const Matrix<1, H, TData>> in, const std::span<Matrix<1, H, TData>> out) const
+			requires (W == H)
+		{
+			if (in.empty())
+				return;
+
+			if constexpr (IsSimd4)
+			{
+				static_assert(sizeof(Matrix<1, H, TData>) == sizeof(TData[H]), "Column vectors must be packed.");
+
+				Simd::transformBatch4(this->raw2D(), in.data()->raw(), out.data()->raw(), in.size());
+				return;
+			}
+
+			for (size_t i = 0; i < in.size(); ++i)
+				out[i] = *this * in[i];
+		}
+
 		Matrix& operator*=(const Matrix& right)
 		{
 			// This operator exits solely as an alias on * in order to allow the *= syntax.
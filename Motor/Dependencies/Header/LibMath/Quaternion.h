@@ -3,6 +3,9 @@
 #include "MathArray/Linear/LinearMathArray4.h"
 #include "Vector/Vector3.h"
 #include "MathArray/Internal/PointAliases.h"
+#include "Simd.h"
+
+#include <type_traits>
 
 namespace LibMath
 {
@@ -94,10 +97,16 @@ namespace LibMath
         
         Quaternion& operator*=(const Quaternion& right)
         {
-            return *this = Quaternion(
-                scalar() * right.vector() + right.scalar() * vector() + vector().cross(right.vector()),
-                scalar() * right.scalar() - vector().dot(right.vector())
-            );
+            if constexpr (std::is_same_v<TData, float> && Simd::HasQuaternion)
+            {
+                Simd::quaternionMultiply(this->raw(), right.raw(), this->raw());
+                return *this;
+            }
+            else
+                return *this = Quaternion(
+                    scalar() * right.vector() + right.scalar() * vector() + vector().cross(right.vector()),
+                    scalar() * right.scalar() - vector().dot(right.vector())
+                );
         }
 
         _NODISCARD Quaternion operator*(const Cartesian3<TData>& right) const
@@ -87,7 +87,15 @@ namespace LibMath
 
         _NODISCARD PointType rotate(const PointType& point) const
         {
-            return (*this * point * this->conjugate()).vector().template as<PointType>();
+            if constexpr (std::is_same_v<TData, float> && Simd::HasQuaternion)
+            {
+                PointType out;
+                Simd::quaternionRotate(this->raw(), point.raw(), out.raw());
+
+                return out;
+            }
+            else
+                return (*this * point * this->conjugate()).vector().template as<PointType>();
         }
 
 
@@ -0,0 +1,459 @@
+#pragma once
+
+// Selects the SIMD path at compile time from the target instruction set
+// Define LIBMATH_NO_SIMD to force the scalar templates
+
+#if !defined(LIBMATH_NO_SIMD)
+	#if defined(__AVX2__)
+		#define LIBMATH_SIMD_AVX2
+	#endif
+
+	#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+		#define LIBMATH_SIMD_SSE
+	#elif defined(__ARM_NEON) || defined(_M_ARM64)
+		#define LIBMATH_SIMD_NEON
+	#endif
+#endif
+
+#include <cstddef>
+
+#if defined(LIBMATH_SIMD_AVX2)
+	#include <immintrin.h>
+#elif defined(LIBMATH_SIMD_SSE)
+	#include <emmintrin.h>
+#elif defined(LIBMATH_SIMD_NEON)
+	#include <arm_neon.h>
+#endif
+
+namespace LibMath::Simd
+{
+	using Float4x4 = float[4][4];
+
+	/// <summary>
+	/// Whether 4x4 float matrix multiplication and transposition have a SIMD path
+	/// </summary>
+	constexpr bool HasMatrix4 =
+#if defined(LIBMATH_SIMD_SSE) || defined(LIBMATH_SIMD_NEON)
+		true;
+#else
+		false;
+#endif
+
+	/// <summary>
+	/// Whether 4x4 float matrix inversion has a SIMD path
+	/// </summary>
+	constexpr bool HasInverse4 =
+#if defined(LIBMATH_SIMD_SSE)
+		true;
+#else
+		false;
+#endif
+
+	/// <summary>
+	/// Whether float quaternion composition and rotation have a SIMD path
+	/// </summary>
+	constexpr bool HasQuaternion =
+#if defined(LIBMATH_SIMD_SSE)
+		true;
+#else
+		false;
+#endif
+
+	/// <summary>
+	/// Name of the selected path, for diagnostics
+	/// </summary>
+	constexpr const char* PathName =
+#if defined(LIBMATH_SIMD_AVX2)
+		"AVX2";
+#elif defined(LIBMATH_SIMD_SSE)
+		"SSE2";
+#elif defined(LIBMATH_SIMD_NEON)
+		"NEON";
+#else
+		"Scalar";
+#endif
+
+	// Matrices are stored as columns: out[x] = sum of left[i] * right[x][i]
+	// The output may alias either input
+
+#if defined(LIBMATH_SIMD_SSE)
+	namespace Internal
+	{
+		template <int X, int Y, int Z, int W>
+		__m128 swizzle(const __m128 vec) noexcept
+		{
+			return _mm_shuffle_ps(vec, vec, _MM_SHUFFLE(W, Z, Y, X));
+		}
+
+		template <int X, int Y, int Z, int W>
+		__m128 shuffle(const __m128 left, const __m128 right) noexcept
+		{
+			return _mm_shuffle_ps(left, right, _MM_SHUFFLE(W, Z, Y, X));
+		}
+
+		// 2x2 matrices packed in a register as (m00, m01, m10, m11)
+
+		inline __m128 mat2Mul(const __m128 left, const __m128 right) noexcept
+		{
+			return _mm_add_ps(_mm_mul_ps(left, swizzle<0, 3, 0, 3>(right)),
+				_mm_mul_ps(swizzle<1, 0, 3, 2>(left), swizzle<2, 1, 2, 1>(right)));
+		}
+
+		// Adjugate of left times right
+		inline __m128 mat2AdjMul(const __m128 left, const __m128 right) noexcept
+		{
+			return _mm_sub_ps(_mm_mul_ps(swizzle<3, 3, 0, 0>(left), right),
+				_mm_mul_ps(swizzle<1, 1, 2, 2>(left), swizzle<2, 3, 0, 1>(right)));
+		}
+
+		// Left times the adjugate of right
+		inline __m128 mat2MulAdj(const __m128 left, const __m128 right) noexcept
+		{
+			return _mm_sub_ps(_mm_mul_ps(left, swizzle<3, 0, 3, 0>(right)),
+				_mm_mul_ps(swizzle<1, 0, 3, 2>(left), swizzle<2, 1, 2, 1>(right)));
+		}
+
+		inline __m128 dot3(const __m128 left, const __m128 right) noexcept
+		{
+			const __m128 product = _mm_mul_ps(left, right);
+
+			return _mm_add_ps(_mm_add_ps(swizzle<0, 0, 0, 0>(product), swizzle<1, 1, 1, 1>(product)),
+				swizzle<2, 2, 2, 2>(product));
+		}
+
+		inline __m128 cross3(const __m128 left, const __m128 right) noexcept
+		{
+			return _mm_sub_ps(
+				_mm_mul_ps(swizzle<1, 2, 0, 3>(left), swizzle<2, 0, 1, 3>(right)),
+				_mm_mul_ps(swizzle<2, 0, 1, 3>(left), swizzle<1, 2, 0, 3>(right)));
+		}
+	}
+#endif
+
+	inline void multiply4(const Float4x4& left, const Float4x4& right, Float4x4& out) noexcept
+	{
+#if defined(LIBMATH_SIMD_AVX2)
+		// Two output columns per iteration
+		const __m256
+			c0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(left[0])),
+			c1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(left[1])),
+			c2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(left[2])),
+			c3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(left[3]));
+
+		const __m256
+			r01 = _mm256_loadu_ps(right[0]),
+			r23 = _mm256_loadu_ps(right[2]);
+
+		const auto column = [&](const __m256 r) -> __m256
+		{
+			__m256 sum = _mm256_mul_ps(c0, _mm256_permute_ps(r, 0x00));
+			sum = _mm256_add_ps(sum, _mm256_mul_ps(c1, _mm256_permute_ps(r, 0x55)));
+			sum = _mm256_add_ps(sum, _mm256_mul_ps(c2, _mm256_permute_ps(r, 0xAA)));
+			return _mm256_add_ps(sum, _mm256_mul_ps(c3, _mm256_permute_ps(r, 0xFF)));
+		};
+
+		const __m256 o01 = column(r01), o23 = column(r23);
+
+		_mm256_storeu_ps(out[0], o01);
+		_mm256_storeu_ps(out[2], o23);
+#elif defined(LIBMATH_SIMD_SSE)
+		const __m128
+			c0 = _mm_loadu_ps(left[0]),
+			c1 = _mm_loadu_ps(left[1]),
+			c2 = _mm_loadu_ps(left[2]),
+			c3 = _mm_loadu_ps(left[3]);
+
+		__m128 result[4];
+
+		for (int x = 0; x < 4; ++x)
+		{
+			const __m128 r = _mm_loadu_ps(right[x]);
+
+			__m128 sum = _mm_mul_ps(c0, Internal::swizzle<0, 0, 0, 0>(r));
+			sum = _mm_add_ps(sum, _mm_mul_ps(c1, Internal::swizzle<1, 1, 1, 1>(r)));
+			sum = _mm_add_ps(sum, _mm_mul_ps(c2, Internal::swizzle<2, 2, 2, 2>(r)));
+			result[x] = _mm_add_ps(sum, _mm_mul_ps(c3, Internal::swizzle<3, 3, 3, 3>(r)));
+		}
+
+		for (int x = 0; x < 4; ++x)
+			_mm_storeu_ps(out[x], result[x]);
+#elif defined(LIBMATH_SIMD_NEON)
+		const float32x4_t
+			c0 = vld1q_f32(left[0]),
+			c1 = vld1q_f32(left[1]),
+			c2 = vld1q_f32(left[2]),
+			c3 = vld1q_f32(left[3]);
+
+		float32x4_t result[4];
+
+		for (int x = 0; x < 4; ++x)
+		{
+			float32x4_t sum = vmulq_n_f32(c0, right[x][0]);
+			sum = vmlaq_n_f32(sum, c1, right[x][1]);
+			sum = vmlaq_n_f32(sum, c2, right[x][2]);
+			result[x] = vmlaq_n_f32(sum, c3, right[x][3]);
+		}
+
+		for (int x = 0; x < 4; ++x)
+			vst1q_f32(out[x], result[x]);
+#else
+		static_assert(HasMatrix4, "No SIMD path for 4x4 matrices.");
+#endif
+	}
+
+	/// <summary>
+	/// Multiplies a 4x4 matrix by a column vector.
+	/// </summary>
+	inline void transform4(const Float4x4& matrix, const float (&in)[4], float (&out)[4]) noexcept
+	{
+#if defined(LIBMATH_SIMD_SSE)
+		const __m128 v = _mm_loadu_ps(in);
+
+		__m128 sum = _mm_mul_ps(_mm_loadu_ps(matrix[0]), Internal::swizzle<0, 0, 0, 0>(v));
+		sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(matrix[1]), Internal::swizzle<1, 1, 1, 1>(v)));
+		sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(matrix[2]), Internal::swizzle<2, 2, 2, 2>(v)));
+		sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(matrix[3]), Internal::swizzle<3, 3, 3, 3>(v)));
+
+		_mm_storeu_ps(out, sum);
+#elif defined(LIBMATH_SIMD_NEON)
+		const float32x4_t v = vld1q_f32(in);
+
+		float32x4_t sum = vmulq_laneq_f32(vld1q_f32(matrix[0]), v, 0);
+		sum = vmlaq_laneq_f32(sum, vld1q_f32(matrix[1]), v, 1);
+		sum = vmlaq_laneq_f32(sum, vld1q_f32(matrix[2]), v, 2);
+		sum = vmlaq_laneq_f32(sum, vld1q_f32(matrix[3]), v, 3);
+
+		vst1q_f32(out, sum);
+#else
+		static_assert(HasMatrix4, "No SIMD path for 4x4 matrices.");
+#endif
+	}
+
+	/// <summary>
+	/// Multiplies a 4x4 matrix by packed column vectors, keeping the matrix in registers across the batch.
+	/// </summary>
+	/// <remarks>The output may alias the input.</remarks>
+	inline void transformBatch4(const Float4x4& matrix, const float* in, float* out, const size_t count) noexcept
+	{
+		size_t i = 0;
+
+#if defined(LIBMATH_SIMD_AVX2)
+		{
+			// Two vectors per iteration
+			const __m256
+				c0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(matrix[0])),
+				c1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(matrix[1])),
+				c2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(matrix[2])),
+				c3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(matrix[3]));
+
+			for (; i + 2 <= count; i += 2)
+			{
+				const __m256 v = _mm256_loadu_ps(in + i * 4);
+
+				__m256 sum = _mm256_mul_ps(c0, _mm256_permute_ps(v, 0x00));
+				sum = _mm256_add_ps(sum, _mm256_mul_ps(c1, _mm256_permute_ps(v, 0x55)));
+				sum = _mm256_add_ps(sum, _mm256_mul_ps(c2, _mm256_permute_ps(v, 0xAA)));
+				sum = _mm256_add_ps(sum, _mm256_mul_ps(c3, _mm256_permute_ps(v, 0xFF)));
+
+				_mm256_storeu_ps(out + i * 4, sum);
+			}
+		}
+#endif
+
+#if defined(LIBMATH_SIMD_SSE)
+		const __m128
+			c0 = _mm_loadu_ps(matrix[0]),
+			c1 = _mm_loadu_ps(matrix[1]),
+			c2 = _mm_loadu_ps(matrix[2]),
+			c3 = _mm_loadu_ps(matrix[3]);
+
+		// Whole batch on SSE2, the odd vector left by AVX2
+		for (; i < count; ++i)
+		{
+			const __m128 v = _mm_loadu_ps(in + i * 4);
+
+			__m128 sum = _mm_mul_ps(c0, Internal::swizzle<0, 0, 0, 0>(v));
+			sum = _mm_add_ps(sum, _mm_mul_ps(c1, Internal::swizzle<1, 1, 1, 1>(v)));
+			sum = _mm_add_ps(sum, _mm_mul_ps(c2, Internal::swizzle<2, 2, 2, 2>(v)));
+			sum = _mm_add_ps(sum, _mm_mul_ps(c3, Internal::swizzle<3, 3, 3, 3>(v)));
+
+			_mm_storeu_ps(out + i * 4, sum);
+		}
+#elif defined(LIBMATH_SIMD_NEON)
+		const float32x4_t
+			c0 = vld1q_f32(matrix[0]),
+			c1 = vld1q_f32(matrix[1]),
+			c2 = vld1q_f32(matrix[2]),
+			c3 = vld1q_f32(matrix[3]);
+
+		for (; i < count; ++i)
+		{
+			const float32x4_t v = vld1q_f32(in + i * 4);
+
+			float32x4_t sum = vmulq_laneq_f32(c0, v, 0);
+			sum = vmlaq_laneq_f32(sum, c1, v, 1);
+			sum = vmlaq_laneq_f32(sum, c2, v, 2);
+			sum = vmlaq_laneq_f32(sum, c3, v, 3);
+
+			vst1q_f32(out + i * 4, sum);
+		}
+#else
+		static_assert(HasMatrix4, "No SIMD path for 4x4 matrices.");
+#endif
+	}
+
+	inline void transpose4(const Float4x4& in, Float4x4& out) noexcept
+	{
+#if defined(LIBMATH_SIMD_SSE)
+		__m128
+			c0 = _mm_loadu_ps(in[0]),
+			c1 = _mm_loadu_ps(in[1]),
+			c2 = _mm_loadu_ps(in[2]),
+			c3 = _mm_loadu_ps(in[3]);
+
+		_MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+
+		_mm_storeu_ps(out[0], c0);
+		_mm_storeu_ps(out[1], c1);
+		_mm_storeu_ps(out[2], c2);
+		_mm_storeu_ps(out[3], c3);
+#elif defined(LIBMATH_SIMD_NEON)
+		// De-interleaving load is a transposition
+		const float32x4x4_t columns = vld4q_f32(in[0]);
+
+		vst1q_f32(out[0], columns.val[0]);
+		vst1q_f32(out[1], columns.val[1]);
+		vst1q_f32(out[2], columns.val[2]);
+		vst1q_f32(out[3], columns.val[3]);
+#else
+		static_assert(HasMatrix4, "No SIMD path for 4x4 matrices.");
+#endif
+	}
+
+	/// <summary>
+	/// Inverts a 4x4 matrix by 2x2 blocks.
+	/// </summary>
+	/// <remarks>Layout-agnostic as the inverse of the transpose is the transpose of the inverse. Singular matrices produce non-finite values.</remarks>
+	inline void invert4(const Float4x4& in, Float4x4& out) noexcept
+	{
+#if defined(LIBMATH_SIMD_SSE)
+		using namespace Internal;
+
+		const __m128
+			v0 = _mm_loadu_ps(in[0]),
+			v1 = _mm_loadu_ps(in[1]),
+			v2 = _mm_loadu_ps(in[2]),
+			v3 = _mm_loadu_ps(in[3]);
+
+		// Sub-matrices
+		const __m128
+			a = _mm_movelh_ps(v0, v1),
+			b = _mm_movehl_ps(v1, v0),
+			c = _mm_movelh_ps(v2, v3),
+			d = _mm_movehl_ps(v3, v2);
+
+		// Determinants of the sub-matrices as (|A|, |B|, |C|, |D|)
+		const __m128 detSub = _mm_sub_ps(
+			_mm_mul_ps(shuffle<0, 2, 0, 2>(v0, v2), shuffle<1, 3, 1, 3>(v1, v3)),
+			_mm_mul_ps(shuffle<1, 3, 1, 3>(v0, v2), shuffle<0, 2, 0, 2>(v1, v3)));
+
+		const __m128
+			detA = swizzle<0, 0, 0, 0>(detSub),
+			detB = swizzle<1, 1, 1, 1>(detSub),
+			detC = swizzle<2, 2, 2, 2>(detSub),
+			detD = swizzle<3, 3, 3, 3>(detSub);
+
+		const __m128
+			dc = mat2AdjMul(d, c),
+			ab = mat2AdjMul(a, b);
+
+		__m128
+			x = _mm_sub_ps(_mm_mul_ps(detD, a), mat2Mul(b, dc)),
+			w = _mm_sub_ps(_mm_mul_ps(detA, d), mat2Mul(c, ab)),
+			y = _mm_sub_ps(_mm_mul_ps(detB, c), mat2MulAdj(d, ab)),
+			z = _mm_sub_ps(_mm_mul_ps(detC, b), mat2MulAdj(a, dc));
+
+		// |M| = |A||D| + |B||C| - tr((A#B)(D#C))
+		__m128 trace = _mm_mul_ps(ab, swizzle<0, 2, 1, 3>(dc));
+		trace = _mm_add_ps(trace, _mm_movehl_ps(trace, trace));
+		trace = _mm_add_ps(trace, swizzle<1, 1, 1, 1>(trace));
+		trace = swizzle<0, 0, 0, 0>(trace);
+
+		const __m128 det = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(detA, detD), _mm_mul_ps(detB, detC)), trace);
+		const __m128 invDet = _mm_div_ps(_mm_setr_ps(1.f, -1.f, -1.f, 1.f), det);
+
+		x = _mm_mul_ps(x, invDet);
+		y = _mm_mul_ps(y, invDet);
+		z = _mm_mul_ps(z, invDet);
+		w = _mm_mul_ps(w, invDet);
+
+		// Apply the adjugate shuffle while storing
+		_mm_storeu_ps(out[0], shuffle<3, 1, 3, 1>(x, y));
+		_mm_storeu_ps(out[1], shuffle<2, 0, 2, 0>(x, y));
+		_mm_storeu_ps(out[2], shuffle<3, 1, 3, 1>(z, w));
+		_mm_storeu_ps(out[3], shuffle<2, 0, 2, 0>(z, w));
+#else
+		static_assert(HasInverse4, "No SIMD path for 4x4 matrix inversion.");
+#endif
+	}
+
+	/// <summary>
+	/// Hamilton product of two quaternions stored as (x, y, z, w).
+	/// </summary>
+	inline void quaternionMultiply(const float (&left)[4], const float (&right)[4], float (&out)[4]) noexcept
+	{
+#if defined(LIBMATH_SIMD_SSE)
+		using namespace Internal;
+
+		const __m128
+			l = _mm_loadu_ps(left),
+			r = _mm_loadu_ps(right);
+
+		// Negates the w lane
+		const __m128 signW = _mm_setr_ps(0.f, 0.f, 0.f, -0.f);
+
+		const __m128
+			t0 = _mm_mul_ps(swizzle<3, 3, 3, 3>(l), r),
+			t1 = _mm_mul_ps(swizzle<0, 1, 2, 0>(l), swizzle<3, 3, 3, 0>(r)),
+			t2 = _mm_mul_ps(swizzle<1, 2, 0, 1>(l), swizzle<2, 0, 1, 1>(r)),
+			t3 = _mm_mul_ps(swizzle<2, 0, 1, 2>(l), swizzle<1, 2, 0, 2>(r));
+
+		_mm_storeu_ps(out, _mm_sub_ps(_mm_add_ps(t0, _mm_xor_ps(_mm_add_ps(t1, t2), signW)), t3));
+#else
+		static_assert(HasQuaternion, "No SIMD path for quaternions.");
+#endif
+	}
+
+	/// <summary>
+	/// Rotates a point by a quaternion stored as (x, y, z, w), matching q * p * conjugate(q) for non-unit quaternions.
+	/// </summary>
+	inline void quaternionRotate(const float (&rotation)[4], const float (&point)[3], float (&out)[3]) noexcept
+	{
+#if defined(LIBMATH_SIMD_SSE)
+		using namespace Internal;
+
+		const __m128 q = _mm_loadu_ps(rotation);
+		const __m128 p = _mm_setr_ps(point[0], point[1], point[2], 0.f);
+
+		// Vector part with a cleared w lane
+		const __m128 u = _mm_and_ps(q, _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0)));
+		const __m128 w = swizzle<3, 3, 3, 3>(q);
+
+		// p (w² - u.u) + 2 (u.p) u + 2 w (u x p)
+		const __m128 two = _mm_set1_ps(2.f);
+
+		__m128 result = _mm_mul_ps(p, _mm_sub_ps(_mm_mul_ps(w, w), dot3(u, u)));
+		result = _mm_add_ps(result, _mm_mul_ps(_mm_mul_ps(two, dot3(u, p)), u));
+		result = _mm_add_ps(result, _mm_mul_ps(_mm_mul_ps(two, w), cross3(u, p)));
+
+		alignas(16) float values[4];
+		_mm_store_ps(values, result);
+
+		out[0] = values[0];
+		out[1] = values[1];
+		out[2] = values[2];
+#else
+		static_assert(HasQuaternion, "No SIMD path for quaternions.");
+#endif
+	}
+}
@@ -22,11 +22,39 @@ namespace KaputEngine
         /// <returns>Returns false if initialization fails</returns>
         static _NODISCARD bool init(const char* title, const LibMath::Vector2i& size);
 
+        /// <summary>
+        /// Initializes the application without a window, UI or rendering context.
+        /// </summary>
+        /// <param name="tickRate">Number of updates per second, 0 to update as fast as possible</param>
+        /// <returns>Returns false if initialization fails</returns>
+        /// <remarks>
+        /// The context queue, scene updates, physics and scripts keep running. Resources skip their GPU data and sounds are not played.
+        /// </remarks>
+        static _NODISCARD bool initHeadless(double tickRate);
+
+        _NODISCARD static bool headless() noexcept;
+
+        /// <summary>
+        /// Sets the number of updates per second in headless mode, 0 to update as fast as possible.
+        /// </summary>
+        static void setTickRate(double tickRate);
+        _NODISCARD static double tickRate() noexcept;
+
         /// <summary>
         /// Runs the application loop.
         /// </summary>
         static void run();
 
+        /// <summary>
+        /// Enables pipelined rendering, drawing a frame on a dedicated render thread while the next one is simulated.
+        /// </summary>
+        /// <remarks>
+        /// Takes effect on the next call to <see cref="run"/>. The render thread owns the context, all rendering calls must go through the context queue.
+        /// UI platform windows are not supported in this mode.
+        /// </remarks>
+        static void setPipelined(bool pipelined) noexcept;
+        _NODISCARD static bool pipelined() noexcept;
+
         /// <summary>
         /// Exits the application loop.
         /// </summary>
@@ -42,6 +70,11 @@ namespace KaputEngine
 
         static double getDeltaTime() noexcept;
 
+        /// <summary>
+        /// Seconds from the start of the application to the start of the current frame.
+        /// </summary>
+        static double getTime() noexcept;
+
         static InputManager& getInputManager() noexcept;
 
         static void setPauseBool();
@@ -113,6 +146,16 @@ namespace KaputEngine
     private:
 		static void updateDeltaTime();
 
+        /// <summary>
+        /// Runs the update loop at the tick rate without rendering.
+        /// </summary>
+        static void runHeadless();
+
+        /// <summary>
+        /// Initializes the state shared by the windowed and headless modes, such as the Lua bindings.
+        /// </summary>
+        static void initCommon();
+
         friend class ObjectBase;
         friend class RenderComponent;
 
@@ -127,6 +170,10 @@ namespace KaputEngine
 
         static bool s_shouldQuit;
         static bool s_paused;
+        static bool s_pipelined;
+        static bool s_headless;
+
+        static double s_tickRate;
 
 		static sol::state s_lua;
 
@@ -2,6 +2,8 @@
 
 #include "GameObject/ObjectBase.h"
 
+#include "Component/ComponentType.h"
+#include "Utils/HandlePool.h"
 #include "Utils/Pointer.h"
 
 #define COMPONENT_SIGS(type, base) \
@@ -51,9 +53,33 @@ namespace KaputEngine
 		_NODISCARD _Ret_notnull_ GameObject* parentObject() const noexcept final;
 		_NODISCARD _Ret_maybenull_ Scene* parentScene() const noexcept final;
 
+		/// <summary>
+		/// Handle of the component in its scene, unset while outside of a scene.
+		/// </summary>
+		_NODISCARD Handle<Component> handle() const noexcept;
+
+		/// <summary>
+		/// Index of the dynamic type of the component in <see cref="ComponentTypes"/>.
+		/// </summary>
+		_NODISCARD ComponentTypeIndex typeIndex() const noexcept;
+
+		/// <summary>
+		/// Bits of the dynamic type of the component and its bases.
+		/// </summary>
+		_NODISCARD ComponentTypeMask typeMask() const noexcept;
+
+		/// <summary>
+		/// Whether the component is of type T or derived from it, without RTTI.
+		/// </summary>
+		template <std::derived_from<Component> T>
+		_NODISCARD bool is() const noexcept;
+
 		void destroy() override;
 
 	protected:
+		void registerQueues(Scene& scene) override;
+		void unregisterQueues() override;
+
 		template <std::derived_from<Component> T>
 		static sol::usertype<T> registerLuaType(sol::state& lua);
 
@@ -65,6 +91,12 @@ namespace KaputEngine
 		exclusive_weak_ptr<Component> m_ptr;
 
 	private:
+		Handle<Component> m_handle;
+
+		// Set by the object adding the component, which knows its static type
+		ComponentTypeIndex m_typeIndex = 0;
+		ComponentTypeMask m_typeMask = 0;
+
 		using CreateFunc = Component&(GameObject& parent);
 		using DeserializeFunc = _Ret_maybenull_ Component*(const Text::Xml::XmlNode::Map& map, GameObject& parent);
 
@@ -66,8 +66,22 @@ namespace KaputEngine
 	{
 		ObjectBase::defineLuaMembers(type);
 
+		type["handle"]    = sol::readonly_property(&handle);
+		type["typeIndex"] = sol::readonly_property(&typeIndex);
+
+		// Type indices for the index-based lookups of GameObject
+		sol::table componentTypes = Application::luaState().globals()["ComponentType"].get_or_create<sol::table>();
+		componentTypes[T::TypeName] = componentTypeIndex<T>();
+
 		auto gameObjectType = Application::luaState().globals()["GameObject"];
 		/*gameObjectType[std::format("add{}", T::TypeName).c_str()] = &GameObject::addComponent<T>;*/
 		gameObjectType[std::format("get{}", T::TypeName).c_str()] = (T* (GameObject::*)())(&GameObject::getComponent<T>);
+		gameObjectType[std::format("has{}", T::TypeName).c_str()] = &GameObject::hasComponent<T>;
+	}
+
+	template <std::derived_from<Component> T>
+	bool Component::is() const noexcept
+	{
+		return m_typeMask & componentTypeBit<T>();
 	}
 }
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <concepts>
+#include <cstdint>
+
+namespace KaputEngine
+{
+	class Component;
+	class AudioComponent;
+	class AudioListenerComponent;
+	class LightComponent;
+	class DirectionalLightComponent;
+	class PointLightComponent;
+	class PhysicComponent;
+	class RenderComponent;
+	class ScriptComponent;
+
+	using ComponentTypeIndex = uint8_t;
+
+	/// <summary>
+	/// Set of component types with one bit per type index
+	/// </summary>
+	using ComponentTypeMask = uint32_t;
+
+	template <typename... Ts>
+	struct ComponentTypeList
+	{
+		static constexpr size_t Count = sizeof...(Ts);
+	};
+
+	/// <summary>
+	/// Component types with a type index, given by their position in the list.
+	/// </summary>
+	/// <remarks>New component types must be added here to be added to game objects.</remarks>
+	using ComponentTypes = ComponentTypeList<
+		Component,
+		AudioComponent,
+		AudioListenerComponent,
+		LightComponent,
+		DirectionalLightComponent,
+		PointLightComponent,
+		PhysicComponent,
+		RenderComponent,
+		ScriptComponent>;
+
+	constexpr size_t ComponentTypeCount = ComponentTypes::Count;
+
+	static_assert(ComponentTypeCount <= sizeof(ComponentTypeMask) * 8, "Too many component types for the type mask.");
+
+	/// <summary>
+	/// Index of a component type in <see cref="ComponentTypes"/>.
+	/// </summary>
+	template <typename T>
+	_NODISCARD consteval ComponentTypeIndex componentTypeIndex() noexcept;
+
+	/// <summary>
+	/// Mask with the bits of a component type and all of its component base types.
+	/// </summary>
+	/// <remarks>A component of type T is a U if the mask of T contains the bit of U.</remarks>
+	template <std::derived_from<Component> T>
+	_NODISCARD consteval ComponentTypeMask componentTypeMask() noexcept;
+
+	template <typename T>
+	_NODISCARD consteval ComponentTypeMask componentTypeBit() noexcept;
+}
+
+#include "ComponentType.hpp"
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "Component/ComponentType.h"
+
+#include <type_traits>
+
+namespace KaputEngine
+{
+	namespace Detail
+	{
+		template <typename T, typename... Ts>
+		consteval size_t indexInList(ComponentTypeList<Ts...>) noexcept
+		{
+			constexpr bool matches[] { std::is_same_v<T, Ts>... };
+
+			for (size_t i = 0; i < sizeof...(Ts); ++i)
+				if (matches[i])
+					return i;
+
+			return sizeof...(Ts);
+		}
+	}
+
+	template <typename T>
+	consteval ComponentTypeIndex componentTypeIndex() noexcept
+	{
+		constexpr size_t index = Detail::indexInList<std::remove_cv_t<T>>(ComponentTypes());
+		static_assert(index < ComponentTypeCount, "Component type is not listed in ComponentTypes.");
+
+		return static_cast<ComponentTypeIndex>(index);
+	}
+
+	template <typename T>
+	consteval ComponentTypeMask componentTypeBit() noexcept
+	{
+		return ComponentTypeMask(1) << componentTypeIndex<T>();
+	}
+
+	template <std::derived_from<Component> T>
+	consteval ComponentTypeMask componentTypeMask() noexcept
+	{
+		using Type = std::remove_cv_t<T>;
+
+		if constexpr (std::is_same_v<Type, Component>)
+			return componentTypeBit<Type>();
+		else
+			return componentTypeBit<Type>() | componentTypeMask<typename Type::Base>();
+	}
+}
@@ -67,6 +67,11 @@ namespace KaputEngine
 
 		void updatePhysics(double deltaTime) override;
 
+		/// <summary>
+		/// Moves the parent object between the last two simulated states.
+		/// </summary>
+		void interpolatePhysics(double alpha) override;
+
 		void render(const Camera& camera);
 
 		void renderRightForm();
@@ -119,6 +124,16 @@ namespace KaputEngine
 
 		void getRightShape(ePhysicShape shape, const LibMath::Vector3f& size);
 
+		/// <summary>
+		/// Gets the world transform of the parent object with the simulated position and rotation, excluding frozen translation axes.
+		/// </summary>
+		_NODISCARD Transform getSimulatedTransform() const;
+
+		/// <summary>
+		/// Discards the previous simulated state so the parent object does not blend across a teleport.
+		/// </summary>
+		void resetInterpolation();
+
 		void onCollisionEnter(_In_ IPhysicsUpdatable* collider) override;
 
 		void onCollision(_In_ IPhysicsUpdatable* collider) override;
@@ -148,6 +163,11 @@ namespace KaputEngine
 		std::string m_collisionTag;
 		std::bitset<3> m_fixRotation;
 		std::bitset<3> m_fixTranslation;
+
+		// Last two simulated states, blended by interpolatePhysics
+		Transform m_previousSimulatedTransform;
+		Transform m_simulatedTransform;
+
 		ePhysicShape m_shape;
 		bool m_physicUpdate;
 	};
@@ -29,6 +29,16 @@ namespace KaputEngine
         OBJECTBASE_DEFAULT_REGISTER(RenderComponent)
 
     public:
+        /// <summary>
+        /// Projected height of the bounding sphere relative to the screen below which each level after the full mesh is used.
+        /// </summary>
+        static constexpr float LodScreenSizes[] { .5f, .25f, .125f };
+
+        /// <summary>
+        /// Relative margin past a threshold before switching level, so objects at the threshold do not flicker.
+        /// </summary>
+        static constexpr float LodHysteresis = .1f;
+
         explicit RenderComponent(GameObject& parent,
             _In_ const std::shared_ptr<const Rendering::Mesh>& mesh,
             _In_ const std::shared_ptr<Rendering::Material>& material);
@@ -47,8 +57,35 @@ namespace KaputEngine
         void setCanRender(bool canRender) noexcept;
 
         void setShaderProgram(const std::shared_ptr<const Rendering::ShaderProgram>& prog);
+        _NODISCARD const std::shared_ptr<const Rendering::ShaderProgram>& shaderProgram() const noexcept;
+
+        /// <summary>
+        /// Whether the mesh is drawn by a static batch of the scene instead of the component.
+        /// </summary>
+        /// <remarks>Unbatching removes the mesh from its batches, which cannot take it back.</remarks>
+        _NODISCARD bool batched() const noexcept;
+        void setBatched(bool batched);
+
+        /// <summary>
+        /// Whether the mesh hides the renderables behind it, such as walls and large props.
+        /// </summary>
+        _NODISCARD bool isOccluder() const noexcept;
+        void setOccluder(bool occluder) noexcept;
 
         void render(const Camera& camera) override;
+        void record(Rendering::Command::CommandList& list, const Camera& camera) override;
+
+        _NODISCARD _Success_(return) bool getWorldBounds(_Out_ Rendering::Culling::Bounds& out) const override;
+
+        _Success_(return) bool queue(Rendering::DrawQueue& queue, const Camera& camera) override;
+
+        void appendOccluders(std::vector<Rendering::Culling::Occluder>& out) const override;
+
+        /// <summary>
+        /// Picks the level of detail for a projected size, leaving the current one only past the hysteresis around its thresholds.
+        /// </summary>
+        /// <param name="screenSize">Projected height of the bounding sphere relative to the screen</param>
+        _NODISCARD static uint8_t selectLod(float screenSize, uint8_t current, uint8_t lodCount) noexcept;
 
          _NODISCARD _Ret_maybenull_ std::shared_ptr<const Rendering::Mesh>& mesh() noexcept;
          _NODISCARD _Ret_maybenull_ const std::shared_ptr<const Rendering::Mesh>& mesh() const noexcept;
@@ -79,6 +116,21 @@ namespace KaputEngine
 		std::shared_ptr<Rendering::Material> m_material;
 
     private:
+        /// <summary>
+        /// Picks the level of detail of the mesh from its projected size as seen by the camera.
+        /// </summary>
+        _NODISCARD uint8_t selectLod(const Camera& camera);
+
+        /// <summary>
+        /// Removes the meshes from the static batches of the scene, leaving the component unbatched without registering it.
+        /// </summary>
+        void leaveBatches();
+
         bool m_canRender = true;
+        bool m_batched = false;
+        bool m_occluder = false;
+
+        // Level of detail of the last queued draw
+        uint8_t m_lod = 0;
     };
 }
@@ -57,6 +57,6 @@ namespace KaputEngine
 
         mutable LibMath::Matrix4f m_viewProjection;
 
-        void updateWorldTransform() const noexcept final;
+        void onWorldTransformChanged() const final;
     };
 }
@@ -4,7 +4,9 @@
 #include "Scene/Transform/MatrixSource.h"
 
 #include "../Component/Component.h"
+#include "Utils/HandlePool.h"
 
+#include <array>
 #include <sol/sol.hpp>
 
 #define GAMEOBJECT_SIGS(type, base) \
@@ -44,6 +46,8 @@ namespace KaputEngine
 		public MatrixTransformSource
 	{
 		OBJECTBASE_SIGS(GameObject, ObjectBase)
+		friend Scene;
+		friend class TransformHierarchy;
 
 	protected:
 		REGISTER_SIG(GameObject);
@@ -81,15 +85,42 @@ namespace KaputEngine
 
 		_NODISCARD bool isRoot() const noexcept;
 
+		/// <summary>
+		/// Handle of the object in its scene, unset while outside of a scene.
+		/// </summary>
+		_NODISCARD Handle<GameObject> handle() const noexcept;
+
 		template <std::derived_from<Component> T, typename... Args>
 		T& addComponent(Args&&... args);
 
+		/// <summary>
+		/// Gets the first component of type T or derived from it in constant time.
+		/// </summary>
 		template <std::derived_from<Component> T>
 		_NODISCARD _Success_(return) T* getComponent();
 
 		template <typename T>
 		_NODISCARD _Success_(return) const T* getComponent() const;
 
+		/// <summary>
+		/// Gets the first component of a type by its index in <see cref="ComponentTypes"/>.
+		/// </summary>
+		_NODISCARD _Ret_maybenull_ Component* getComponent(ComponentTypeIndex index) const noexcept;
+
+		template <std::derived_from<Component> T>
+		_NODISCARD bool hasComponent() const noexcept;
+
+		_NODISCARD bool hasComponent(ComponentTypeIndex index) const noexcept;
+
+		/// <summary>
+		/// Calls a function on every component of type T or derived from it.
+		/// </summary>
+		template <std::derived_from<Component> T, std::invocable<T&> Func>
+		void forEachComponent(Func&& func);
+
+		template <std::derived_from<Component> T, std::invocable<const T&> Func>
+		void forEachComponent(Func&& func) const;
+
 		void removeComponent(Component& component);
 
 		_NODISCARD _Ret_maybenull_ GameObject* parentObject() const noexcept final;
@@ -98,6 +129,12 @@ namespace KaputEngine
 		_NODISCARD const RemoveVector<GameObject, std::shared_ptr<GameObject>>& children() const noexcept;
 
 		void attachTo(_In_opt_ GameObject* parent, bool adjustWorldTransform = false, eDeletePolicy policy = eDeletePolicy::DELETE);
+
+		/// <summary>
+		/// Attaches to an object of the same scene referenced by handle.
+		/// </summary>
+		/// <returns>Whether the handle resolved to a parent</returns>
+		_Success_(return) bool attachTo(Handle<GameObject> parent, bool adjustWorldTransform = false, eDeletePolicy policy = eDeletePolicy::DELETE);
 		void detach();
 
 		void setWorldTransform(const Transform& transform) noexcept override;
@@ -108,6 +145,18 @@ namespace KaputEngine
 
 		_NODISCARD _Ret_maybenull_ TransformSource* getParentTransform() const override;
 
+		/// <summary>
+		/// Incremented every time the world transform is recomputed, so consumers can skip re-reading unchanged matrices.
+		/// </summary>
+		_NODISCARD uint32_t transformVersion() const noexcept;
+
+		/// <summary>
+		/// Whether the object never moves once the scene started, letting its render components be merged into static batches.
+		/// </summary>
+		/// <remarks>Read when the scene starts. Batched geometry keeps its start position if the object moves anyway.</remarks>
+		_NODISCARD bool isStatic() const noexcept;
+		void setStatic(bool isStatic) noexcept;
+
 		void serializeValues(Text::Xml::XmlSerializeContext& context) const override;
 
 		void setPhysicComponentPtr(_In_opt_ PhysicComponent* ptr);
@@ -134,6 +183,11 @@ namespace KaputEngine
 
 		void setTransformDirty() const noexcept override;
 
+		/// <summary>
+		/// Called after the world transform was recomputed.
+		/// </summary>
+		virtual void onWorldTransformChanged() const;
+
 	protected:
 		template <std::derived_from<GameObject> T>
 		static sol::usertype<T> registerLuaType(sol::state& lua);
@@ -147,6 +201,20 @@ namespace KaputEngine
 
 		RemoveVectorStatus& getParentStatus() const noexcept;
 
+		void applyWorldTransform(const Transform& world, const LibMath::Matrix4f& matrix) const;
+
+		void dirtyTransformComponents() const;
+
+		/// <summary>
+		/// Fills the empty type slots of an added component.
+		/// </summary>
+		void slotComponent(Component& component) noexcept;
+
+		/// <summary>
+		/// Moves the type slots held by a removed component to the next component of each type.
+		/// </summary>
+		void unslotComponent(const Component& component) noexcept;
+
 		template <std::derived_from<GameObject> T>
 		static void registerCreate();
 
@@ -160,5 +228,15 @@ namespace KaputEngine
 		static std::unordered_map<std::string, DeserializeFunc*> s_deserializeFuncs;
 
 		PhysicComponent* m_physicBody;
+
+		Handle<GameObject> m_handle;
+
+		mutable uint32_t m_transformVersion = 0;
+
+		bool m_static = false;
+
+		// Types of the components, including their base types, and the first component of each
+		ComponentTypeMask m_componentMask = 0;
+		std::array<Component*, ComponentTypeCount> m_componentSlots { };
 	};
 }
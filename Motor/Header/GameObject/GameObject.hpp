@@ -4,6 +4,8 @@
 
 #include "Component/PhysicComponent.h"
 #include "GameObject/ObjectBase.hpp"
+#include "Memory/SlabAllocator.h"
+#include "Scene/Scene.h"
 
 namespace KaputEngine
 {
@@ -17,7 +19,7 @@ namespace KaputEngine
 	template <std::derived_from<GameObject> T, typename... Args>
 	std::shared_ptr<T> GameObject::create(Args&&... args)
 	{
-		return std::make_shared<T>(ConstructorBlocker(), std::forward<Args>(args)...);
+		return std::allocate_shared<T>(Memory::SlabAllocator<T>::fromCurrent(), ConstructorBlocker(), std::forward<Args>(args)...);
 	}
 
 	template<std::derived_from<GameObject> T>
@@ -103,28 +105,55 @@ namespace KaputEngine
 			obj.setLocalScale(scale);
 		};
 
-		type["attachTo"] = [](GameObject& obj, GameObject& parent)
+		type["handle"] = sol::readonly_property(&handle);
+		type["isStatic"] = sol::property(&isStatic, &setStatic);
+
+		// Index-based lookups taking values of the ComponentType table
+		type["hasComponent"] = [](const GameObject& obj, const ComponentTypeIndex index) -> bool
+		{
+			return obj.hasComponent(index);
+		};
+		type["getComponent"] = [](const GameObject& obj, const ComponentTypeIndex index) -> Component*
 		{
-			obj.attachTo(&parent, true);
+			return obj.getComponent(index);
 		};
+
+		type["attachTo"] = sol::overload(
+			[](GameObject& obj, GameObject& parent)
+			{
+				obj.attachTo(&parent, true);
+			},
+			[](GameObject& obj, Handle<GameObject> parent) -> bool
+			{
+				return obj.attachTo(parent, true);
+			});
 		type["detach"] = (void (GameObject::*)())&detach;
 	}
 
 	template <std::derived_from<Component> T, typename... Args>
 	T& GameObject::addComponent(Args&&... args)
 	{
+		// Components share the memory of the scene of their object when it has one
+		Memory::SlabAllocator<T> allocator = m_scene
+			? Memory::SlabAllocator<T>(m_scene->m_arena)
+			: Memory::SlabAllocator<T>::fromCurrent();
+
 		std::shared_ptr<T> component = std::static_pointer_cast<T>(
-			m_components.push_back(std::make_shared<T>(*this, std::forward<Args>(args)...)));
+			m_components.push_back(std::allocate_shared<T>(allocator, *this, std::forward<Args>(args)...)));
 
 		component->m_ptr = static_cast<std::weak_ptr<Component>>(component);
+		component->m_typeIndex = componentTypeIndex<T>();
+		component->m_typeMask = componentTypeMask<T>();
+
+		slotComponent(*component);
 
 		if (m_scene)
 			component->registerQueues(*m_scene);
 
-		if (std::shared_ptr<PhysicComponent> castPtr = std::dynamic_pointer_cast<PhysicComponent>(component); castPtr)
+		if constexpr (std::derived_from<T, PhysicComponent>)
 		{
-			castPtr->setTransform(this->m_worldTransform);
-			this->m_physicBody = std::to_address(castPtr);
+			component->setTransform(this->m_worldTransform);
+			this->m_physicBody = std::to_address(component);
 		}
 
 		if (m_started)
@@ -136,11 +165,7 @@ namespace KaputEngine
 	template <std::derived_from<Component> T>
 	_Success_(return) T* GameObject::getComponent()
 	{
-		for (auto& component : m_components)
-			if (T* castPtr = dynamic_cast<T*>(&component); castPtr)
-				return castPtr;
-
-		return nullptr;
+		return static_cast<T*>(m_componentSlots[componentTypeIndex<T>()]);
 	}
 
 	template <typename T>
@@ -148,4 +173,32 @@ namespace KaputEngine
 	{
 		return const_cast<GameObject*>(this)->getComponent<T>();
 	}
+
+	template <std::derived_from<Component> T>
+	bool GameObject::hasComponent() const noexcept
+	{
+		return m_componentMask & componentTypeBit<T>();
+	}
+
+	template <std::derived_from<Component> T, std::invocable<T&> Func>
+	void GameObject::forEachComponent(Func&& func)
+	{
+		if (!hasComponent<T>())
+			return;
+
+		for (Component& component : m_components)
+			if (component.typeMask() & componentTypeBit<T>())
+				func(static_cast<T&>(component));
+	}
+
+	template <std::derived_from<Component> T, std::invocable<const T&> Func>
+	void GameObject::forEachComponent(Func&& func) const
+	{
+		if (!hasComponent<T>())
+			return;
+
+		for (const Component& component : m_components)
+			if (component.typeMask() & componentTypeBit<T>())
+				func(static_cast<const T&>(component));
+	}
 }
@@ -13,8 +13,18 @@ namespace KaputEngine
 
 	struct IPhysicsUpdatable: RemoveVectorStatusSource<IPhysicsUpdatable>
 	{
+		/// <summary>
+		/// Called once per fixed simulation step.
+		/// </summary>
+		/// <param name="deltaTime">Fixed time step of the simulation</param>
 		virtual void updatePhysics(double deltaTime){ };
 
+		/// <summary>
+		/// Called once per frame after the simulation steps to blend the last two simulated states.
+		/// </summary>
+		/// <param name="alpha">Fraction of a step elapsed since the last simulated state, in [0, 1)</param>
+		virtual void interpolatePhysics(double alpha){ };
+
 		virtual void onCollisionEnter(IPhysicsUpdatable* collider){ };
 
 		virtual void onCollision(IPhysicsUpdatable* collider){ };
@@ -2,14 +2,56 @@
 
 #include "Utils/RemoveVector.h"
 
+#include <vector>
+
 namespace KaputEngine
 {
     class Camera;
 
+    namespace Rendering::Command
+    {
+        class CommandList;
+    }
+
+    namespace Rendering::Culling
+    {
+        struct Bounds;
+        struct Occluder;
+    }
+
+    namespace Rendering
+    {
+        class DrawQueue;
+    }
+
     struct IWorldRenderable : RemoveVectorStatusSource<IWorldRenderable>
     {
         using RenderFunc = void(const Camera&);
 
         virtual void render(const Camera& camera) {}
+
+        /// <summary>
+        /// Records the render commands for the frame without accessing the rendering context.
+        /// </summary>
+        /// <remarks>By default, records a callback to <see cref="render"/>. The camera must remain alive until the list is submitted.</remarks>
+        virtual void record(Rendering::Command::CommandList& list, const Camera& camera);
+
+        /// <summary>
+        /// Gets the world space bounds used to skip recording the renderable when outside of the view.
+        /// </summary>
+        /// <returns>False if the renderable has no bounds and is always recorded, which is the default.</returns>
+        _NODISCARD _Success_(return) virtual bool getWorldBounds(_Out_ Rendering::Culling::Bounds& out) const;
+
+        /// <summary>
+        /// Queues the draws of the renderable to be sorted with the rest of the frame.
+        /// </summary>
+        /// <returns>False if the renderable cannot be sorted and must be recorded in place, which is the default.</returns>
+        _Success_(return) virtual bool queue(Rendering::DrawQueue& queue, const Camera& camera);
+
+        /// <summary>
+        /// Adds the meshes hiding what is behind the renderable to the occlusion buffer of the frame.
+        /// </summary>
+        /// <remarks>Renderables occlude nothing by default.</remarks>
+        virtual void appendOccluders(std::vector<Rendering::Culling::Occluder>& out) const;
     };
 }
@@ -31,3 +31,17 @@ namespace KaputEngine
 	using Id = unsigned long long;
 #endif
 }
+
+#ifdef KAPUT_GUID
+#include <functional>
+
+template <>
+struct std::hash<KaputEngine::Id>
+{
+	_NODISCARD size_t operator()(const KaputEngine::Id& id) const noexcept
+	{
+		// Both halves are random, mixing them is enough
+		return static_cast<size_t>(id.data()[0] ^ id.data()[1]);
+	}
+};
+#endif
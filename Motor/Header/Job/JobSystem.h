@@ -0,0 +1,180 @@
+#pragma once
+
+#include "Job/WorkStealingDeque.h"
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace KaputEngine::Job
+{
+	enum class eJobPriority : std::uint8_t
+	{
+		// Picked before any other work
+		HIGH,
+		// Default priority
+		NORMAL,
+		// Background work, only picked when nothing else is pending
+		LOW
+	};
+
+	class Job;
+
+	using JobHandle = std::shared_ptr<Job>;
+
+	/// <summary>
+	/// Unit of work executed by the <see cref="JobSystem"/>
+	/// </summary>
+	class Job
+	{
+		friend class JobSystem;
+
+	public:
+		using Function = std::function<void()>;
+
+		Job(Function&& func, eJobPriority priority);
+		Job(const Job&) = delete;
+		Job(Job&&) = delete;
+
+		Job& operator=(const Job&) = delete;
+		Job& operator=(Job&&) = delete;
+
+		_NODISCARD eJobPriority priority() const noexcept;
+
+		/// <summary>
+		/// Returns if the job function has returned.
+		/// </summary>
+		_NODISCARD bool finished() const noexcept;
+
+	private:
+		Function m_func;
+		eJobPriority m_priority;
+
+		std::atomic<bool> m_finished = false;
+
+		// Jobs scheduled once this one finishes
+		std::vector<JobHandle> m_continuations;
+		std::mutex m_continuationMutex;
+	};
+
+	/// <summary>
+	/// Singleton pool of worker threads with per-worker work-stealing deques
+	/// </summary>
+	/// <remarks>Workers are started on first use. One worker is created per hardware thread, minus the main thread.</remarks>
+	class JobSystem
+	{
+	public:
+		static constexpr size_t PriorityCount = 3;
+
+		JobSystem(const JobSystem&) = delete;
+		JobSystem(JobSystem&&) = delete;
+
+		~JobSystem();
+
+		JobSystem& operator=(const JobSystem&) = delete;
+		JobSystem& operator=(JobSystem&&) = delete;
+
+		_NODISCARD static JobSystem& instance() noexcept;
+
+		_NODISCARD size_t workerCount();
+
+		/// <summary>
+		/// Returns if the calling thread is one of the pool's workers.
+		/// </summary>
+		_NODISCARD bool isWorkerThread() const noexcept;
+
+		/// <summary>
+		/// Schedules a function on the pool.
+		/// </summary>
+		/// <returns>Handle to the scheduled job</returns>
+		JobHandle schedule(Job::Function&& func, eJobPriority priority = eJobPriority::NORMAL);
+
+		/// <summary>
+		/// Schedules a function to run once another job has finished.
+		/// </summary>
+		/// <param name="parent">Job to wait on</param>
+		/// <returns>Handle to the continuation job</returns>
+		JobHandle then(_In_ const JobHandle& parent, Job::Function&& func, eJobPriority priority = eJobPriority::NORMAL);
+
+		/// <summary>
+		/// Schedules a function and exposes its result as a future.
+		/// </summary>
+		/// <remarks>Exceptions thrown by the function are forwarded to the future.</remarks>
+		template <typename TResult>
+		_NODISCARD std::future<TResult> async(std::function<TResult()>&& func, eJobPriority priority = eJobPriority::NORMAL);
+
+		/// <summary>
+		/// Waits for a job to finish.
+		/// </summary>
+		/// <remarks>If called from a worker, other pending jobs are executed while waiting so nested waits cannot starve the pool.</remarks>
+		void wait(_In_ const JobHandle& job);
+
+		/// <summary>
+		/// Waits for a future to be ready.
+		/// </summary>
+		/// <remarks>If called from a worker, other pending jobs are executed while waiting so nested waits cannot starve the pool.</remarks>
+		template <typename T>
+		void wait(const std::future<T>& future);
+
+		/// <summary>
+		/// Stops the workers and joins them, then runs the jobs that have not started on the calling thread.
+		/// </summary>
+		/// <param name="idle">Function called repeatedly while waiting on running jobs, used to service queues those jobs may be blocked on</param>
+		void shutdown(const std::function<void()>& idle = nullptr);
+
+	private:
+		struct Worker
+		{
+			std::array<WorkStealingDeque<JobHandle>, PriorityCount> queues;
+			std::thread thread;
+		};
+
+		static constexpr size_t NoWorker = static_cast<size_t>(-1);
+
+		JobSystem() = default;
+
+		void start();
+		void workerLoop(size_t index);
+
+		void submit(JobHandle&& job);
+		void execute(JobHandle& job);
+
+		/// <summary>
+		/// Fetches a job from the given worker's deques or steals one from other workers.
+		/// </summary>
+		/// <param name="index">Index of the calling worker</param>
+		_NODISCARD bool findJob(size_t index, _When_(return == true, _Out_) JobHandle* job);
+
+		/// <summary>
+		/// Executes a single pending job from the calling worker.
+		/// </summary>
+		/// <returns>False if no job was available</returns>
+		bool helpOne();
+
+		std::vector<std::unique_ptr<Worker>> m_workers;
+		std::once_flag m_startFlag;
+
+		std::atomic<bool> m_running = false;
+		std::atomic<size_t> m_nextWorker = 0;
+
+		// Number of queued jobs not yet taken by a worker
+		std::atomic<size_t> m_pending = 0;
+		// Number of jobs currently executing
+		std::atomic<size_t> m_active = 0;
+
+		std::mutex m_sleepMutex;
+		std::condition_variable m_sleepCondition;
+
+		static thread_local size_t s_workerIndex;
+		static JobSystem m_inst;
+	};
+}
+
+#include "JobSystem.hpp"
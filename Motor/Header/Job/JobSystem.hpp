@@ -0,0 +1,37 @@
+#pragma once
+
+#include "JobSystem.h"
+
+#include <chrono>
+
+namespace KaputEngine::Job
+{
+	template <typename TResult>
+	std::future<TResult> JobSystem::async(std::function<TResult()>&& func, const eJobPriority priority)
+	{
+		// std::function requires copyable targets, share the task between copies
+		auto task = std::make_shared<std::packaged_task<TResult()>>(std::move(func));
+		std::future<TResult> future = task->get_future();
+
+		schedule([task]() -> void { (*task)(); }, priority);
+
+		return future;
+	}
+
+	template <typename T>
+	void JobSystem::wait(const std::future<T>& future)
+	{
+		if (!future.valid())
+			return;
+
+		if (!isWorkerThread())
+		{
+			future.wait();
+			return;
+		}
+
+		while (future.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+			if (!helpOne())
+				std::this_thread::yield();
+	}
+}
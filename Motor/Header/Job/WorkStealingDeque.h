@@ -0,0 +1,52 @@
+#pragma once
+
+#include <deque>
+#include <mutex>
+#include <sal.h>
+
+namespace KaputEngine::Job
+{
+	/// <summary>
+	/// Double-ended queue shared between an owning worker and thieves
+	/// </summary>
+	/// <typeparam name="T">Item type</typeparam>
+	/// <remarks>The owner pushes and pops from the back (LIFO, cache-warm) while other threads steal from the front (FIFO, oldest work first).</remarks>
+	template <typename T>
+	class WorkStealingDeque
+	{
+	public:
+		using Type = T;
+
+		WorkStealingDeque() = default;
+		WorkStealingDeque(const WorkStealingDeque&) = delete;
+		WorkStealingDeque(WorkStealingDeque&&) = delete;
+
+		~WorkStealingDeque() = default;
+
+		WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+		WorkStealingDeque& operator=(WorkStealingDeque&&) = delete;
+
+		/// <summary>
+		/// Pushes an item to the back of the deque.
+		/// </summary>
+		void push(T&& item);
+
+		/// <summary>
+		/// Pops the most recently pushed item. Intended for the owning worker.
+		/// </summary>
+		_NODISCARD bool pop(_When_(return == true, _Out_) T* item);
+
+		/// <summary>
+		/// Takes the oldest item. Intended for threads other than the owner.
+		/// </summary>
+		_NODISCARD bool steal(_When_(return == true, _Out_) T* item);
+
+		_NODISCARD bool empty() const;
+
+	private:
+		std::deque<T> m_items;
+		mutable std::mutex m_mutex;
+	};
+}
+
+#include "WorkStealingDeque.hpp"
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "WorkStealingDeque.h"
+
+#define TEMPLATE template <typename T>
+#define DEQUE WorkStealingDeque<T>
+
+namespace KaputEngine::Job
+{
+	TEMPLATE
+	void DEQUE::push(T&& item)
+	{
+		std::lock_guard lock(m_mutex);
+		m_items.push_back(std::move(item));
+	}
+
+	TEMPLATE
+	bool DEQUE::pop(_When_(return == true, _Out_) T* item)
+	{
+		std::lock_guard lock(m_mutex);
+
+		if (m_items.empty())
+			return false;
+
+		*item = std::move(m_items.back());
+		m_items.pop_back();
+
+		return true;
+	}
+
+	TEMPLATE
+	bool DEQUE::steal(_When_(return == true, _Out_) T* item)
+	{
+		std::lock_guard lock(m_mutex);
+
+		if (m_items.empty())
+			return false;
+
+		*item = std::move(m_items.front());
+		m_items.pop_front();
+
+		return true;
+	}
+
+	TEMPLATE
+	bool DEQUE::empty() const
+	{
+		std::lock_guard lock(m_mutex);
+		return m_items.empty();
+	}
+}
+
+#undef TEMPLATE
+#undef DEQUE
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "Memory/SlabArena.h"
+
+namespace KaputEngine::Memory
+{
+	/// <summary>
+	/// Standard allocator drawing from a shared <see cref="SlabArena"/>, or the general heap without one.
+	/// </summary>
+	/// <remarks>Meant for std::allocate_shared, where the control block keeps the arena alive with the object.</remarks>
+	/// <typeparam name="T">Item type</typeparam>
+	template <typename T>
+	class SlabAllocator
+	{
+		template <typename U>
+		friend class SlabAllocator;
+
+	public:
+		using value_type = T;
+
+		SlabAllocator() noexcept = default;
+		explicit SlabAllocator(std::shared_ptr<SlabArena> arena) noexcept;
+
+		/// <summary>
+		/// Uses the arena of the innermost <see cref="SlabArena::Scope"/> on the calling thread.
+		/// </summary>
+		_NODISCARD static SlabAllocator fromCurrent();
+
+		template <typename U>
+		SlabAllocator(const SlabAllocator<U>& other) noexcept;
+
+		_NODISCARD _Ret_notnull_ T* allocate(size_t count);
+		void deallocate(_In_ T* ptr, size_t count) noexcept;
+
+		_NODISCARD _Ret_maybenull_ SlabArena* arena() const noexcept;
+
+		template <typename U>
+		_NODISCARD bool operator==(const SlabAllocator<U>& other) const noexcept;
+
+	private:
+		std::shared_ptr<SlabArena> m_arena;
+	};
+}
+
+#include "SlabAllocator.hpp"
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "Memory/SlabAllocator.h"
+
+#include <new>
+
+#define TEMPLATE template <typename T>
+#define SLABALLOCATOR SlabAllocator<T>
+
+namespace KaputEngine::Memory
+{
+	TEMPLATE
+	SLABALLOCATOR::SlabAllocator(std::shared_ptr<SlabArena> arena) noexcept : m_arena(std::move(arena)) { }
+
+	TEMPLATE
+	SLABALLOCATOR SLABALLOCATOR::fromCurrent()
+	{
+		SlabArena* const arena = SlabArena::current();
+		return arena ? SlabAllocator(arena->shared_from_this()) : SlabAllocator();
+	}
+
+	TEMPLATE
+	template <typename U>
+	SLABALLOCATOR::SlabAllocator(const SlabAllocator<U>& other) noexcept : m_arena(other.m_arena) { }
+
+	TEMPLATE
+	_Ret_notnull_ T* SLABALLOCATOR::allocate(const size_t count)
+	{
+		if (!m_arena)
+			return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t(alignof(T))));
+
+		return static_cast<T*>(m_arena->allocate(count * sizeof(T), alignof(T)));
+	}
+
+	TEMPLATE
+	void SLABALLOCATOR::deallocate(_In_ T* const ptr, const size_t count) noexcept
+	{
+		if (!m_arena)
+			::operator delete(ptr, count * sizeof(T), std::align_val_t(alignof(T)));
+		else
+			m_arena->deallocate(ptr, count * sizeof(T), alignof(T));
+	}
+
+	TEMPLATE
+	_Ret_maybenull_ SlabArena* SLABALLOCATOR::arena() const noexcept
+	{
+		return std::to_address(m_arena);
+	}
+
+	TEMPLATE
+	template <typename U>
+	bool SLABALLOCATOR::operator==(const SlabAllocator<U>& other) const noexcept
+	{
+		return m_arena == other.m_arena;
+	}
+}
+
+#undef TEMPLATE
+#undef SLABALLOCATOR
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <sal.h>
+#include <vector>
+
+namespace KaputEngine::Memory
+{
+	/// <summary>
+	/// Memory usage of a <see cref="SlabArena"/>
+	/// </summary>
+	struct SlabStats
+	{
+		// Bytes reserved in slabs and large blocks
+		size_t reservedBytes = 0;
+
+		// Bytes handed out for live allocations, rounded up to their size class
+		size_t usedBytes = 0;
+
+		size_t liveAllocations = 0;
+		size_t totalAllocations = 0;
+
+		size_t slabCount = 0;
+
+		// Allocations too large for a size class, served by the general heap
+		size_t largeAllocations = 0;
+	};
+
+	/// <summary>
+	/// Size-class allocator carving fixed blocks out of large slabs.
+	/// </summary>
+	/// <remarks>
+	/// Freed blocks are kept in per-class free lists for reuse and slabs are only returned to the heap when the arena is destroyed.
+	/// Arenas are shared by the allocators using them so they outlive every allocation made from them.
+	/// </remarks>
+	class SlabArena : public std::enable_shared_from_this<SlabArena>
+	{
+	public:
+		static constexpr size_t MinBlockSize = 64;
+		static constexpr size_t MaxBlockSize = 2048;
+		static constexpr size_t SlabSize = 64 * 1024;
+
+		/// <summary>
+		/// Makes an arena the default for allocations on the calling thread for the lifetime of the scope.
+		/// </summary>
+		class Scope
+		{
+		public:
+			explicit Scope(_In_opt_ SlabArena* arena) noexcept;
+			Scope(const Scope&) = delete;
+			Scope(Scope&&) = delete;
+
+			~Scope();
+
+			Scope& operator=(const Scope&) = delete;
+			Scope& operator=(Scope&&) = delete;
+
+		private:
+			SlabArena* m_previous;
+		};
+
+		SlabArena() = default;
+		SlabArena(const SlabArena&) = delete;
+		SlabArena(SlabArena&&) = delete;
+
+		~SlabArena();
+
+		SlabArena& operator=(const SlabArena&) = delete;
+		SlabArena& operator=(SlabArena&&) = delete;
+
+		/// <summary>
+		/// Arena of the innermost scope on the calling thread.
+		/// </summary>
+		_NODISCARD _Ret_maybenull_ static SlabArena* current() noexcept;
+
+		_NODISCARD _Ret_notnull_ void* allocate(size_t size, size_t alignment);
+		void deallocate(_In_ void* ptr, size_t size, size_t alignment) noexcept;
+
+		_NODISCARD SlabStats stats() const;
+
+	private:
+		static constexpr size_t ClassCount = std::bit_width(MaxBlockSize / MinBlockSize);
+
+		struct FreeBlock
+		{
+			FreeBlock* next;
+		};
+
+		struct SizeClass
+		{
+			FreeBlock* freeList = nullptr;
+
+			// Unused tail of the last slab of the class
+			std::byte* cursor = nullptr;
+			std::byte* end = nullptr;
+		};
+
+		_NODISCARD static size_t classIndex(size_t size) noexcept;
+		_NODISCARD static bool isLarge(size_t size, size_t alignment) noexcept;
+
+		static thread_local SlabArena* s_current;
+
+		// Allocations can be released from any thread holding the last reference
+		mutable std::mutex m_mutex;
+
+		std::array<SizeClass, ClassCount> m_classes;
+		std::vector<std::byte*> m_slabs;
+
+		SlabStats m_stats;
+	};
+}
@@ -7,6 +7,7 @@
 #include <unordered_map>
 
 constexpr float TARGET_FPS = 60.f;
+constexpr unsigned int MAX_PHYSICS_SUBSTEPS = 5;
 
 namespace KaputEngine
 {
@@ -36,8 +37,25 @@ namespace KaputEngine
 
 		void updateSimulation(double deltaTime);
 
+		/// <summary>
+		/// Advances the simulation by as many fixed steps as fit in the accumulated time, then interpolates the physics-driven objects.
+		/// </summary>
+		/// <remarks>
+		/// Time past <see cref="getMaxSubsteps"/> steps is dropped so a slow frame cannot cause ever more steps on the next ones.
+		/// </remarks>
 		void updatePhysics(double deltaTime) override;
 
+		_NODISCARD double getFixedTimeStep() const noexcept;
+		void setFixedTimeStep(double timeStep);
+
+		_NODISCARD unsigned int getMaxSubsteps() const noexcept;
+		void setMaxSubsteps(unsigned int maxSubsteps);
+
+		/// <summary>
+		/// Fraction of a step elapsed since the last simulated state, used to blend it with the previous one.
+		/// </summary>
+		_NODISCARD double getInterpolationAlpha() const noexcept;
+
 		void addCollisionsTag(const std::string& name);
 
 		void removeTag(const std::string& name);
@@ -58,6 +76,8 @@ namespace KaputEngine
 
 		double m_targetFrameTime = 1 / TARGET_FPS;
 		double m_accumulator = 0;
+		double m_interpolationAlpha = 0;
+		unsigned int m_maxSubsteps = MAX_PHYSICS_SUBSTEPS;
 
 		void checkWorldCollisions();
 
@@ -0,0 +1,169 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <sal.h>
+#include <string>
+#include <vector>
+
+#ifndef KAPUT_PROFILING
+#define KAPUT_PROFILING 1
+#endif
+
+#define PROFILE_CONCAT_IMPL(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_IMPL(a, b)
+
+#if KAPUT_PROFILING
+/// <summary>
+/// Profiles the rest of the enclosing scope. The name must be a string with static storage.
+/// </summary>
+#define PROFILE_ZONE(name) const ::KaputEngine::Profiling::Zone PROFILE_CONCAT(_profileZone, __LINE__)(name)
+#define PROFILE_FUNCTION() PROFILE_ZONE(__FUNCTION__)
+#else
+#define PROFILE_ZONE(name) ((void)0)
+#define PROFILE_FUNCTION() ((void)0)
+#endif
+
+namespace KaputEngine::Profiling
+{
+	struct ZoneEvent
+	{
+		const char* name;
+
+		// Nanoseconds since the profiler started
+		int64_t start;
+		int64_t duration;
+
+		// Number of enclosing zones on the thread
+		uint32_t depth;
+	};
+
+	/// <summary>
+	/// Scope timer recording an event on destruction while the profiler is enabled
+	/// </summary>
+	class Zone
+	{
+	public:
+		explicit Zone(_In_z_ const char* name) noexcept;
+		Zone(const Zone&) = delete;
+		Zone(Zone&&) = delete;
+
+		~Zone();
+
+		Zone& operator=(const Zone&) = delete;
+		Zone& operator=(Zone&&) = delete;
+
+	private:
+		const char* m_name;
+
+		// Negative if the profiler was disabled when the zone started
+		int64_t m_start;
+	};
+
+	/// <summary>
+	/// Collects zones from every thread in thread-local buffers and exports them as Chrome trace events
+	/// </summary>
+	/// <remarks>Open exported files in Perfetto or chrome://tracing.</remarks>
+	class Profiler
+	{
+		friend Zone;
+
+	public:
+		// Events past this count are dropped until the buffers are cleared
+		static constexpr size_t MaxEventsPerThread = 1 << 20;
+
+		Profiler(const Profiler&) = delete;
+		Profiler(Profiler&&) = delete;
+
+		Profiler& operator=(const Profiler&) = delete;
+		Profiler& operator=(Profiler&&) = delete;
+
+		_NODISCARD static Profiler& instance() noexcept;
+
+		_NODISCARD bool enabled() const noexcept;
+		void setEnabled(bool enabled) noexcept;
+
+		/// <summary>
+		/// Names the calling thread in exported traces.
+		/// </summary>
+		void setThreadName(std::string name);
+
+		/// <summary>
+		/// Captures the next frames and saves them once done.
+		/// </summary>
+		/// <param name="frameCount">Number of frames, delimited by calls to <see cref="newFrame"/></param>
+		/// <param name="path">Destination of the trace file</param>
+		/// <remarks>Clears previously recorded events when the capture starts.</remarks>
+		void captureFrames(size_t frameCount, std::filesystem::path path);
+
+		_NODISCARD bool capturing() const noexcept;
+
+		/// <summary>
+		/// Marks the start of a frame, starting or ending pending captures. Called by the application loop.
+		/// </summary>
+		void newFrame();
+
+		/// <summary>
+		/// Writes all recorded events as Chrome trace event JSON.
+		/// </summary>
+		_Success_(return) bool save(const std::filesystem::path& path) const;
+
+		/// <summary>
+		/// Removes all recorded events.
+		/// </summary>
+		void clear();
+
+		_NODISCARD size_t eventCount() const;
+
+	private:
+		struct ThreadBuffer
+		{
+			uint32_t id;
+			std::string name;
+
+			// Current zone depth, only accessed by the owning thread
+			uint32_t depth = 0;
+
+			// Guards events against export from another thread
+			mutable std::mutex mutex;
+			std::vector<ZoneEvent> events;
+		};
+
+		struct CaptureRequest
+		{
+			size_t frameCount;
+			std::filesystem::path path;
+		};
+
+		Profiler() = default;
+
+		static Profiler m_inst;
+		static thread_local ThreadBuffer* s_threadBuffer;
+
+		std::atomic<bool> m_enabled = false;
+
+		mutable std::mutex m_buffersMutex;
+		std::vector<std::unique_ptr<ThreadBuffer>> m_buffers;
+
+		std::mutex m_captureMutex;
+		std::optional<CaptureRequest> m_captureRequest;
+
+		// Frames left in the running capture, only accessed by the frame thread
+		size_t m_captureRemaining = 0;
+		std::filesystem::path m_capturePath;
+		bool m_enabledBeforeCapture = false;
+
+		_NODISCARD static int64_t now() noexcept;
+
+		_NODISCARD ThreadBuffer& threadBuffer();
+
+		_NODISCARD int64_t beginZone();
+		void endZone(_In_z_ const char* name, int64_t start);
+	};
+}
+
+#include "Profiler.hpp"
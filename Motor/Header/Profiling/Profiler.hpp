@@ -0,0 +1,22 @@
+#pragma once
+
+#include "Profiler.h"
+
+namespace KaputEngine::Profiling
+{
+	// Inline so a disabled profiler only costs a relaxed load per zone
+
+	inline Zone::Zone(_In_z_ const char* const name) noexcept
+		: m_name(name), m_start(Profiler::m_inst.enabled() ? Profiler::m_inst.beginZone() : -1) { }
+
+	inline Zone::~Zone()
+	{
+		if (m_start >= 0)
+			Profiler::m_inst.endZone(m_name, m_start);
+	}
+
+	inline bool Profiler::enabled() const noexcept
+	{
+		return m_enabled.load(std::memory_order_relaxed);
+	}
+}
@@ -1,9 +1,11 @@
 #pragma once
 
-#include "Queue/Concurrent.h"
+#include "Queue/Ring.h"
+#include "Utils/InlineFunction.h"
 
-#include <functional>
+#include <atomic>
 #include <future>
+#include <optional>
 #include <thread>
 #include <type_traits>
 
@@ -13,14 +15,15 @@ namespace KaputEngine::Queue
 	/// Thread-safe queue of functions to be executed by an owning thread
 	/// </summary>
 	/// <typeparam name="Func">Contained function signature</typeparam>
-	template <typename Func>
+	/// <typeparam name="Capacity">Maximum number of pending functions. Producers wait for the owner when the queue is full.</typeparam>
+	template <typename Func, size_t Capacity = 4096>
 		requires std::is_function_v<Func>
 	class ActionQueue
 	{
 	public:
 		using Function = Func;
-		using Lambda = std::function<Func>;
-		using Return = typename Lambda::result_type;
+		using Lambda = InlineFunction<Func>;
+		using Return = typename Lambda::Return;
 
 		/// <summary>
 		/// Container type for queue items
@@ -31,13 +34,14 @@ namespace KaputEngine::Queue
 
 		public:
 			Item(Lambda&& func);
+			Item(Lambda&& func, std::promise<Return>&& promise);
 
 		private:
 			// Function to be executed
 			Lambda m_func;
 
-			// Promise wrapping the async execution
-			std::promise<Return> m_promise;
+			// Promise wrapping the async execution, only set if the caller waits on the result
+			std::optional<std::promise<Return>> m_promise;
 
 			/// <summary>
 			/// Invokes the function and sets the promise.
@@ -61,6 +65,12 @@ namespace KaputEngine::Queue
 		/// </summary>
 		_NODISCARD std::thread::id owner() const noexcept;
 
+		/// <summary>
+		/// Transfers ownership of the queue to another thread.
+		/// </summary>
+		/// <remarks>Must not be called while the queue is being popped. Functions pushed before the transfer are executed by the new owner.</remarks>
+		void setOwner(std::thread::id owner) noexcept;
+
 		_NODISCARD bool validateThread() const noexcept;
 
 		/// <summary>
@@ -68,8 +78,20 @@ namespace KaputEngine::Queue
 		/// </summary>
 		/// <param name="allowRunImmediate">If the calling thread is the owning thread, the function can be executed immediately using the given arguments, bypassing the queue</param>
 		/// <param name="args">Function arguments for immediate execution</param>
-		template <typename... Args>
-		std::future<Return> push(Lambda&& func, const bool allowRunImmediate = true, Args&&... args);
+		/// <returns>Future set once the function has been executed</returns>
+		template <typename F, typename... Args>
+			requires std::constructible_from<InlineFunction<Func>, F>
+		std::future<Return> push(F&& func, const bool allowRunImmediate = true, Args&&... args);
+
+		/// <summary>
+		/// Pushes a function to the queue without tracking its completion.
+		/// </summary>
+		/// <param name="allowRunImmediate">If the calling thread is the owning thread, the function can be executed immediately using the given arguments, bypassing the queue</param>
+		/// <param name="args">Function arguments for immediate execution</param>
+		/// <remarks>No promise is created, prefer over <see cref="push"/> when the result is not waited on. Exceptions thrown by the function are logged.</remarks>
+		template <typename F, typename... Args>
+			requires std::constructible_from<InlineFunction<Func>, F>
+		void post(F&& func, const bool allowRunImmediate = true, Args&&... args);
 
 		/// <summary>
 		/// Executed and pops a function from the queue.
@@ -88,8 +110,13 @@ namespace KaputEngine::Queue
 		void popAll(Args&&... args);
 
 	protected:
-		ConcurrentQueue<Item> m_queue;
-		std::thread::id m_owner;
+		/// <summary>
+		/// Adds an item to the queue, waiting for free space if full.
+		/// </summary>
+		void enqueue(Item&& item);
+
+		RingQueue<Item, Capacity> m_queue;
+		std::atomic<std::thread::id> m_owner;
 	};
 }
 
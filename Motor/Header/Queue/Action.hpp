@@ -2,14 +2,20 @@
 
 #include "Action.h"
 
+#include "Profiling/Profiler.h"
+#include "Queue/Ring.hpp"
+#include "Utils/Bind.h"
+#include "Utils/Function.h"
+#include "Utils/InlineFunction.hpp"
 #include "Utils/Policy.h"
+#include "Utils/rawalloc.hpp"
 
 #include <exception>
 #include <iostream>
 #include <stdexcept>
 
-#define ACTIONQUEUE ActionQueue<Func>
-#define ACTIONQUEUE_TEMPLATE template <typename Func> requires std::is_function_v<Func>
+#define ACTIONQUEUE ActionQueue<Func, Capacity>
+#define ACTIONQUEUE_TEMPLATE template <typename Func, size_t Capacity> requires std::is_function_v<Func>
 
 namespace KaputEngine::Queue
 {
@@ -18,6 +24,10 @@ namespace KaputEngine::Queue
 	ACTIONQUEUE::Item::Item(Lambda&& func)
 		: m_func(std::move(func)) { }
 
+	ACTIONQUEUE_TEMPLATE
+	ACTIONQUEUE::Item::Item(Lambda&& func, std::promise<Return>&& promise)
+		: m_func(std::move(func)), m_promise(std::move(promise)) { }
+
 	ACTIONQUEUE_TEMPLATE
 	template <typename... Args>
 	void ACTIONQUEUE::Item::invoke(Args&&... args)
@@ -29,14 +39,20 @@ namespace KaputEngine::Queue
 				// Placing the invoke call as a set_value parameter is illegal for void
 				m_func(std::forward<Args>(args)...);
 
-				m_promise.set_value();
+				if (m_promise)
+					m_promise->set_value();
 			}
+			else if (m_promise)
+				m_promise->set_value(m_func(std::forward<Args>(args)...));
 			else
-				m_promise.set_value(m_func(std::forward<Args>(args)...));
+				m_func(std::forward<Args>(args)...);
 		} catch (...)
 		{
 			// On exception, forward the exception in the promise
-			m_promise.set_exception(std::current_exception());
+			if (m_promise)
+				m_promise->set_exception(std::current_exception());
+			else
+				std::cerr << __FUNCTION__": Unhandled exception in queued action.\n";
 		}
 	}
 #pragma endregion
@@ -49,18 +65,31 @@ namespace KaputEngine::Queue
 	ACTIONQUEUE_TEMPLATE
 	std::thread::id ACTIONQUEUE::owner() const noexcept
 	{
-		return m_owner;
+		return m_owner.load(std::memory_order_acquire);
 	}
 
 	ACTIONQUEUE_TEMPLATE
-	template <typename... Args>
-	std::future<typename ACTIONQUEUE::Return> ACTIONQUEUE::push(Lambda&& func, const bool allowRunImmediate, Args&&... args)
+	void ACTIONQUEUE::setOwner(const std::thread::id owner) noexcept
+	{
+		m_owner.store(owner, std::memory_order_release);
+	}
+
+	ACTIONQUEUE_TEMPLATE
+	template <typename F, typename... Args>
+		requires std::constructible_from<InlineFunction<Func>, F>
+	std::future<typename ACTIONQUEUE::Return> ACTIONQUEUE::push(F&& func, const bool allowRunImmediate, Args&&... args)
 	{
 		// TODO Find a way to bind the arguments to the function signature instead of relying on loose variadic arguments
 
-		if (!allowRunImmediate || std::this_thread::get_id() != m_owner)
+		if (!allowRunImmediate || std::this_thread::get_id() != owner())
+		{
 			// Not the owning thread - Queue the function
-			return m_queue.emplace(std::move(func)).m_promise.get_future();
+			std::promise<Return> promise;
+			std::future<Return> future = promise.get_future();
+
+			enqueue(Item(Lambda(FORWARD(func)), std::move(promise)));
+			return future;
+		}
 
 		if constexpr (std::is_void_v<Return>)
 		{
@@ -71,21 +100,36 @@ namespace KaputEngine::Queue
 			return emptyFuture<Return>(func(std::forward<Args>(args)...));
 	}
 
+	ACTIONQUEUE_TEMPLATE
+	template <typename F, typename... Args>
+		requires std::constructible_from<InlineFunction<Func>, F>
+	void ACTIONQUEUE::post(F&& func, const bool allowRunImmediate, Args&&... args)
+	{
+		if (!allowRunImmediate || std::this_thread::get_id() != owner())
+			// Not the owning thread - Queue the function
+			enqueue(Item(Lambda(FORWARD(func))));
+		else
+			func(std::forward<Args>(args)...);
+	}
+
 	ACTIONQUEUE_TEMPLATE
 	template <typename... Args>
 	bool ACTIONQUEUE::pop(Args&&... args)
 	{
 		// Validate calling thread
-		if (std::this_thread::get_id() != m_owner)
+		if (std::this_thread::get_id() != owner())
 			throw std::logic_error("Only the owning thread can pop actions from the queue.");
 
 		// Allocate a raw container on the stack as there is no empty ctor for Item
-		rawalloc<Item> actionAlloc;
+		rawalloc<Item, false> actionAlloc;
 
 		if (!m_queue.pop(actionAlloc.ptr()))
 			return false;
 
+		// Invoke does not throw, the item is always destroyed
 		actionAlloc->invoke(std::forward<Args>(args)...);
+		actionAlloc->~Item();
+
 		return true;
 	}
 
@@ -93,13 +137,19 @@ namespace KaputEngine::Queue
 	template <typename... Args>
 	void ACTIONQUEUE::popAll(Args&&... args)
 	{
+		// Keep idle polling out of profiles
+		if (!m_queue.size())
+			return;
+
+		PROFILE_FUNCTION();
+
 		while (pop(std::forward<Args>(args)...)) {}
 	}
 
 	ACTIONQUEUE_TEMPLATE
 	bool ACTIONQUEUE::validateThread() const noexcept
 	{
-		if (std::this_thread::get_id() != m_owner)
+		if (std::this_thread::get_id() != owner())
 		{
 			std::cerr << __FUNCTION__"Thread " << std::this_thread::get_id() << " is not the owner of the queue.\n";
 			return false;
@@ -107,6 +157,23 @@ namespace KaputEngine::Queue
 
 		return true;
 	}
+
+	ACTIONQUEUE_TEMPLATE
+	void ACTIONQUEUE::enqueue(Item&& item)
+	{
+		while (!m_queue.tryEmplace(std::move(item)))
+		{
+			// The owner cannot wait on itself, drain to make room
+			if constexpr (function_traits<Func>::argument_count == 0)
+				if (std::this_thread::get_id() == owner())
+				{
+					pop();
+					continue;
+				}
+
+			std::this_thread::yield();
+		}
+	}
 #pragma endregion
 }
 
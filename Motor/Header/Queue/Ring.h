@@ -0,0 +1,70 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <sal.h>
+
+namespace KaputEngine::Queue
+{
+	/// <summary>
+	/// Bounded lock-free queue for multiple producers and a single consumer
+	/// </summary>
+	/// <typeparam name="Capacity">Maximum number of items. Must be a power of two.</typeparam>
+	/// <remarks>Items are constructed in place in a fixed ring of slots, so pushing and popping never allocates.</remarks>
+	template <typename T, size_t Capacity>
+		requires (Capacity >= 2 && (Capacity & (Capacity - 1)) == 0)
+	class RingQueue
+	{
+	public:
+		using Type = T;
+
+		RingQueue() noexcept;
+		RingQueue(const RingQueue&) = delete;
+		RingQueue(RingQueue&&) = delete;
+
+		~RingQueue();
+
+		RingQueue& operator=(const RingQueue&) = delete;
+		RingQueue& operator=(RingQueue&&) = delete;
+
+		/// <summary>
+		/// Constructs an item at the end of the queue. Safe to call from any thread.
+		/// </summary>
+		/// <returns>False if the queue is full</returns>
+		template <typename... Args>
+		_NODISCARD bool tryEmplace(Args&&... args);
+
+		/// <summary>
+		/// Moves the first item out of the queue. Only one thread may pop at a time.
+		/// </summary>
+		/// <param name="item">Uninitialized storage to move-construct the item into</param>
+		/// <returns>False if the queue is empty</returns>
+		_NODISCARD bool pop(_When_(return == true, _Out_) T* item);
+
+		/// <summary>
+		/// Returns the number of items in the queue.
+		/// </summary>
+		/// <remarks>Only a snapshot when producers are active.</remarks>
+		_NODISCARD size_t size() const noexcept;
+
+		_NODISCARD static constexpr size_t capacity() noexcept;
+
+	private:
+		static constexpr size_t Mask = Capacity - 1;
+
+		struct Slot
+		{
+			// Equal to the write position when free and to the write position + 1 once written
+			std::atomic<size_t> sequence;
+			alignas(T) std::byte storage[sizeof(T)];
+		};
+
+		// Producers and consumer on separate cache lines
+		alignas(64) std::atomic<size_t> m_head = 0;
+		alignas(64) std::atomic<size_t> m_tail = 0;
+
+		alignas(64) Slot m_slots[Capacity];
+	};
+}
+
+#include "Ring.hpp"
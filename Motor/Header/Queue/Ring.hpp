@@ -0,0 +1,101 @@
+#pragma once
+
+#include "Ring.h"
+
+#include <new>
+#include <utility>
+
+#define TEMPLATE template <typename T, size_t Capacity> requires (Capacity >= 2 && (Capacity & (Capacity - 1)) == 0)
+#define RINGQUEUE RingQueue<T, Capacity>
+
+namespace KaputEngine::Queue
+{
+	TEMPLATE
+	RINGQUEUE::RingQueue() noexcept
+	{
+		for (size_t i = 0; i < Capacity; ++i)
+			m_slots[i].sequence.store(i, std::memory_order_relaxed);
+	}
+
+	TEMPLATE
+	RINGQUEUE::~RingQueue()
+	{
+		// Destroy items that were never popped
+		size_t tail = m_tail.load(std::memory_order_relaxed);
+		const size_t head = m_head.load(std::memory_order_relaxed);
+
+		for (; tail != head; ++tail)
+			std::launder(reinterpret_cast<T*>(m_slots[tail & Mask].storage))->~T();
+	}
+
+	TEMPLATE
+	template <typename... Args>
+	bool RINGQUEUE::tryEmplace(Args&&... args)
+	{
+		size_t pos = m_head.load(std::memory_order_relaxed);
+		Slot* slot;
+
+		while (true)
+		{
+			slot = &m_slots[pos & Mask];
+
+			const size_t sequence = slot->sequence.load(std::memory_order_acquire);
+			const auto diff = static_cast<std::ptrdiff_t>(sequence - pos);
+
+			if (!diff)
+			{
+				// Slot is free for this lap, claim it
+				if (m_head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+					break;
+			}
+			else if (diff < 0)
+				// The consumer has not freed the slot from the previous lap
+				return false;
+			else
+				// Another producer claimed the slot
+				pos = m_head.load(std::memory_order_relaxed);
+		}
+
+		new (slot->storage) T(std::forward<Args>(args)...);
+
+		// Publish to the consumer
+		slot->sequence.store(pos + 1, std::memory_order_release);
+		return true;
+	}
+
+	TEMPLATE
+	bool RINGQUEUE::pop(_When_(return == true, _Out_) T* item)
+	{
+		const size_t pos = m_tail.load(std::memory_order_relaxed);
+		Slot& slot = m_slots[pos & Mask];
+
+		if (slot.sequence.load(std::memory_order_acquire) != pos + 1)
+			return false;
+
+		T* const stored = std::launder(reinterpret_cast<T*>(slot.storage));
+
+		new (item) T(std::move(*stored));
+		stored->~T();
+
+		// Advance before freeing the slot so a reentrant pop from the item does not see it again
+		m_tail.store(pos + 1, std::memory_order_relaxed);
+		slot.sequence.store(pos + Capacity, std::memory_order_release);
+
+		return true;
+	}
+
+	TEMPLATE
+	size_t RINGQUEUE::size() const noexcept
+	{
+		return m_head.load(std::memory_order_relaxed) - m_tail.load(std::memory_order_relaxed);
+	}
+
+	TEMPLATE
+	constexpr size_t RINGQUEUE::capacity() noexcept
+	{
+		return Capacity;
+	}
+}
+
+#undef TEMPLATE
+#undef RINGQUEUE
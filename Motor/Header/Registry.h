@@ -30,6 +30,10 @@ namespace KaputEngine
 
         static void registerAngle();
 
+		static void registerHandles();
+
+		static void registerSpatial();
+
 		static void registerGlobals();
     };
 }
@@ -17,14 +17,34 @@ namespace KaputEngine::Rendering::Buffer
 
 		ElementBuffer& operator=(ElementBuffer&&) = default;
 
+		/// <summary>
+		/// Uploads the indices, as 16 bit indices if they all fit.
+		/// </summary>
 		void create(const std::span<const unsigned int>& indices);
 
+		/// <summary>
+		/// Overwrites a range of indices with zeros, leaving degenerate triangles the GPU discards before rasterizing.
+		/// </summary>
+		/// <param name="first">Index the range starts at, counted in indices</param>
+		void clearRange(size_t first, size_t count) const;
+
 		void bind() const override;
 		void unbind() const override;
 
 		_NODISCARD const int& count() const noexcept;
 
+		/// <summary>
+		/// GL type of the uploaded indices, GL_UNSIGNED_SHORT or GL_UNSIGNED_INT.
+		/// </summary>
+		_NODISCARD unsigned int indexType() const noexcept;
+
+		/// <summary>
+		/// Whether the indices all fit in 16 bits, addressing at most 65536 vertices.
+		/// </summary>
+		_NODISCARD static bool fitsShortIndices(std::span<const unsigned int> indices) noexcept;
+
 	private:
 		int m_count = 0;
+		unsigned int m_indexType = 0;
 	};
 }
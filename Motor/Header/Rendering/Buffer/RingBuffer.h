@@ -0,0 +1,122 @@
+#pragma once
+
+#include "Buffer.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <sal.h>
+#include <vector>
+
+namespace KaputEngine::Rendering::Buffer
+{
+	enum class eRingTarget : uint8_t
+	{
+		STORAGE,
+		UNIFORM
+	};
+
+	/// <summary>
+	/// Buffer of dynamic data split in <see cref="FrameCount"/> frame regions written in turn, persistently mapped.
+	/// </summary>
+	/// <remarks>
+	/// Uploads run on the context thread as a command list is submitted. The first upload of a frame fences the region in use, moves to the next one
+	/// and waits for its fence, so a region is never written while the GPU may still read it. Later uploads of the frame take the next slots of the region.
+	/// Only the bytes that changed since a slot was last written in that region are copied.
+	/// Without buffer storage support, regions are written with glBufferSubData instead of through the mapping.
+	/// </remarks>
+	class RingBuffer : public Buffer
+	{
+	public:
+		static constexpr uint32_t FrameCount = 3;
+
+		RingBuffer() = default;
+		RingBuffer(const RingBuffer&) = delete;
+		RingBuffer(RingBuffer&&) = delete;
+
+		~RingBuffer() final;
+
+		RingBuffer& operator=(const RingBuffer&) = delete;
+		RingBuffer& operator=(RingBuffer&&) = delete;
+
+		/// <param name="size">Size of the content, allocated once per slot</param>
+		/// <param name="index">Binding point of the block reading the buffer</param>
+		/// <param name="slotCount">Uploads per frame before the ring moves to the next region early, waiting on the GPU sooner. The editor records its scene and game views in the same frame.</param>
+		void create(eRingTarget target, size_t size, unsigned int index, uint32_t slotCount = 2);
+		void destroy() final;
+
+		/// <summary>
+		/// Ends the frame submitted on the context thread. The next upload of each ring moves to its next region.
+		/// </summary>
+		/// <remarks>Must be called from the thread owning the rendering context, before swapping buffers.</remarks>
+		static void endFrame() noexcept;
+
+		_NODISCARD eRingTarget target() const noexcept;
+		_NODISCARD size_t size() const noexcept;
+		_NODISCARD unsigned int index() const noexcept;
+
+		/// <summary>
+		/// Writes the content to the next slot and binds it.
+		/// </summary>
+		/// <remarks>Must be called from the thread owning the rendering context.</remarks>
+		void upload(_In_reads_bytes_(size) const void* data, size_t size);
+
+		/// <summary>
+		/// Binds the slot of the last upload to the binding point.
+		/// </summary>
+		/// <remarks>Must be called from the thread owning the rendering context.</remarks>
+		void bindRegion() const;
+
+		void bind() const final;
+		void unbind() const final;
+
+	private:
+		/// <summary>
+		/// Byte range of a slot, empty when begin reaches end
+		/// </summary>
+		struct Range
+		{
+			size_t begin = 0;
+			size_t end = 0;
+		};
+
+		static uint64_t s_frame;
+
+		eRingTarget m_target = eRingTarget::STORAGE;
+
+		size_t m_size = 0;
+		// Distance between slots, rounded to the offset alignment of the target
+		size_t m_stride = 0;
+
+		uint32_t m_slotCount = 1;
+
+		unsigned int m_index = -1;
+
+		// Null without buffer storage support
+		_Maybenull_ std::byte* m_mapped = nullptr;
+
+		uint32_t m_region = 0;
+		uint32_t m_slot = 0;
+
+		// Frame of the last upload, regions only change between frames
+		uint64_t m_frame = 0;
+
+		// Last content uploaded to each slot, in any region
+		std::vector<std::byte> m_shadow;
+
+		// Bytes of each slot of each region that differ from the shadow, indexed by region then slot
+		std::vector<Range> m_dirty;
+
+		// GLsync guarding each region, null once the GPU is done with it
+		void* m_fences[FrameCount] { };
+
+		_NODISCARD size_t offset() const noexcept;
+
+		/// <summary>
+		/// Moves to the next slot, or to the first slot of the next region for a new frame or a full region.
+		/// </summary>
+		void advance();
+
+		void waitFence(uint32_t region);
+		void deleteFences();
+	};
+}
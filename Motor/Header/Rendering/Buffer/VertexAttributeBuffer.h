@@ -23,7 +23,14 @@ namespace KaputEngine::Rendering::Buffer
         void bind() const final;
         void unbind() const final;
 
+        /// <summary>
+        /// Describes a vertex field read by the attribute at an index.
+        /// </summary>
+        /// <remarks>
+        /// Fields can be scalars, math arrays or fixed arrays. Integer fields are read as integers unless normalized.
+        /// </remarks>
+        /// <param name="bufferOffset">Start of the vertices of this layout in the vertex buffer</param>
         template <typename T, typename TVertex>
-        void defineAttribute(const unsigned int index, T TVertex::* attribute, bool normalized = false);
+        void defineAttribute(const unsigned int index, T TVertex::* attribute, bool normalized = false, size_t bufferOffset = 0);
     };
 }
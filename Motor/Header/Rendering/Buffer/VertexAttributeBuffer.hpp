@@ -5,13 +5,42 @@
 #include "Queue/Context.h"
 #include "Rendering/GlTypes.h"
 
-#include <crtdbg.h>
 #include <glad/glad.h>
 
+#include <type_traits>
+
 namespace KaputEngine::Rendering::Buffer
 {
+    namespace Detail
+    {
+        /// <summary>
+        /// Component type and count of a vertex field.
+        /// </summary>
+        template <typename T>
+        struct AttributeElement
+        {
+            using Type = T;
+            static constexpr uint8_t Size = 1;
+        };
+
+        template <typename T, size_t N>
+        struct AttributeElement<T[N]>
+        {
+            using Type = T;
+            static constexpr uint8_t Size = N;
+        };
+
+        template <typename T> requires (std::is_class_v<T> && LibMath::IsMathArray<T>)
+        struct AttributeElement<T>
+        {
+            using Type = typename T::DataType;
+            static constexpr uint8_t Size = T::Size;
+        };
+    }
+
     template <typename T, typename TVertex>
-    void VertexAttributeBuffer::defineAttribute(const unsigned int index, T TVertex::* const attribute, const bool normalized)
+    void VertexAttributeBuffer::defineAttribute(
+        const unsigned int index, T TVertex::* const attribute, const bool normalized, const size_t bufferOffset)
     {
         enum class eAttribType
         {
@@ -20,39 +49,31 @@ namespace KaputEngine::Rendering::Buffer
             OTHER
         };
 
+        using Element = typename Detail::AttributeElement<T>::Type;
+
+        constexpr uint8_t size = Detail::AttributeElement<T>::Size;
+        constexpr GLenum type = Rendering::glType<Element>();
+
+        static_assert(size >= 1 && size <= 4, "Vertex attributes have one to four components.");
+        static_assert(type != GL_INVALID_ENUM, "Vertex attribute type has no GL type.");
+
         bind();
 
-        uint8_t size = 1;
-        GLenum type = Rendering::glType<T>();
         eAttribType attribType = eAttribType::OTHER;
 
-        if constexpr (std::is_class_v<T> && LibMath::IsMathArray<T>)
-        {
-            size = T::Size;
-            type = Rendering::glType<typename T::DataType>();
-
-            if constexpr (std::integral<typename T::DataType>)
-                attribType = eAttribType::INTEGER;
-            else if constexpr (std::same_as<typename T::DataType, double>)
-                attribType = eAttribType::DOUBLE;
-        }
-        else
-        {
-            if constexpr (std::integral<T>)
-                attribType = eAttribType::INTEGER;
-            else if constexpr (std::same_as<T, double>)
-                attribType = eAttribType::DOUBLE;
-        }
-
-        _ASSERT(type != GL_INVALID_ENUM);
+        // Normalized integers are read as floats
+        if constexpr (std::integral<Element>)
+            attribType = normalized ? eAttribType::OTHER : eAttribType::INTEGER;
+        else if constexpr (std::same_as<Element, double>)
+            attribType = eAttribType::DOUBLE;
 
         // Find the offset of the field in the vertex
         // Assuming a vertex object at address null (0), the address of the field is the offset
         // Reinterpreting the field to char to bypass custom operator& that may assume a valid object
         // Based on <cstddef> offsetof - Macro substitution fails with field references
-        const void* startPtr = &reinterpret_cast<const char&>(static_cast<TVertex*>(nullptr)->*attribute);
+        const void* startPtr = &reinterpret_cast<const char&>(static_cast<TVertex*>(nullptr)->*attribute) + bufferOffset;
 
-        KaputEngine::Queue::ContextQueue::instance().push([attribType, index, size, type, startPtr, normalized]
+        KaputEngine::Queue::ContextQueue::instance().post([attribType, index, startPtr, normalized]
         {
             switch (attribType)
             {
@@ -67,8 +88,6 @@ namespace KaputEngine::Rendering::Buffer
                 break;
             }
 
-            glVertexAttribPointer(index, size, type, normalized, sizeof(TVertex), startPtr);
-
             glEnableVertexAttribArray(index);
         });
     }
@@ -0,0 +1,342 @@
+#pragma once
+
+#include "Rendering/ShaderProgram.h"
+
+#include <LibMath/MathArray/MathArray.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <sal.h>
+#include <type_traits>
+#include <vector>
+
+namespace KaputEngine
+{
+	class Camera;
+}
+
+namespace KaputEngine::Rendering
+{
+	class Color;
+	class Material;
+	struct MaterialLayer;
+
+	namespace Buffer
+	{
+		class ElementBuffer;
+		class RingBuffer;
+		class SharedBuffer;
+		class TextureBuffer;
+		class VertexAttributeBuffer;
+		class VertexBuffer;
+	}
+}
+
+namespace KaputEngine::Rendering::Command
+{
+	enum class eCommandType : uint8_t
+	{
+		CLEAR,
+		USE_PROGRAM,
+		BIND_STORAGE_BUFFER,
+		UNBIND_STORAGE_BUFFER,
+		UPDATE_STORAGE_BUFFER,
+		UPLOAD_RING_BUFFER,
+		BIND_RING_BUFFER,
+		SET_UNIFORM,
+		BIND_TEXTURE,
+		DRAW_ELEMENTS,
+		BIND_VERTEX_ARRAY,
+		DRAW_BOUND_ELEMENTS,
+		DRAW_BOUND_ELEMENTS_INSTANCED,
+		CALLBACK
+	};
+
+	enum class eUniformScalar : uint8_t
+	{
+		INT,
+		UNSIGNED_INT,
+		FLOAT,
+		DOUBLE
+	};
+
+	struct ClearCommand
+	{
+		float color[4];
+	};
+
+	struct ProgramCommand
+	{
+		unsigned int id;
+	};
+
+	/// <summary>
+	/// Binding of a storage buffer to an indexed binding point
+	/// </summary>
+	struct BufferBindingCommand
+	{
+		unsigned int id;
+		unsigned int index;
+	};
+
+	/// <summary>
+	/// Buffer upload with the bytes stored in the list's data block
+	/// </summary>
+	struct BufferDataCommand
+	{
+		unsigned int id;
+		uint32_t offset;
+		uint32_t size;
+		uint32_t dataOffset;
+	};
+
+	/// <summary>
+	/// Ring buffer upload with the bytes stored in the list's data block, or binding of its current region
+	/// </summary>
+	struct RingBufferCommand
+	{
+		Buffer::RingBuffer* buffer;
+		uint32_t size;
+		uint32_t dataOffset;
+	};
+
+	/// <summary>
+	/// Uniform referenced by location or by name, with an offset from the named location
+	/// </summary>
+	/// <remarks>
+	/// Names are resolved against the reflection of the program of the last <see cref="CommandList::useProgram"/> when recorded,
+	/// so recording needs no context and the list keeps no name. Prefer <see cref="UniformHandle"/> in draw loops.
+	/// </remarks>
+	struct UniformTarget
+	{
+		// Null if referenced by location
+		_Maybenull_ const char* name = nullptr;
+		// Location, or offset from the named location
+		int location = 0;
+
+		UniformTarget(int location) noexcept;
+		UniformTarget(_In_z_ const char* name) noexcept;
+		UniformTarget(const UniformReference& uniform) noexcept;
+
+		_NODISCARD UniformTarget operator+(int offset) const noexcept;
+	};
+
+	/// <summary>
+	/// Uniform assignment with values stored in the list's data block
+	/// </summary>
+	struct UniformCommand
+	{
+		int location;
+
+		uint32_t dataOffset;
+		uint16_t count;
+
+		eUniformScalar scalar;
+		// MathArray dimensions, 1x1 for scalars
+		uint8_t width, height;
+	};
+
+	struct TextureCommand
+	{
+		unsigned int id;
+		unsigned int unitIndex;
+	};
+
+	/// <summary>
+	/// Draw binding its buffers, or binding of the buffers alone for the following bound draws
+	/// </summary>
+	struct DrawCommand
+	{
+		unsigned int vertexArray;
+		unsigned int vertexBuffer;
+		unsigned int elementBuffer;
+		int count;
+		unsigned int indexType;
+	};
+
+	/// <summary>
+	/// Draw using the buffers of the last vertex array binding
+	/// </summary>
+	struct BoundDrawCommand
+	{
+		int count;
+		unsigned int indexType;
+		// Number of instances of instanced draws
+		int instanceCount;
+	};
+
+	/// <summary>
+	/// Escape hatch for work not expressible as a command, executed on the context thread during submit
+	/// </summary>
+	/// <remarks>The object is read when the list is submitted rather than copied, see <see cref="CommandList::hasCallbacks"/>.</remarks>
+	struct CallbackCommand
+	{
+		void (*func)(void* object, const void* argument);
+		void* object;
+		const void* argument;
+	};
+
+	struct RenderCommand
+	{
+		eCommandType type;
+
+		union
+		{
+			ClearCommand clear;
+			ProgramCommand program;
+			BufferBindingCommand bufferBinding;
+			BufferDataCommand bufferData;
+			RingBufferCommand ringBuffer;
+			UniformCommand uniform;
+			TextureCommand texture;
+			DrawCommand draw;
+			BoundDrawCommand boundDraw;
+			CallbackCommand callback;
+		};
+	};
+
+	static_assert(std::is_trivially_copyable_v<RenderCommand>);
+
+	/// <summary>
+	/// List of render commands recorded on any thread and submitted to the context in one pass
+	/// </summary>
+	/// <remarks>
+	/// Recording does not touch the rendering context. Values are copied and objects are referenced by GL id,
+	/// which must remain alive until the list is submitted. Ring buffers and callback objects are referenced directly.
+	/// </remarks>
+	class CommandList
+	{
+	public:
+		CommandList() = default;
+		CommandList(const CommandList&) = delete;
+		CommandList(CommandList&&) noexcept = default;
+
+		~CommandList() = default;
+
+		CommandList& operator=(const CommandList&) = delete;
+		CommandList& operator=(CommandList&&) noexcept = default;
+
+		/// <summary>
+		/// Removes all commands while keeping the allocated memory for the next frame.
+		/// </summary>
+		void reset() noexcept;
+
+		_NODISCARD size_t size() const noexcept;
+		_NODISCARD bool empty() const noexcept;
+
+		_NODISCARD const std::vector<RenderCommand>& commands() const noexcept;
+
+		/// <summary>
+		/// Returns if callback commands were recorded. Their objects are only read at submit time, so the list is not a snapshot.
+		/// </summary>
+		_NODISCARD bool hasCallbacks() const noexcept;
+
+#pragma region Record
+		void clear(const Color& color);
+
+		void useProgram(const ShaderProgram& program);
+
+		void bindStorageBuffer(const Buffer::SharedBuffer& buffer);
+		void unbindStorageBuffer();
+
+		/// <summary>
+		/// Records a write to a storage buffer, copying the bytes.
+		/// </summary>
+		void updateStorageBuffer(const Buffer::SharedBuffer& buffer, size_t offset, size_t size, _In_reads_bytes_(size) const void* data);
+
+		/// <summary>
+		/// Records the upload of the whole content of a ring buffer to its next region, copying the bytes. The region is then bound.
+		/// </summary>
+		void uploadRingBuffer(Buffer::RingBuffer& buffer, size_t size, _In_reads_bytes_(size) const void* data);
+
+		/// <summary>
+		/// Binds the region of the last upload of a ring buffer.
+		/// </summary>
+		void bindRingBuffer(Buffer::RingBuffer& buffer);
+
+		void bindTexture(const Buffer::TextureBuffer& texture, unsigned int unitIndex);
+
+		void drawElements(
+			const Buffer::VertexAttributeBuffer& attributes,
+			const Buffer::VertexBuffer& vertices,
+			const Buffer::ElementBuffer& elements);
+
+		/// <summary>
+		/// Binds the buffers of a mesh for the following <see cref="drawBoundElements"/> commands.
+		/// </summary>
+		void bindVertexArray(
+			const Buffer::VertexAttributeBuffer& attributes,
+			const Buffer::VertexBuffer& vertices,
+			const Buffer::ElementBuffer& elements);
+
+		/// <summary>
+		/// Draws the elements of the last bound vertex array, skipped if its buffers were not created.
+		/// </summary>
+		void drawBoundElements(const Buffer::ElementBuffer& elements);
+
+		/// <summary>
+		/// Draws several instances of the elements of the last bound vertex array, skipped if its buffers were not created.
+		/// </summary>
+		void drawBoundElementsInstanced(const Buffer::ElementBuffer& elements, int instanceCount);
+
+		void callback(void (*func)(void* object, const void* argument), void* object, _In_opt_ const void* argument = nullptr);
+
+		void setUniform(const UniformTarget& uniform, int value);
+		void setUniform(const UniformTarget& uniform, unsigned int value);
+		void setUniform(const UniformTarget& uniform, float value);
+		void setUniform(const UniformTarget& uniform, double value);
+		void setUniform(const UniformTarget& uniform, bool value);
+
+		template <LibMath::ArrIndex W, LibMath::ArrIndex H, typename T>
+		void setUniform(const UniformTarget& uniform, const LibMath::MathArray<W, H, T>& value);
+
+		template <typename T>
+		void setUniform(const UniformTarget& uniform, const Sampler<T>& sampler);
+
+		template <typename T>
+		void setUniform(const UniformTarget& uniform, const SamplerLayer<T>& layer);
+
+		void setUniform(const UniformTarget& uniform, const Material& material);
+		void setUniform(const UniformTarget& uniform, const MaterialLayer& layer);
+		void setUniform(const UniformTarget& uniform, const Camera& camera);
+
+		/// <summary>
+		/// Records a uniform assignment by its resolved location, skipped if the program does not use the uniform.
+		/// </summary>
+		template <typename T>
+		void setUniform(UniformHandle<T> uniform, const std::type_identity_t<T>& value);
+#pragma endregion
+
+		/// <summary>
+		/// Executes the commands in order.
+		/// </summary>
+		/// <remarks>Must be called from the thread owning the rendering context.</remarks>
+		void submit() const;
+
+	private:
+		std::vector<RenderCommand> m_commands;
+		std::vector<std::byte> m_data;
+
+		// Program of the last useProgram, resolving the uniforms recorded by name
+		_Maybenull_ const ShaderProgram* m_program = nullptr;
+
+		bool m_callbacks = false;
+
+		RenderCommand& add(eCommandType type);
+
+		/// <summary>
+		/// Copies bytes to the data block.
+		/// </summary>
+		/// <returns>Offset of the copy in the data block</returns>
+		uint32_t addData(_In_reads_bytes_(size) const void* data, size_t size);
+
+		/// <summary>
+		/// Records a uniform assignment, copying the values.
+		/// </summary>
+		/// <remarks>Skipped if the uniform is named and the current program does not declare it.</remarks>
+		void addUniform(const UniformTarget& uniform, eUniformScalar scalar,
+			uint8_t width, uint8_t height, _In_reads_bytes_(size) const void* values, size_t size);
+	};
+}
+
+#include "CommandList.hpp"
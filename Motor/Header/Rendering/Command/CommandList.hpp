@@ -0,0 +1,73 @@
+#pragma once
+
+#include "CommandList.h"
+
+#include "Rendering/Sampler.h"
+#include "Rendering/TextureSample.h"
+
+namespace KaputEngine::Rendering::Command
+{
+	template <LibMath::ArrIndex W, LibMath::ArrIndex H, typename T>
+	void CommandList::setUniform(const UniformTarget& uniform, const LibMath::MathArray<W, H, T>& value)
+	{
+		eUniformScalar scalar;
+
+		if constexpr (std::is_same_v<T, int>)
+			scalar = eUniformScalar::INT;
+		else if constexpr (std::is_same_v<T, unsigned int>)
+			scalar = eUniformScalar::UNSIGNED_INT;
+		else if constexpr (std::is_same_v<T, float>)
+			scalar = eUniformScalar::FLOAT;
+		else if constexpr (std::is_same_v<T, double>)
+			scalar = eUniformScalar::DOUBLE;
+		else
+			static_assert(false, "Unsupported uniform scalar type.");
+
+		addUniform(uniform, scalar,
+			static_cast<uint8_t>(W), static_cast<uint8_t>(H), value.raw(), sizeof(T) * W * H);
+	}
+
+	template <typename T>
+	void CommandList::setUniform(const UniformTarget& uniform, const Sampler<T>& sampler)
+	{
+		// Texture not defined or not available - Use fallback
+		if (!sampler.texture().texture || !sampler.texture().texture->id())
+		{
+			// Assign fallback mode, offset by 1 to ignore layer mode
+			setUniform(uniform, static_cast<int>(sampler.fallbackMode()) - 1);
+
+			if (sampler.fallbackMode() == eSamplerFallback::GLOBAL)
+				setUniform(uniform + 1, sampler.global());
+		}
+		else
+		{
+			// Set mode to texture
+			setUniform(uniform, 2);
+
+			const TextureSample& texSample = sampler.texture();
+
+			bindTexture(*texSample.texture, texSample.unitIndex);
+
+			// Assign texture unit to sampler2D - Texture unit requires signed int
+			setUniform(uniform + 2, static_cast<int>(texSample.unitIndex));
+		}
+	}
+
+	template <typename T>
+	void CommandList::setUniform(const UniformTarget& uniform, const SamplerLayer<T>& layer)
+	{
+		const std::shared_ptr<const Buffer::TextureBuffer> tex = layer.primary.texture().texture;
+
+		if ((tex && tex->id()) || layer.primary.fallbackMode() != eSamplerFallback::LAYER)
+			setUniform(uniform, layer.primary);
+		else if (layer.fallback)
+			setUniform(uniform, *layer.fallback);
+	}
+
+	template <typename T>
+	void CommandList::setUniform(const UniformHandle<T> uniform, const std::type_identity_t<T>& value)
+	{
+		if (uniform)
+			setUniform(UniformTarget(uniform.location()), value);
+	}
+}
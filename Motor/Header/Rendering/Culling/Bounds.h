@@ -0,0 +1,82 @@
+#pragma once
+
+#include <LibMath/Matrix.h>
+#include <LibMath/Point/Cartesian.h>
+
+#include <limits>
+
+namespace KaputEngine::Rendering::Culling
+{
+	struct BoundingSphere;
+
+	/// <summary>
+	/// Axis-aligned bounding box.
+	/// </summary>
+	/// <remarks>Default constructed boxes are empty and grow with the points merged into them.</remarks>
+	struct BoundingBox
+	{
+		static constexpr float Infinity = std::numeric_limits<float>::infinity();
+
+		LibMath::Cartesian3f min { Infinity, Infinity, Infinity };
+		LibMath::Cartesian3f max { -Infinity, -Infinity, -Infinity };
+
+		_NODISCARD bool empty() const noexcept;
+
+		_NODISCARD LibMath::Cartesian3f center() const noexcept;
+
+		/// <summary>
+		/// Half the size of the box on each axis.
+		/// </summary>
+		_NODISCARD LibMath::Cartesian3f extents() const noexcept;
+
+		void merge(const LibMath::Cartesian3f& point) noexcept;
+		void merge(const BoundingBox& box) noexcept;
+
+		_NODISCARD bool intersects(const BoundingBox& box) const noexcept;
+		_NODISCARD bool intersects(const BoundingSphere& sphere) const noexcept;
+
+		/// <summary>
+		/// Box containing this box once transformed by an affine matrix.
+		/// </summary>
+		_NODISCARD BoundingBox transform(const LibMath::Matrix4f& matrix) const noexcept;
+	};
+
+	struct BoundingSphere
+	{
+		LibMath::Cartesian3f center;
+		float radius = -1.f;
+
+		_NODISCARD bool empty() const noexcept;
+
+		/// <summary>
+		/// Sphere containing this sphere once transformed by an affine matrix.
+		/// </summary>
+		/// <remarks>Non-uniform scales grow the radius by the largest axis scale.</remarks>
+		_NODISCARD BoundingSphere transform(const LibMath::Matrix4f& matrix) const noexcept;
+	};
+
+	/// <summary>
+	/// Box and sphere around the same points, the sphere being tested first as the cheaper rejection.
+	/// </summary>
+	struct Bounds
+	{
+		BoundingBox box;
+		BoundingSphere sphere;
+
+		/// <summary>
+		/// Bounds of a set of points with the sphere centered on the box.
+		/// </summary>
+		_NODISCARD static Bounds fromPoints(_In_reads_(count) const LibMath::Cartesian3f* points, size_t count) noexcept;
+
+		/// <summary>
+		/// Bounds of a box with the sphere circumscribing it.
+		/// </summary>
+		_NODISCARD static Bounds fromBox(const BoundingBox& box) noexcept;
+
+		_NODISCARD bool empty() const noexcept;
+
+		void merge(const Bounds& bounds) noexcept;
+
+		_NODISCARD Bounds transform(const LibMath::Matrix4f& matrix) const noexcept;
+	};
+}
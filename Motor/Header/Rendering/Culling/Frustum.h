@@ -0,0 +1,78 @@
+#pragma once
+
+#include "Bounds.h"
+
+#include <LibMath/Matrix.h>
+
+#include <array>
+#include <cstdint>
+
+namespace KaputEngine::Rendering::Culling
+{
+	/// <summary>
+	/// Plane of points p where dot(normal, p) + distance = 0, the normal pointing inside the frustum.
+	/// </summary>
+	struct Plane
+	{
+		float normal[3] { };
+		float distance = 0.f;
+
+		_NODISCARD float signedDistance(const LibMath::Cartesian3f& point) const noexcept;
+	};
+
+	/// <summary>
+	/// View volume of a camera for visibility tests.
+	/// </summary>
+	class Frustum
+	{
+	public:
+		enum ePlane : uint8_t
+		{
+			LEFT,
+			RIGHT,
+			BOTTOM,
+			TOP,
+			NEAR_PLANE,
+			FAR_PLANE,
+			COUNT
+		};
+
+		Frustum() = default;
+
+		/// <summary>
+		/// Extracts the planes of a view projection matrix mapping to OpenGL clip space.
+		/// </summary>
+		explicit Frustum(const LibMath::Matrix4f& viewProjection) noexcept;
+
+		_NODISCARD const std::array<Plane, COUNT>& planes() const noexcept;
+
+		_NODISCARD bool intersects(const BoundingSphere& sphere) const noexcept;
+
+		_NODISCARD bool intersects(const BoundingBox& box) const noexcept;
+
+		/// <summary>
+		/// Tests the sphere then the box. Empty bounds are considered visible.
+		/// </summary>
+		_NODISCARD bool intersects(const Bounds& bounds) const noexcept;
+
+	private:
+		std::array<Plane, COUNT> m_planes;
+	};
+
+	/// <summary>
+	/// Visibility results of the last recorded frame.
+	/// </summary>
+	struct CullingStats
+	{
+		uint32_t visible = 0;
+		uint32_t culled = 0;
+
+		// Inside the view but hidden behind occluders
+		uint32_t occluded = 0;
+
+		_NODISCARD uint32_t total() const noexcept
+		{
+			return visible + culled + occluded;
+		}
+	};
+}
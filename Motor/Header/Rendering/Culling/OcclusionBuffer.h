@@ -0,0 +1,150 @@
+#pragma once
+
+#include "Frustum.h"
+
+#include "Job/JobSystem.h"
+
+#include <LibMath/Matrix.h>
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace KaputEngine::Rendering
+{
+	class Mesh;
+}
+
+namespace KaputEngine::Rendering::Culling
+{
+	/// <summary>
+	/// Mesh rasterized into the occlusion buffer, drawn with its coarsest level of detail.
+	/// </summary>
+	struct Occluder
+	{
+		const Mesh* mesh = nullptr;
+		LibMath::Matrix4f model;
+	};
+
+	/// <summary>
+	/// Low resolution depth buffer rasterized on the CPU from the occluders of a frame, to skip renderables hidden behind them.
+	/// </summary>
+	/// <remarks>
+	/// Occluder triangles are transformed, clipped to the near plane and binned into horizontal bands by a setup job,
+	/// then each band is rasterized by its own job, four pixels at a time. Every tile keeps the nearest and farthest depth
+	/// of its pixels, so most bounding box tests are answered by the tiles without reading pixels.
+	/// Depths are OpenGL window depths, smaller is nearer.
+	/// </remarks>
+	class OcclusionBuffer
+	{
+	public:
+		static constexpr uint32_t Width = 256;
+		static constexpr uint32_t Height = 144;
+
+		static constexpr uint32_t TileSize = 8;
+		static constexpr uint32_t TilesX = Width / TileSize;
+		static constexpr uint32_t TilesY = Height / TileSize;
+
+		/// <summary>
+		/// Horizontal bands rasterized in parallel.
+		/// </summary>
+		static constexpr uint32_t BandCount = 6;
+		static constexpr uint32_t BandHeight = Height / BandCount;
+
+		/// <summary>
+		/// Depth added to tested boxes so surfaces do not hide themselves through rounding.
+		/// </summary>
+		static constexpr float DepthBias = 1e-4f;
+
+		static_assert(Width % TileSize == 0 && Height % TileSize == 0);
+		static_assert(BandHeight % TileSize == 0 && BandHeight * BandCount == Height);
+		static_assert(Width % 4 == 0, "Rows are rasterized four pixels at a time.");
+
+		OcclusionBuffer();
+		OcclusionBuffer(const OcclusionBuffer&) = delete;
+		OcclusionBuffer(OcclusionBuffer&&) = delete;
+
+		OcclusionBuffer& operator=(const OcclusionBuffer&) = delete;
+		OcclusionBuffer& operator=(OcclusionBuffer&&) = delete;
+
+		/// <summary>
+		/// Clears the buffer and rasterizes the occluders on the job system workers.
+		/// </summary>
+		/// <remarks>The occluders and their meshes must stay alive and unchanged until the job finishes.</remarks>
+		/// <returns>Job to wait on before testing, null if there is nothing to rasterize</returns>
+		_NODISCARD Job::JobHandle rasterize(
+			const LibMath::Matrix4f& viewProjection, const Frustum& frustum, std::span<const Occluder> occluders);
+
+		/// <summary>
+		/// Clears the buffer and rasterizes the occluders on the calling thread.
+		/// </summary>
+		void rasterizeNow(const LibMath::Matrix4f& viewProjection, const Frustum& frustum, std::span<const Occluder> occluders);
+
+		/// <summary>
+		/// Whether the box is entirely behind the rasterized occluders.
+		/// </summary>
+		/// <remarks>Boxes crossing the near plane or the screen edges are tested against the visible part only.</remarks>
+		_NODISCARD bool occluded(const BoundingBox& box) const noexcept;
+
+		_NODISCARD bool occluded(const Bounds& bounds) const noexcept;
+
+		/// <summary>
+		/// Depth of a pixel, from the bottom left corner.
+		/// </summary>
+		_NODISCARD float depth(uint32_t x, uint32_t y) const noexcept;
+
+		/// <summary>
+		/// Occluder triangles rasterized in the last frame, after clipping.
+		/// </summary>
+		_NODISCARD uint32_t triangleCount() const noexcept;
+
+	private:
+		/// <summary>
+		/// Screen space triangle with its edge and depth planes, evaluated at pixel centers.
+		/// </summary>
+		struct Triangle
+		{
+			// a * x + b * y + c, positive inside
+			float edgeA[3], edgeB[3], edgeC[3];
+			float depthA, depthB, depthC;
+
+			// Nearest depth of the triangle, to skip tiles already nearer
+			float nearest;
+
+			// Pixel bounds, inclusive
+			int minX, minY, maxX, maxY;
+		};
+
+		void clear() noexcept;
+
+		/// <summary>
+		/// Transforms, clips and bins the triangles of the occluders.
+		/// </summary>
+		void setup(const Frustum& frustum, std::span<const Occluder> occluders);
+
+		/// <param name="a">Clip space position, in front of the near plane</param>
+		void addTriangle(const float* a, const float* b, const float* c);
+
+		void rasterizeBand(uint32_t band) noexcept;
+		void rasterizeTriangle(const Triangle& triangle, int bandMinY, int bandMaxY) noexcept;
+
+		/// <summary>
+		/// Updates the nearest and farthest depth of the tiles of a band.
+		/// </summary>
+		void updateTiles(uint32_t band) noexcept;
+
+		LibMath::Matrix4f m_viewProjection;
+
+		std::vector<float> m_depth;
+		std::vector<float> m_tileNearest;
+		std::vector<float> m_tileFarthest;
+
+		std::vector<Triangle> m_triangles;
+
+		// Indices of the triangles overlapping each band
+		std::vector<uint32_t> m_bins[BandCount];
+
+		// Whether anything was rasterized, tests are skipped otherwise
+		bool m_empty = true;
+	};
+}
@@ -0,0 +1,200 @@
+#pragma once
+
+#include "Rendering/Buffer/RingBuffer.h"
+
+#include <LibMath/Matrix.h>
+#include <LibMath/Point/Cartesian.h>
+
+#include <cstdint>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace KaputEngine::Rendering
+{
+	class Material;
+	class Mesh;
+	class ShaderProgram;
+
+	namespace Command
+	{
+		class CommandList;
+	}
+
+	enum class eRenderPass : uint8_t
+	{
+		// Drawn front to back
+		SOLID,
+		// Drawn back to front after the solid pass
+		TRANSLUCENT
+	};
+
+	/// <summary>
+	/// Single mesh draw queued for sorting.
+	/// </summary>
+	struct DrawItem
+	{
+		eRenderPass pass = eRenderPass::SOLID;
+
+		const ShaderProgram* program = nullptr;
+		const Material* material = nullptr;
+
+		// Material of the mesh used for unset samplers of the material
+		_Maybenull_ const Material* fallbackMaterial = nullptr;
+
+		const Mesh* mesh = nullptr;
+
+		// Level of detail of the mesh, clamped to the levels of each mesh when queued
+		uint8_t lod = 0;
+
+		LibMath::Matrix4f model;
+
+		// Position of the owning object, sent as the worldPosition uniform
+		LibMath::Cartesian3f worldPosition;
+	};
+
+	/// <summary>
+	/// State changes and draws of the last recorded queue.
+	/// </summary>
+	struct DrawStats
+	{
+		uint32_t drawCalls = 0;
+
+		/// <summary>
+		/// Draw calls drawing several objects at once, included in the draw calls.
+		/// </summary>
+		uint32_t instancedDraws = 0;
+
+		/// <summary>
+		/// Objects drawn by instanced draws.
+		/// </summary>
+		uint32_t instances = 0;
+
+		uint32_t programChanges = 0;
+		uint32_t materialChanges = 0;
+		uint32_t meshChanges = 0;
+		uint32_t bufferBinds = 0;
+
+		/// <summary>
+		/// Binds avoided compared to binding every state for every draw.
+		/// </summary>
+		uint32_t stateChangesSaved = 0;
+
+		uint32_t trianglesDrawn = 0;
+
+		/// <summary>
+		/// Triangles not drawn thanks to coarser levels of detail, compared to drawing every mesh in full.
+		/// </summary>
+		uint32_t trianglesSaved = 0;
+	};
+
+	/// <summary>
+	/// Draws of a frame recorded in an order minimizing state changes.
+	/// </summary>
+	/// <remarks>
+	/// Each draw gets a 64 bit key made of, from the most significant bits, its pass, program, material,
+	/// mesh level of detail and quantized depth.
+	/// Recording walks the sorted draws and only records the binds that differ from the previous draw.
+	/// Consecutive draws of the same mesh level of detail with the same material and an instanced program are merged into one instanced draw,
+	/// with their model matrices packed in the instance buffer. Single draws of instanced programs read their matrix from it as well.
+	/// </remarks>
+	class DrawQueue
+	{
+	public:
+		/// <summary>
+		/// Model matrices held by a region of the instance ring buffer. Larger frames upload the next chunk to the next region.
+		/// </summary>
+		static constexpr uint32_t MaxInstances = 8192;
+
+		DrawQueue() = default;
+		DrawQueue(const DrawQueue&) = delete;
+		DrawQueue(DrawQueue&&) = delete;
+
+		DrawQueue& operator=(const DrawQueue&) = delete;
+		DrawQueue& operator=(DrawQueue&&) = delete;
+
+		/// <summary>
+		/// Creates the instance buffer. Draws are never instanced without it.
+		/// </summary>
+		/// <param name="index">Storage buffer binding of the instance buffer in Instancing.glsl</param>
+		void create(unsigned int index);
+
+		/// <summary>
+		/// Clears the queue for a new frame while keeping its allocations.
+		/// </summary>
+		/// <param name="viewPosition">Position depths are measured from</param>
+		/// <param name="viewDistance">Depth mapped to the last quantization step</param>
+		void reset(const LibMath::Cartesian3f& viewPosition, float viewDistance);
+
+		void push(const DrawItem& item);
+
+		_NODISCARD size_t size() const noexcept;
+		_NODISCARD bool empty() const noexcept;
+
+		/// <summary>
+		/// Sorts the draws and records them.
+		/// </summary>
+		/// <remarks>Camera data is read from the view block, which must be recorded first.</remarks>
+		/// <param name="storageBuffers">Buffers bound once around all draws</param>
+		void record(Command::CommandList& list, std::span<Buffer::RingBuffer* const> storageBuffers);
+
+		_NODISCARD const DrawStats& stats() const noexcept;
+
+	private:
+		/// <summary>
+		/// Sorted draws recorded with a single draw call.
+		/// </summary>
+		struct Batch
+		{
+			// Position of the first draw in the sorted order
+			uint32_t first;
+			uint32_t count;
+
+			// Index of the first matrix in the uploaded chunk of the instance buffer, negative if not instanced
+			int instanceOffset;
+			uint32_t chunk;
+		};
+
+		_NODISCARD uint64_t makeKey(const DrawItem& item);
+
+		/// <summary>
+		/// Dense index of a state within the frame, so keys compare by state without depending on addresses.
+		/// </summary>
+		_NODISCARD static uint16_t stateIndex(std::unordered_map<const void*, uint16_t>& indices, const void* state);
+
+		/// <summary>
+		/// Whether two draws only differ by their object and can be drawn as instances.
+		/// </summary>
+		_NODISCARD static bool instanceable(const DrawItem& first, const DrawItem& second) noexcept;
+
+		/// <summary>
+		/// Groups the sorted draws into batches and packs the model matrices of the instanced ones.
+		/// </summary>
+		void batch();
+
+		/// <summary>
+		/// Records the upload of a chunk of <see cref="MaxInstances"/> packed matrices to the instance buffer.
+		/// </summary>
+		void uploadInstances(Command::CommandList& list, uint32_t chunk);
+
+		std::vector<DrawItem> m_items;
+
+		// Key and item index pairs
+		std::vector<std::pair<uint64_t, uint32_t>> m_order;
+
+		std::vector<Batch> m_batches;
+
+		// Model matrices of the instanced batches in draw order
+		std::vector<LibMath::Matrix4f> m_instances;
+		Buffer::RingBuffer m_instanceBuffer;
+
+		std::unordered_map<const void*, uint16_t> m_programIndices;
+		std::unordered_map<const void*, uint16_t> m_materialIndices;
+		std::unordered_map<const void*, uint16_t> m_meshIndices;
+
+		LibMath::Cartesian3f m_viewPosition;
+		float m_viewDistance = 1.f;
+
+		DrawStats m_stats;
+	};
+}
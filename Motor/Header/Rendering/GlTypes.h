@@ -11,6 +11,7 @@ namespace KaputEngine::Rendering
     using RenderBool = uint32_t;
 
     class Color;
+    struct HalfFloat;
 
     namespace Rendering
     {
@@ -52,6 +53,7 @@ GL_TYPE_DEF(ARGS(LibMath::MathArray<4, 4, type>), gl_type##_MAT4) \
         GL_TYPE_DEF(float, GL_FLOAT)
         GL_TYPE_DEF(double, GL_DOUBLE)
         GL_TYPE_DEF(bool, GL_BOOL)
+        GL_TYPE_DEF(HalfFloat, GL_HALF_FLOAT)
 
         GL_TYPE_DEF_VECS(int, GL_INT)
         GL_TYPE_DEF_VECS(unsigned int, GL_UNSIGNED_INT)
@@ -1,14 +1,21 @@
 #pragma once
 
-#include "Rendering/Buffer/SharedBuffer.h"
+#include "Rendering/Buffer/RingBuffer.h"
 
 #include <bitset>
+#include <cstddef>
+#include <vector>
 
 namespace KaputEngine
 {
 	class LightComponent;
 }
 
+namespace KaputEngine::Rendering::Command
+{
+	class CommandList;
+}
+
 namespace KaputEngine::Rendering::Lighting
 {
 	class LightBuffer
@@ -20,17 +27,38 @@ namespace KaputEngine::Rendering::Lighting
 		LightBuffer(const LightBuffer&) = delete;
 		LightBuffer(LightBuffer&&) = delete;
 
-		_NODISCARD const Buffer::SharedBuffer& buffer() const noexcept;
+		_NODISCARD Buffer::RingBuffer& buffer() noexcept;
+		_NODISCARD const Buffer::RingBuffer& buffer() const noexcept;
 
 		void destroy();
 
+		/// <summary>
+		/// Records the upload of the light data if it was modified since the last call.
+		/// </summary>
+		/// <remarks>Changes made during the frame are coalesced in the CPU copy and uploaded at once.</remarks>
+		void record(Command::CommandList& list);
+
 	protected:
 		virtual void updateLight(const LightComponent& light) noexcept  = 0;
 
 		_NODISCARD virtual size_t registerLight(const LightComponent& light) = 0;
 		virtual void unregisterLight(const LightComponent& light) = 0;
 
-		Buffer::SharedBuffer m_buffer;
+		/// <summary>
+		/// Writes to the CPU copy of the buffer. Changes are uploaded when the frame is recorded.
+		/// </summary>
+		void write(size_t offset, size_t size, _In_reads_bytes_(size) const void* data);
+
+		template <typename T>
+		void write(size_t offset, const T& data);
+
+		Buffer::RingBuffer m_buffer;
+
+		// CPU copy of the buffer content
+		std::vector<std::byte> m_data;
+
+		// Modified since the last upload
+		bool m_dirty = false;
 	};
 
 	template <size_t _MaxLights, size_t _Stride>
@@ -4,22 +4,27 @@
 
 #include "Component/Lighting/LightComponent.h"
 #include "LightData.h"
-#include "Rendering/Buffer/SharedBuffer.hpp"
 
 #define TEMPLATE template <size_t _MaxLights, size_t _Stride>
 #define LIGHTBUFFERBASE LightBufferBase<_MaxLights, _Stride>
 
 namespace KaputEngine::Rendering::Lighting
 {
+	template <typename T>
+	void LightBuffer::write(const size_t offset, const T& data)
+	{
+		write(offset, sizeof(T), &data);
+	}
+
 	TEMPLATE void LIGHTBUFFERBASE::create(const unsigned int index)
 	{
 		static constexpr size_t size = _MaxLights * _Stride;
 
-		m_buffer.create(size, index);
+		m_buffer.create(Buffer::eRingTarget::STORAGE, size, index);
+		m_data.assign(size, std::byte { });
 
-		uint8_t* bytes = new uint8_t[size] { };
-		m_buffer.write(0, size, bytes);
-		delete[] bytes;
+		// Cleared on the first upload
+		m_dirty = true;
 	}
 
 	TEMPLATE size_t LIGHTBUFFERBASE::registerLight(const LightComponent& light)
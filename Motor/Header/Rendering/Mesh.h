@@ -5,7 +5,11 @@
 #include "Rendering/Buffer/ElementBuffer.h"
 #include "Rendering/Buffer/VertexAttributeBuffer.h"
 #include "Rendering/Buffer/VertexBuffer.h"
+#include "Rendering/Culling/Bounds.h"
+#include "Rendering/MeshOptimizer.h"
+#include "Rendering/Vertex.h"
 
+#include <concepts>
 #include <vector>
 
 namespace KaputEngine::Resource
@@ -17,9 +21,43 @@ class aiMesh;
 
 namespace KaputEngine::Rendering
 {
+    namespace Command
+    {
+        class CommandList;
+    }
+
+    class DrawQueue;
+    struct DrawItem;
+
+    /// <summary>
+    /// Geometry kept on the CPU once a mesh is uploaded.
+    /// </summary>
+    enum class eMeshRetention : uint8_t
+    {
+        /// <summary>
+        /// Nothing, for meshes only ever drawn such as the static batches.
+        /// </summary>
+        NONE,
+
+        /// <summary>
+        /// Positions and indices of the coarsest level of detail, rasterized when the mesh is an occluder.
+        /// </summary>
+        OCCLUDER,
+
+        /// <summary>
+        /// The occluder geometry, and the full vertices and indices until the mesh is merged into a static batch.
+        /// </summary>
+        FULL
+    };
+
     class Mesh : public MatrixTransformSource
     {
     public:
+        /// <summary>
+        /// Levels of detail of imported meshes, including the full mesh.
+        /// </summary>
+        static constexpr uint8_t MaxLods = 4;
+
         Mesh() = default;
         explicit Mesh(const Mesh& parent);
         Mesh(Resource::MeshResource& resource);
@@ -29,7 +67,18 @@ namespace KaputEngine::Rendering
 
         Mesh& operator=(Mesh&&) noexcept = default;
 
-        _Success_(return) bool init(const aiMesh& mesh, _In_opt_ const std::shared_ptr<class Material>& mat);
+        /// <param name="format">Layout of the uploaded vertices</param>
+        /// <param name="lods">Levels of detail to generate, including the full mesh</param>
+        _Success_(return) bool init(const aiMesh& mesh, _In_opt_ const std::shared_ptr<class Material>& mat,
+            eVertexFormat format = eVertexFormat::COMPACT, uint8_t lods = MaxLods);
+
+        /// <summary>
+        /// Uploads generated vertices with float positions.
+        /// </summary>
+        /// <param name="colors">Whether to upload the albedo of the vertices</param>
+        /// <param name="retention">Geometry to keep on the CPU once uploaded</param>
+        void init(std::span<const Vertex> vertices, std::span<const unsigned int> indices, bool colors = false,
+            eMeshRetention retention = eMeshRetention::FULL);
 
         void destroy();
 
@@ -42,13 +91,113 @@ namespace KaputEngine::Rendering
         _NODISCARD Buffer::ElementBuffer& elements() noexcept;
         _NODISCARD const Buffer::ElementBuffer& elements() const noexcept;
 
+        /// <summary>
+        /// Indices of a level of detail, sharing the vertices of the full mesh. Clamped to the coarsest level.
+        /// </summary>
+        _NODISCARD const Buffer::ElementBuffer& elements(uint8_t lod) const noexcept;
+
+        /// <summary>
+        /// Uploaded levels of detail, including the full mesh.
+        /// </summary>
+        _NODISCARD uint8_t lodCount() const noexcept;
+
+        _NODISCARD uint32_t triangleCount(uint8_t lod = 0) const noexcept;
+
+        /// <summary>
+        /// Mapping of the uploaded positions to mesh space, set as the position uniforms of Vertex.glsl.
+        /// </summary>
+        _NODISCARD const VertexQuantization& quantization() const noexcept;
+
+        /// <summary>
+        /// Material of the imported mesh, used for the samplers left unset by the drawing material.
+        /// </summary>
+        _NODISCARD _Ret_maybenull_ const class Material* material() const noexcept;
+
+        /// <summary>
+        /// Geometry currently kept on the CPU, lowered from full to occluder once the source is released.
+        /// </summary>
+        _NODISCARD eMeshRetention retention() const noexcept;
+
+        /// <summary>
+        /// Vertices of the full level of detail, kept on the CPU to merge static geometry. Empty once released.
+        /// </summary>
+        _NODISCARD std::span<const Vertex> sourceVertices() const noexcept;
+        _NODISCARD std::span<const unsigned int> sourceIndices() const noexcept;
+
+        /// <summary>
+        /// Frees the full vertices and indices, keeping the occluder geometry.
+        /// </summary>
+        /// <remarks>Called on shared meshes once merged, later batches draw the components using them on their own.</remarks>
+        void releaseSource() const noexcept;
+
+        /// <summary>
+        /// Positions of the vertices used by the coarsest level of detail, rasterized when the mesh is an occluder.
+        /// </summary>
+        _NODISCARD std::span<const LibMath::Cartesian3f> occluderPositions() const noexcept;
+
+        /// <summary>
+        /// Indices of the coarsest level of detail into the occluder positions.
+        /// </summary>
+        _NODISCARD std::span<const unsigned int> occluderIndices() const noexcept;
+
+        /// <summary>
+        /// Vertex counts and cache miss ratios of the import optimization, left at zero for generated meshes.
+        /// </summary>
+        _NODISCARD const MeshOptimizationStats& optimizationStats() const noexcept;
+
+        /// <summary>
+        /// Whether the vertex colors were uploaded.
+        /// </summary>
+        _NODISCARD bool hasColors() const noexcept;
+
+        /// <summary>
+        /// Appends the source geometry transformed by a world matrix, with indices offset past the existing vertices.
+        /// </summary>
+        /// <param name="colors">Whether to keep the albedo of the vertices, the default vertex color is used otherwise</param>
+        void appendWorldGeometry(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices,
+            const LibMath::Matrix4f& model, bool colors) const;
+
+        /// <summary>
+        /// Calls a function with the mesh and each of its children and their world matrix, as drawn by <see cref="queue"/>.
+        /// </summary>
+        /// <param name="parent">World matrix of the parent object or mesh</param>
+        template <std::invocable<const Mesh&, const LibMath::Matrix4f&> Func>
+        void forEachMesh(const LibMath::Matrix4f& parent, Func&& func) const;
+
         /// <summary>
         /// Legacy draw
         /// </summary>
         void draw() const;
 
+        /// <summary>
+        /// Draws the mesh and its children by recording and submitting a command list.
+        /// </summary>
         void draw(const TransformSource& parent, const class Material& material, const class ShaderProgram& program) const;
 
+        /// <summary>
+        /// Records the draw commands for the mesh and its children.
+        /// </summary>
+        /// <remarks>The program is expected to be in use when the list is submitted.</remarks>
+        void record(Command::CommandList& list,
+            const TransformSource& parent, const class Material& material, const class ShaderProgram& program) const;
+
+        /// <summary>
+        /// Bounds of the vertices of this mesh alone, in mesh space.
+        /// </summary>
+        _NODISCARD const Culling::Bounds& localBounds() const noexcept;
+
+        /// <summary>
+        /// Bounds of the mesh and its submeshes, in mesh space.
+        /// </summary>
+        _NODISCARD Culling::Bounds bounds() const noexcept;
+
+        /// <summary>
+        /// Queues a draw for the mesh and each of its children.
+        /// </summary>
+        /// <param name="item">Draw state shared by the meshes</param>
+        /// <param name="parent">World matrix of the parent object or mesh</param>
+        void queue(DrawQueue& queue, const DrawItem& item, const LibMath::Matrix4f& parent) const;
+
 		_NODISCARD _Ret_maybenull_ Resource::MeshResource* parentResource() noexcept;
 		_NODISCARD _Ret_maybenull_ const Resource::MeshResource* parentResource() const noexcept;
 
@@ -59,6 +208,13 @@ namespace KaputEngine::Rendering
         _NODISCARD _Ret_maybenull_ const TransformSource* getParentTransform() const noexcept final;
 
     private:
+        /// <summary>
+        /// Computes the bounds of the vertices, then packs and uploads them if there is a context.
+        /// </summary>
+        /// <param name="lods">Indices of the coarser levels of detail</param>
+        void upload(std::span<const Vertex> vertices, std::span<const unsigned int> indices, eVertexFormat format, bool colors,
+            eMeshRetention retention, std::span<const std::vector<unsigned int>> lods = { });
+
         /// <summary>
         /// Parent mesh, object or component
         /// </summary>
@@ -71,6 +227,27 @@ namespace KaputEngine::Rendering
         Buffer::VertexAttributeBuffer m_vertexAttributeBuffer;
         Buffer::ElementBuffer m_elementBuffer;
 
+        // Coarser levels of detail, from the second. Never resized once created, the buffers do not survive relocation.
+        std::vector<Buffer::ElementBuffer> m_lodBuffers;
+
+        // Computed from the imported vertices
+        Culling::Bounds m_bounds;
+
+        VertexQuantization m_quantization;
+
+        MeshOptimizationStats m_optimizationStats;
+
+        // Released through the shared const meshes once merged
+        mutable eMeshRetention m_retention = eMeshRetention::NONE;
+        mutable std::vector<Vertex> m_sourceVertices;
+        mutable std::vector<unsigned int> m_sourceIndices;
+
+        // Only the vertices of the coarsest level, indexed from zero
+        std::vector<LibMath::Cartesian3f> m_occluderPositions;
+        std::vector<unsigned int> m_occluderIndices;
+
+        bool m_colors = false;
+
 		Resource::MeshResource* m_resource = nullptr;
     };
 }
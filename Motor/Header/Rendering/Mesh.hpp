@@ -0,0 +1,17 @@
+#pragma once
+
+#include "Mesh.h"
+
+namespace KaputEngine::Rendering
+{
+	template <std::invocable<const Mesh&, const LibMath::Matrix4f&> Func>
+	void Mesh::forEachMesh(const LibMath::Matrix4f& parent, Func&& func) const
+	{
+		const LibMath::Matrix4f model = parent * getLocalTransform().toMatrix();
+
+		func(*this, model);
+
+		for (const Mesh& child : m_children)
+			child.forEachMesh(model, func);
+	}
+}
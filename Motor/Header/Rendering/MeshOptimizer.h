@@ -0,0 +1,91 @@
+#pragma once
+
+#include "Rendering/Vertex.h"
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace KaputEngine::Rendering
+{
+	/// <summary>
+	/// Vertex counts and average cache miss ratios (cache misses per triangle) of a mesh before and after optimization.
+	/// </summary>
+	struct MeshOptimizationStats
+	{
+		size_t verticesBefore = 0;
+		size_t verticesAfter = 0;
+
+		float acmrBefore = 0.f;
+		float acmrAfter = 0.f;
+	};
+
+	/// <summary>
+	/// Optimization stage run on imported meshes before upload.
+	/// </summary>
+	/// <remarks>
+	/// Identical vertices are welded, triangles are reordered for the post-transform vertex cache with Tipsify
+	/// (Sander, Nehab and Barczak, Fast Triangle Reordering for Vertex Locality and Reduced Overdraw),
+	/// the clusters it produces are sorted to draw outward facing ones first, and vertices are reordered by first use.
+	/// Levels of detail are simplified with quadric error metrics (Garland and Heckbert).
+	/// </remarks>
+	class MeshOptimizer
+	{
+	public:
+		/// <summary>
+		/// Size of the FIFO vertex cache targeted by the reordering and simulated for the miss ratios.
+		/// </summary>
+		static constexpr uint32_t CacheSize = 16;
+
+		/// <summary>
+		/// Largest increase of the miss ratio accepted from the overdraw ordering, relative to the cache ordering.
+		/// </summary>
+		static constexpr float OverdrawThreshold = 1.05f;
+
+		MeshOptimizer() = delete;
+
+		/// <summary>
+		/// Runs every step on a triangle list.
+		/// </summary>
+		static MeshOptimizationStats optimize(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices);
+
+		/// <summary>
+		/// Merges vertices with identical attributes.
+		/// </summary>
+		static void weld(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices);
+
+		/// <summary>
+		/// Reorders triangles to reuse the vertices left in the cache.
+		/// </summary>
+		/// <returns>First triangle of each cluster, starting where the order jumps to vertices outside of the cache</returns>
+		static std::vector<uint32_t> optimizeVertexCache(std::vector<unsigned int>& indices, size_t vertexCount);
+
+		/// <summary>
+		/// Reorders the clusters of a cache-ordered triangle list so outward facing ones are drawn first.
+		/// </summary>
+		/// <param name="clusters">First triangle of each cluster</param>
+		static void optimizeOverdraw(
+			std::span<const Vertex> vertices, std::vector<unsigned int>& indices, std::span<const uint32_t> clusters);
+
+		/// <summary>
+		/// Reorders vertices by first use in the triangles and drops unused ones.
+		/// </summary>
+		static void optimizeVertexFetch(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices);
+
+		/// <summary>
+		/// Removes triangles with quadric error half-edge collapses until reaching a triangle count or an error.
+		/// </summary>
+		/// <remarks>
+		/// Vertices are only moved onto other vertices, keeping their attributes. Vertices on borders and seams,
+		/// sharing their position with other vertices with different normals or UVs, are never moved.
+		/// </remarks>
+		/// <param name="maxError">Largest distance a collapse may move the surface, relative to the size of the mesh</param>
+		static void simplify(
+			std::span<const Vertex> vertices, std::vector<unsigned int>& indices, size_t targetTriangles, float maxError);
+
+		/// <summary>
+		/// Average cache miss ratio of a triangle list with a FIFO cache of <see cref="CacheSize"/> vertices.
+		/// </summary>
+		_NODISCARD static float acmr(std::span<const unsigned int> indices, size_t vertexCount);
+	};
+}
@@ -0,0 +1,136 @@
+#pragma once
+
+#include "Rendering/Command/CommandList.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <sal.h>
+#include <thread>
+
+struct GLFWwindow;
+struct ImDrawData;
+
+namespace KaputEngine::Rendering
+{
+	/// <summary>
+	/// Thread owning the rendering context in pipelined mode, drawing frame N while the main thread simulates frame N+1
+	/// </summary>
+	/// <remarks>
+	/// Frames are double-buffered snapshots. The main thread records into one while the render thread submits the other.
+	/// Frames with callback commands read live objects when drawn, so they are drawn before <see cref="present"/> returns instead.
+	/// While running, the render thread owns the <see cref="Queue::ContextQueue"/>.
+	/// </remarks>
+	class RenderThread
+	{
+	public:
+		/// <summary>
+		/// Snapshot of the data needed to draw a frame, immutable once presented
+		/// </summary>
+		class Frame
+		{
+			friend RenderThread;
+
+		public:
+			Frame() = default;
+			Frame(const Frame&) = delete;
+			Frame(Frame&&) = delete;
+
+			~Frame();
+
+			Frame& operator=(const Frame&) = delete;
+			Frame& operator=(Frame&&) = delete;
+
+			_NODISCARD Command::CommandList& commands() noexcept;
+			_NODISCARD const Command::CommandList& commands() const noexcept;
+
+			/// <summary>
+			/// Copies the UI draw data so the UI context can start the next frame.
+			/// </summary>
+			void captureUI(const ImDrawData& data);
+
+			/// <summary>
+			/// Clears the recorded data while keeping the allocated memory.
+			/// </summary>
+			void reset();
+
+		private:
+			Command::CommandList m_commands;
+
+			// Copy of the UI draw data, owning its draw lists
+			_Maybenull_ ImDrawData* m_ui = nullptr;
+
+			void releaseUI() noexcept;
+		};
+
+		RenderThread(const RenderThread&) = delete;
+		RenderThread(RenderThread&&) = delete;
+
+		~RenderThread();
+
+		RenderThread& operator=(const RenderThread&) = delete;
+		RenderThread& operator=(RenderThread&&) = delete;
+
+		_NODISCARD static RenderThread& instance() noexcept;
+
+		/// <summary>
+		/// Starts the render thread, moving the window context and the context queue to it.
+		/// </summary>
+		/// <remarks>Must be called from the thread currently owning the context.</remarks>
+		_Success_(return) bool start(_In_ GLFWwindow* window);
+
+		/// <summary>
+		/// Draws the last presented frame and stops the render thread, moving the window context and the context queue back to the calling thread.
+		/// </summary>
+		void stop();
+
+		_NODISCARD bool running() const noexcept;
+
+		/// <summary>
+		/// Returns the frame being recorded by the main thread.
+		/// </summary>
+		_NODISCARD Frame& frame() noexcept;
+
+		/// <summary>
+		/// Hands the recorded frame to the render thread.
+		/// </summary>
+		/// <remarks>
+		/// Waits for the previous frame to be drawn, the returned <see cref="frame"/> is then free to record into.
+		/// Frames with callback commands are not pipelined, the call also waits for them to be drawn.
+		/// </remarks>
+		void present();
+
+		/// <summary>
+		/// Waits for the frame handed to the render thread to be drawn, so the objects it references can be destroyed.
+		/// </summary>
+		void waitIdle();
+
+	private:
+		RenderThread() = default;
+
+		static RenderThread m_inst;
+
+		std::thread m_thread;
+		_Maybenull_ GLFWwindow* m_window = nullptr;
+
+		Frame m_frames[2];
+
+		// Index of the frame recorded by the main thread, the other is drawn by the render thread
+		uint8_t m_recordIndex = 0;
+
+		std::mutex m_mutex;
+		std::condition_variable m_condition;
+
+		// A presented frame is waiting to be drawn or being drawn
+		bool m_busy = false;
+
+		std::atomic<bool> m_running = false;
+
+		void loop();
+
+		/// <summary>
+		/// Submits the commands and UI of a frame and swaps the window buffers.
+		/// </summary>
+		void draw(const Frame& frame) const;
+	};
+}
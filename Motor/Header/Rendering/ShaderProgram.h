@@ -1,10 +1,19 @@
 #pragma once
 
+#include "ShaderReflection.h"
+#include "UniformHandle.h"
+
+#include <mutex>
 #include <sal.h>
+#include <string_view>
+#include <type_traits>
 #include <variant>
 #include <vector>
 
 #include <LibMath/MathArray/MathArray.h>
+#include <LibMath/Matrix.h>
+#include <LibMath/Point/Cartesian.h>
+#include <LibMath/Vector/Vector3.h>
 
 namespace KaputEngine
 {
@@ -18,6 +27,9 @@ namespace KaputEngine
 
 namespace KaputEngine::Rendering
 {
+	class Color;
+	struct MaterialLayer;
+
 	template <typename T>
 	class Sampler;
 
@@ -26,6 +38,26 @@ namespace KaputEngine::Rendering
 
 	using UniformReference = std::variant<int, const char*>;
 
+	/// <summary>
+	/// Uniforms set by the engine while drawing, resolved when the program is linked.
+	/// </summary>
+	/// <remarks>Handles of uniforms a program does not declare are invalid and ignored when set.</remarks>
+	struct EngineUniforms
+	{
+		UniformHandle<LibMath::Matrix4f> model;
+		UniformHandle<LibMath::Cartesian3f> worldPosition;
+		UniformHandle<MaterialLayer> material;
+		UniformHandle<int> instanceOffset;
+
+		// Mapping of quantized vertex positions, see Mesh::quantization
+		UniformHandle<LibMath::Vector3f> positionScale;
+		UniformHandle<LibMath::Cartesian3f> positionOffset;
+
+		// Picking and collider shapes
+		UniformHandle<LibMath::Matrix4f> mvp;
+		UniformHandle<Color> pickingColor;
+	};
+
 	class ShaderProgram
 	{
 	public:
@@ -49,6 +81,30 @@ namespace KaputEngine::Rendering
 		_NODISCARD unsigned int& id() noexcept;
 		_NODISCARD const unsigned int& id() const noexcept;
 
+		/// <summary>
+		/// Whether the program reads its model matrices from the instance buffer declared in Instancing.glsl.
+		/// </summary>
+		_NODISCARD bool instanced() const noexcept;
+
+		/// <summary>
+		/// Active uniforms and buffer blocks of the linked program.
+		/// </summary>
+		_NODISCARD const ShaderReflection& reflection() const noexcept;
+
+		_NODISCARD const EngineUniforms& engineUniforms() const noexcept;
+
+		/// <summary>
+		/// Resolves a uniform by name once, to be set without looking up its name again.
+		/// </summary>
+		/// <remarks>Names the program does not use are reported once.</remarks>
+		template <typename T>
+		_NODISCARD UniformHandle<T> uniform(std::string_view name) const;
+
+		/// <summary>
+		/// Reports a uniform missing from the program, only the first time it is reported so draws do not flood the output.
+		/// </summary>
+		void reportMissingUniform(std::string_view name) const;
+
 #pragma region Uniforms
 #pragma region Overloads
 #define SHADER_UNIFORM_SIG(...) \
@@ -92,6 +148,9 @@ SHADER_UNIFORM_SIG_MATRIX(type, 4, 4)
 		template <typename T>
 		void setUniform(const UniformReference& uniform, const T& value) const;
 
+		template <typename T>
+		void setUniform(UniformHandle<T> uniform, const std::type_identity_t<T>& value) const;
+
 		template <typename T>
 		void setUniform(const UniformReference& uniform, _In_reads_(count) const Sampler<T>* values, int count) const;
 
@@ -112,8 +171,23 @@ SHADER_UNIFORM_SIG_MATRIX(type, 4, 4)
 		ShaderList m_shaders;
 		Resource::ShaderProgramResource* m_resource = nullptr;
 
+		ShaderReflection m_reflection;
+		EngineUniforms m_engineUniforms;
+
+		// Missing uniform names already reported, from any thread drawing with the program
+		mutable std::vector<std::string> m_missingUniforms;
+		mutable std::mutex m_missingMutex;
+
 		_NODISCARD int getLocation(const UniformReference& uniform) const;
 
+		void resolveEngineUniforms();
+
+		/// <summary>
+		/// Records a missing uniform.
+		/// </summary>
+		/// <returns>True the first time the name is missing</returns>
+		_NODISCARD bool markMissing(std::string_view name) const;
+
 		void investigateUniform(const UniformReference& uniform, const std::string& target) const;
 	};
 }
@@ -13,6 +13,25 @@ namespace KaputEngine::Rendering
 		setUniform(uniform, &value, 1);
 	}
 
+	template <typename T>
+	void ShaderProgram::setUniform(const UniformHandle<T> uniform, const std::type_identity_t<T>& value) const
+	{
+		if (uniform)
+			setUniform(uniform.location(), value);
+	}
+
+	template <typename T>
+	UniformHandle<T> ShaderProgram::uniform(const std::string_view name) const
+	{
+		const int location = m_reflection.location(name);
+
+		// Programs left invalid have nothing to report
+		if (location == -1 && m_id)
+			reportMissingUniform(name);
+
+		return UniformHandle<T>(location);
+	}
+
 	template <typename T>
 	void ShaderProgram::setUniform(
 		const UniformReference& uniform, _In_reads_(count) const Sampler<T>* const values, const int count) const
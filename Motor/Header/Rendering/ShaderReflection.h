@@ -0,0 +1,77 @@
+#pragma once
+
+#include <sal.h>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace KaputEngine::Rendering
+{
+	/// <summary>
+	/// Active uniform outside of any uniform block.
+	/// </summary>
+	struct ShaderUniformInfo
+	{
+		// Name without the [0] suffix of arrays
+		std::string name;
+		int location;
+
+		// GL type enum
+		unsigned int type;
+		int arraySize;
+	};
+
+	/// <summary>
+	/// Active uniform or shader storage block.
+	/// </summary>
+	struct ShaderBlockInfo
+	{
+		std::string name;
+		int binding;
+		int dataSize;
+	};
+
+	/// <summary>
+	/// Uniforms and buffer blocks of a linked program, enumerated once so lookups need no context.
+	/// </summary>
+	class ShaderReflection
+	{
+	public:
+		ShaderReflection() = default;
+		ShaderReflection(const ShaderReflection&) = default;
+		ShaderReflection(ShaderReflection&&) noexcept = default;
+
+		ShaderReflection& operator=(const ShaderReflection&) = default;
+		ShaderReflection& operator=(ShaderReflection&&) noexcept = default;
+
+		/// <summary>
+		/// Enumerates the active resources of a linked program.
+		/// </summary>
+		/// <remarks>Must be called from the thread owning the rendering context.</remarks>
+		void reflect(unsigned int program);
+
+		void clear() noexcept;
+
+		/// <summary>
+		/// Location of a uniform by name, -1 if the program does not use it.
+		/// </summary>
+		_NODISCARD int location(std::string_view name) const noexcept;
+
+		_NODISCARD _Ret_maybenull_ const ShaderUniformInfo* uniform(std::string_view name) const noexcept;
+		_NODISCARD _Ret_maybenull_ const ShaderBlockInfo* uniformBlock(std::string_view name) const noexcept;
+		_NODISCARD _Ret_maybenull_ const ShaderBlockInfo* storageBlock(std::string_view name) const noexcept;
+
+		/// <summary>
+		/// Uniforms sorted by name.
+		/// </summary>
+		_NODISCARD const std::vector<ShaderUniformInfo>& uniforms() const noexcept;
+
+		_NODISCARD const std::vector<ShaderBlockInfo>& uniformBlocks() const noexcept;
+		_NODISCARD const std::vector<ShaderBlockInfo>& storageBlocks() const noexcept;
+
+	private:
+		std::vector<ShaderUniformInfo> m_uniforms;
+		std::vector<ShaderBlockInfo> m_uniformBlocks;
+		std::vector<ShaderBlockInfo> m_storageBlocks;
+	};
+}
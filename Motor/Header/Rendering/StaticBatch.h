@@ -0,0 +1,104 @@
+#pragma once
+
+#include "IWorldRenderable.h"
+
+#include "Rendering/Culling/OcclusionBuffer.h"
+#include "Rendering/Mesh.h"
+
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace KaputEngine
+{
+	class RenderComponent;
+}
+
+namespace KaputEngine::Rendering
+{
+	class Material;
+	class ShaderProgram;
+
+	/// <summary>
+	/// Meshes of static game objects sharing a program and materials, merged in world space and drawn at once.
+	/// </summary>
+	/// <remarks>
+	/// Built when the scene starts. The merged geometry is drawn with an identity model matrix,
+	/// so batches have no transform to update and their bounds never change, even as components are removed.
+	/// </remarks>
+	class StaticBatch final : public IWorldRenderable
+	{
+	public:
+		/// <summary>
+		/// Size of the world grid cells batches are split by, so each batch can still be culled on its own.
+		/// </summary>
+		static constexpr float CellSize = 32.f;
+
+		StaticBatch(std::shared_ptr<const ShaderProgram> program, std::shared_ptr<const Material> material,
+			_In_opt_ const Material* fallbackMaterial);
+
+		StaticBatch(const StaticBatch&) = delete;
+		StaticBatch(StaticBatch&&) = delete;
+
+		StaticBatch& operator=(const StaticBatch&) = delete;
+		StaticBatch& operator=(StaticBatch&&) = delete;
+
+		/// <summary>
+		/// Merges the meshes of render components by program, materials and grid cell, then stops the components drawing themselves.
+		/// </summary>
+		/// <remarks>
+		/// Components without a mesh or program are left drawing themselves, as are those whose meshes were released by an earlier build.
+		/// The source geometry of the merged meshes is released, keeping the occluder geometry.
+		/// </remarks>
+		_NODISCARD static std::vector<std::unique_ptr<StaticBatch>> build(std::span<RenderComponent* const> components);
+
+		_NODISCARD _Success_(return) bool getWorldBounds(_Out_ Culling::Bounds& out) const override;
+
+		_Success_(return) bool queue(DrawQueue& queue, const Camera& camera) override;
+
+		/// <summary>
+		/// Adds the source meshes of the occluder components, rasterized with their own levels of detail rather than the merged geometry.
+		/// </summary>
+		void appendOccluders(std::vector<Culling::Occluder>& out) const override;
+
+		/// <summary>
+		/// Stops drawing the meshes of a component, turning their triangles in the merged geometry into degenerate ones.
+		/// </summary>
+		/// <returns>Whether the component had meshes in the batch</returns>
+		bool remove(const RenderComponent& component);
+
+		_NODISCARD const Mesh& mesh() const noexcept;
+
+		/// <summary>
+		/// Render component meshes still drawn by the batch.
+		/// </summary>
+		_NODISCARD size_t pieceCount() const noexcept;
+
+	private:
+		/// <summary>
+		/// Mesh of a render component merged into the batch, with the world matrix it was merged with.
+		/// </summary>
+		struct Piece
+		{
+			const RenderComponent* component;
+			const Mesh* mesh;
+			LibMath::Matrix4f model;
+
+			// Range of the merged indices
+			uint32_t firstIndex = 0;
+			uint32_t indexCount = 0;
+		};
+
+		std::shared_ptr<const ShaderProgram> m_program;
+		std::shared_ptr<const Material> m_material;
+		_Maybenull_ const Material* m_fallbackMaterial;
+
+		// Keep the resources owning the fallback material alive
+		std::vector<std::shared_ptr<const Mesh>> m_sources;
+
+		// Point into the source meshes
+		std::vector<Piece> m_pieces;
+
+		Mesh m_mesh;
+	};
+}
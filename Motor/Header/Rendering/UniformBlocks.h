@@ -0,0 +1,102 @@
+#pragma once
+
+#include "Rendering/Buffer/RingBuffer.h"
+
+#include <LibMath/Matrix.h>
+#include <LibMath/Point/Cartesian.h>
+
+#include <cstddef>
+
+namespace KaputEngine
+{
+	class Camera;
+}
+
+namespace KaputEngine::Rendering
+{
+	namespace Command
+	{
+		class CommandList;
+	}
+
+	/// <summary>
+	/// Mirror of the std140 FrameBlock of Dependency/Frame.glsl.
+	/// </summary>
+	struct FrameData
+	{
+		static constexpr unsigned int Binding = 0;
+
+		// Seconds since the start of the application
+		float time = 0.f;
+		float deltaTime = 0.f;
+
+		// Size of the primary window in pixels
+		alignas(sizeof(float[2])) float resolution[2] { };
+
+		_NODISCARD bool operator==(const FrameData& other) const noexcept = default;
+	};
+
+	static_assert(offsetof(FrameData, time) == 0);
+	static_assert(offsetof(FrameData, deltaTime) == 4);
+	static_assert(offsetof(FrameData, resolution) == 8);
+	static_assert(sizeof(FrameData) == 16);
+
+	/// <summary>
+	/// Mirror of the std140 ViewBlock of Dependency/Camera.glsl.
+	/// </summary>
+	struct ViewData
+	{
+		static constexpr unsigned int Binding = 1;
+
+		LibMath::Matrix4f view;
+		LibMath::Matrix4f projection;
+		LibMath::Matrix4f viewProjection;
+
+		alignas(sizeof(float[4])) LibMath::Cartesian3f position;
+	};
+
+	static_assert(offsetof(ViewData, view) == 0);
+	static_assert(offsetof(ViewData, projection) == 64);
+	static_assert(offsetof(ViewData, viewProjection) == 128);
+	static_assert(offsetof(ViewData, position) == 192);
+	static_assert(sizeof(ViewData) == 208);
+
+	/// <summary>
+	/// Ring buffers of the frame and view blocks shared by every program.
+	/// </summary>
+	/// <remarks>The frame block is uploaded once per frame and the view block once per recorded camera, instead of setting camera uniforms on every draw.</remarks>
+	class UniformBlocks
+	{
+	public:
+		UniformBlocks() = default;
+		UniformBlocks(const UniformBlocks&) = delete;
+		UniformBlocks(UniformBlocks&&) = delete;
+
+		UniformBlocks& operator=(const UniformBlocks&) = delete;
+		UniformBlocks& operator=(UniformBlocks&&) = delete;
+
+		/// <summary>
+		/// Creates the buffers at the bindings of their blocks.
+		/// </summary>
+		void create();
+		void destroy();
+
+		/// <summary>
+		/// Records the upload of the view data of a camera, of the frame data if it changed since the last call, and binds both blocks.
+		/// </summary>
+		void record(Command::CommandList& list, const Camera& camera);
+
+		_NODISCARD const FrameData& frame() const noexcept;
+		_NODISCARD const ViewData& view() const noexcept;
+
+	private:
+		Buffer::RingBuffer m_frameBuffer;
+		Buffer::RingBuffer m_viewBuffer;
+
+		// Last uploaded data
+		FrameData m_frame;
+		ViewData m_view;
+
+		bool m_frameUploaded = false;
+	};
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+namespace KaputEngine::Rendering
+{
+	/// <summary>
+	/// Location of a uniform resolved once from the reflection of a program, typed by the value it is set with.
+	/// </summary>
+	/// <remarks>Struct values such as cameras and materials are referenced by the location of their first primitive member.</remarks>
+	template <typename T>
+	class UniformHandle
+	{
+	public:
+		using Type = T;
+
+		UniformHandle() noexcept = default;
+		explicit UniformHandle(int location) noexcept;
+
+		_NODISCARD int location() const noexcept;
+
+		/// <summary>
+		/// Whether the uniform is declared and used by the program. Setting an invalid handle does nothing.
+		/// </summary>
+		_NODISCARD bool valid() const noexcept;
+		_NODISCARD explicit operator bool() const noexcept;
+
+	private:
+		int m_location = -1;
+	};
+}
+
+#include "UniformHandle.hpp"
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "UniformHandle.h"
+
+namespace KaputEngine::Rendering
+{
+	template <typename T>
+	UniformHandle<T>::UniformHandle(const int location) noexcept : m_location(location) { }
+
+	template <typename T>
+	int UniformHandle<T>::location() const noexcept
+	{
+		return m_location;
+	}
+
+	template <typename T>
+	bool UniformHandle<T>::valid() const noexcept
+	{
+		return m_location != -1;
+	}
+
+	template <typename T>
+	UniformHandle<T>::operator bool() const noexcept
+	{
+		return valid();
+	}
+}
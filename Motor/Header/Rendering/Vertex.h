@@ -5,8 +5,21 @@
 #include <LibMath/Point/Cartesian.h>
 #include <LibMath/Vector/Vector3.h>
 
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
 namespace KaputEngine::Rendering
 {
+	namespace Buffer
+	{
+		class VertexAttributeBuffer;
+	}
+
+	/// <summary>
+	/// Vertex as built on the CPU from imported or generated geometry. Packed in a compact format before upload.
+	/// </summary>
 	struct Vertex
 	{
 		Color albedo;
@@ -16,4 +29,113 @@ namespace KaputEngine::Rendering
 		LibMath::Vector3f tangent;
 		LibMath::Vector3f bitangent;
 	};
+
+	/// <summary>
+	/// Layout of the vertices uploaded to the GPU.
+	/// </summary>
+	/// <remarks>
+	/// Both formats store half precision UVs, an octahedral normal and an octahedral tangent with the sign of the bitangent,
+	/// which is rebuilt in Vertex.glsl. Vertex colors are only uploaded when the source has them.
+	/// </remarks>
+	enum class eVertexFormat : uint8_t
+	{
+		/// <summary>
+		/// Float positions, 24 bytes per vertex.
+		/// </summary>
+		COMPACT,
+
+		/// <summary>
+		/// 16 bit positions quantized to the bounds of the mesh, 20 bytes per vertex.
+		/// </summary>
+		QUANTIZED
+	};
+
+	/// <summary>
+	/// Half precision float stored as its bits, read as a float by vertex attributes.
+	/// </summary>
+	struct HalfFloat
+	{
+		uint16_t bits = 0;
+
+		HalfFloat() = default;
+		explicit HalfFloat(float value) noexcept;
+	};
+
+	struct CompactVertex
+	{
+		LibMath::Cartesian3f position;
+		HalfFloat textureUV[2];
+
+		// Normalized, octahedral encoding
+		int16_t normal[2];
+
+		// Normalized, octahedral encoding in xy and sign of the bitangent in z
+		int8_t tangent[4];
+	};
+
+	struct QuantizedVertex
+	{
+		// Normalized over the bounds of the mesh, w unused
+		uint16_t position[4];
+
+		HalfFloat textureUV[2];
+		int16_t normal[2];
+		int8_t tangent[4];
+	};
+
+	/// <summary>
+	/// Vertex color stored after the vertices when the source has colors.
+	/// </summary>
+	struct VertexColor
+	{
+		// Normalized
+		uint8_t albedo[4];
+	};
+
+	static_assert(sizeof(HalfFloat) == 2);
+	static_assert(sizeof(CompactVertex) == 24);
+	static_assert(sizeof(QuantizedVertex) == 20);
+
+	/// <summary>
+	/// Maps the positions read by the vertex shader back to mesh space, as position * scale + offset.
+	/// </summary>
+	struct VertexQuantization
+	{
+		LibMath::Vector3f scale { 1.f, 1.f, 1.f };
+		LibMath::Cartesian3f offset { 0.f, 0.f, 0.f };
+
+		_NODISCARD bool operator==(const VertexQuantization& other) const noexcept;
+	};
+
+	/// <summary>
+	/// Vertices packed in one of the compact formats, ready to be uploaded to a vertex buffer.
+	/// </summary>
+	class PackedVertices
+	{
+	public:
+		/// <param name="colors">Whether to keep the albedo of the vertices</param>
+		_NODISCARD static PackedVertices pack(std::span<const Vertex> vertices, eVertexFormat format, bool colors);
+
+		/// <summary>
+		/// Describes the layout to a vertex array. The vertex buffer holding the data must be bound.
+		/// </summary>
+		void defineAttributes(Buffer::VertexAttributeBuffer& attributes) const;
+
+		_NODISCARD const std::byte* data() const noexcept;
+		_NODISCARD size_t size() const noexcept;
+
+		_NODISCARD eVertexFormat format() const noexcept;
+		_NODISCARD const VertexQuantization& quantization() const noexcept;
+		_NODISCARD bool hasColors() const noexcept;
+
+	private:
+		std::vector<std::byte> m_data;
+
+		// Start of the vertex colors in the data
+		size_t m_colorOffset = 0;
+
+		VertexQuantization m_quantization;
+		eVertexFormat m_format = eVertexFormat::COMPACT;
+		bool m_colors = false;
+	};
 }
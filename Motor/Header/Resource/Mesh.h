@@ -30,6 +30,12 @@ namespace KaputEngine::Resource
 
 		std::filesystem::path m_modelPath;
 
+		// Optional VertexFormat value of the asset, either Compact or Quantized
+		Rendering::eVertexFormat m_vertexFormat = Rendering::eVertexFormat::COMPACT;
+
+		// Optional Lods value of the asset, levels of detail generated including the full mesh, 1 to disable
+		unsigned int m_lods = Rendering::Mesh::MaxLods;
+
 		std::vector<Rendering::Mesh> m_meshes;
 		std::vector<Rendering::Material> m_materials;
 
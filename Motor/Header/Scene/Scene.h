@@ -2,17 +2,29 @@
 
 #include "IWorldRenderable.h"
 
+#include "Memory/SlabArena.h"
 #include "Physics/PhysicHandler.h"
 #include "Rendering/Color.h"
+#include "Rendering/Command/CommandList.h"
+#include "Rendering/Culling/Frustum.h"
+#include "Rendering/Culling/OcclusionBuffer.h"
+#include "Rendering/DrawQueue.h"
 #include "Rendering/Lighting/DirectionalLightBuffer.h"
 #include "Rendering/Lighting/PointLightBuffer.h"
 #include "Rendering/ShaderProgram.h"
+#include "Rendering/StaticBatch.h"
+#include "Rendering/UniformBlocks.h"
 #include "Root.h"
+#include "Spatial/SpatialIndex.h"
 #include "Text/Xml/Context.h"
 #include "Text/Xml/Node.h"
+#include "Transform/Hierarchy.h"
+#include "Utils/HandlePool.h"
+#include "Utils/Pointer.h"
 #include "Utils/RemoveVector.h"
 
 #include <filesystem>
+#include <unordered_map>
 
 namespace KaputEngine
 {
@@ -25,6 +37,8 @@ namespace KaputEngine
         private Text::Xml::IXmlPolymorphicSerializer
     {
         friend ObjectBase;
+        friend GameObject;
+        friend Component;
         friend class RenderComponent;
 
     public:
@@ -32,6 +46,7 @@ namespace KaputEngine
         bool save(const std::filesystem::path& path, bool indent) const;
 
         Scene();
+        ~Scene();
 
         void start();
         _NODISCARD bool started() const noexcept;
@@ -39,6 +54,41 @@ namespace KaputEngine
         _NODISCARD SceneRoot& sceneRoot() noexcept;
         _NODISCARD const SceneRoot& sceneRoot() const noexcept;
 
+        /// <summary>
+        /// Finds a game object or component of the scene in constant time.
+        /// </summary>
+        /// <returns>Null if no live object of the scene has the Id. The scene root is not indexed.</returns>
+        _NODISCARD _Ret_maybenull_ ObjectBase* find(const Id& id) const;
+
+        _NODISCARD _Ret_maybenull_ std::shared_ptr<GameObject> findObject(const Id& id) const;
+        _NODISCARD exclusive_weak_ptr<Component> findComponent(const Id& id) const;
+
+        /// <summary>
+        /// Resolves a handle to a game object or component of the scene in constant time.
+        /// </summary>
+        /// <returns>Null if the handle is stale or belongs to another scene</returns>
+        _NODISCARD _Ret_maybenull_ GameObject* get(Handle<GameObject> handle) const noexcept;
+        _NODISCARD _Ret_maybenull_ Component* get(Handle<Component> handle) const noexcept;
+
+        _NODISCARD bool valid(Handle<GameObject> handle) const noexcept;
+        _NODISCARD bool valid(Handle<Component> handle) const noexcept;
+
+        _NODISCARD const HandlePool<GameObject>& objects() const noexcept;
+        _NODISCARD const HandlePool<Component>& components() const noexcept;
+
+        /// <summary>
+        /// Memory used by the game objects and components allocated for the scene.
+        /// </summary>
+        _NODISCARD Memory::SlabStats memoryStats() const;
+
+        _NODISCARD TransformHierarchy& transforms() noexcept;
+        _NODISCARD const TransformHierarchy& transforms() const noexcept;
+
+        /// <summary>
+        /// Bounding volume hierarchy of the game objects for spatial queries.
+        /// </summary>
+        _NODISCARD const SpatialIndex& spatialIndex() const noexcept;
+
         _NODISCARD std::weak_ptr<Camera> getPrimaryCamera() noexcept;
         _NODISCARD std::weak_ptr<const Camera> getPrimaryCamera() const noexcept;
 
@@ -56,8 +106,40 @@ namespace KaputEngine
         void update(double deltaTime) override;
 
         void render();
+
+        /// <summary>
+        /// Records the frame into the scene command list and submits it in a single context round trip.
+        /// </summary>
         void render(const Camera& camera) override;
 
+        /// <summary>
+        /// Records the clear and render commands of all renderables into a list.
+        /// </summary>
+        void record(Rendering::Command::CommandList& list, const Camera& camera) override;
+
+        _NODISCARD const Rendering::Command::CommandList& commandList() const noexcept;
+
+        /// <summary>
+        /// Number of renderables recorded and skipped by frustum and occlusion culling in the last recorded frame.
+        /// </summary>
+        _NODISCARD const Rendering::Culling::CullingStats& cullingStats() const noexcept;
+
+        /// <summary>
+        /// Draw calls and state changes of the sorted draws in the last recorded frame.
+        /// </summary>
+        _NODISCARD const Rendering::DrawStats& drawStats() const noexcept;
+
+        /// <summary>
+        /// Geometry of the static game objects merged when the scene started.
+        /// </summary>
+        _NODISCARD const std::vector<std::unique_ptr<Rendering::StaticBatch>>& staticBatches() const noexcept;
+
+        /// <summary>
+        /// Records the scene from the primary camera into the frame recorded for the render thread.
+        /// </summary>
+        /// <remarks>Called at the end of <see cref="update"/> when the render thread is running.</remarks>
+        void snapshot();
+
         _NODISCARD Rendering::Color& clearColor() noexcept;
 
         _NODISCARD const Rendering::Color& clearColor() const noexcept;
@@ -82,7 +164,40 @@ namespace KaputEngine
 
         _NODISCARD bool parseTags(_In_ const Text::Xml::XmlNode::Map& map);
 
+        /// <summary>
+        /// Adds an object entering the scene to the Id index and assigns its handle.
+        /// </summary>
+        void index(GameObject& object);
+        void index(Component& component);
+
+        void unindex(GameObject& object);
+        void unindex(Component& component);
+
+        /// <summary>
+        /// Merges the render components of the static game objects into batches drawn in their place.
+        /// </summary>
+        void buildStaticBatches();
+
         bool m_started = false;
+
+        // Backs the objects created while loading or updating the scene, released in bulk with the last of them
+        std::shared_ptr<Memory::SlabArena> m_arena;
+
+        // Maintained as objects register to and unregister from the scene
+        // Declared before the root so objects leaving the scene on destruction can still unregister
+        std::unordered_map<Id, std::weak_ptr<GameObject>> m_objectIndex;
+        std::unordered_map<Id, exclusive_weak_ptr<Component>> m_componentIndex;
+
+        HandlePool<GameObject> m_objectPool;
+        HandlePool<Component> m_componentPool;
+
+        TransformHierarchy m_transforms;
+        SpatialIndex m_spatialIndex;
+
+        // Declared before the root so components leaving the scene on destruction can leave their batches,
+        // and before the render queue holding them
+        std::vector<std::unique_ptr<Rendering::StaticBatch>> m_staticBatches;
+
         SceneRoot m_sceneRoot;
 
         std::weak_ptr<Camera> m_camera;
@@ -95,7 +210,24 @@ namespace KaputEngine
         PhysicHandler m_physics;
         Rendering::Color m_clearColor;
 
+        // Reused every frame to keep its allocations
+        Rendering::Command::CommandList m_commandList;
+
+        Rendering::Culling::CullingStats m_cullingStats;
+
+        // Reused every frame to keep their allocations
+        Rendering::Culling::OcclusionBuffer m_occlusionBuffer;
+        std::vector<Rendering::Culling::Occluder> m_occluders;
+
+        // Renderables inside the view with their bounds, tested once the occluders are rasterized
+        std::vector<std::pair<IWorldRenderable*, Rendering::Culling::Bounds>> m_visible;
+
+        // Reused every frame to keep its allocations
+        Rendering::DrawQueue m_drawQueue;
+
         Rendering::Lighting::DirectionalLightBuffer m_directionalLightBuffer;
         Rendering::Lighting::PointLightBuffer m_pointLightBuffer;
+
+        Rendering::UniformBlocks m_uniformBlocks;
     };
 }
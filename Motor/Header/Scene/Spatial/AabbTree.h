@@ -0,0 +1,153 @@
+#pragma once
+
+#include "Ray.h"
+
+#include "Rendering/Culling/Frustum.h"
+#include "Utils/HandlePool.h"
+
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace KaputEngine
+{
+	class GameObject;
+
+	/// <summary>
+	/// Dynamic bounding volume hierarchy of game objects.
+	/// </summary>
+	/// <remarks>
+	/// Leaves store boxes fattened by a margin so small moves do not touch the tree. Moves leaving the fat box reinsert the leaf
+	/// along the cheapest surface area path, and tree rotations on the way back up keep the height logarithmic.
+	/// </remarks>
+	class AabbTree
+	{
+	public:
+		using Proxy = uint32_t;
+
+		static constexpr Proxy NullNode = std::numeric_limits<uint32_t>::max();
+
+		/// <summary>
+		/// Default margin added on every side of the leaf boxes.
+		/// </summary>
+		static constexpr float DefaultMargin = .1f;
+
+		AabbTree() = default;
+		AabbTree(const AabbTree&) = delete;
+		AabbTree(AabbTree&&) = delete;
+
+		AabbTree& operator=(const AabbTree&) = delete;
+		AabbTree& operator=(AabbTree&&) = delete;
+
+		_NODISCARD Proxy insert(const Rendering::Culling::BoundingBox& box, Handle<GameObject> object);
+
+		void erase(Proxy proxy);
+
+		/// <summary>
+		/// Updates the box of a leaf.
+		/// </summary>
+		/// <returns>Whether the leaf was reinserted, false if the box still fits in the fat box</returns>
+		bool move(Proxy proxy, const Rendering::Culling::BoundingBox& box);
+
+		void clear() noexcept;
+
+		_NODISCARD Handle<GameObject> object(Proxy proxy) const noexcept;
+
+		/// <summary>
+		/// Fattened box of a leaf.
+		/// </summary>
+		_NODISCARD const Rendering::Culling::BoundingBox& box(Proxy proxy) const noexcept;
+
+		/// <summary>
+		/// Calls a function with each object whose fat box overlaps the box, until it returns false.
+		/// </summary>
+		template <std::invocable<Handle<GameObject>> Func>
+		void query(const Rendering::Culling::BoundingBox& box, Func&& func) const;
+
+		template <std::invocable<Handle<GameObject>> Func>
+		void query(const Rendering::Culling::BoundingSphere& sphere, Func&& func) const;
+
+		template <std::invocable<Handle<GameObject>> Func>
+		void query(const Rendering::Culling::Frustum& frustum, Func&& func) const;
+
+		/// <summary>
+		/// Calls a function with each object whose fat box the ray crosses and the distance at which it enters it.
+		/// </summary>
+		/// <remarks>
+		/// The function returns the max distance for the rest of the cast: the hit distance to only look for closer hits,
+		/// the current max distance to get all hits, or 0 to stop.
+		/// </remarks>
+		template <std::invocable<Handle<GameObject>, float> Func>
+		void raycast(const Ray& ray, Func&& func) const;
+
+		_NODISCARD float margin() const noexcept;
+		void setMargin(float margin) noexcept;
+
+		/// <summary>
+		/// Number of objects in the tree.
+		/// </summary>
+		_NODISCARD size_t size() const noexcept;
+
+		/// <summary>
+		/// Height of the root, 0 for a single leaf.
+		/// </summary>
+		_NODISCARD int32_t height() const noexcept;
+
+	private:
+		struct Node
+		{
+			Rendering::Culling::BoundingBox box;
+			Handle<GameObject> object;
+
+			// Next free node while in the free list
+			Proxy parent = NullNode;
+
+			Proxy child1 = NullNode;
+			Proxy child2 = NullNode;
+
+			// Leaves are at 0 and free nodes at -1
+			int32_t height = -1;
+
+			_NODISCARD bool isLeaf() const noexcept
+			{
+				return child1 == NullNode;
+			}
+		};
+
+		/// <summary>
+		/// Depth-first traversal entering the nodes passing a test.
+		/// </summary>
+		template <typename Test, typename Func>
+		void traverse(Test&& test, Func&& func) const;
+
+		_NODISCARD Proxy allocateNode();
+		void freeNode(Proxy node) noexcept;
+
+		void insertLeaf(Proxy leaf);
+		void removeLeaf(Proxy leaf);
+
+		/// <summary>
+		/// Rotates a node whose children heights differ by more than one.
+		/// </summary>
+		/// <returns>The node now in its place</returns>
+		_NODISCARD Proxy balance(Proxy node) noexcept;
+
+		/// <summary>
+		/// Recomputes the boxes and heights from a node up to the root, balancing along the way.
+		/// </summary>
+		void refit(Proxy node) noexcept;
+
+		_NODISCARD Rendering::Culling::BoundingBox fatten(const Rendering::Culling::BoundingBox& box) const noexcept;
+
+		std::vector<Node> m_nodes;
+
+		Proxy m_root = NullNode;
+		Proxy m_freeList = NullNode;
+
+		size_t m_leafCount = 0;
+		float m_margin = DefaultMargin;
+	};
+}
+
+#include "AabbTree.hpp"
@@ -0,0 +1,127 @@
+#pragma once
+
+#include "AabbTree.h"
+
+#include <algorithm>
+#include <array>
+
+namespace KaputEngine
+{
+	namespace Detail
+	{
+		/// <summary>
+		/// Traversal stack kept on the call stack for balanced trees, spilling to the heap past its capacity.
+		/// </summary>
+		class TraversalStack
+		{
+		public:
+			void push(const AabbTree::Proxy node)
+			{
+				if (m_count < m_inline.size())
+					m_inline[m_count] = node;
+				else
+					m_spill.push_back(node);
+
+				++m_count;
+			}
+
+			_NODISCARD AabbTree::Proxy pop() noexcept
+			{
+				--m_count;
+
+				if (m_count < m_inline.size())
+					return m_inline[m_count];
+
+				const AabbTree::Proxy node = m_spill.back();
+				m_spill.pop_back();
+
+				return node;
+			}
+
+			_NODISCARD bool empty() const noexcept
+			{
+				return m_count == 0;
+			}
+
+		private:
+			std::array<AabbTree::Proxy, 128> m_inline;
+			std::vector<AabbTree::Proxy> m_spill;
+			size_t m_count = 0;
+		};
+	}
+
+	template <typename Test, typename Func>
+	void AabbTree::traverse(Test&& test, Func&& func) const
+	{
+		if (m_root == NullNode)
+			return;
+
+		Detail::TraversalStack stack;
+		stack.push(m_root);
+
+		while (!stack.empty())
+		{
+			const Node& node = m_nodes[stack.pop()];
+
+			if (!test(node.box))
+				continue;
+
+			if (node.isLeaf())
+			{
+				if (!func(node.object))
+					return;
+			}
+			else
+			{
+				stack.push(node.child1);
+				stack.push(node.child2);
+			}
+		}
+	}
+
+	template <std::invocable<Handle<GameObject>> Func>
+	void AabbTree::query(const Rendering::Culling::BoundingBox& box, Func&& func) const
+	{
+		traverse([&box](const Rendering::Culling::BoundingBox& nodeBox)
+		{
+			return nodeBox.intersects(box);
+		}, std::forward<Func>(func));
+	}
+
+	template <std::invocable<Handle<GameObject>> Func>
+	void AabbTree::query(const Rendering::Culling::BoundingSphere& sphere, Func&& func) const
+	{
+		traverse([&sphere](const Rendering::Culling::BoundingBox& nodeBox)
+		{
+			return nodeBox.intersects(sphere);
+		}, std::forward<Func>(func));
+	}
+
+	template <std::invocable<Handle<GameObject>> Func>
+	void AabbTree::query(const Rendering::Culling::Frustum& frustum, Func&& func) const
+	{
+		traverse([&frustum](const Rendering::Culling::BoundingBox& nodeBox)
+		{
+			return frustum.intersects(nodeBox);
+		}, std::forward<Func>(func));
+	}
+
+	template <std::invocable<Handle<GameObject>, float> Func>
+	void AabbTree::raycast(const Ray& ray, Func&& func) const
+	{
+		const RayCast cast(ray);
+		float maxDistance = ray.maxDistance;
+		float distance = 0.f;
+
+		traverse([&](const Rendering::Culling::BoundingBox& nodeBox)
+		{
+			return cast.intersects(nodeBox, maxDistance, distance);
+		},
+		[&](const Handle<GameObject> object) -> bool
+		{
+			// The distance of the leaf is the last one computed by the test
+			maxDistance = std::min(maxDistance, static_cast<float>(func(object, distance)));
+			return maxDistance > 0.f;
+		});
+	}
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "Rendering/Culling/Bounds.h"
+
+#include <LibMath/Point/Cartesian.h>
+#include <LibMath/Vector/Vector3.h>
+
+#include <limits>
+
+namespace KaputEngine
+{
+	struct Ray
+	{
+		LibMath::Cartesian3f origin;
+
+		/// <summary>
+		/// Direction of the ray, distances being measured in multiples of its length.
+		/// </summary>
+		LibMath::Vector3f direction;
+
+		float maxDistance = std::numeric_limits<float>::infinity();
+	};
+
+	/// <summary>
+	/// Ray prepared for repeated box tests.
+	/// </summary>
+	class RayCast
+	{
+	public:
+		explicit RayCast(const Ray& ray) noexcept;
+
+		_NODISCARD const Ray& ray() const noexcept;
+
+		/// <summary>
+		/// Slab test of the ray against a box.
+		/// </summary>
+		/// <param name="maxDistance">Distance past which hits are ignored</param>
+		/// <param name="distance">Distance at which the ray enters the box, 0 if the origin is inside</param>
+		_NODISCARD _Success_(return)
+		bool intersects(const Rendering::Culling::BoundingBox& box, float maxDistance, _Out_ float& distance) const noexcept;
+
+	private:
+		Ray m_ray;
+
+		// Padded to four lanes, the last lane turning into the [0, maxDistance] clamp of the test
+		alignas(16) float m_origin[4];
+		alignas(16) float m_inverseDirection[4];
+	};
+}
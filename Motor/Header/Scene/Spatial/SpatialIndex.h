@@ -0,0 +1,54 @@
+#pragma once
+
+#include "AabbTree.h"
+
+#include <vector>
+
+namespace KaputEngine
+{
+	class GameObject;
+
+	/// <summary>
+	/// Bounding volume hierarchy of the game objects of a scene, refitted as their world transforms change.
+	/// </summary>
+	/// <remarks>Objects are bounded by their render components, or by their position if they have none.</remarks>
+	class SpatialIndex
+	{
+	public:
+		SpatialIndex() = default;
+		SpatialIndex(const SpatialIndex&) = delete;
+		SpatialIndex(SpatialIndex&&) = delete;
+
+		SpatialIndex& operator=(const SpatialIndex&) = delete;
+		SpatialIndex& operator=(SpatialIndex&&) = delete;
+
+		/// <summary>
+		/// Adds an object entering the scene. Its scene handle must be assigned.
+		/// </summary>
+		void insert(const GameObject& object);
+
+		void erase(const GameObject& object);
+
+		/// <summary>
+		/// Updates the bounds of an object after its world transform or render components changed.
+		/// </summary>
+		void refit(const GameObject& object);
+
+		_NODISCARD bool contains(const GameObject& object) const noexcept;
+
+		_NODISCARD const AabbTree& tree() const noexcept;
+
+		/// <summary>
+		/// Tight world bounds of an object, as opposed to the fattened boxes of the tree.
+		/// </summary>
+		_NODISCARD static Rendering::Culling::BoundingBox computeBounds(const GameObject& object);
+
+	private:
+		_NODISCARD AabbTree::Proxy proxy(const GameObject& object) const noexcept;
+
+		// Proxy of each scene handle slot
+		std::vector<AabbTree::Proxy> m_proxies;
+
+		AabbTree m_tree;
+	};
+}
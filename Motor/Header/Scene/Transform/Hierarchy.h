@@ -0,0 +1,112 @@
+#pragma once
+
+#include "Transform.h"
+
+#include <LibMath/Matrix.h>
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace KaputEngine
+{
+	class GameObject;
+
+	/// <summary>
+	/// World transforms of the game objects of a scene stored in contiguous arrays, parents before children.
+	/// </summary>
+	/// <remarks>
+	/// Local changes only flag their node. Children notice a moved parent through its version, so a single linear pass per frame
+	/// brings every world transform and matrix up to date. Reads in between resolve the ancestors of the read object only.
+	/// </remarks>
+	class TransformHierarchy
+	{
+	public:
+		static constexpr uint32_t InvalidNode = std::numeric_limits<uint32_t>::max();
+
+		TransformHierarchy() = default;
+		TransformHierarchy(const TransformHierarchy&) = delete;
+		TransformHierarchy(TransformHierarchy&&) = delete;
+
+		TransformHierarchy& operator=(const TransformHierarchy&) = delete;
+		TransformHierarchy& operator=(TransformHierarchy&&) = delete;
+
+		/// <summary>
+		/// Adds an object entering the scene. Its scene handle must be assigned.
+		/// </summary>
+		void insert(GameObject& object);
+
+		void erase(const GameObject& object);
+
+		/// <summary>
+		/// Updates the parent of an object after it was attached within the scene.
+		/// </summary>
+		void reparent(const GameObject& object);
+
+		/// <summary>
+		/// Copies the local transform of an object and flags it for update.
+		/// </summary>
+		void markDirty(const GameObject& object);
+
+		/// <summary>
+		/// Brings every node up to date in one pass.
+		/// </summary>
+		void update();
+
+		/// <summary>
+		/// Brings an object and its ancestors up to date.
+		/// </summary>
+		void resolve(const GameObject& object);
+
+		_NODISCARD bool contains(const GameObject& object) const noexcept;
+
+		/// <summary>
+		/// Number of times the world transform of an object was recomputed, to detect changes without comparing matrices.
+		/// </summary>
+		_NODISCARD uint32_t version(const GameObject& object) const noexcept;
+
+		_NODISCARD size_t size() const noexcept;
+
+	private:
+		_NODISCARD uint32_t node(const GameObject& object) const noexcept;
+		_NODISCARD uint32_t parentNode(const GameObject& object) const noexcept;
+
+		void resolveNode(uint32_t node);
+		void refresh(uint32_t node);
+
+		/// <summary>
+		/// Drops erased nodes and restores the parent-first order.
+		/// </summary>
+		void rebuild();
+
+		void changed() noexcept;
+
+		// Node of each scene handle slot
+		std::vector<uint32_t> m_nodes;
+
+		std::vector<GameObject*> m_objects;
+		std::vector<uint32_t> m_parents;
+
+		std::vector<Transform> m_local;
+		std::vector<Transform> m_world;
+		std::vector<LibMath::Matrix4f> m_matrices;
+
+		std::vector<uint32_t> m_versions;
+
+		// Version of the parent when the node was last computed
+		std::vector<uint32_t> m_parentVersions;
+
+		std::vector<uint8_t> m_localDirty;
+
+		uint32_t m_changeCount = 0;
+
+		// No change since the last pass
+		bool m_clean = true;
+
+		// Erased nodes left in place
+		bool m_hasErased = false;
+
+		// A node was attached to a parent placed after it
+		bool m_orderBroken = false;
+	};
+}
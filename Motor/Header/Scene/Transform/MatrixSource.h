@@ -11,6 +11,8 @@ namespace KaputEngine
 
 		void updateWorldTransform() const noexcept override;
 
+		void setWorldTransform(const Transform& transform) noexcept override;
+
 	protected:
 		mutable LibMath::Matrix4f m_worldTransformMatrix;
 	};
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace KaputEngine
+{
+	/// <summary>
+	/// Weak reference to an item of a <see cref="HandlePool"/> made of a slot index and a generation.
+	/// </summary>
+	/// <remarks>
+	/// Handles are trivially copyable and detect reuse of their slot in constant time.
+	/// They only identify an item for the lifetime of the pool. Persistent references should use the Id.
+	/// </remarks>
+	/// <typeparam name="T">Item type</typeparam>
+	template <typename T>
+	struct Handle
+	{
+		static constexpr uint32_t InvalidIndex = std::numeric_limits<uint32_t>::max();
+
+		uint32_t index      = InvalidIndex;
+		uint32_t generation = 0;
+
+		/// <summary>
+		/// Packs the handle into a single integer for storage or transfer to scripts.
+		/// </summary>
+		_NODISCARD constexpr uint64_t pack() const noexcept;
+		_NODISCARD static constexpr Handle unpack(uint64_t value) noexcept;
+
+		/// <summary>
+		/// Whether the handle was ever assigned. A set handle can still be stale.
+		/// </summary>
+		_NODISCARD constexpr bool isSet() const noexcept;
+
+		_NODISCARD constexpr bool operator==(const Handle&) const noexcept = default;
+	};
+
+	/// <summary>
+	/// Non-owning dense pool of items addressed through generational handles.
+	/// </summary>
+	/// <remarks>
+	/// Items are referenced by address and must erase themselves before being destroyed.
+	/// Erasing swaps the last item in place so the dense range stays contiguous.
+	/// </remarks>
+	/// <typeparam name="T">Item type</typeparam>
+	template <typename T>
+	class HandlePool
+	{
+	public:
+		using iterator       = typename std::vector<T*>::iterator;
+		using const_iterator = typename std::vector<T*>::const_iterator;
+
+		/// <summary>
+		/// Adds an item to the pool.
+		/// </summary>
+		/// <returns>Handle to the item, valid until it is erased</returns>
+		Handle<T> insert(T& item);
+
+		/// <summary>
+		/// Removes the item referenced by a handle and invalidates all copies of the handle.
+		/// </summary>
+		/// <returns>Whether the handle was valid</returns>
+		bool erase(Handle<T> handle) noexcept;
+
+		_NODISCARD bool valid(Handle<T> handle) const noexcept;
+
+		/// <returns>Null if the handle is stale or unset</returns>
+		_NODISCARD _Ret_maybenull_ T* get(Handle<T> handle) const noexcept;
+
+		_NODISCARD size_t size() const noexcept;
+		_NODISCARD bool empty() const noexcept;
+
+		/// <summary>
+		/// Removes all items, invalidating every outstanding handle.
+		/// </summary>
+		void clear() noexcept;
+
+		_NODISCARD iterator begin() noexcept;
+		_NODISCARD iterator end() noexcept;
+		_NODISCARD const_iterator begin() const noexcept;
+		_NODISCARD const_iterator end() const noexcept;
+
+	private:
+		struct Slot
+		{
+			uint32_t generation = 0;
+
+			// Index in the dense arrays when used, next free slot otherwise
+			uint32_t index = Handle<T>::InvalidIndex;
+		};
+
+		std::vector<Slot> m_slots;
+		uint32_t m_freeSlot = Handle<T>::InvalidIndex;
+
+		// Dense item array and the slot of each item
+		std::vector<T*> m_items;
+		std::vector<uint32_t> m_itemSlots;
+	};
+}
+
+#include "HandlePool.hpp"
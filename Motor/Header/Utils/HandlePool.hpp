@@ -0,0 +1,155 @@
+#pragma once
+
+#include "Utils/HandlePool.h"
+
+#define HANDLE_TEMPLATE template <typename T>
+#define HANDLE Handle<T>
+#define HANDLEPOOL HandlePool<T>
+
+namespace KaputEngine
+{
+#pragma region Handle
+	HANDLE_TEMPLATE
+	constexpr uint64_t HANDLE::pack() const noexcept
+	{
+		return static_cast<uint64_t>(generation) << 32 | index;
+	}
+
+	HANDLE_TEMPLATE
+	constexpr HANDLE HANDLE::unpack(const uint64_t value) noexcept
+	{
+		return HANDLE { static_cast<uint32_t>(value), static_cast<uint32_t>(value >> 32) };
+	}
+
+	HANDLE_TEMPLATE
+	constexpr bool HANDLE::isSet() const noexcept
+	{
+		return index != InvalidIndex;
+	}
+#pragma endregion
+
+#pragma region HandlePool
+	HANDLE_TEMPLATE
+	HANDLE HANDLEPOOL::insert(T& item)
+	{
+		uint32_t slotIndex;
+
+		if (m_freeSlot != HANDLE::InvalidIndex)
+		{
+			slotIndex  = m_freeSlot;
+			m_freeSlot = m_slots[slotIndex].index;
+		}
+		else
+		{
+			slotIndex = static_cast<uint32_t>(m_slots.size());
+			m_slots.emplace_back();
+		}
+
+		Slot& slot = m_slots[slotIndex];
+		slot.index = static_cast<uint32_t>(m_items.size());
+
+		m_items.push_back(&item);
+		m_itemSlots.push_back(slotIndex);
+
+		return HANDLE { slotIndex, slot.generation };
+	}
+
+	HANDLE_TEMPLATE
+	bool HANDLEPOOL::erase(const HANDLE handle) noexcept
+	{
+		if (!valid(handle))
+			return false;
+
+		Slot& slot = m_slots[handle.index];
+		const uint32_t denseIndex = slot.index;
+
+		// Move the last item in the freed place
+		if (const uint32_t last = static_cast<uint32_t>(m_items.size() - 1); denseIndex != last)
+		{
+			m_items[denseIndex]     = m_items[last];
+			m_itemSlots[denseIndex] = m_itemSlots[last];
+
+			m_slots[m_itemSlots[denseIndex]].index = denseIndex;
+		}
+
+		m_items.pop_back();
+		m_itemSlots.pop_back();
+
+		// Outstanding copies of the handle no longer match
+		++slot.generation;
+		slot.index = m_freeSlot;
+		m_freeSlot = handle.index;
+
+		return true;
+	}
+
+	HANDLE_TEMPLATE
+	bool HANDLEPOOL::valid(const HANDLE handle) const noexcept
+	{
+		return handle.index < m_slots.size() && m_slots[handle.index].generation == handle.generation
+			&& m_slots[handle.index].index < m_items.size() && m_itemSlots[m_slots[handle.index].index] == handle.index;
+	}
+
+	HANDLE_TEMPLATE
+	_Ret_maybenull_ T* HANDLEPOOL::get(const HANDLE handle) const noexcept
+	{
+		return valid(handle) ? m_items[m_slots[handle.index].index] : nullptr;
+	}
+
+	HANDLE_TEMPLATE
+	size_t HANDLEPOOL::size() const noexcept
+	{
+		return m_items.size();
+	}
+
+	HANDLE_TEMPLATE
+	bool HANDLEPOOL::empty() const noexcept
+	{
+		return m_items.empty();
+	}
+
+	HANDLE_TEMPLATE
+	void HANDLEPOOL::clear() noexcept
+	{
+		for (const uint32_t slotIndex : m_itemSlots)
+		{
+			Slot& slot = m_slots[slotIndex];
+
+			++slot.generation;
+			slot.index = m_freeSlot;
+			m_freeSlot = slotIndex;
+		}
+
+		m_items.clear();
+		m_itemSlots.clear();
+	}
+
+	HANDLE_TEMPLATE
+	typename HANDLEPOOL::iterator HANDLEPOOL::begin() noexcept
+	{
+		return m_items.begin();
+	}
+
+	HANDLE_TEMPLATE
+	typename HANDLEPOOL::iterator HANDLEPOOL::end() noexcept
+	{
+		return m_items.end();
+	}
+
+	HANDLE_TEMPLATE
+	typename HANDLEPOOL::const_iterator HANDLEPOOL::begin() const noexcept
+	{
+		return m_items.begin();
+	}
+
+	HANDLE_TEMPLATE
+	typename HANDLEPOOL::const_iterator HANDLEPOOL::end() const noexcept
+	{
+		return m_items.end();
+	}
+#pragma endregion
+}
+
+#undef HANDLE_TEMPLATE
+#undef HANDLE
+#undef HANDLEPOOL
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <type_traits>
+
+namespace KaputEngine
+{
+	template <typename Func, size_t Capacity = 48>
+	class InlineFunction;
+
+	/// <summary>
+	/// Move-only type-erased callable storing small targets inline
+	/// </summary>
+	/// <typeparam name="Capacity">Size in bytes of the inline buffer. Larger targets fall back to a heap allocation.</typeparam>
+	/// <remarks>Unlike std::function, targets do not need to be copyable and captures up to the capacity never allocate.</remarks>
+	template <typename Ret, typename... Args, size_t Capacity>
+	class InlineFunction<Ret(Args...), Capacity>
+	{
+	public:
+		using Signature = Ret(Args...);
+		using Return = Ret;
+
+		/// <summary>
+		/// Returns if a target of the given type is stored without allocating.
+		/// </summary>
+		template <typename F>
+		static constexpr bool FitsInline =
+			sizeof(F) <= Capacity &&
+			alignof(F) <= alignof(std::max_align_t) &&
+			std::is_nothrow_move_constructible_v<F>;
+
+		InlineFunction() noexcept = default;
+		InlineFunction(std::nullptr_t) noexcept;
+
+		template <typename F>
+			requires (!std::same_as<std::decay_t<F>, InlineFunction> && std::is_invocable_r_v<Ret, std::decay_t<F>&, Args...>)
+		InlineFunction(F&& func);
+
+		InlineFunction(const InlineFunction&) = delete;
+		InlineFunction(InlineFunction&& other) noexcept;
+
+		~InlineFunction();
+
+		InlineFunction& operator=(const InlineFunction&) = delete;
+		InlineFunction& operator=(InlineFunction&& other) noexcept;
+		InlineFunction& operator=(std::nullptr_t) noexcept;
+
+		Ret operator()(Args... args);
+
+		_NODISCARD explicit operator bool() const noexcept;
+
+	private:
+		struct VTable
+		{
+			Ret (*invoke)(void* target, Args&&... args);
+			void (*move)(void* destination, void* source) noexcept;
+			void (*destroy)(void* target) noexcept;
+		};
+
+		template <typename F>
+		static const VTable s_inlineTable;
+
+		template <typename F>
+		static const VTable s_heapTable;
+
+		void reset() noexcept;
+
+		alignas(std::max_align_t) std::byte m_storage[Capacity];
+		const VTable* m_vtable = nullptr;
+	};
+}
+
+#include "InlineFunction.hpp"
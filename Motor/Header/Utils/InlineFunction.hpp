@@ -0,0 +1,138 @@
+#pragma once
+
+#include "InlineFunction.h"
+
+#include <functional>
+#include <new>
+#include <utility>
+
+#define TEMPLATE template <typename Ret, typename... Args, size_t Capacity>
+#define INLINEFUNCTION InlineFunction<Ret(Args...), Capacity>
+
+namespace KaputEngine
+{
+	TEMPLATE
+	template <typename F>
+	const typename INLINEFUNCTION::VTable INLINEFUNCTION::s_inlineTable =
+	{
+		[](void* target, Args&&... args) -> Ret
+		{
+			return std::invoke(*static_cast<F*>(target), std::forward<Args>(args)...);
+		},
+		[](void* destination, void* source) noexcept
+		{
+			new (destination) F(std::move(*static_cast<F*>(source)));
+			static_cast<F*>(source)->~F();
+		},
+		[](void* target) noexcept
+		{
+			static_cast<F*>(target)->~F();
+		}
+	};
+
+	TEMPLATE
+	template <typename F>
+	const typename INLINEFUNCTION::VTable INLINEFUNCTION::s_heapTable =
+	{
+		[](void* target, Args&&... args) -> Ret
+		{
+			return std::invoke(**static_cast<F**>(target), std::forward<Args>(args)...);
+		},
+		[](void* destination, void* source) noexcept
+		{
+			// Only the pointer is stored, steal it
+			*static_cast<F**>(destination) = *static_cast<F**>(source);
+		},
+		[](void* target) noexcept
+		{
+			delete *static_cast<F**>(target);
+		}
+	};
+
+	TEMPLATE
+	INLINEFUNCTION::InlineFunction(std::nullptr_t) noexcept { }
+
+	TEMPLATE
+	template <typename F>
+		requires (!std::same_as<std::decay_t<F>, INLINEFUNCTION> && std::is_invocable_r_v<Ret, std::decay_t<F>&, Args...>)
+	INLINEFUNCTION::InlineFunction(F&& func)
+	{
+		using Target = std::decay_t<F>;
+
+		if constexpr (FitsInline<Target>)
+		{
+			new (m_storage) Target(std::forward<F>(func));
+			m_vtable = &s_inlineTable<Target>;
+		}
+		else
+		{
+			*reinterpret_cast<Target**>(m_storage) = new Target(std::forward<F>(func));
+			m_vtable = &s_heapTable<Target>;
+		}
+	}
+
+	TEMPLATE
+	INLINEFUNCTION::InlineFunction(InlineFunction&& other) noexcept
+	{
+		if (!other.m_vtable)
+			return;
+
+		other.m_vtable->move(m_storage, other.m_storage);
+		m_vtable = std::exchange(other.m_vtable, nullptr);
+	}
+
+	TEMPLATE
+	INLINEFUNCTION::~InlineFunction()
+	{
+		reset();
+	}
+
+	TEMPLATE
+	INLINEFUNCTION& INLINEFUNCTION::operator=(InlineFunction&& other) noexcept
+	{
+		if (this == &other)
+			return *this;
+
+		reset();
+
+		if (other.m_vtable)
+		{
+			other.m_vtable->move(m_storage, other.m_storage);
+			m_vtable = std::exchange(other.m_vtable, nullptr);
+		}
+
+		return *this;
+	}
+
+	TEMPLATE
+	INLINEFUNCTION& INLINEFUNCTION::operator=(std::nullptr_t) noexcept
+	{
+		reset();
+		return *this;
+	}
+
+	TEMPLATE
+	Ret INLINEFUNCTION::operator()(Args... args)
+	{
+		if (!m_vtable)
+			throw std::bad_function_call();
+
+		return m_vtable->invoke(m_storage, std::forward<Args>(args)...);
+	}
+
+	TEMPLATE
+	INLINEFUNCTION::operator bool() const noexcept
+	{
+		return m_vtable;
+	}
+
+	TEMPLATE
+	void INLINEFUNCTION::reset() noexcept
+	{
+		if (m_vtable)
+			std::exchange(m_vtable, nullptr)->destroy(m_storage);
+	}
+}
+
+#undef TEMPLATE
+#undef INLINEFUNCTION
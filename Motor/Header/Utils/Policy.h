@@ -1,5 +1,6 @@
 #pragma once
 
+#include "Job/JobSystem.h"
 #include "Utils/Function.h"
 #include "Utils/rawalloc.h"
 
@@ -40,8 +41,16 @@ namespace KaputEngine
 		return promise.get_future();
 	}
 
+	/// <summary>
+	/// Runs a function according to a threading policy.
+	/// </summary>
+	/// <param name="priority">Priority of the job when scheduled on the <see cref="Job::JobSystem"/></param>
+	/// <remarks>Multi-threaded work is scheduled on the shared worker pool rather than a dedicated thread.</remarks>
 	template <typename TResult>
-	_NODISCARD std::future<TResult> createFuture(eMultiThreadPolicy policy, std::function<TResult(eMultiThreadPolicy)>&& func)
+	_NODISCARD std::future<TResult> createFuture(
+		eMultiThreadPolicy policy,
+		std::function<TResult(eMultiThreadPolicy)>&& func,
+		Job::eJobPriority priority = Job::eJobPriority::NORMAL)
 	{
 		switch (policy)
 		{
@@ -54,7 +63,9 @@ namespace KaputEngine
 				return future;
 			}
 		case eMultiThreadPolicy::MULTI_THREAD:
-			return std::async(std::launch::async, std::move(func), policy);
+			return Job::JobSystem::instance().async<TResult>(
+				[func = std::move(func), policy]() -> TResult { return func(policy); },
+				priority);
 		default:
 			throw std::runtime_error("Unreachable branch.");
 		}
@@ -113,10 +113,10 @@ namespace KaputEngine
         /// <returns>Return false if the initialization failed</returns>
         _NODISCARD bool initImGui();
 
-        VirtualWindow* m_backgroundWindow;
+        VirtualWindow* m_backgroundWindow = nullptr;
         std::shared_ptr<Scene> m_scene;
         LibMath::Vector2i m_size;
-        GLFWwindow* m_windowHandle;
+        GLFWwindow* m_windowHandle = nullptr;
         const char* m_title;
         bool m_shouldClose = false;
 		bool m_docking = false;
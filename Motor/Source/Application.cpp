@@ -3,8 +3,11 @@
 
 #include "Application.h"
 
+#include "Job/JobSystem.h"
+#include "Profiling/Profiler.h"
 #include "Queue/Context.h"
 #include "Registry.h"
+#include "Rendering/RenderThread.h"
 
 #include <glad/glad.h>
 
@@ -14,12 +17,21 @@
 #include <imgui/imgui_impl_glfw.h>
 #include <imgui/imgui_impl_opengl3.h>
 
+#include <chrono>
+#include <iostream>
+#include <thread>
+
 using namespace LibMath;
 using namespace KaputEngine;
 
 using KaputEngine::Audio::AudioEngine;
+using KaputEngine::Job::JobSystem;
+using KaputEngine::Profiling::Profiler;
 using KaputEngine::Queue::ContextQueue;
 using KaputEngine::Rendering::Color;
+using KaputEngine::Rendering::RenderThread;
+
+using std::cerr;
 
 decltype(Application::preUpdate)     Application::preUpdate  = nullptr;
 decltype(Application::postUpdate)    Application::postUpdate = nullptr;
@@ -30,10 +42,16 @@ decltype(Application::s_lua)	     Application::s_lua;
 
 bool Application::s_shouldQuit = false;
 bool Application::s_paused = false;
+bool Application::s_pipelined = false;
+bool Application::s_headless = false;
 PrimaryWindow Application::s_window;
 
-double Application::s_lastFrame = glfwGetTime();
+double Application::s_lastFrame = 0;
 double Application::s_deltaTime = 0;
+double Application::s_tickRate  = 60;
+
+// Reference point of frame times, not tied to GLFW so headless mode does not need it initialized
+static const std::chrono::steady_clock::time_point StartTime = std::chrono::steady_clock::now();
 
 std::vector<VirtualWindow*> Application::s_UIWindows;
 std::vector<std::function<void()>> Application::s_onClose;
@@ -45,27 +63,75 @@ bool Application::init(const char* title, const Vector2i& size)
 	if (!s_window.init(title, size))
 		return false;
 
+	initCommon();
+	return true;
+}
+
+bool Application::initHeadless(const double tickRate)
+{
+	if (tickRate < 0)
+	{
+		cerr << __FUNCTION__": Tick rate cannot be negative.\n";
+		return false;
+	}
+
+	s_headless = true;
+	s_tickRate = tickRate;
+
+	initCommon();
+	return true;
+}
+
+void Application::initCommon()
+{
+	Profiler::instance().setThreadName("Main");
+
 	s_lua.open_libraries(sol::lib::base);
 
 	Registry::registerDefaultTypes();
 	Registry::registerLuaInput();
 	Registry::registerAngle();
+	Registry::registerHandles();
+	Registry::registerSpatial();
 	Registry::registerOperator();
 	Registry::registerGlobals();
+}
 
-	return true;
+bool Application::headless() noexcept
+{
+	return s_headless;
+}
+
+void Application::setTickRate(const double tickRate)
+{
+	if (tickRate < 0)
+	{
+		cerr << __FUNCTION__": Tick rate cannot be negative.\n";
+		return;
+	}
+
+	s_tickRate = tickRate;
+}
+
+double Application::tickRate() noexcept
+{
+	return s_tickRate;
 }
 
 void Application::update()
 {
 	updateDeltaTime();
-	s_inputs.updateMouse();
+
+	if (!s_headless)
+		s_inputs.updateMouse();
 }
 
 void Application::resizeViewport(const Vector2i& size)
 {
-	// TODO Use ContextQueue
-	glViewport(0, 0, size.x(), size.y());
+	ContextQueue::instance().push([size]
+	{
+		glViewport(0, 0, size.x(), size.y());
+	}).wait();
 }
 
 sol::state& Application::luaState() noexcept
@@ -91,43 +157,125 @@ void Application::callCloseFunctions()
 
 void Application::run()
 {
+	if (s_headless)
+	{
+		runHeadless();
+		return;
+	}
+
+	const bool pipelined = s_pipelined && RenderThread::instance().start(s_window.getHandle());
+
 	while (!s_shouldQuit && !s_window.shouldClose())
 	{
-		ContextQueue::instance().popAll();
+		Profiler::instance().newFrame();
+		PROFILE_ZONE("Frame");
 
-		update();
+		// In pipelined mode, the render thread owns the queue
+		if (!pipelined)
+			ContextQueue::instance().popAll();
 
-		if (!s_paused)
 		{
-			if (preUpdate)
-				preUpdate();
+			PROFILE_ZONE("Update");
+
+			update();
 
-			s_window.update();
+			if (!s_paused)
+			{
+				if (preUpdate)
+					preUpdate();
 
-			if (postUpdate)
-				postUpdate();
+				s_window.update();
+
+				if (postUpdate)
+					postUpdate();
+			}
 		}
 
 		// Apply changes made during upates
+		if (!pipelined)
+			ContextQueue::instance().popAll();
+
+		{
+			PROFILE_ZONE("Render");
+
+			if (preRender)
+				preRender();
+
+				newUIFrame();               //Initialize a new UI frame (for the editor && the game)
+				renderWindows();            //Render the virtual windows (for the editor)
+				s_window.render();          //Render everuthing in the scene (for the game)
+				renderUIFrame();            //Render the UI frame (for the editor && the game)
+
+			if (postRender)
+				postRender();
+		}
+
+		{
+			PROFILE_ZONE("Present");
+			s_window.glUpdate();
+		}
+	}
+
+	cleanup();
+}
+
+void Application::runHeadless()
+{
+	using Clock = std::chrono::steady_clock;
+
+	Clock::time_point nextTick = Clock::now();
+
+	while (!s_shouldQuit)
+	{
+		Profiler::instance().newFrame();
+		PROFILE_ZONE("Frame");
+
 		ContextQueue::instance().popAll();
 
-		if (preRender)
-			preRender();
+		{
+			PROFILE_ZONE("Update");
+
+			update();
+
+			if (!s_paused)
+			{
+				if (preUpdate)
+					preUpdate();
 
-			newUIFrame();               //Initialize a new UI frame (for the editor && the game)
-			renderWindows();            //Render the virtual windows (for the editor)
-			s_window.render();          //Render everuthing in the scene (for the game)
-			renderUIFrame();            //Render the UI frame (for the editor && the game)
+				s_window.update();
 
-		if (postRender)
-			postRender();
+				if (postUpdate)
+					postUpdate();
+			}
+		}
+
+		ContextQueue::instance().popAll();
 
-		s_window.glUpdate();
+		if (s_tickRate <= 0)
+			continue;
+
+		nextTick += std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1. / s_tickRate));
+
+		// Do not try to catch up after a long tick, the physics already bound their own steps
+		if (const Clock::time_point now = Clock::now(); nextTick < now)
+			nextTick = now;
+		else
+			std::this_thread::sleep_until(nextTick);
 	}
 
 	cleanup();
 }
 
+void Application::setPipelined(const bool pipelined) noexcept
+{
+	s_pipelined = pipelined;
+}
+
+bool Application::pipelined() noexcept
+{
+	return s_pipelined;
+}
+
 void Application::quit()
 {
 	s_shouldQuit = true;
@@ -138,9 +286,12 @@ void Application::clearScreen(const Color& col)
 {
 	Vector2f size = s_window.getSize();
 
-	glViewport(0,0 ,size.x(), size.y());
-	glClearColor(col.r(), col.g(), col.b(), col.a());
-	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+	ContextQueue::instance().push([&size, &col]
+	{
+		glViewport(0,0 ,size.x(), size.y());
+		glClearColor(col.r(), col.g(), col.b(), col.a());
+		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+	}).wait();
 }
 
 VirtualWindow* Application::addUIWindow(VirtualWindow& window)
@@ -172,6 +323,11 @@ double Application::getDeltaTime() noexcept
 	return s_deltaTime;
 }
 
+double Application::getTime() noexcept
+{
+	return s_lastFrame;
+}
+
 InputManager& Application::getInputManager() noexcept
 {
 	return s_inputs;
@@ -189,17 +345,24 @@ void Application::setWindowShouldClose(bool value)
 
 void Application::updateDeltaTime()
 {
-	const double currentFrame = glfwGetTime();
+	const double currentFrame = std::chrono::duration<double>(std::chrono::steady_clock::now() - StartTime).count();
 	s_deltaTime = currentFrame - s_lastFrame;
 	s_lastFrame = currentFrame;
 }
 
 void Application::cleanup()
 {
+	// Move the context back to the main thread
+	RenderThread::instance().stop();
+
 	for (VirtualWindow* uiWindow : s_UIWindows)
 		delete uiWindow;
 
 	s_onClose.clear();
+
+	// Loads in flight may be blocked on the context queue
+	JobSystem::instance().shutdown([]() { ContextQueue::instance().popAll(); });
+
 	s_window.destroy();
 	//s_lua.collect_garbage();
 }
@@ -212,7 +375,10 @@ void Application::renderWindows()
 
 void Application::newUIFrame()
 {
-	ImGui_ImplOpenGL3_NewFrame();
+	// The render thread creates the renderer objects when started
+	if (!RenderThread::instance().running())
+		ImGui_ImplOpenGL3_NewFrame();
+
 	ImGui_ImplGlfw_NewFrame();
 	ImGui::NewFrame();
 
@@ -222,6 +388,14 @@ void Application::newUIFrame()
 void Application::renderUIFrame()
 {
 	ImGui::Render();
+
+	if (RenderThread& renderThread = RenderThread::instance(); renderThread.running())
+	{
+		// Drawn with the frame snapshot
+		renderThread.frame().captureUI(*ImGui::GetDrawData());
+		return;
+	}
+
 	ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
 
 	ImGuiIO& io = ImGui::GetIO();
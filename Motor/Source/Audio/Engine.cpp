@@ -34,12 +34,19 @@ AudioEngine::~AudioEngine() noexcept
 
 void AudioEngine::stopAll()
 {
+	// No audio device, such as on a headless server
+	if (!m_engine)
+		return;
+
 	m_engine->stopAllSounds();
 	m_engine->removeAllSoundSources();
 }
 
 void AudioEngine::updateTracking()
 {
+	if (!m_engine)
+		return;
+
 	const exclusive_weak_ptr<AudioListenerComponent> primary = AudioListenerComponent::getPrimary();
 
 	if (primary.expired())
@@ -67,6 +67,9 @@ bool Sound::valid() const noexcept
 
 void Sound::play(const bool loop, const float volume)
 {
+	if (Application::headless())
+		return;
+
 	ISound* ptr = Application::audio().engine().play2D(this->m_parentResource->getSoundPath().string().c_str(), loop, false, true);
 
 	if (ptr)
@@ -75,6 +78,9 @@ void Sound::play(const bool loop, const float volume)
 
 void Sound::play(const Vector3f& pos, const bool loop, const float volume)
 {
+	if (Application::headless())
+		return;
+
 	ISound* ptr = Application::audio().engine().play3D(this->m_parentResource->getSoundPath().string().c_str(), { pos.x(), pos.y(), pos.z() }, loop, false, true);
 
 	if (ptr)
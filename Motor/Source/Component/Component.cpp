@@ -1,6 +1,7 @@
 #include "Component/Component.h"
 
 #include "GameObject/GameObject.h"
+#include "Scene/Scene.h"
 
 using namespace KaputEngine;
 using namespace KaputEngine::Text::Xml;
@@ -26,6 +27,20 @@ void Component::destroy()
 	m_parentObject.removeComponent(*this);
 }
 
+void Component::registerQueues(Scene& scene)
+{
+	ObjectBase::registerQueues(scene);
+	scene.index(*this);
+}
+
+void Component::unregisterQueues()
+{
+	ObjectBase::unregisterQueues();
+
+	if (Scene* scene = parentScene())
+		scene->unindex(*this);
+}
+
 std::vector<string> Component::getTypes()
 {
 	std::vector<string> types;
@@ -74,6 +89,21 @@ _Ret_notnull_ GameObject* Component::parentObject() const noexcept
 	return &m_parentObject;
 }
 
+Handle<Component> Component::handle() const noexcept
+{
+	return m_handle;
+}
+
+ComponentTypeIndex Component::typeIndex() const noexcept
+{
+	return m_typeIndex;
+}
+
+ComponentTypeMask Component::typeMask() const noexcept
+{
+	return m_typeMask;
+}
+
 _Ret_maybenull_ Scene* Component::parentScene() const noexcept
 {
 	return m_parentObject.parentScene();
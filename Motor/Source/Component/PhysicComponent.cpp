@@ -107,6 +107,8 @@ void PhysicComponent::setTransform(const Transform& trans)
 
 	this->m_body->m_btBody->setWorldTransform(transConverted);
 	this->m_body->m_btBody->getMotionState()->setWorldTransform(transConverted);
+
+	this->resetInterpolation();
 }
 
 void PhysicComponent::setMass(const float mass)
@@ -191,6 +193,8 @@ void PhysicComponent::setRigidBodyPosition(const Vector3f& vec)
 
 	this->m_body->m_btBody->setWorldTransform(transConverted);
 	this->m_body->m_btBody->getMotionState()->setWorldTransform(transConverted);
+
+	this->resetInterpolation();
 }
 
 void PhysicComponent::resetVelocity()
@@ -232,17 +236,31 @@ void PhysicComponent::setShape(ePhysicShape shape)
 
 void PhysicComponent::updatePhysics(const double deltaTime)
 {
-	btTransform physicTrans;
-	this->m_body->m_btBody->getMotionState()->getWorldTransform(physicTrans);
+	this->m_previousSimulatedTransform = this->m_simulatedTransform;
+	this->m_simulatedTransform = this->getSimulatedTransform();
+}
+
+void PhysicComponent::interpolatePhysics(const double alpha)
+{
+	const Transform& previous = this->m_previousSimulatedTransform;
+	const Transform& current  = this->m_simulatedTransform;
+
+	const btVector3 position = btVector3(previous.position.x(), previous.position.y(), previous.position.z())
+		.lerp({ current.position.x(), current.position.y(), current.position.z() }, static_cast<btScalar>(alpha));
+
+	const btQuaternion rotation = slerp(
+		btQuaternion(previous.rotation.x(), previous.rotation.y(), previous.rotation.z(), previous.rotation.w()),
+		btQuaternion(current.rotation.x(), current.rotation.y(), current.rotation.z(), current.rotation.w()),
+		static_cast<btScalar>(alpha));
+
+	// Scale and frozen axes are not simulated, keep the ones of the object
 	Transform newTrans = this->m_parentObject.getWorldTransform();
 
-	for (int i = 0; i < this->m_fixTranslation.size() ; ++i)
+	for (int i = 0; i < this->m_fixTranslation.size(); ++i)
 		if (!this->m_fixTranslation[i])
-			newTrans.position[i] = physicTrans.getOrigin()[i];
+			newTrans.position[i] = position[i];
 
-	physicTrans.setOrigin({ newTrans.position .x(), newTrans.position.y(), newTrans.position.z() });
-
-	newTrans.rotation = { physicTrans.getRotation().x(), physicTrans.getRotation().y(), physicTrans.getRotation().z(), physicTrans.getRotation().w() };
+	newTrans.rotation = { rotation.x(), rotation.y(), rotation.z(), rotation.w() };
 
 	this->m_parentObject.setWorldTransformWithoutPhysic(newTrans);
 }
@@ -267,8 +285,15 @@ void PhysicComponent::render(const Camera& camera)
 
 	Matrix4f MVP = projView * model;
 
-	this->m_program->setUniform("MVP", MVP);
-	this->m_program->setUniform("PickingColor", Color::Red);
+	const EngineUniforms& uniforms = this->m_program->engineUniforms();
+
+	this->m_program->setUniform(uniforms.mvp, MVP);
+	this->m_program->setUniform(uniforms.pickingColor, Color::Red);
+
+	// Collider shapes are generated with float positions
+	const VertexQuantization identity;
+	this->m_program->setUniform(uniforms.positionScale, identity.scale);
+	this->m_program->setUniform(uniforms.positionOffset, identity.offset);
 
 	glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
 	this->renderRightForm();
@@ -456,6 +481,8 @@ void PhysicComponent::registerPhysics(Scene& scene)
 {
 	scene.getPhysicHandler().addToWorld(this->m_body.get());
 	scene.getPhysicHandler().m_physicsQueue.push_back(*this);
+
+	this->resetInterpolation();
 }
 
 void PhysicComponent::unregisterPhysics(Scene& scene)
@@ -480,6 +507,27 @@ void PhysicComponent::unregisterQueues()
 	unregisterPhysics(*this->m_parentObject.parentScene());
 }
 
+Transform PhysicComponent::getSimulatedTransform() const
+{
+	btTransform physicTrans;
+	this->m_body->m_btBody->getMotionState()->getWorldTransform(physicTrans);
+	Transform newTrans = this->m_parentObject.getWorldTransform();
+
+	for (int i = 0; i < this->m_fixTranslation.size() ; ++i)
+		if (!this->m_fixTranslation[i])
+			newTrans.position[i] = physicTrans.getOrigin()[i];
+
+	newTrans.rotation = { physicTrans.getRotation().x(), physicTrans.getRotation().y(), physicTrans.getRotation().z(), physicTrans.getRotation().w() };
+
+	return newTrans;
+}
+
+void PhysicComponent::resetInterpolation()
+{
+	this->m_simulatedTransform = this->getSimulatedTransform();
+	this->m_previousSimulatedTransform = this->m_simulatedTransform;
+}
+
 void PhysicComponent::drawSphereShapeMesh()
 {
 	const btSphereShape* sphere = static_cast<const btSphereShape*>(this->m_collisionShape->m_btShape);
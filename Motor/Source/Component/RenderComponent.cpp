@@ -2,7 +2,13 @@
 
 #include "Component/Component.hpp"
 #include "GameObject/Camera.h"
+#include "Queue/Context.h"
+#include "Rendering/Command/CommandList.hpp"
+#include "Rendering/Culling/OcclusionBuffer.h"
+#include "Rendering/DrawQueue.h"
+#include "Rendering/Mesh.hpp"
 #include "Rendering/ShaderProgram.hpp"
+#include "Rendering/StaticBatch.h"
 #include "Resource/Manager.hpp"
 #include "Resource/Material.h"
 #include "Resource/Mesh.h"
@@ -12,16 +18,25 @@
 #include "Text/Xml/Node.hpp"
 #include "Utils/RemoveVector.hpp"
 
+#include <algorithm>
+#include <iterator>
+
 using namespace KaputEngine;
 using namespace KaputEngine::Rendering;
 using namespace KaputEngine::Resource;
 using namespace KaputEngine::Text::Xml;
 
 using KaputEngine::Inspector::Property;
+using KaputEngine::Queue::ContextQueue;
+using KaputEngine::Rendering::Command::CommandList;
+using KaputEngine::Rendering::Culling::Bounds;
+using KaputEngine::Rendering::Culling::Occluder;
 
 using std::cerr;
 using std::string;
 
+static_assert(std::size(RenderComponent::LodScreenSizes) == Mesh::MaxLods - 1, "One screen size per level after the full mesh.");
+
 COMPONENT_IMPL(RenderComponent)
 
 RenderComponent::RenderComponent(GameObject& parent, const Id& id,
@@ -45,6 +60,7 @@ RenderComponent::RenderComponent(GameObject& parent)
 
 void RenderComponent::destroy()
 {
+	leaveBatches();
 	unregisterRender();
 	Component::destroy();
 }
@@ -61,12 +77,16 @@ void RenderComponent::setCanRender(bool canRender) noexcept
 
 	m_canRender = canRender;
 
-	if (Scene* scene = parentScene(); scene)
+	if (Scene* scene = parentScene())
 	{
 		if (m_canRender)
 			registerRender(*scene);
 		else
+		{
+			// Drawn by the component itself once enabled again
+			leaveBatches();
 			unregisterRender();
+		}
 	}
 }
 
@@ -75,36 +95,170 @@ void RenderComponent::setShaderProgram(const std::shared_ptr<const ShaderProgram
 	this->m_program = prog;
 }
 
+const std::shared_ptr<const ShaderProgram>& RenderComponent::shaderProgram() const noexcept
+{
+	return m_program;
+}
+
+bool RenderComponent::batched() const noexcept
+{
+	return m_batched;
+}
+
+void RenderComponent::setBatched(const bool batched)
+{
+	if (m_batched == batched)
+		return;
+
+	if (!batched)
+		leaveBatches();
+
+	m_batched = batched;
+
+	if (Scene* const scene = parentScene(); scene && m_canRender)
+	{
+		if (batched)
+			unregisterRender();
+		else
+			registerRender(*scene);
+	}
+}
+
+bool RenderComponent::isOccluder() const noexcept
+{
+	return m_occluder;
+}
+
+void RenderComponent::setOccluder(const bool occluder) noexcept
+{
+	m_occluder = occluder;
+}
+
 void RenderComponent::render(const Camera& camera)
 {
-	if (!this->m_program->use())
+	CommandList list;
+	record(list, camera);
+
+	if (list.empty())
+		return;
+
+	ContextQueue::instance().push([&list]
+	{
+		list.submit();
+	}).wait();
+}
+
+void RenderComponent::record(CommandList& list, const Camera&)
+{
+	if (!this->m_program->id())
 		return;
 
 	if (!m_mesh)
 		return;
 
-	if (Scene* scene = parentScene(); scene)
+	list.useProgram(*m_program);
+
+	Scene* scene = parentScene();
+
+	if (scene)
 	{
-		scene->directionalLightBuffer().buffer().bind();
-		scene->pointLightBuffer().buffer().bind();
+		list.bindRingBuffer(scene->directionalLightBuffer().buffer());
+		list.bindRingBuffer(scene->pointLightBuffer().buffer());
 	}
 
-	m_program->setUniform("worldPosition", m_parentObject.getWorldTransform().position);
-	m_program->setUniform("camera.position", camera);
+	const EngineUniforms& uniforms = m_program->engineUniforms();
+
+	// Camera data comes from the view block recorded by the scene
+	list.setUniform(uniforms.worldPosition, m_parentObject.getWorldTransform().position);
 
 	if (this->m_material)
-		m_mesh->draw(m_parentObject, *m_material, *m_program);
+		m_mesh->record(list, m_parentObject, *m_material, *m_program);
 	else
 	{
 		std::shared_ptr<const MaterialResource> mat = MaterialResource::defaultMaterial();
-		m_mesh->draw(m_parentObject, mat->data(), *m_program);
+		m_mesh->record(list, m_parentObject, mat->data(), *m_program);
 	}
 
-	if (Scene* scene = parentScene(); scene)
+	if (scene)
+		list.unbindStorageBuffer();
+}
+
+_Success_(return) bool RenderComponent::queue(DrawQueue& queue, const Camera& camera)
+{
+	// Nothing to draw, handled all the same
+	if (!m_mesh || !m_program->id())
+		return true;
+
+	const Material& material = m_material ? *m_material : MaterialResource::defaultMaterial()->data();
+
+	m_mesh->queue(queue, DrawItem
 	{
-		scene->directionalLightBuffer().buffer().unbind();
-		scene->pointLightBuffer().buffer().unbind();
-	}
+		.program       = std::to_address(m_program),
+		.material      = &material,
+		.lod           = selectLod(camera),
+		.worldPosition = m_parentObject.getWorldTransform().position
+	}, m_parentObject.getWorldTransformMatrix());
+
+	return true;
+}
+
+void RenderComponent::appendOccluders(std::vector<Occluder>& out) const
+{
+	if (!m_occluder || !m_mesh)
+		return;
+
+	m_mesh->forEachMesh(m_parentObject.getWorldTransformMatrix(), [&out](const Mesh& mesh, const LibMath::Matrix4f& model)
+	{
+		if (!mesh.occluderIndices().empty())
+			out.push_back({ .mesh = &mesh, .model = model });
+	});
+}
+
+uint8_t RenderComponent::selectLod(const Camera& camera)
+{
+	Bounds bounds;
+
+	if (m_mesh->lodCount() < 2 || !getWorldBounds(bounds))
+		return m_lod = 0;
+
+	const float distance = (bounds.sphere.center - camera.getWorldTransform().position).magnitude();
+
+	// The camera is inside the mesh
+	if (distance <= bounds.sphere.radius)
+		return m_lod = 0;
+
+	// Diameter over the height of the view at that distance
+	const float screenSize = bounds.sphere.radius * camera.getProjectionMatrix().raw2D()[1][1] / distance;
+
+	return m_lod = selectLod(screenSize, m_lod, m_mesh->lodCount());
+}
+
+uint8_t RenderComponent::selectLod(const float screenSize, const uint8_t current, const uint8_t lodCount) noexcept
+{
+	uint8_t lod = std::min<uint8_t>(current, lodCount - 1);
+
+	while (lod > 0 && screenSize > LodScreenSizes[lod - 1] * (1.f + LodHysteresis))
+		--lod;
+
+	while (lod + 1 < lodCount && screenSize < LodScreenSizes[lod] * (1.f - LodHysteresis))
+		++lod;
+
+	return lod;
+}
+
+_Success_(return) bool RenderComponent::getWorldBounds(_Out_ Bounds& out) const
+{
+	if (!m_mesh)
+		return false;
+
+	const Bounds local = m_mesh->bounds();
+
+	if (local.empty())
+		return false;
+
+	// Matches the transform the mesh is drawn with
+	out = local.transform(m_parentObject.getWorldTransformMatrix() * m_mesh->getLocalTransform().toMatrix());
+	return true;
 }
 
 _Ret_maybenull_ std::shared_ptr<const Mesh>& RenderComponent::mesh() noexcept
@@ -153,6 +307,9 @@ void RenderComponent::serializeValues(XmlSerializeContext& context) const
 
 	context.value("CanRender", m_canRender);
 
+	if (m_occluder)
+		context.value("Occluder", m_occluder);
+
 	if (const MeshResource* meshRes = m_mesh ? m_mesh->parentResource() : nullptr)
 		context.value("Mesh", *meshRes->path());
 	if (const MaterialResource* matRes = m_material ? m_material->parentResource() : nullptr)
@@ -181,6 +338,19 @@ _Success_(return) bool RenderComponent::deserializeMap(_In_ const XmlNode::Map&
 	else
 		m_canRender = false;
 
+	if (const auto it = map.find("Occluder"); it != map.end())
+	{
+		const std::optional<bool> op = it->second->parse<bool>();
+
+		if (!op)
+		{
+			cerr << __FUNCTION__ ": Failed to parse Occluder.\n";
+			return false;
+		}
+
+		m_occluder = *op;
+	}
+
 	if (const auto it = map.find("Mesh"); it != map.end())
 	{
 		const std::optional<string> sourceOp = it->second->parse<string>();
@@ -228,32 +398,54 @@ void RenderComponent::defineLuaMembers(sol::usertype<RenderComponent>& type)
 	Component::defineLuaMembers(type);
 
 	type["canRender"] = sol::property(&getCanRender, &setCanRender);
+	type["isOccluder"] = sol::property(&isOccluder, &setOccluder);
 }
 
 void RenderComponent::registerRender(Scene& scene)
 {
 	scene.m_renderQueue.push_back(*this);
+	scene.m_spatialIndex.refit(m_parentObject);
 }
 
 void RenderComponent::unregisterRender()
 {
-	IWorldRenderable::m_status.castVector<IWorldRenderable>()->erase(*this);
+	// Disabled and batched components are not in the render queue
+	if (RemoveVector<IWorldRenderable>* const queue = IWorldRenderable::m_status.castVector<IWorldRenderable>())
+		queue->erase(*this);
+
+	if (Scene* const scene = parentScene())
+		scene->m_spatialIndex.refit(m_parentObject);
 }
 
 void RenderComponent::registerQueues(Scene& scene)
 {
 	Component::registerQueues(scene);
 
-	if (m_canRender)
+	if (m_canRender && !m_batched)
 		registerRender(scene);
 }
 
 void RenderComponent::unregisterQueues()
 {
+	// While the scene owning the batches is still known
+	leaveBatches();
+
 	Component::unregisterQueues();
 	unregisterRender();
 }
 
+void RenderComponent::leaveBatches()
+{
+	if (!m_batched)
+		return;
+
+	if (Scene* const scene = parentScene())
+		for (const std::unique_ptr<StaticBatch>& batch : scene->m_staticBatches)
+			batch->remove(*this);
+
+	m_batched = false;
+}
+
 void RenderComponent::getProperties(std::vector<Property>& out) noexcept
 {
 	Base::getProperties(out);
@@ -262,4 +454,8 @@ void RenderComponent::getProperties(std::vector<Property>& out) noexcept
 	out.emplace_back("Can Render",
 	[this]() { return getCanRender(); },
 	[this](const bool& value) { setCanRender(value); });
+
+	out.emplace_back("Is Occluder",
+	[this]() { return isOccluder(); },
+	[this](const bool& value) { setOccluder(value); });
 }
@@ -3,6 +3,7 @@
 #include "Application.h"
 #include "Component/Component.hpp"
 #include "GameObject/GameObject.h"
+#include "Profiling/Profiler.h"
 #include "Resource/Manager.hpp"
 #include "Text/Xml/Context.hpp"
 #include "Text/Xml/Node.hpp"
@@ -61,6 +62,8 @@ void ScriptComponent::start()
 
 void ScriptComponent::update(double deltaTime)
 {
+	PROFILE_FUNCTION();
+
 	if (!m_updateFunc.valid())
 		return;
 
@@ -26,10 +26,11 @@ Camera::Camera(ConstructorBlocker, const Id& id) : GameObject(ConstructorBlocker
 	updateWorldTransform();
 }
 
-void Camera::updateWorldTransform() const noexcept
+void Camera::onWorldTransformChanged() const
 {
-	GameObject::updateWorldTransform();
+	GameObject::onWorldTransformChanged();
 
+	// The orientation is driven by the yaw and pitch
 	Quaternionf Xrot = m_worldTransform.fromAxis(Vector3f::Dir::up(), this->m_yaw);
 	Quaternionf Yrot = m_worldTransform.fromAxis(Vector3f::Dir::right(), this->m_pitch);
 
@@ -118,16 +119,14 @@ Matrix4f Camera::getProjectionMatrix() const noexcept
 
 const Vector3f& Camera::getFront() const noexcept
 {
-	if (m_dirtyTransform)
-		updateWorldTransform();
+	updateWorldTransform();
 
 	return m_front;
 }
 
 const Matrix4f& Camera::getViewProjectionMatrix() const noexcept
 {
-	if (m_dirtyTransform)
-		updateWorldTransform();
+	updateWorldTransform();
 
 	return m_viewProjection;
 }
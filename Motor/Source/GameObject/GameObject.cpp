@@ -1,5 +1,6 @@
 #include "GameObject/GameObject.h"
 
+#include "Component/Lighting/PointLightComponent.h"
 #include "Component/PhysicComponent.h"
 #include "GameObject/ObjectBase.hpp"
 #include "Inspector/Property.hpp"
@@ -19,6 +20,11 @@ using std::string;
 
 OBJECTBASE_IMPL(GameObject)
 
+static constexpr ComponentTypeMask PhysicTypeBit = componentTypeBit<PhysicComponent>();
+
+// Components with a transform of their own, following the object
+static constexpr ComponentTypeMask TransformComponentTypes = componentTypeBit<PointLightComponent>();
+
 decltype(GameObject::s_createFuncs) GameObject::s_createFuncs = {};
 decltype(GameObject::s_deserializeFuncs) GameObject::s_deserializeFuncs = {};
 
@@ -110,8 +116,8 @@ void KaputEngine::GameObject::onCollision(_In_ PhysicComponent* other)
 
 	for (Component& component : m_components)
 	{
-		std::string name = component.typeName();
-		if (name == "PhysicComponent")
+		// The body reporting the contact
+		if (component.typeMask() & PhysicTypeBit)
 			continue;
 
 		component.onCollision(other);
@@ -124,8 +130,8 @@ void KaputEngine::GameObject::onCollisionEnter(_In_ PhysicComponent* other)
 
 	for (Component& component : m_components)
 	{
-		std::string name = component.typeName();
-		if (name == "PhysicComponent")
+		// The body reporting the contact
+		if (component.typeMask() & PhysicTypeBit)
 			continue;
 
 		component.onCollisionEnter(other);
@@ -138,8 +144,8 @@ void KaputEngine::GameObject::onCollisionExit()
 
 	for (Component& component : m_components)
 	{
-		std::string name = component.typeName();
-		if (name == "PhysicComponent")
+		// The body reporting the contact
+		if (component.typeMask() & PhysicTypeBit)
 			continue;
 
 		component.onCollisionExit();
@@ -148,6 +154,21 @@ void KaputEngine::GameObject::onCollisionExit()
 
 _Ret_maybenull_ std::shared_ptr<GameObject> GameObject::findChild(const Id& id) const
 {
+	if (m_scene)
+	{
+		std::shared_ptr<GameObject> object = m_scene->findObject(id);
+
+		if (!object)
+			return nullptr;
+
+		// Indexed scene-wide, only accept descendants
+		for (const GameObject* parent = object->m_parent; parent; parent = parent->m_parent)
+			if (parent == this)
+				return object;
+
+		return nullptr;
+	}
+
 	for (GameObject& child : m_children)
 	{
 		if (child.id() == id)
@@ -167,9 +188,61 @@ const GameObject::ComponentList& GameObject::components() const noexcept
 
 void GameObject::removeComponent(Component& component)
 {
+	if (m_scene)
+		m_scene->unindex(component);
+
+	unslotComponent(component);
+
 	m_components.erase(component);
 }
 
+_Ret_maybenull_ Component* GameObject::getComponent(const ComponentTypeIndex index) const noexcept
+{
+	return index < ComponentTypeCount ? m_componentSlots[index] : nullptr;
+}
+
+bool GameObject::hasComponent(const ComponentTypeIndex index) const noexcept
+{
+	return index < ComponentTypeCount && m_componentMask & ComponentTypeMask(1) << index;
+}
+
+void GameObject::slotComponent(Component& component) noexcept
+{
+	const ComponentTypeMask newTypes = component.typeMask() & ~m_componentMask;
+
+	for (ComponentTypeIndex i = 0; i < ComponentTypeCount; ++i)
+		if (newTypes & ComponentTypeMask(1) << i)
+			m_componentSlots[i] = &component;
+
+	m_componentMask |= newTypes;
+}
+
+void GameObject::unslotComponent(const Component& component) noexcept
+{
+	for (ComponentTypeIndex i = 0; i < ComponentTypeCount; ++i)
+	{
+		if (m_componentSlots[i] != &component)
+			continue;
+
+		const ComponentTypeMask bit = ComponentTypeMask(1) << i;
+
+		m_componentSlots[i] = nullptr;
+		m_componentMask &= ~bit;
+
+		// Hand the slot to the next component of the type
+		for (Component& other : m_components)
+		{
+			if (&other != &component && other.typeMask() & bit)
+			{
+				m_componentSlots[i] = &other;
+				m_componentMask |= bit;
+
+				break;
+			}
+		}
+	}
+}
+
 _Ret_maybenull_ GameObject* GameObject::parentObject() const noexcept
 {
 	return m_parent;
@@ -208,6 +281,24 @@ void GameObject::attachTo(
 	}
 
 	parent->m_children.push_back(this->shared_from_this());
+
+	if (m_scene)
+		m_scene->m_transforms.reparent(*this);
+}
+
+_Success_(return) bool GameObject::attachTo(
+	const Handle<GameObject> parent, const bool adjustWorldTransform, const eDeletePolicy policy)
+{
+	GameObject* const parentPtr = m_scene ? m_scene->get(parent) : nullptr;
+
+	if (!parentPtr)
+	{
+		cerr << __FUNCTION__": Parent handle does not resolve in the scene of the object.\n";
+		return false;
+	}
+
+	attachTo(parentPtr, adjustWorldTransform, policy);
+	return true;
 }
 
 void GameObject::detach()
@@ -229,6 +320,7 @@ void GameObject::detach(_In_opt_ Scene* const newScene)
 void GameObject::registerQueues(Scene& scene)
 {
 	ObjectBase::registerQueues(scene);
+	scene.index(*this);
 
 	for (Component& component : m_components)
 		component.registerQueues(scene);
@@ -238,38 +330,56 @@ void GameObject::unregisterQueues()
 {
 	ObjectBase::unregisterQueues();
 
+	if (m_scene)
+		m_scene->unindex(*this);
+
 	for (Component& component : m_components)
 		component.unregisterQueues();
 }
 
 void GameObject::setWorldTransform(const Transform& transform) noexcept
 {
-	TransformSource::setWorldTransform(transform);
+	setWorldTransformWithoutPhysic(transform);
 
 	if (this->m_physicBody)
 		this->m_physicBody->setTransform(transform);
-
-	for (Component& component : m_components)
-		if (TransformSource* transformSource = dynamic_cast<TransformSource*>(&component))
-			transformSource->setTransformDirty();
-
-	// Only mark the children as dirty and not this as the world transform is provided
-	for (GameObject& child : m_children)
-		switchScene(m_scene);
 }
 
 void GameObject::updateWorldTransform() const noexcept
 {
+	// Objects of a scene are computed by its hierarchy along with their ancestors
+	if (m_scene && m_handle.isSet())
+	{
+		m_scene->m_transforms.resolve(*this);
+		return;
+	}
+
+	if (!m_dirtyTransform)
+		return;
+
 	MatrixTransformSource::updateWorldTransform();
+
+	++m_transformVersion;
+	onWorldTransformChanged();
 }
 
 void GameObject::setWorldTransformWithoutPhysic(const Transform& transform) noexcept
 {
-	TransformSource::setWorldTransform(transform);
+	MatrixTransformSource::setWorldTransform(transform);
+
+	if (m_scene && m_handle.isSet())
+	{
+		// Recomputed from the new local transform along with the children
+		m_scene->m_transforms.markDirty(*this);
+		return;
+	}
+
+	++m_transformVersion;
+	onWorldTransformChanged();
 
 	// Only mark the children as dirty and not this as the world transform is provided
 	for (GameObject& child : m_children)
-		switchScene(m_scene);
+		child.setTransformDirty();
 }
 
 _Ret_maybenull_ TransformSource* GameObject::getParentTransform() const
@@ -286,20 +396,52 @@ RemoveVectorStatus& GameObject::getParentStatus() const noexcept
 
 void GameObject::setTransformDirty() const noexcept
 {
+	if (m_scene && m_handle.isSet())
+	{
+		m_scene->m_transforms.markDirty(*this);
+		return;
+	}
+
 	// Skip updating branches already marked dirty
 	if (isTransformDirty())
 		return;
 
 	m_dirtyTransform = true;
 
-	for (Component& component : m_components)
-		if (TransformSource* transformSource = dynamic_cast<TransformSource*>(&component))
-			transformSource->setTransformDirty();
+	dirtyTransformComponents();
 
 	for (GameObject& child : m_children)
 		child.setTransformDirty();
 }
 
+void GameObject::onWorldTransformChanged() const
+{
+	dirtyTransformComponents();
+}
+
+void GameObject::applyWorldTransform(const Transform& world, const Matrix4f& matrix) const
+{
+	m_worldTransform = world;
+	m_worldTransformMatrix = matrix;
+	m_dirtyTransform = false;
+
+	++m_transformVersion;
+	onWorldTransformChanged();
+
+	// Only in-scene objects have their world transform applied
+	m_scene->m_spatialIndex.refit(*this);
+}
+
+void GameObject::dirtyTransformComponents() const
+{
+	if (!(m_componentMask & TransformComponentTypes))
+		return;
+
+	for (const Component& component : m_components)
+		if (component.typeMask() & TransformComponentTypes)
+			static_cast<const PointLightComponent&>(component).setTransformDirty();
+}
+
 void GameObject::switchScene(_In_opt_ Scene* const newScene)
 {
 	bool recurse = false;
@@ -332,19 +474,37 @@ void GameObject::switchScene(_In_opt_ Scene* const newScene)
 	if (!recurse)
 		return;
 
-	for (Component& component : m_components)
-		if (TransformSource* transformSource = dynamic_cast<TransformSource*>(&component))
-			transformSource->setTransformDirty();
+	dirtyTransformComponents();
 
 	for (GameObject& child : m_children)
 		child.switchScene(newScene);
 }
 
+uint32_t GameObject::transformVersion() const noexcept
+{
+	return m_transformVersion;
+}
+
+bool GameObject::isStatic() const noexcept
+{
+	return m_static;
+}
+
+void GameObject::setStatic(const bool isStatic) noexcept
+{
+	m_static = isStatic;
+}
+
 bool GameObject::isRoot() const noexcept
 {
 	return !m_parent;
 }
 
+Handle<GameObject> GameObject::handle() const noexcept
+{
+	return m_handle;
+}
+
 void GameObject::serializeValues(XmlSerializeContext& context) const
 {
 	ObjectBase::serializeValues(context);
@@ -352,6 +512,9 @@ void GameObject::serializeValues(XmlSerializeContext& context) const
 
 	context.value("DeletePolicy", static_cast<uint8_t>(deletePolicy));
 
+	if (m_static)
+		context.value("IsStatic", m_static);
+
 	if (!m_components.empty())
 	{
 		context.startObject("Components");
@@ -400,6 +563,19 @@ bool GameObject::deserializeMap(const XmlNode::Map& map)
 		deletePolicy = static_cast<eDeletePolicy>(*op);
 	}
 
+	if (const auto it = map.find("IsStatic"); it != map.end())
+	{
+		std::optional<bool> op = it->second->parse<bool>();
+
+		if (!op)
+		{
+			deserializeError(__FUNCTION__, "IsStatic");
+			return false;
+		}
+
+		m_static = *op;
+	}
+
 	if (const auto it = map.find("Components"); it != map.end())
 	{
 		const std::vector<XmlNode>* children = std::get_if<std::vector<XmlNode>>(&it->second->body);
@@ -439,4 +615,8 @@ void GameObject::getProperties(std::vector<Property>& out) noexcept
 	out.emplace_back("World Transform",
 	[this]() { return getWorldTransform(); },
 	[this](const Transform& value) { setWorldTransform(value); });
+
+	out.emplace_back("Is Static",
+	[this]() { return isStatic(); },
+	[this](const bool& value) { setStatic(value); });
 }
@@ -0,0 +1,31 @@
+#include "IWorldRenderable.h"
+
+#include "Rendering/Command/CommandList.h"
+#include "Rendering/Culling/OcclusionBuffer.h"
+
+using KaputEngine::Camera;
+using KaputEngine::IWorldRenderable;
+using KaputEngine::Rendering::Command::CommandList;
+using KaputEngine::Rendering::DrawQueue;
+using KaputEngine::Rendering::Culling::Bounds;
+using KaputEngine::Rendering::Culling::Occluder;
+
+void IWorldRenderable::record(CommandList& list, const Camera& camera)
+{
+	list.callback([](void* const object, const void* const argument)
+	{
+		static_cast<IWorldRenderable*>(object)->render(*static_cast<const Camera*>(argument));
+	}, this, &camera);
+}
+
+_Success_(return) bool IWorldRenderable::getWorldBounds(_Out_ Bounds&) const
+{
+	return false;
+}
+
+_Success_(return) bool IWorldRenderable::queue(DrawQueue&, const Camera&)
+{
+	return false;
+}
+
+void IWorldRenderable::appendOccluders(std::vector<Occluder>&) const { }
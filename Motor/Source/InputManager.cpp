@@ -28,6 +28,10 @@ void InputManager::updateMouse() noexcept
 
 bool InputManager::isKeyPressed(eKey key, _In_opt_ VirtualWindow* window)
 {
+    // No input without a window
+    if (Application::headless())
+        return false;
+
     if (key == KEY_MOUSE_LEFT_BUTTON)
         return this->isLeftClickPressed(window);
 
@@ -50,6 +54,9 @@ bool InputManager::isKeyPressed(eKey key, _In_opt_ VirtualWindow* window)
 
 bool InputManager::isKeyDown(eKey key, _In_opt_ VirtualWindow* window)
 {
+    if (Application::headless())
+        return false;
+
     if (key == KEY_MOUSE_LEFT_BUTTON)
         return this->isLeftClickDown(window);
 
@@ -72,6 +79,9 @@ bool InputManager::isKeyDown(eKey key, _In_opt_ VirtualWindow* window)
 
 bool InputManager::isKeyReleased(eKey key, _In_opt_ VirtualWindow* window)
 {
+    if (Application::headless())
+        return false;
+
     if (key == KEY_MOUSE_LEFT_BUTTON)
         return this->isLeftClickReleased(window);
 
@@ -94,6 +104,9 @@ bool InputManager::isKeyReleased(eKey key, _In_opt_ VirtualWindow* window)
 
 bool InputManager::isLeftClickPressed(_In_opt_ VirtualWindow* window)
 {
+    if (Application::headless())
+        return false;
+
     bool result;
 
     if (window == nullptr)
@@ -113,6 +126,9 @@ bool InputManager::isLeftClickPressed(_In_opt_ VirtualWindow* window)
 
 bool InputManager::isLeftClickReleased(_In_opt_ VirtualWindow* window)
 {
+    if (Application::headless())
+        return false;
+
     bool result;
 
     if (window == nullptr)
@@ -132,6 +148,9 @@ bool InputManager::isLeftClickReleased(_In_opt_ VirtualWindow* window)
 
 bool InputManager::isLeftClickDown(_In_opt_ VirtualWindow* window)
 {
+    if (Application::headless())
+        return false;
+
     bool result;
 
     if (window == nullptr)
@@ -151,5 +170,8 @@ bool InputManager::isLeftClickDown(_In_opt_ VirtualWindow* window)
 
 bool InputManager::isMouseLeftDoubleClicked() const noexcept
 {
+    if (Application::headless())
+        return false;
+
     return ImGui::IsMouseDoubleClicked(0);;
 }
@@ -0,0 +1,282 @@
+#include "Job/JobSystem.h"
+
+#include "Profiling/Profiler.h"
+
+#include <algorithm>
+#include <exception>
+#include <iostream>
+#include <string>
+
+using KaputEngine::Job::eJobPriority;
+using KaputEngine::Job::Job;
+using KaputEngine::Job::JobHandle;
+using KaputEngine::Job::JobSystem;
+using KaputEngine::Profiling::Profiler;
+
+using std::cerr;
+
+#pragma region Job
+Job::Job(Function&& func, const eJobPriority priority) :
+	m_func(std::move(func)), m_priority(priority) { }
+
+eJobPriority Job::priority() const noexcept
+{
+	return m_priority;
+}
+
+bool Job::finished() const noexcept
+{
+	return m_finished;
+}
+#pragma endregion
+
+#pragma region JobSystem
+JobSystem JobSystem::m_inst;
+thread_local size_t JobSystem::s_workerIndex = JobSystem::NoWorker;
+
+JobSystem::~JobSystem()
+{
+	shutdown();
+}
+
+JobSystem& JobSystem::instance() noexcept
+{
+	return m_inst;
+}
+
+size_t JobSystem::workerCount()
+{
+	std::call_once(m_startFlag, &JobSystem::start, this);
+	return m_workers.size();
+}
+
+bool JobSystem::isWorkerThread() const noexcept
+{
+	return s_workerIndex != NoWorker;
+}
+
+JobHandle JobSystem::schedule(Job::Function&& func, const eJobPriority priority)
+{
+	JobHandle job = std::make_shared<Job>(std::move(func), priority);
+	submit(JobHandle(job));
+
+	return job;
+}
+
+JobHandle JobSystem::then(_In_ const JobHandle& parent, Job::Function&& func, const eJobPriority priority)
+{
+	JobHandle job = std::make_shared<Job>(std::move(func), priority);
+
+	{
+		std::lock_guard lock(parent->m_continuationMutex);
+
+		// Queue on the parent, it will be submitted when it finishes
+		if (!parent->m_finished)
+		{
+			parent->m_continuations.push_back(job);
+			return job;
+		}
+	}
+
+	submit(JobHandle(job));
+	return job;
+}
+
+void JobSystem::wait(_In_ const JobHandle& job)
+{
+	if (!job)
+		return;
+
+	if (!isWorkerThread())
+	{
+		job->m_finished.wait(false);
+		return;
+	}
+
+	while (!job->finished())
+		if (!helpOne())
+			std::this_thread::yield();
+}
+
+void JobSystem::shutdown(const std::function<void()>& idle)
+{
+	if (!m_running.exchange(false))
+		return;
+
+	{
+		std::lock_guard lock(m_sleepMutex);
+	}
+	m_sleepCondition.notify_all();
+
+	// Running jobs may be waiting on the caller, let it service them until they return
+	while (m_active)
+	{
+		if (idle)
+			idle();
+
+		std::this_thread::yield();
+	}
+
+	for (const std::unique_ptr<Worker>& worker : m_workers)
+		if (worker->thread.joinable())
+			worker->thread.join();
+
+	// Run the jobs that never started so nothing waiting on them blocks forever
+	// New jobs run inline now the pool is stopped, the count also waits on pushes already under way
+	while (m_pending)
+	{
+		JobHandle job;
+
+		// Workers are joined, any deque can be emptied from here
+		if (findJob(0, &job))
+			execute(job);
+		else
+			std::this_thread::yield();
+	}
+}
+
+void JobSystem::start()
+{
+	const unsigned int hardwareCount = std::thread::hardware_concurrency();
+
+	// Leave one hardware thread to the main thread
+	const size_t count = hardwareCount > 1 ? hardwareCount - 1 : 1;
+
+	m_workers.reserve(count);
+
+	for (size_t i = 0; i < count; ++i)
+		m_workers.emplace_back(std::make_unique<Worker>());
+
+	m_running = true;
+
+	for (size_t i = 0; i < count; ++i)
+		m_workers[i]->thread = std::thread(&JobSystem::workerLoop, this, i);
+}
+
+void JobSystem::workerLoop(const size_t index)
+{
+	s_workerIndex = index;
+	Profiler::instance().setThreadName("Worker " + std::to_string(index));
+
+	while (m_running)
+	{
+		// Flag as active before checking the running state so shutdown cannot miss a job about to start
+		++m_active;
+
+		if (!m_running)
+		{
+			--m_active;
+			break;
+		}
+
+		JobHandle job;
+
+		if (findJob(index, &job))
+		{
+			execute(job);
+			--m_active;
+
+			continue;
+		}
+
+		--m_active;
+
+		std::unique_lock lock(m_sleepMutex);
+		m_sleepCondition.wait(lock, [this]() { return m_pending || !m_running; });
+	}
+}
+
+void JobSystem::submit(JobHandle&& job)
+{
+	std::call_once(m_startFlag, &JobSystem::start, this);
+
+	// Pool stopped, fall back to running on the calling thread
+	if (!m_running)
+	{
+		execute(job);
+		return;
+	}
+
+	// Workers keep their own jobs local, other threads distribute round-robin
+	const size_t index = isWorkerThread() ? s_workerIndex : m_nextWorker++ % m_workers.size();
+	const size_t priority = static_cast<size_t>(job->m_priority);
+
+	// Counted before it can be taken, so a worker popping it right away cannot underflow the count
+	++m_pending;
+	m_workers[index]->queues[priority].push(std::move(job));
+
+	{
+		// Synchronize with sleeping workers checking the pending count
+		std::lock_guard lock(m_sleepMutex);
+	}
+	m_sleepCondition.notify_one();
+}
+
+void JobSystem::execute(JobHandle& job)
+{
+	PROFILE_ZONE("Job");
+
+	try
+	{
+		job->m_func();
+	} catch (const std::exception& e)
+	{
+		cerr << __FUNCTION__": Unhandled exception in job: " << e.what() << '\n';
+	} catch (...)
+	{
+		cerr << __FUNCTION__": Unhandled exception in job.\n";
+	}
+
+	// Release captured state as soon as possible
+	job->m_func = nullptr;
+
+	std::vector<JobHandle> continuations;
+
+	{
+		std::lock_guard lock(job->m_continuationMutex);
+
+		job->m_finished = true;
+		continuations.swap(job->m_continuations);
+	}
+
+	job->m_finished.notify_all();
+
+	for (JobHandle& continuation : continuations)
+		submit(std::move(continuation));
+}
+
+_Success_(return) bool JobSystem::findJob(const size_t index, _When_(return == true, _Out_) JobHandle* job)
+{
+	const size_t count = m_workers.size();
+
+	// Higher priorities first, looking at the local deque before stealing
+	for (size_t priority = 0; priority < PriorityCount; ++priority)
+	{
+		if (m_workers[index]->queues[priority].pop(job))
+		{
+			--m_pending;
+			return true;
+		}
+
+		for (size_t offset = 1; offset < count; ++offset)
+			if (m_workers[(index + offset) % count]->queues[priority].steal(job))
+			{
+				--m_pending;
+				return true;
+			}
+	}
+
+	return false;
+}
+
+bool JobSystem::helpOne()
+{
+	JobHandle job;
+
+	if (!isWorkerThread() || !findJob(s_workerIndex, &job))
+		return false;
+
+	execute(job);
+	return true;
+}
+#pragma endregion
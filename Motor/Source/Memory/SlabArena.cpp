@@ -0,0 +1,133 @@
+#include "Memory/SlabArena.h"
+
+#include <algorithm>
+#include <new>
+
+using KaputEngine::Memory::SlabArena;
+using KaputEngine::Memory::SlabStats;
+
+thread_local SlabArena* SlabArena::s_current = nullptr;
+
+#pragma region Scope
+SlabArena::Scope::Scope(_In_opt_ SlabArena* const arena) noexcept : m_previous(s_current)
+{
+	s_current = arena;
+}
+
+SlabArena::Scope::~Scope()
+{
+	s_current = m_previous;
+}
+#pragma endregion
+
+SlabArena::~SlabArena()
+{
+	// Blocks still in use at this point are leaked by their owner, release the slabs regardless
+	for (std::byte* const slab : m_slabs)
+		::operator delete(slab, SlabSize, std::align_val_t(MaxBlockSize));
+}
+
+_Ret_maybenull_ SlabArena* SlabArena::current() noexcept
+{
+	return s_current;
+}
+
+_Ret_notnull_ void* SlabArena::allocate(const size_t size, const size_t alignment)
+{
+	if (isLarge(size, alignment))
+	{
+		void* const ptr = ::operator new(size, std::align_val_t(alignment));
+
+		std::scoped_lock lock(m_mutex);
+
+		m_stats.reservedBytes += size;
+		m_stats.usedBytes += size;
+		++m_stats.liveAllocations;
+		++m_stats.totalAllocations;
+		++m_stats.largeAllocations;
+
+		return ptr;
+	}
+
+	// Blocks are aligned to their size
+	const size_t index = classIndex(std::max(size, alignment));
+	const size_t blockSize = MinBlockSize << index;
+
+	std::scoped_lock lock(m_mutex);
+
+	SizeClass& sizeClass = m_classes[index];
+	void* ptr;
+
+	if (sizeClass.freeList)
+	{
+		ptr = sizeClass.freeList;
+		sizeClass.freeList = sizeClass.freeList->next;
+	}
+	else
+	{
+		if (sizeClass.cursor == sizeClass.end)
+		{
+			// Aligned to the largest block so every block is aligned to its own size
+			std::byte* const slab = static_cast<std::byte*>(::operator new(SlabSize, std::align_val_t(MaxBlockSize)));
+			m_slabs.push_back(slab);
+
+			sizeClass.cursor = slab;
+			sizeClass.end = slab + SlabSize;
+
+			m_stats.reservedBytes += SlabSize;
+			++m_stats.slabCount;
+		}
+
+		ptr = sizeClass.cursor;
+		sizeClass.cursor += blockSize;
+	}
+
+	m_stats.usedBytes += blockSize;
+	++m_stats.liveAllocations;
+	++m_stats.totalAllocations;
+
+	return ptr;
+}
+
+void SlabArena::deallocate(_In_ void* const ptr, const size_t size, const size_t alignment) noexcept
+{
+	if (isLarge(size, alignment))
+	{
+		::operator delete(ptr, size, std::align_val_t(alignment));
+
+		std::scoped_lock lock(m_mutex);
+
+		m_stats.reservedBytes -= size;
+		m_stats.usedBytes -= size;
+		--m_stats.liveAllocations;
+		--m_stats.largeAllocations;
+
+		return;
+	}
+
+	const size_t index = classIndex(std::max(size, alignment));
+
+	std::scoped_lock lock(m_mutex);
+
+	SizeClass& sizeClass = m_classes[index];
+	sizeClass.freeList = new (ptr) FreeBlock { sizeClass.freeList };
+
+	m_stats.usedBytes -= MinBlockSize << index;
+	--m_stats.liveAllocations;
+}
+
+SlabStats SlabArena::stats() const
+{
+	std::scoped_lock lock(m_mutex);
+	return m_stats;
+}
+
+size_t SlabArena::classIndex(const size_t size) noexcept
+{
+	return size <= MinBlockSize ? 0 : std::bit_width((size - 1) / MinBlockSize);
+}
+
+bool SlabArena::isLarge(const size_t size, const size_t alignment) noexcept
+{
+	return size > MaxBlockSize || alignment > MaxBlockSize;
+}
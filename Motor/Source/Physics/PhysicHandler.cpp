@@ -2,14 +2,20 @@
 
 #include "Component/PhysicComponent.h"
 #include "Physics/PrivateBulletWrapper.h"
+#include "Profiling/Profiler.h"
 #include "Utils/RemoveVector.hpp"
 
 #include <btBulletDynamicsCommon.h>
 
+#include <algorithm>
+#include <iostream>
+
 using namespace KaputEngine;
 
 using LibMath::Vector3f;
 
+using std::cerr;
+
 PhysicHandler::PhysicHandler() : m_physicsQueue(IPhysicsUpdatable::createRemoveVector())
 {
 	this->m_handle = new PhysicHandlerImpl;
@@ -55,17 +61,64 @@ void PhysicHandler::updateSimulation(const double deltaTime)
 
 void PhysicHandler::updatePhysics(double deltaTime)
 {
-	m_accumulator += deltaTime;
+	PROFILE_FUNCTION();
+
+	// Bound the work per frame, the simulation slows down instead of falling further behind
+	m_accumulator = std::min(m_accumulator + deltaTime, m_maxSubsteps * m_targetFrameTime);
 
 	while (m_accumulator >= m_targetFrameTime) {
+		PROFILE_ZONE("PhysicHandler::step");
+
 		this->updateSimulation(m_targetFrameTime);
 		this->checkWorldCollisions();
 
 		for (IPhysicsUpdatable& physicObj : m_physicsQueue)
-			physicObj.updatePhysics(deltaTime);
+			physicObj.updatePhysics(m_targetFrameTime);
 
 		m_accumulator -= m_targetFrameTime;
 	}
+
+	m_interpolationAlpha = m_accumulator / m_targetFrameTime;
+
+	for (IPhysicsUpdatable& physicObj : m_physicsQueue)
+		physicObj.interpolatePhysics(m_interpolationAlpha);
+}
+
+double PhysicHandler::getFixedTimeStep() const noexcept
+{
+	return this->m_targetFrameTime;
+}
+
+void PhysicHandler::setFixedTimeStep(const double timeStep)
+{
+	if (timeStep <= 0)
+	{
+		cerr << __FUNCTION__": Time step must be positive.\n";
+		return;
+	}
+
+	this->m_targetFrameTime = timeStep;
+}
+
+unsigned int PhysicHandler::getMaxSubsteps() const noexcept
+{
+	return this->m_maxSubsteps;
+}
+
+void PhysicHandler::setMaxSubsteps(const unsigned int maxSubsteps)
+{
+	if (!maxSubsteps)
+	{
+		cerr << __FUNCTION__": At least one substep is required.\n";
+		return;
+	}
+
+	this->m_maxSubsteps = maxSubsteps;
+}
+
+double PhysicHandler::getInterpolationAlpha() const noexcept
+{
+	return this->m_interpolationAlpha;
 }
 
 void PhysicHandler::addCollisionsTag(const std::string& name)
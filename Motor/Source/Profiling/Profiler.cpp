@@ -0,0 +1,231 @@
+#include "Profiling/Profiler.h"
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+
+using KaputEngine::Profiling::Profiler;
+
+using std::cerr;
+using std::filesystem::path;
+using std::string;
+
+Profiler Profiler::m_inst;
+thread_local Profiler::ThreadBuffer* Profiler::s_threadBuffer = nullptr;
+
+// Reference point of event timestamps
+static const std::chrono::steady_clock::time_point Epoch = std::chrono::steady_clock::now();
+
+namespace
+{
+	void writeEscaped(std::ostream& stream, const char* str)
+	{
+		for (; *str; ++str)
+		{
+			switch (*str)
+			{
+			case '"':
+			case '\\':
+				stream << '\\' << *str;
+				break;
+			case '\n':
+				stream << "\\n";
+				break;
+			default:
+				stream << *str;
+				break;
+			}
+		}
+	}
+}
+
+Profiler& Profiler::instance() noexcept
+{
+	return m_inst;
+}
+
+void Profiler::setEnabled(const bool enabled) noexcept
+{
+	m_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void Profiler::setThreadName(string name)
+{
+	ThreadBuffer& buffer = threadBuffer();
+
+	std::scoped_lock lock(buffer.mutex);
+	buffer.name = std::move(name);
+}
+
+void Profiler::captureFrames(const size_t frameCount, path path)
+{
+	if (!frameCount)
+		return;
+
+	std::scoped_lock lock(m_captureMutex);
+	m_captureRequest = CaptureRequest { frameCount, std::move(path) };
+}
+
+bool Profiler::capturing() const noexcept
+{
+	return m_captureRemaining;
+}
+
+void Profiler::newFrame()
+{
+	if (m_captureRemaining && !--m_captureRemaining)
+	{
+		setEnabled(m_enabledBeforeCapture);
+
+		if (save(m_capturePath))
+			std::cout << "Profiler capture saved to " << m_capturePath << ".\n";
+	}
+
+	if (m_captureRemaining)
+		return;
+
+	std::optional<CaptureRequest> request;
+
+	{
+		std::scoped_lock lock(m_captureMutex);
+		request.swap(m_captureRequest);
+	}
+
+	if (!request)
+		return;
+
+	clear();
+
+	m_captureRemaining = request->frameCount;
+	m_capturePath = std::move(request->path);
+	m_enabledBeforeCapture = enabled();
+
+	setEnabled(true);
+}
+
+_Success_(return) bool Profiler::save(const path& path) const
+{
+	std::ofstream file(path, std::ios::out | std::ios::trunc);
+
+	if (!file.is_open())
+	{
+		cerr << __FUNCTION__": Failed to open file: " << path << ".\n";
+		return false;
+	}
+
+	file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+	bool first = true;
+
+	const auto separate = [&file, &first]()
+	{
+		if (!first)
+			file << ',';
+
+		first = false;
+		file << '\n';
+	};
+
+	std::scoped_lock buffersLock(m_buffersMutex);
+
+	for (const std::unique_ptr<ThreadBuffer>& buffer : m_buffers)
+	{
+		std::scoped_lock lock(buffer->mutex);
+
+		if (!buffer->name.empty())
+		{
+			separate();
+
+			file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << buffer->id << ",\"args\":{\"name\":\"";
+			writeEscaped(file, buffer->name.c_str());
+			file << "\"}}";
+		}
+
+		for (const ZoneEvent& event : buffer->events)
+		{
+			separate();
+
+			// Timestamps are in microseconds
+			file << "{\"name\":\"";
+			writeEscaped(file, event.name);
+			file << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << buffer->id
+				<< ",\"ts\":" << event.start / 1000 << '.' << event.start % 1000 / 100
+				<< ",\"dur\":" << event.duration / 1000 << '.' << event.duration % 1000 / 100
+				<< ",\"args\":{\"depth\":" << event.depth << "}}";
+		}
+	}
+
+	file << "\n]}\n";
+	file.close();
+
+	return true;
+}
+
+void Profiler::clear()
+{
+	std::scoped_lock buffersLock(m_buffersMutex);
+
+	for (const std::unique_ptr<ThreadBuffer>& buffer : m_buffers)
+	{
+		std::scoped_lock lock(buffer->mutex);
+		buffer->events.clear();
+	}
+}
+
+size_t Profiler::eventCount() const
+{
+	std::scoped_lock buffersLock(m_buffersMutex);
+	size_t count = 0;
+
+	for (const std::unique_ptr<ThreadBuffer>& buffer : m_buffers)
+	{
+		std::scoped_lock lock(buffer->mutex);
+		count += buffer->events.size();
+	}
+
+	return count;
+}
+
+int64_t Profiler::now() noexcept
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - Epoch).count();
+}
+
+Profiler::ThreadBuffer& Profiler::threadBuffer()
+{
+	if (s_threadBuffer)
+		return *s_threadBuffer;
+
+	// Buffers outlive their thread so events can be exported after it exits
+	std::scoped_lock lock(m_buffersMutex);
+
+	std::unique_ptr<ThreadBuffer>& buffer = m_buffers.emplace_back(std::make_unique<ThreadBuffer>());
+	buffer->id = static_cast<uint32_t>(m_buffers.size());
+
+	return *(s_threadBuffer = buffer.get());
+}
+
+int64_t Profiler::beginZone()
+{
+	++threadBuffer().depth;
+	return now();
+}
+
+void Profiler::endZone(_In_z_ const char* const name, const int64_t start)
+{
+	const int64_t end = now();
+	ThreadBuffer& buffer = threadBuffer();
+
+	--buffer.depth;
+
+	std::scoped_lock lock(buffer.mutex);
+
+	if (buffer.events.size() < MaxEventsPerThread)
+		buffer.events.emplace_back(ZoneEvent
+		{
+			.name     = name,
+			.start    = start,
+			.duration = end - start,
+			.depth    = buffer.depth
+		});
+}
@@ -13,6 +13,7 @@
 #include "Component/ScriptComponent.h"
 #include "GameObject/Camera.h"
 #include "GameObject/GameObject.hpp"
+#include "Profiling/Profiler.h"
 #include "Rendering/Color.h"
 #include "Resource/Material.h"
 #include "Resource/Mesh.h"
@@ -22,6 +23,7 @@
 #include "Resource/ShaderProgram.h"
 #include "Resource/Sound.h"
 #include "Resource/Texture.h"
+#include "Scene/Scene.h"
 #include "Window/UIObject.hpp"
 
 #include <LibMath/Angle/Degree.h>
@@ -31,6 +33,32 @@ using namespace KaputEngine;
 using namespace KaputEngine::Resource;
 using namespace LibMath;
 
+using KaputEngine::Rendering::Culling::BoundingBox;
+using KaputEngine::Rendering::Culling::BoundingSphere;
+using KaputEngine::Rendering::Culling::Frustum;
+
+namespace
+{
+	/// <summary>
+	/// Collects the objects of a tree query whose tight bounds also pass the test.
+	/// </summary>
+	template <typename Query, typename Test>
+	std::vector<GameObject*> collectObjects(const Scene& scene, const Query& query, Test&& test)
+	{
+		std::vector<GameObject*> out;
+
+		scene.spatialIndex().tree().query(query, [&](const Handle<GameObject> handle)
+		{
+			if (GameObject* const object = scene.get(handle); object && test(SpatialIndex::computeBounds(*object)))
+				out.push_back(object);
+
+			return true;
+		});
+
+		return out;
+	}
+}
+
 sol::state& Registry::getAppState()
 {
 	return Application::luaState();
@@ -232,6 +260,146 @@ void Registry::registerAngle()
 	};
 }
 
+void Registry::registerHandles()
+{
+	sol::state& lua = getAppState();
+
+	// Handles resolve against the current scene as scripts only run in it
+	const auto currentScene = []() -> Scene*
+	{
+		return std::to_address(Application::getWindow().currentScene());
+	};
+
+	sol::usertype<Handle<GameObject>> objectHandle = lua.globals().new_usertype<Handle<GameObject>>("ObjectHandle",
+		sol::constructors<Handle<GameObject>()>());
+
+	objectHandle["index"]      = sol::readonly(&Handle<GameObject>::index);
+	objectHandle["generation"] = sol::readonly(&Handle<GameObject>::generation);
+	objectHandle["pack"]       = &Handle<GameObject>::pack;
+	objectHandle["unpack"]     = &Handle<GameObject>::unpack;
+
+	objectHandle["valid"] = [currentScene](const Handle<GameObject>& handle) -> bool
+	{
+		const Scene* const scene = currentScene();
+		return scene && scene->valid(handle);
+	};
+
+	objectHandle["get"] = [currentScene](const Handle<GameObject>& handle) -> GameObject*
+	{
+		const Scene* const scene = currentScene();
+		return scene ? scene->get(handle) : nullptr;
+	};
+
+	sol::usertype<Handle<Component>> componentHandle = lua.globals().new_usertype<Handle<Component>>("ComponentHandle",
+		sol::constructors<Handle<Component>()>());
+
+	componentHandle["index"]      = sol::readonly(&Handle<Component>::index);
+	componentHandle["generation"] = sol::readonly(&Handle<Component>::generation);
+	componentHandle["pack"]       = &Handle<Component>::pack;
+	componentHandle["unpack"]     = &Handle<Component>::unpack;
+
+	componentHandle["valid"] = [currentScene](const Handle<Component>& handle) -> bool
+	{
+		const Scene* const scene = currentScene();
+		return scene && scene->valid(handle);
+	};
+
+	componentHandle["get"] = [currentScene](const Handle<Component>& handle) -> Component*
+	{
+		const Scene* const scene = currentScene();
+		return scene ? scene->get(handle) : nullptr;
+	};
+}
+
+void Registry::registerSpatial()
+{
+	sol::state& lua = getAppState();
+
+	// Queries run against the current scene as scripts only run in it
+	const auto currentScene = []() -> Scene*
+	{
+		return std::to_address(Application::getWindow().currentScene());
+	};
+
+	sol::table spatial = lua.create_named_table("Spatial");
+
+	spatial["queryBox"] = [currentScene](const Cartesian3f& min, const Cartesian3f& max)
+	{
+		const Scene* const scene = currentScene();
+
+		if (!scene)
+			return sol::as_table(std::vector<GameObject*>());
+
+		const BoundingBox box { min, max };
+
+		return sol::as_table(collectObjects(*scene, box, [&box](const BoundingBox& bounds)
+		{
+			return bounds.intersects(box);
+		}));
+	};
+
+	spatial["querySphere"] = [currentScene](const Cartesian3f& center, const float radius)
+	{
+		const Scene* const scene = currentScene();
+
+		if (!scene)
+			return sol::as_table(std::vector<GameObject*>());
+
+		const BoundingSphere sphere { center, radius };
+
+		return sol::as_table(collectObjects(*scene, sphere, [&sphere](const BoundingBox& bounds)
+		{
+			return bounds.intersects(sphere);
+		}));
+	};
+
+	spatial["queryFrustum"] = [currentScene](const Camera& camera)
+	{
+		const Scene* const scene = currentScene();
+
+		if (!scene)
+			return sol::as_table(std::vector<GameObject*>());
+
+		const Frustum frustum(camera.getViewProjectionMatrix());
+
+		return sol::as_table(collectObjects(*scene, frustum, [&frustum](const BoundingBox& bounds)
+		{
+			return frustum.intersects(bounds);
+		}));
+	};
+
+	// Returns the closest object hit and its distance, or nil
+	spatial["raycast"] = [currentScene](const Cartesian3f& origin, const Vector3f& direction,
+		const sol::optional<float> maxDistance) -> std::tuple<GameObject*, float>
+	{
+		const Scene* const scene = currentScene();
+
+		if (!scene)
+			return { nullptr, 0.f };
+
+		const Ray ray { origin, direction, maxDistance.value_or(std::numeric_limits<float>::infinity()) };
+		const RayCast cast(ray);
+
+		GameObject* closest = nullptr;
+		float closestDistance = ray.maxDistance;
+
+		scene->spatialIndex().tree().raycast(ray, [&](const Handle<GameObject> handle, float) -> float
+		{
+			GameObject* const object = scene->get(handle);
+
+			if (float distance; object && cast.intersects(SpatialIndex::computeBounds(*object), closestDistance, distance))
+			{
+				closest = object;
+				closestDistance = distance;
+			}
+
+			return closestDistance;
+		});
+
+		return { closest, closest ? closestDistance : 0.f };
+	};
+}
+
 void Registry::registerGlobals()
 {
 	sol::state& lua = getAppState();
@@ -243,6 +411,12 @@ void Registry::registerGlobals()
 		return Application::getWindow().currentScene()->getUIObjectByName(name);
 	};
 
+	lua.globals()["find"] = [](const Id& id) -> ObjectBase*
+	{
+		const std::shared_ptr<Scene>& scene = Application::getWindow().currentScene();
+		return scene ? scene->find(id) : nullptr;
+	};
+
 	lua.globals()["loadScene"] = [](const std::string& scenePath)
 	{
 		std::shared_ptr<Scene> newScene = std::make_shared<Scene>();
@@ -263,4 +437,14 @@ void Registry::registerGlobals()
 	{
 		Application::getWindow().setCursorStatus(value);
 	};
+
+	lua.globals()["setProfilerEnabled"] = [](bool value)
+	{
+		Profiling::Profiler::instance().setEnabled(value);
+	};
+
+	lua.globals()["captureProfile"] = [](size_t frameCount, const std::string& path)
+	{
+		Profiling::Profiler::instance().captureFrames(frameCount, path);
+	};
 }
@@ -12,7 +12,7 @@ void Buffer::destroy()
 	if (!m_id)
 		return;
 
-	ContextQueue::instance().push([id = m_id]
+	ContextQueue::instance().post([id = m_id]
 	{
 		glDeleteBuffers(1, &id);
 	});
@@ -4,6 +4,12 @@
 
 #include <glad/glad.h>
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
 using KaputEngine::Queue::ContextQueue;
 using KaputEngine::Rendering::Buffer::ElementBuffer;
 
@@ -19,9 +25,42 @@ void ElementBuffer::create(const std::span<const unsigned int>& indices)
 	generateBuffer();
 	bind();
 
-	ContextQueue::instance().push([this, &indices]
+	// Half the index bandwidth for meshes with up to 65536 vertices
+	if (fitsShortIndices(indices))
+	{
+		const std::vector<uint16_t> shortIndices(indices.begin(), indices.end());
+		m_indexType = GL_UNSIGNED_SHORT;
+
+		ContextQueue::instance().push([&shortIndices]
+		{
+			glBufferData(GL_ELEMENT_ARRAY_BUFFER, shortIndices.size() * sizeof(uint16_t), shortIndices.data(), GL_STATIC_DRAW);
+		}).wait();
+	}
+	else
+	{
+		m_indexType = GL_UNSIGNED_INT;
+
+		ContextQueue::instance().push([&indices]
+		{
+			glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size_bytes(), indices.data(), GL_STATIC_DRAW);
+		}).wait();
+	}
+}
+
+void ElementBuffer::clearRange(const size_t first, const size_t count) const
+{
+	if (!valid() || !count)
+		return;
+
+	const size_t indexSize = m_indexType == GL_UNSIGNED_SHORT ? sizeof(uint16_t) : sizeof(uint32_t);
+	const std::vector<std::byte> zeros(count * indexSize);
+
+	ContextQueue::instance().push([this, first, indexSize, &zeros]
 	{
-		glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size_bytes(), indices.data(), GL_STATIC_DRAW);
+		// The element array binding belongs to the bound vertex array, left untouched
+		glBindBuffer(GL_COPY_WRITE_BUFFER, m_id);
+		glBufferSubData(GL_COPY_WRITE_BUFFER, static_cast<GLintptr>(first * indexSize), static_cast<GLsizeiptr>(zeros.size()), zeros.data());
+		glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
 	}).wait();
 }
 
@@ -45,3 +84,13 @@ const int& ElementBuffer::count() const noexcept
 {
 	return m_count;
 }
+
+unsigned int ElementBuffer::indexType() const noexcept
+{
+	return m_indexType;
+}
+
+bool ElementBuffer::fitsShortIndices(const std::span<const unsigned int> indices) noexcept
+{
+	return indices.empty() || *std::ranges::max_element(indices) <= std::numeric_limits<uint16_t>::max();
+}
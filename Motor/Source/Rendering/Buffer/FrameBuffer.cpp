@@ -38,7 +38,7 @@ void FrameBuffer::destroy()
 	if (!m_id)
 		return;
 
-	ContextQueue::instance().push([id = m_id]
+	ContextQueue::instance().post([id = m_id]
 	{
 		glDeleteFramebuffers(1, &id);
 	});
@@ -43,7 +43,7 @@ void RenderBuffer::destroy()
 	if (!m_id)
 		return;
 
-	ContextQueue::instance().push([id = m_id]
+	ContextQueue::instance().post([id = m_id]
 	{
 		glDeleteRenderbuffers(1, &id);
 	});
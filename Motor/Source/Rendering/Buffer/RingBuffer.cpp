@@ -0,0 +1,324 @@
+#include "Rendering/Buffer/RingBuffer.h"
+
+#include "Application.h"
+#include "Profiling/Profiler.h"
+#include "Queue/Context.h"
+
+#include <algorithm>
+#include <cstring>
+#include <glad/glad.h>
+#include <iostream>
+
+using KaputEngine::Queue::ContextQueue;
+using KaputEngine::Rendering::Buffer::eRingTarget;
+using KaputEngine::Rendering::Buffer::RingBuffer;
+
+namespace
+{
+	_NODISCARD GLenum glTarget(const eRingTarget target) noexcept
+	{
+		return target == eRingTarget::UNIFORM ? GL_UNIFORM_BUFFER : GL_SHADER_STORAGE_BUFFER;
+	}
+
+	_NODISCARD GLenum glAlignment(const eRingTarget target) noexcept
+	{
+		return target == eRingTarget::UNIFORM ? GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT : GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT;
+	}
+
+	// Nanoseconds waited per attempt on a region fence
+	constexpr GLuint64 FenceTimeout = 1'000'000;
+
+	// Granularity of the comparison of an upload with the previous content of its slot
+	constexpr size_t BlockSize = 64;
+
+	// Start of the first differing block, size if both contents are equal
+	_NODISCARD size_t firstChange(const std::byte* const previous, const std::byte* const current, const size_t size) noexcept
+	{
+		size_t offset = 0;
+
+		while (offset < size)
+		{
+			const size_t length = std::min(BlockSize, size - offset);
+
+			if (std::memcmp(previous + offset, current + offset, length))
+				break;
+
+			offset += length;
+		}
+
+		return offset;
+	}
+
+	// End of the last differing block, searched down to the first change
+	_NODISCARD size_t lastChange(const std::byte* const previous, const std::byte* const current, const size_t size, const size_t first) noexcept
+	{
+		size_t end = size;
+
+		while (end > first)
+		{
+			const size_t begin = (end - 1) / BlockSize * BlockSize;
+
+			if (std::memcmp(previous + begin, current + begin, end - begin))
+				break;
+
+			end = begin;
+		}
+
+		return end;
+	}
+}
+
+uint64_t RingBuffer::s_frame = 1;
+
+RingBuffer::~RingBuffer()
+{
+	destroy();
+}
+
+void RingBuffer::create(const eRingTarget target, const size_t size, const unsigned int index, const uint32_t slotCount)
+{
+	if (Application::headless())
+		return;
+
+	m_target    = target;
+	m_size      = size;
+	m_slotCount = std::max<uint32_t>(slotCount, 1);
+	m_index     = index;
+	m_region    = 0;
+	m_slot      = 0;
+	m_frame     = 0;
+
+	m_shadow.assign(m_slotCount * m_size, std::byte { });
+
+	// The regions start uninitialized, the first upload to each writes it whole
+	m_dirty.assign(static_cast<size_t>(FrameCount) * m_slotCount, Range { 0, m_size });
+
+	ContextQueue::instance().push([this]
+	{
+		const GLenum target = glTarget(m_target);
+
+		GLint alignment = 1;
+		glGetIntegerv(glAlignment(m_target), &alignment);
+
+		m_stride = (m_size + alignment - 1) / alignment * alignment;
+
+		glGenBuffers(1, &m_id);
+		glBindBuffer(target, m_id);
+
+		const GLsizeiptr total = static_cast<GLsizeiptr>(m_stride * m_slotCount * FrameCount);
+
+		if (GLAD_GL_VERSION_4_4)
+		{
+			constexpr GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+			// Dynamic storage keeps buffer updates possible if mapping fails
+			glBufferStorage(target, total, nullptr, flags | GL_DYNAMIC_STORAGE_BIT);
+			m_mapped = static_cast<std::byte*>(glMapBufferRange(target, 0, total, flags));
+
+			if (!m_mapped)
+				std::cerr << __FUNCTION__": Failed to map ring buffer, falling back to buffer updates.\n";
+		}
+
+		// Buffer storage is immutable, only allocated here when unavailable
+		if (!GLAD_GL_VERSION_4_4)
+			glBufferData(target, total, nullptr, GL_DYNAMIC_DRAW);
+
+		glBindBuffer(target, 0);
+	}).wait();
+}
+
+void RingBuffer::destroy()
+{
+	if (!m_id)
+		return;
+
+	ContextQueue::instance().push([this]
+	{
+		deleteFences();
+
+		if (m_mapped)
+		{
+			glBindBuffer(glTarget(m_target), m_id);
+			glUnmapBuffer(glTarget(m_target));
+			glBindBuffer(glTarget(m_target), 0);
+
+			m_mapped = nullptr;
+		}
+	}).wait();
+
+	Buffer::destroy();
+
+	m_size = m_stride = 0;
+	m_index = -1;
+
+	m_shadow.clear();
+	m_dirty.clear();
+}
+
+void RingBuffer::endFrame() noexcept
+{
+	++s_frame;
+}
+
+eRingTarget RingBuffer::target() const noexcept
+{
+	return m_target;
+}
+
+size_t RingBuffer::size() const noexcept
+{
+	return m_size;
+}
+
+unsigned int RingBuffer::index() const noexcept
+{
+	return m_index;
+}
+
+void RingBuffer::upload(_In_reads_bytes_(size) const void* const data, const size_t size)
+{
+	PROFILE_FUNCTION();
+
+	if (!m_id)
+		return;
+
+	if (size > m_size)
+	{
+		std::cerr << __FUNCTION__": Attempting to write outside of buffer bounds.\n";
+		return;
+	}
+
+	advance();
+
+	const std::byte* const content = static_cast<const std::byte*>(data);
+	std::byte* const shadow = m_shadow.data() + m_slot * m_size;
+
+	const size_t changeBegin = firstChange(shadow, content, size);
+
+	if (changeBegin < size)
+	{
+		const size_t changeEnd = lastChange(shadow, content, size, changeBegin);
+		std::memcpy(shadow + changeBegin, content + changeBegin, changeEnd - changeBegin);
+
+		// Every region receives the change before its slot is bound again
+		for (uint32_t region = 0; region < FrameCount; ++region)
+		{
+			Range& dirty = m_dirty[region * m_slotCount + m_slot];
+
+			dirty = dirty.begin < dirty.end ?
+				Range { std::min(dirty.begin, changeBegin), std::max(dirty.end, changeEnd) } :
+				Range { changeBegin, changeEnd };
+		}
+	}
+
+	Range& dirty = m_dirty[m_region * m_slotCount + m_slot];
+
+	if (dirty.begin < std::min(dirty.end, size))
+	{
+		// Bytes past the content are not read, they stay dirty for a larger upload
+		const size_t begin = dirty.begin, end = std::min(dirty.end, size);
+		const size_t offset = this->offset() + begin;
+
+		if (m_mapped)
+			std::memcpy(m_mapped + offset, shadow + begin, end - begin);
+		else
+		{
+			const GLenum target = glTarget(m_target);
+
+			glBindBuffer(target, m_id);
+			glBufferSubData(target, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(end - begin), shadow + begin);
+			glBindBuffer(target, 0);
+		}
+
+		dirty = end < dirty.end ? Range { end, dirty.end } : Range { };
+	}
+
+	bindRegion();
+}
+
+void RingBuffer::bindRegion() const
+{
+	if (!m_id)
+		return;
+
+	glBindBufferRange(glTarget(m_target), m_index, m_id,
+		static_cast<GLintptr>(offset()), static_cast<GLsizeiptr>(m_size));
+}
+
+void RingBuffer::bind() const
+{
+	ContextQueue::instance().push([this]
+	{
+		bindRegion();
+	}).wait();
+}
+
+void RingBuffer::unbind() const
+{
+	ContextQueue::instance().push([this]
+	{
+		glBindBufferBase(glTarget(m_target), m_index, 0);
+	}).wait();
+}
+
+size_t RingBuffer::offset() const noexcept
+{
+	return (m_region * m_slotCount + m_slot) * m_stride;
+}
+
+void RingBuffer::advance()
+{
+	if (m_frame == s_frame && m_slot + 1 < m_slotCount)
+	{
+		++m_slot;
+		return;
+	}
+
+	// Draws recorded since the region was entered read it
+	if (m_fences[m_region])
+		glDeleteSync(static_cast<GLsync>(m_fences[m_region]));
+
+	m_fences[m_region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+	m_region = (m_region + 1) % FrameCount;
+	m_slot   = 0;
+	m_frame  = s_frame;
+
+	waitFence(m_region);
+}
+
+void RingBuffer::waitFence(const uint32_t region)
+{
+	GLsync fence = static_cast<GLsync>(m_fences[region]);
+
+	if (!fence)
+		return;
+
+	// Only stalls when uploads outrun the GPU by more than the region count
+	GLbitfield flags = 0;
+
+	while (true)
+	{
+		const GLenum result = glClientWaitSync(fence, flags, FenceTimeout);
+
+		if (result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED || result == GL_WAIT_FAILED)
+			break;
+
+		// Commands before the fence must reach the GPU for it to ever signal
+		flags = GL_SYNC_FLUSH_COMMANDS_BIT;
+	}
+
+	glDeleteSync(fence);
+	m_fences[region] = nullptr;
+}
+
+void RingBuffer::deleteFences()
+{
+	for (void*& fence : m_fences)
+	{
+		if (fence)
+			glDeleteSync(static_cast<GLsync>(fence));
+
+		fence = nullptr;
+	}
+}
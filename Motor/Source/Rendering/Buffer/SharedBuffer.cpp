@@ -1,5 +1,6 @@
 #include "Rendering/Buffer/SharedBuffer.h"
 
+#include "Application.h"
 #include "Queue/Context.h"
 
 #include <glad/glad.h>
@@ -15,6 +16,9 @@ SharedBuffer::~SharedBuffer()
 
 void SharedBuffer::create(const size_t size, const unsigned int index)
 {
+	if (Application::headless())
+		return;
+
 	generateBuffer();
 
 	m_size  = size;
@@ -73,12 +77,11 @@ void SharedBuffer::write(const size_t offset, const size_t size, _In_reads_bytes
 		return;
 	}
 
-	bind();
-
+	// Single round trip to the context thread
 	ContextQueue::instance().push([this, offset, size, data]()
 	{
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_id);
 		glBufferSubData(GL_SHADER_STORAGE_BUFFER, offset, size, data);
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
 	}).wait();
-
-	unbind();
 }
@@ -19,7 +19,10 @@ TextureBuffer::~TextureBuffer()
 
 void TextureBuffer::destroy()
 {
-	ContextQueue::instance().push([id = m_id]
+	if (!m_id)
+		return;
+
+	ContextQueue::instance().post([id = m_id]
 	{
 		glDeleteTextures(1, &id);
 	});
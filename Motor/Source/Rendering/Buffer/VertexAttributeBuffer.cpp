@@ -25,7 +25,7 @@ void VertexAttributeBuffer::destroy()
 	if (!m_id)
 		return;
 
-	ContextQueue::instance().push([id = m_id]
+	ContextQueue::instance().post([id = m_id]
 	{
 		glDeleteVertexArrays(1, &id);
 	});
@@ -0,0 +1,509 @@
+#include "Rendering/Command/CommandList.hpp"
+
+#include "GameObject/Camera.h"
+#include "Rendering/Buffer/ElementBuffer.h"
+#include "Rendering/Buffer/RingBuffer.h"
+#include "Rendering/Buffer/SharedBuffer.h"
+#include "Rendering/Buffer/TextureBuffer.h"
+#include "Rendering/Buffer/VertexAttributeBuffer.h"
+#include "Rendering/Buffer/VertexBuffer.h"
+#include "Rendering/Color.h"
+#include "Rendering/Material.hpp"
+
+#include <cstring>
+#include <glad/glad.h>
+#include <iostream>
+
+using namespace KaputEngine::Rendering::Command;
+
+using KaputEngine::Camera;
+using KaputEngine::Rendering::Color;
+using KaputEngine::Rendering::Material;
+using KaputEngine::Rendering::MaterialLayer;
+using KaputEngine::Rendering::ShaderProgram;
+using KaputEngine::Rendering::UniformReference;
+using KaputEngine::Rendering::Buffer::ElementBuffer;
+using KaputEngine::Rendering::Buffer::RingBuffer;
+using KaputEngine::Rendering::Buffer::SharedBuffer;
+using KaputEngine::Rendering::Buffer::TextureBuffer;
+using KaputEngine::Rendering::Buffer::VertexAttributeBuffer;
+using KaputEngine::Rendering::Buffer::VertexBuffer;
+
+using LibMath::Vector3f;
+using std::cerr;
+
+#pragma region UniformTarget
+UniformTarget::UniformTarget(const int location) noexcept : location(location) { }
+
+UniformTarget::UniformTarget(_In_z_ const char* const name) noexcept : name(name) { }
+
+UniformTarget::UniformTarget(const UniformReference& uniform) noexcept
+{
+	if (const char* const* str = std::get_if<const char*>(&uniform); str)
+		name = *str;
+	else
+		location = std::get<int>(uniform);
+}
+
+UniformTarget UniformTarget::operator+(const int offset) const noexcept
+{
+	UniformTarget target = *this;
+	target.location += offset;
+
+	return target;
+}
+#pragma endregion
+
+void CommandList::reset() noexcept
+{
+	m_commands.clear();
+	m_data.clear();
+
+	m_program = nullptr;
+	m_callbacks = false;
+}
+
+size_t CommandList::size() const noexcept
+{
+	return m_commands.size();
+}
+
+bool CommandList::empty() const noexcept
+{
+	return m_commands.empty();
+}
+
+const std::vector<RenderCommand>& CommandList::commands() const noexcept
+{
+	return m_commands;
+}
+
+bool CommandList::hasCallbacks() const noexcept
+{
+	return m_callbacks;
+}
+
+#pragma region Record
+RenderCommand& CommandList::add(const eCommandType type)
+{
+	RenderCommand& command = m_commands.emplace_back();
+	command.type = type;
+
+	return command;
+}
+
+void CommandList::clear(const Color& color)
+{
+	RenderCommand& command = add(eCommandType::CLEAR);
+	std::memcpy(command.clear.color, color.raw(), sizeof(command.clear.color));
+}
+
+void CommandList::useProgram(const ShaderProgram& program)
+{
+	add(eCommandType::USE_PROGRAM).program = { .id = program.id() };
+	m_program = &program;
+}
+
+void CommandList::bindStorageBuffer(const SharedBuffer& buffer)
+{
+	add(eCommandType::BIND_STORAGE_BUFFER).bufferBinding =
+	{
+		.id    = buffer.id(),
+		.index = buffer.index()
+	};
+}
+
+void CommandList::unbindStorageBuffer()
+{
+	add(eCommandType::UNBIND_STORAGE_BUFFER);
+}
+
+void CommandList::updateStorageBuffer(
+	const SharedBuffer& buffer, const size_t offset, const size_t size, _In_reads_bytes_(size) const void* const data)
+{
+	if (offset + size > buffer.size())
+	{
+		cerr << __FUNCTION__": Attempting to write outside of buffer bounds.\n";
+		return;
+	}
+
+	const uint32_t dataOffset = addData(data, size);
+
+	add(eCommandType::UPDATE_STORAGE_BUFFER).bufferData =
+	{
+		.id         = buffer.id(),
+		.offset     = static_cast<uint32_t>(offset),
+		.size       = static_cast<uint32_t>(size),
+		.dataOffset = dataOffset
+	};
+}
+
+void CommandList::uploadRingBuffer(RingBuffer& buffer, const size_t size, _In_reads_bytes_(size) const void* const data)
+{
+	if (size > buffer.size())
+	{
+		cerr << __FUNCTION__": Attempting to write outside of buffer bounds.\n";
+		return;
+	}
+
+	const uint32_t dataOffset = addData(data, size);
+
+	add(eCommandType::UPLOAD_RING_BUFFER).ringBuffer =
+	{
+		.buffer     = &buffer,
+		.size       = static_cast<uint32_t>(size),
+		.dataOffset = dataOffset
+	};
+}
+
+void CommandList::bindRingBuffer(RingBuffer& buffer)
+{
+	add(eCommandType::BIND_RING_BUFFER).ringBuffer = { .buffer = &buffer };
+}
+
+void CommandList::bindTexture(const TextureBuffer& texture, const unsigned int unitIndex)
+{
+	add(eCommandType::BIND_TEXTURE).texture =
+	{
+		.id        = texture.id(),
+		.unitIndex = unitIndex
+	};
+}
+
+void CommandList::drawElements(
+	const VertexAttributeBuffer& attributes, const VertexBuffer& vertices, const ElementBuffer& elements)
+{
+	add(eCommandType::DRAW_ELEMENTS).draw =
+	{
+		.vertexArray   = attributes.id(),
+		.vertexBuffer  = vertices.id(),
+		.elementBuffer = elements.id(),
+		.count         = elements.count(),
+		.indexType     = elements.indexType()
+	};
+}
+
+void CommandList::bindVertexArray(
+	const VertexAttributeBuffer& attributes, const VertexBuffer& vertices, const ElementBuffer& elements)
+{
+	add(eCommandType::BIND_VERTEX_ARRAY).draw =
+	{
+		.vertexArray   = attributes.id(),
+		.vertexBuffer  = vertices.id(),
+		.elementBuffer = elements.id(),
+		.count         = elements.count(),
+		.indexType     = elements.indexType()
+	};
+}
+
+void CommandList::drawBoundElements(const ElementBuffer& elements)
+{
+	add(eCommandType::DRAW_BOUND_ELEMENTS).boundDraw =
+	{
+		.count         = elements.count(),
+		.indexType     = elements.indexType(),
+		.instanceCount = 1
+	};
+}
+
+void CommandList::drawBoundElementsInstanced(const ElementBuffer& elements, const int instanceCount)
+{
+	add(eCommandType::DRAW_BOUND_ELEMENTS_INSTANCED).boundDraw =
+	{
+		.count         = elements.count(),
+		.indexType     = elements.indexType(),
+		.instanceCount = instanceCount
+	};
+}
+
+void CommandList::callback(
+	void (* const func)(void* object, const void* argument), void* const object, _In_opt_ const void* const argument)
+{
+	add(eCommandType::CALLBACK).callback =
+	{
+		.func     = func,
+		.object   = object,
+		.argument = argument
+	};
+
+	m_callbacks = true;
+}
+
+uint32_t CommandList::addData(_In_reads_bytes_(size) const void* const data, const size_t size)
+{
+	// Keep values aligned for the widest scalar
+	const size_t offset = (m_data.size() + alignof(double) - 1) & ~(alignof(double) - 1);
+
+	m_data.resize(offset + size);
+	std::memcpy(m_data.data() + offset, data, size);
+
+	return static_cast<uint32_t>(offset);
+}
+
+void CommandList::addUniform(const UniformTarget& uniform, const eUniformScalar scalar,
+	const uint8_t width, const uint8_t height, _In_reads_bytes_(size) const void* const values, const size_t size)
+{
+	int location = uniform.location;
+
+	if (uniform.name)
+	{
+		const int base = m_program ? m_program->reflection().location(uniform.name) : -1;
+
+		if (base == -1)
+		{
+			if (m_program)
+				m_program->reportMissingUniform(uniform.name);
+
+			return;
+		}
+
+		location += base;
+	}
+
+	const uint32_t dataOffset = addData(values, size);
+
+	add(eCommandType::SET_UNIFORM).uniform =
+	{
+		.location   = location,
+		.dataOffset = dataOffset,
+		.count      = 1,
+		.scalar     = scalar,
+		.width      = width,
+		.height     = height
+	};
+}
+
+void CommandList::setUniform(const UniformTarget& uniform, const int value)
+{
+	addUniform(uniform, eUniformScalar::INT, 1, 1, &value, sizeof(value));
+}
+
+void CommandList::setUniform(const UniformTarget& uniform, const unsigned int value)
+{
+	addUniform(uniform, eUniformScalar::UNSIGNED_INT, 1, 1, &value, sizeof(value));
+}
+
+void CommandList::setUniform(const UniformTarget& uniform, const float value)
+{
+	addUniform(uniform, eUniformScalar::FLOAT, 1, 1, &value, sizeof(value));
+}
+
+void CommandList::setUniform(const UniformTarget& uniform, const double value)
+{
+	addUniform(uniform, eUniformScalar::DOUBLE, 1, 1, &value, sizeof(value));
+}
+
+void CommandList::setUniform(const UniformTarget& uniform, const bool value)
+{
+	// GLSL booleans are set as integers
+	setUniform(uniform, static_cast<int>(value));
+}
+
+void CommandList::setUniform(const UniformTarget& uniform, const Material& material)
+{
+	setUniform(uniform, material.albedo());
+	setUniform(uniform + 3, material.normal());
+	setUniform(uniform + 6, material.metallic());
+	setUniform(uniform + 9, material.roughness());
+	setUniform(uniform + 12, material.ambientOcclusion());
+}
+
+void CommandList::setUniform(const UniformTarget& uniform, const MaterialLayer& layer)
+{
+	setUniform(uniform, layer.getSampler<Color>(&Material::albedo));
+	setUniform(uniform + 3, layer.getSampler<Vector3f>(&Material::normal));
+	setUniform(uniform + 6, layer.getSampler<float>(&Material::metallic));
+	setUniform(uniform + 9, layer.getSampler<float>(&Material::roughness));
+	setUniform(uniform + 12, layer.getSampler<float>(&Material::ambientOcclusion));
+}
+
+void CommandList::setUniform(const UniformTarget& uniform, const Camera& camera)
+{
+	setUniform(uniform, camera.getWorldTransform().position);
+	setUniform(uniform + 1, camera.getViewProjectionMatrix());
+}
+#pragma endregion
+
+#pragma region Submit
+namespace
+{
+#define UNIFORM_VECTOR_CASE(length, typeSuffix, type) \
+case length: glUniform##length##typeSuffix##v(location, count, reinterpret_cast<const type*>(data)); return true;
+
+#define UNIFORM_VECTOR_SWITCH(typeSuffix, type) \
+switch (cmd.height) \
+{ \
+UNIFORM_VECTOR_CASE(1, typeSuffix, type) \
+UNIFORM_VECTOR_CASE(2, typeSuffix, type) \
+UNIFORM_VECTOR_CASE(3, typeSuffix, type) \
+UNIFORM_VECTOR_CASE(4, typeSuffix, type) \
+default: return false; \
+}
+
+#define UNIFORM_MATRIX_CASE(width, height, sizeName, typeSuffix, type) \
+case (width) * 8 + (height): glUniformMatrix##sizeName##typeSuffix##v(location, count, GL_FALSE, reinterpret_cast<const type*>(data)); return true;
+
+#define UNIFORM_MATRIX_SWITCH(typeSuffix, type) \
+switch (cmd.width * 8 + cmd.height) \
+{ \
+UNIFORM_MATRIX_CASE(2, 2, 2, typeSuffix, type) \
+UNIFORM_MATRIX_CASE(2, 3, 2x3, typeSuffix, type) \
+UNIFORM_MATRIX_CASE(2, 4, 2x4, typeSuffix, type) \
+UNIFORM_MATRIX_CASE(3, 2, 3x2, typeSuffix, type) \
+UNIFORM_MATRIX_CASE(3, 3, 3, typeSuffix, type) \
+UNIFORM_MATRIX_CASE(3, 4, 3x4, typeSuffix, type) \
+UNIFORM_MATRIX_CASE(4, 2, 4x2, typeSuffix, type) \
+UNIFORM_MATRIX_CASE(4, 3, 4x3, typeSuffix, type) \
+UNIFORM_MATRIX_CASE(4, 4, 4, typeSuffix, type) \
+default: return false; \
+}
+
+	/// <summary>
+	/// Dispatches a uniform command to the matching glUniform function.
+	/// </summary>
+	/// <returns>False if the dimensions are not supported by the scalar type</returns>
+	_Success_(return) bool applyUniform(const GLint location, const UniformCommand& cmd, const std::byte* const data)
+	{
+		const GLsizei count = cmd.count;
+
+		if (cmd.width == 1)
+		{
+			switch (cmd.scalar)
+			{
+			case eUniformScalar::INT:
+				UNIFORM_VECTOR_SWITCH(i, GLint)
+			case eUniformScalar::UNSIGNED_INT:
+				UNIFORM_VECTOR_SWITCH(ui, GLuint)
+			case eUniformScalar::FLOAT:
+				UNIFORM_VECTOR_SWITCH(f, GLfloat)
+			case eUniformScalar::DOUBLE:
+				UNIFORM_VECTOR_SWITCH(d, GLdouble)
+			}
+		}
+		else
+		{
+			switch (cmd.scalar)
+			{
+			case eUniformScalar::FLOAT:
+				UNIFORM_MATRIX_SWITCH(f, GLfloat)
+			case eUniformScalar::DOUBLE:
+				UNIFORM_MATRIX_SWITCH(d, GLdouble)
+			default:
+				break;
+			}
+		}
+
+		return false;
+	}
+
+#undef UNIFORM_VECTOR_CASE
+#undef UNIFORM_VECTOR_SWITCH
+#undef UNIFORM_MATRIX_CASE
+#undef UNIFORM_MATRIX_SWITCH
+}
+
+void CommandList::submit() const
+{
+	// Whether the last vertex array binding had its buffers created
+	bool boundValid = false;
+
+	for (const RenderCommand& command : m_commands)
+	{
+		switch (command.type)
+		{
+		case eCommandType::CLEAR:
+		{
+			const float* const col = command.clear.color;
+
+			glClearColor(col[0], col[1], col[2], col[3]);
+			glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+			break;
+		}
+		case eCommandType::USE_PROGRAM:
+			glUseProgram(command.program.id);
+			break;
+		case eCommandType::BIND_STORAGE_BUFFER:
+			glBindBuffer(GL_SHADER_STORAGE_BUFFER, command.bufferBinding.id);
+			glBindBufferBase(GL_SHADER_STORAGE_BUFFER, command.bufferBinding.index, command.bufferBinding.id);
+			break;
+		case eCommandType::UNBIND_STORAGE_BUFFER:
+			glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+			break;
+		case eCommandType::UPDATE_STORAGE_BUFFER:
+		{
+			const BufferDataCommand& cmd = command.bufferData;
+
+			glBindBuffer(GL_SHADER_STORAGE_BUFFER, cmd.id);
+			glBufferSubData(GL_SHADER_STORAGE_BUFFER, cmd.offset, cmd.size, m_data.data() + cmd.dataOffset);
+			glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+			break;
+		}
+		case eCommandType::UPLOAD_RING_BUFFER:
+		{
+			const RingBufferCommand& cmd = command.ringBuffer;
+			cmd.buffer->upload(m_data.data() + cmd.dataOffset, cmd.size);
+			break;
+		}
+		case eCommandType::BIND_RING_BUFFER:
+			command.ringBuffer.buffer->bindRegion();
+			break;
+		case eCommandType::SET_UNIFORM:
+		{
+			const UniformCommand& cmd = command.uniform;
+
+			if (!applyUniform(cmd.location, cmd, m_data.data() + cmd.dataOffset))
+				cerr << __FUNCTION__": Unsupported uniform dimensions.\n";
+
+			break;
+		}
+		case eCommandType::BIND_TEXTURE:
+			glActiveTexture(GL_TEXTURE0 + command.texture.unitIndex);
+			glBindTexture(GL_TEXTURE_2D, command.texture.id);
+			break;
+		case eCommandType::DRAW_ELEMENTS:
+		{
+			const DrawCommand& draw = command.draw;
+
+			if (!draw.vertexBuffer)
+				break;
+
+			glBindVertexArray(draw.vertexArray);
+			glBindBuffer(GL_ARRAY_BUFFER, draw.vertexBuffer);
+			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, draw.elementBuffer);
+			glDrawElements(GL_TRIANGLES, draw.count, draw.indexType, nullptr);
+			break;
+		}
+		case eCommandType::BIND_VERTEX_ARRAY:
+		{
+			const DrawCommand& bind = command.draw;
+			boundValid = bind.vertexBuffer != 0;
+
+			if (!boundValid)
+				break;
+
+			glBindVertexArray(bind.vertexArray);
+			glBindBuffer(GL_ARRAY_BUFFER, bind.vertexBuffer);
+			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, bind.elementBuffer);
+			break;
+		}
+		case eCommandType::DRAW_BOUND_ELEMENTS:
+			if (boundValid)
+				glDrawElements(GL_TRIANGLES, command.boundDraw.count, command.boundDraw.indexType, nullptr);
+
+			break;
+		case eCommandType::DRAW_BOUND_ELEMENTS_INSTANCED:
+		{
+			const BoundDrawCommand& draw = command.boundDraw;
+
+			if (boundValid)
+				glDrawElementsInstanced(GL_TRIANGLES, draw.count, draw.indexType, nullptr, draw.instanceCount);
+
+			break;
+		}
+		case eCommandType::CALLBACK:
+			command.callback.func(command.callback.object, command.callback.argument);
+			break;
+		}
+	}
+}
+#pragma endregion
@@ -0,0 +1,214 @@
+#include "Rendering/Culling/Bounds.h"
+
+#include <algorithm>
+#include <cmath>
+
+using KaputEngine::Rendering::Culling::BoundingBox;
+using KaputEngine::Rendering::Culling::BoundingSphere;
+using KaputEngine::Rendering::Culling::Bounds;
+
+using LibMath::Cartesian3f;
+using LibMath::Matrix4f;
+
+namespace
+{
+	Cartesian3f transformPoint(const Matrix4f& matrix, const Cartesian3f& point) noexcept
+	{
+		const float (&m)[4][4] = matrix.raw2D();
+		Cartesian3f out;
+
+		for (int y = 0; y < 3; ++y)
+			out.raw()[y] = m[0][y] * point.raw()[0] + m[1][y] * point.raw()[1] + m[2][y] * point.raw()[2] + m[3][y];
+
+		return out;
+	}
+
+	float lengthSquared(const Cartesian3f& vector) noexcept
+	{
+		return vector.raw()[0] * vector.raw()[0] + vector.raw()[1] * vector.raw()[1] + vector.raw()[2] * vector.raw()[2];
+	}
+}
+
+bool BoundingBox::empty() const noexcept
+{
+	return min.raw()[0] > max.raw()[0];
+}
+
+Cartesian3f BoundingBox::center() const noexcept
+{
+	return (min + max) * .5f;
+}
+
+Cartesian3f BoundingBox::extents() const noexcept
+{
+	return (max - min) * .5f;
+}
+
+void BoundingBox::merge(const Cartesian3f& point) noexcept
+{
+	for (int i = 0; i < 3; ++i)
+	{
+		min.raw()[i] = std::min(min.raw()[i], point.raw()[i]);
+		max.raw()[i] = std::max(max.raw()[i], point.raw()[i]);
+	}
+}
+
+void BoundingBox::merge(const BoundingBox& box) noexcept
+{
+	if (box.empty())
+		return;
+
+	merge(box.min);
+	merge(box.max);
+}
+
+bool BoundingBox::intersects(const BoundingBox& box) const noexcept
+{
+	for (int i = 0; i < 3; ++i)
+		if (max.raw()[i] < box.min.raw()[i] || box.max.raw()[i] < min.raw()[i])
+			return false;
+
+	return true;
+}
+
+bool BoundingBox::intersects(const BoundingSphere& sphere) const noexcept
+{
+	// Distance from the center to the closest point of the box
+	float distanceSquared = 0.f;
+
+	for (int i = 0; i < 3; ++i)
+	{
+		const float
+			center = sphere.center.raw()[i],
+			offset = std::max({ min.raw()[i] - center, 0.f, center - max.raw()[i] });
+
+		distanceSquared += offset * offset;
+	}
+
+	return distanceSquared <= sphere.radius * sphere.radius;
+}
+
+BoundingBox BoundingBox::transform(const Matrix4f& matrix) const noexcept
+{
+	if (empty())
+		return *this;
+
+	const float (&m)[4][4] = matrix.raw2D();
+
+	const Cartesian3f
+		center = transformPoint(matrix, this->center()),
+		extents = this->extents();
+
+	// Extents of the rotated box projected back on each axis
+	Cartesian3f worldExtents;
+
+	for (int y = 0; y < 3; ++y)
+		worldExtents.raw()[y] =
+			std::abs(m[0][y]) * extents.raw()[0] +
+			std::abs(m[1][y]) * extents.raw()[1] +
+			std::abs(m[2][y]) * extents.raw()[2];
+
+	return { center - worldExtents, center + worldExtents };
+}
+
+bool BoundingSphere::empty() const noexcept
+{
+	return radius < 0.f;
+}
+
+BoundingSphere BoundingSphere::transform(const Matrix4f& matrix) const noexcept
+{
+	if (empty())
+		return *this;
+
+	const float (&m)[4][4] = matrix.raw2D();
+
+	float maxScaleSquared = 0.f;
+
+	for (int x = 0; x < 3; ++x)
+		maxScaleSquared = std::max(maxScaleSquared, m[x][0] * m[x][0] + m[x][1] * m[x][1] + m[x][2] * m[x][2]);
+
+	return { transformPoint(matrix, center), radius * std::sqrt(maxScaleSquared) };
+}
+
+Bounds Bounds::fromPoints(_In_reads_(count) const Cartesian3f* const points, const size_t count) noexcept
+{
+	Bounds out;
+
+	for (size_t i = 0; i < count; ++i)
+		out.box.merge(points[i]);
+
+	if (out.box.empty())
+		return out;
+
+	// Tighter than the circumscribed sphere as it only needs to reach the actual points
+	out.sphere.center = out.box.center();
+
+	float radiusSquared = 0.f;
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		radiusSquared = std::max(radiusSquared, lengthSquared(points[i] - out.sphere.center));
+	}
+
+	out.sphere.radius = std::sqrt(radiusSquared);
+
+	return out;
+}
+
+Bounds Bounds::fromBox(const BoundingBox& box) noexcept
+{
+	Bounds out;
+	out.box = box;
+
+	if (box.empty())
+		return out;
+
+	out.sphere.center = box.center();
+	out.sphere.radius = std::sqrt(lengthSquared(box.extents()));
+
+	return out;
+}
+
+bool Bounds::empty() const noexcept
+{
+	return box.empty();
+}
+
+void Bounds::merge(const Bounds& bounds) noexcept
+{
+	if (bounds.empty())
+		return;
+
+	if (empty())
+	{
+		*this = bounds;
+		return;
+	}
+
+	box.merge(bounds.box);
+
+	// Smallest sphere containing both spheres
+	const Cartesian3f offset = bounds.sphere.center - sphere.center;
+
+	const float distance = std::sqrt(lengthSquared(offset));
+
+	if (distance + bounds.sphere.radius <= sphere.radius)
+		return;
+
+	if (distance + sphere.radius <= bounds.sphere.radius)
+	{
+		sphere = bounds.sphere;
+		return;
+	}
+
+	const float radius = (distance + sphere.radius + bounds.sphere.radius) * .5f;
+
+	sphere.center = sphere.center + offset * ((radius - sphere.radius) / distance);
+	sphere.radius = radius;
+}
+
+Bounds Bounds::transform(const Matrix4f& matrix) const noexcept
+{
+	return { box.transform(matrix), sphere.transform(matrix) };
+}
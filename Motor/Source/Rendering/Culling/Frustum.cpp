@@ -0,0 +1,90 @@
+#include "Rendering/Culling/Frustum.h"
+
+#include <cmath>
+
+using KaputEngine::Rendering::Culling::BoundingBox;
+using KaputEngine::Rendering::Culling::BoundingSphere;
+using KaputEngine::Rendering::Culling::Bounds;
+using KaputEngine::Rendering::Culling::Frustum;
+using KaputEngine::Rendering::Culling::Plane;
+
+using LibMath::Cartesian3f;
+using LibMath::Matrix4f;
+
+float Plane::signedDistance(const Cartesian3f& point) const noexcept
+{
+	return normal[0] * point.raw()[0] + normal[1] * point.raw()[1] + normal[2] * point.raw()[2] + distance;
+}
+
+Frustum::Frustum(const Matrix4f& viewProjection) noexcept
+{
+	const float (&m)[4][4] = viewProjection.raw2D();
+
+	// Gribb-Hartmann: each plane is the last row of the matrix plus or minus another row
+	const auto extract = [&m](Plane& plane, const int row, const float sign)
+	{
+		for (int x = 0; x < 3; ++x)
+			plane.normal[x] = m[x][3] + sign * m[x][row];
+
+		plane.distance = m[3][3] + sign * m[3][row];
+
+		const float length = std::sqrt(
+			plane.normal[0] * plane.normal[0] +
+			plane.normal[1] * plane.normal[1] +
+			plane.normal[2] * plane.normal[2]);
+
+		if (length <= 0.f)
+			return;
+
+		for (float& value : plane.normal)
+			value /= length;
+
+		plane.distance /= length;
+	};
+
+	extract(m_planes[LEFT],       0,  1.f);
+	extract(m_planes[RIGHT],      0, -1.f);
+	extract(m_planes[BOTTOM],     1,  1.f);
+	extract(m_planes[TOP],        1, -1.f);
+	extract(m_planes[NEAR_PLANE], 2,  1.f);
+	extract(m_planes[FAR_PLANE],  2, -1.f);
+}
+
+const std::array<Plane, Frustum::COUNT>& Frustum::planes() const noexcept
+{
+	return m_planes;
+}
+
+bool Frustum::intersects(const BoundingSphere& sphere) const noexcept
+{
+	for (const Plane& plane : m_planes)
+		if (plane.signedDistance(sphere.center) < -sphere.radius)
+			return false;
+
+	return true;
+}
+
+bool Frustum::intersects(const BoundingBox& box) const noexcept
+{
+	for (const Plane& plane : m_planes)
+	{
+		// Corner furthest along the plane normal
+		Cartesian3f corner;
+
+		for (int i = 0; i < 3; ++i)
+			corner.raw()[i] = plane.normal[i] >= 0.f ? box.max.raw()[i] : box.min.raw()[i];
+
+		if (plane.signedDistance(corner) < 0.f)
+			return false;
+	}
+
+	return true;
+}
+
+bool Frustum::intersects(const Bounds& bounds) const noexcept
+{
+	if (bounds.empty())
+		return true;
+
+	return intersects(bounds.sphere) && intersects(bounds.box);
+}
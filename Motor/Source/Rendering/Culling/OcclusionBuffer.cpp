@@ -0,0 +1,461 @@
+#include "Rendering/Culling/OcclusionBuffer.h"
+
+#include "Profiling/Profiler.h"
+#include "Rendering/Mesh.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+#if defined(_M_X64) || defined(__SSE2__)
+#define OCCLUSION_SSE2 1
+#include <emmintrin.h>
+#else
+#define OCCLUSION_SSE2 0
+#endif
+
+using KaputEngine::Job::eJobPriority;
+using KaputEngine::Job::JobHandle;
+using KaputEngine::Job::JobSystem;
+using KaputEngine::Rendering::Mesh;
+using KaputEngine::Rendering::Culling::BoundingBox;
+using KaputEngine::Rendering::Culling::Bounds;
+using KaputEngine::Rendering::Culling::Frustum;
+using KaputEngine::Rendering::Culling::OcclusionBuffer;
+using KaputEngine::Rendering::Culling::Occluder;
+
+using LibMath::Cartesian3f;
+using LibMath::Matrix4f;
+
+namespace
+{
+	using ClipVertex = std::array<float, 4>;
+
+	void transform(const float (&m)[4][4], const Cartesian3f& point, ClipVertex& out) noexcept
+	{
+		for (int row = 0; row < 4; ++row)
+			out[row] = m[0][row] * point.x() + m[1][row] * point.y() + m[2][row] * point.z() + m[3][row];
+	}
+
+	// Distance to the OpenGL near plane, z = -w, positive in front
+	float nearDistance(const ClipVertex& vertex) noexcept
+	{
+		return vertex[2] + vertex[3];
+	}
+
+	// Whether the three vertices are all outside the same side plane
+	bool outsideSide(const ClipVertex& a, const ClipVertex& b, const ClipVertex& c) noexcept
+	{
+		for (int axis = 0; axis < 2; ++axis)
+		{
+			if (a[axis] > a[3] && b[axis] > b[3] && c[axis] > c[3])
+				return true;
+
+			if (a[axis] < -a[3] && b[axis] < -b[3] && c[axis] < -c[3])
+				return true;
+		}
+
+		return false;
+	}
+}
+
+OcclusionBuffer::OcclusionBuffer() :
+	m_depth(static_cast<size_t>(Width) * Height, 1.f),
+	m_tileNearest(static_cast<size_t>(TilesX) * TilesY, 1.f),
+	m_tileFarthest(static_cast<size_t>(TilesX) * TilesY, 1.f) { }
+
+JobHandle OcclusionBuffer::rasterize(
+	const Matrix4f& viewProjection, const Frustum& frustum, const std::span<const Occluder> occluders)
+{
+	clear();
+	m_viewProjection = viewProjection;
+
+	if (occluders.empty())
+		return nullptr;
+
+	return JobSystem::instance().schedule([this, frustum, occluders]
+	{
+		PROFILE_ZONE("OcclusionBuffer::rasterize");
+
+		setup(frustum, occluders);
+
+		if (m_triangles.empty())
+			return;
+
+		JobSystem& jobs = JobSystem::instance();
+		JobHandle bands[BandCount];
+
+		for (uint32_t band = 0; band < BandCount; ++band)
+			bands[band] = jobs.schedule([this, band] { rasterizeBand(band); }, eJobPriority::HIGH);
+
+		for (const JobHandle& band : bands)
+			jobs.wait(band);
+
+		m_empty = false;
+	}, eJobPriority::HIGH);
+}
+
+void OcclusionBuffer::rasterizeNow(
+	const Matrix4f& viewProjection, const Frustum& frustum, const std::span<const Occluder> occluders)
+{
+	PROFILE_FUNCTION();
+
+	clear();
+	m_viewProjection = viewProjection;
+
+	setup(frustum, occluders);
+
+	for (uint32_t band = 0; band < BandCount; ++band)
+		rasterizeBand(band);
+
+	m_empty = m_triangles.empty();
+}
+
+bool OcclusionBuffer::occluded(const BoundingBox& box) const noexcept
+{
+	if (m_empty || box.empty())
+		return false;
+
+	const float (&m)[4][4] = m_viewProjection.raw2D();
+
+	float
+		minX = Width, minY = Height,
+		maxX = 0.f, maxY = 0.f,
+		nearest = 1.f;
+
+	for (uint8_t corner = 0; corner < 8; ++corner)
+	{
+		const Cartesian3f point
+		{
+			corner & 1 ? box.max.x() : box.min.x(),
+			corner & 2 ? box.max.y() : box.min.y(),
+			corner & 4 ? box.max.z() : box.min.z()
+		};
+
+		ClipVertex clip;
+		transform(m, point, clip);
+
+		// The box reaches the camera, its projection is unbounded
+		if (nearDistance(clip) <= 0.f || clip[3] <= 0.f)
+			return false;
+
+		const float inverseW = 1.f / clip[3];
+
+		minX = std::min(minX, (clip[0] * inverseW * .5f + .5f) * Width);
+		maxX = std::max(maxX, (clip[0] * inverseW * .5f + .5f) * Width);
+		minY = std::min(minY, (clip[1] * inverseW * .5f + .5f) * Height);
+		maxY = std::max(maxY, (clip[1] * inverseW * .5f + .5f) * Height);
+		nearest = std::min(nearest, clip[2] * inverseW * .5f + .5f);
+	}
+
+	// Pixels touched by the projected box, the parts outside of the screen are never occluded by anything drawn
+	const int
+		x0 = std::max(0, static_cast<int>(std::floor(minX))),
+		y0 = std::max(0, static_cast<int>(std::floor(minY))),
+		x1 = std::min(static_cast<int>(Width) - 1, static_cast<int>(std::floor(maxX))),
+		y1 = std::min(static_cast<int>(Height) - 1, static_cast<int>(std::floor(maxY)));
+
+	if (x0 > x1 || y0 > y1)
+		return false;
+
+	const float threshold = nearest - DepthBias;
+
+	for (int tileY = y0 / TileSize; tileY <= y1 / static_cast<int>(TileSize); ++tileY)
+		for (int tileX = x0 / TileSize; tileX <= x1 / static_cast<int>(TileSize); ++tileX)
+		{
+			const size_t tile = static_cast<size_t>(tileY) * TilesX + tileX;
+
+			// Every pixel of the tile is nearer than the box
+			if (m_tileFarthest[tile] < threshold)
+				continue;
+
+			// No pixel of the tile is
+			if (m_tileNearest[tile] >= threshold)
+				return false;
+
+			const int
+				startX = std::max(x0, tileX * static_cast<int>(TileSize)),
+				startY = std::max(y0, tileY * static_cast<int>(TileSize)),
+				endX   = std::min(x1, (tileX + 1) * static_cast<int>(TileSize) - 1),
+				endY   = std::min(y1, (tileY + 1) * static_cast<int>(TileSize) - 1);
+
+			for (int y = startY; y <= endY; ++y)
+				for (int x = startX; x <= endX; ++x)
+					if (m_depth[static_cast<size_t>(y) * Width + x] >= threshold)
+						return false;
+		}
+
+	return true;
+}
+
+bool OcclusionBuffer::occluded(const Bounds& bounds) const noexcept
+{
+	return occluded(bounds.box);
+}
+
+float OcclusionBuffer::depth(const uint32_t x, const uint32_t y) const noexcept
+{
+	return m_depth[static_cast<size_t>(y) * Width + x];
+}
+
+uint32_t OcclusionBuffer::triangleCount() const noexcept
+{
+	return static_cast<uint32_t>(m_triangles.size());
+}
+
+void OcclusionBuffer::clear() noexcept
+{
+	std::fill(m_depth.begin(), m_depth.end(), 1.f);
+	std::fill(m_tileNearest.begin(), m_tileNearest.end(), 1.f);
+	std::fill(m_tileFarthest.begin(), m_tileFarthest.end(), 1.f);
+
+	m_triangles.clear();
+
+	for (std::vector<uint32_t>& bin : m_bins)
+		bin.clear();
+
+	m_empty = true;
+}
+
+void OcclusionBuffer::setup(const Frustum& frustum, const std::span<const Occluder> occluders)
+{
+	PROFILE_FUNCTION();
+
+	std::vector<ClipVertex> clip;
+
+	for (const Occluder& occluder : occluders)
+	{
+		const std::span<const Cartesian3f> positions = occluder.mesh->occluderPositions();
+		const std::span<const unsigned int> indices = occluder.mesh->occluderIndices();
+
+		if (indices.empty() || !frustum.intersects(occluder.mesh->localBounds().transform(occluder.model)))
+			continue;
+
+		const Matrix4f modelViewProjection = m_viewProjection * occluder.model;
+		const float (&m)[4][4] = modelViewProjection.raw2D();
+
+		clip.resize(positions.size());
+
+		for (size_t v = 0; v < positions.size(); ++v)
+			transform(m, positions[v], clip[v]);
+
+		for (size_t i = 0; i + 2 < indices.size(); i += 3)
+		{
+			const ClipVertex* const corners[3] { &clip[indices[i]], &clip[indices[i + 1]], &clip[indices[i + 2]] };
+
+			if (outsideSide(*corners[0], *corners[1], *corners[2]))
+				continue;
+
+			// Clipped to the near plane, leaving up to four vertices
+			ClipVertex polygon[4];
+			uint8_t count = 0;
+
+			for (uint8_t corner = 0; corner < 3; ++corner)
+			{
+				const ClipVertex
+					&current = *corners[corner],
+					&next    = *corners[(corner + 1) % 3];
+
+				const float
+					currentDistance = nearDistance(current),
+					nextDistance    = nearDistance(next);
+
+				if (currentDistance >= 0.f)
+					polygon[count++] = current;
+
+				if ((currentDistance >= 0.f) != (nextDistance >= 0.f))
+				{
+					const float t = currentDistance / (currentDistance - nextDistance);
+
+					for (uint8_t component = 0; component < 4; ++component)
+						polygon[count][component] = current[component] + (next[component] - current[component]) * t;
+
+					++count;
+				}
+			}
+
+			for (uint8_t fan = 2; fan < count; ++fan)
+				addTriangle(polygon[0].data(), polygon[fan - 1].data(), polygon[fan].data());
+		}
+	}
+}
+
+void OcclusionBuffer::addTriangle(const float* const a, const float* const b, const float* const c)
+{
+	float x[3], y[3], z[3];
+
+	const float* const vertices[3] { a, b, c };
+
+	for (uint8_t v = 0; v < 3; ++v)
+	{
+		const float* const vertex = vertices[v];
+
+		// Points on the near plane itself
+		if (vertex[3] <= 0.f)
+			return;
+
+		const float inverseW = 1.f / vertex[3];
+
+		x[v] = (vertex[0] * inverseW * .5f + .5f) * Width;
+		y[v] = (vertex[1] * inverseW * .5f + .5f) * Height;
+		z[v] = vertex[2] * inverseW * .5f + .5f;
+	}
+
+	float area = (x[1] - x[0]) * (y[2] - y[0]) - (y[1] - y[0]) * (x[2] - x[0]);
+
+	if (std::abs(area) < 1e-6f)
+		return;
+
+	// Occluders hide from both sides
+	if (area < 0.f)
+	{
+		std::swap(x[1], x[2]);
+		std::swap(y[1], y[2]);
+		std::swap(z[1], z[2]);
+		area = -area;
+	}
+
+	Triangle triangle;
+
+	for (uint8_t edge = 0; edge < 3; ++edge)
+	{
+		const uint8_t next = (edge + 1) % 3;
+
+		triangle.edgeA[edge] = y[edge] - y[next];
+		triangle.edgeB[edge] = x[next] - x[edge];
+		triangle.edgeC[edge] = x[edge] * y[next] - y[edge] * x[next];
+	}
+
+	triangle.depthA = ((z[1] - z[0]) * (y[2] - y[0]) - (z[2] - z[0]) * (y[1] - y[0])) / area;
+	triangle.depthB = ((z[2] - z[0]) * (x[1] - x[0]) - (z[1] - z[0]) * (x[2] - x[0])) / area;
+	triangle.depthC = z[0] - triangle.depthA * x[0] - triangle.depthB * y[0];
+
+	triangle.nearest = std::max(0.f, std::min({ z[0], z[1], z[2] }));
+
+	// Entirely past the far plane
+	if (triangle.nearest >= 1.f)
+		return;
+
+	triangle.minX = std::max(0, static_cast<int>(std::floor(std::min({ x[0], x[1], x[2] }))));
+	triangle.minY = std::max(0, static_cast<int>(std::floor(std::min({ y[0], y[1], y[2] }))));
+	triangle.maxX = std::min(static_cast<int>(Width) - 1, static_cast<int>(std::ceil(std::max({ x[0], x[1], x[2] }))));
+	triangle.maxY = std::min(static_cast<int>(Height) - 1, static_cast<int>(std::ceil(std::max({ y[0], y[1], y[2] }))));
+
+	if (triangle.minX > triangle.maxX || triangle.minY > triangle.maxY)
+		return;
+
+	const uint32_t index = static_cast<uint32_t>(m_triangles.size());
+	m_triangles.push_back(triangle);
+
+	for (uint32_t band = triangle.minY / BandHeight; band <= triangle.maxY / BandHeight; ++band)
+		m_bins[band].push_back(index);
+}
+
+void OcclusionBuffer::rasterizeBand(const uint32_t band) noexcept
+{
+	if (m_bins[band].empty())
+		return;
+
+	const int
+		bandMinY = static_cast<int>(band * BandHeight),
+		bandMaxY = bandMinY + static_cast<int>(BandHeight) - 1;
+
+	for (const uint32_t index : m_bins[band])
+		rasterizeTriangle(m_triangles[index], bandMinY, bandMaxY);
+
+	updateTiles(band);
+}
+
+void OcclusionBuffer::rasterizeTriangle(const Triangle& triangle, const int bandMinY, const int bandMaxY) noexcept
+{
+	const int
+		startY = std::max(triangle.minY, bandMinY),
+		endY   = std::min(triangle.maxY, bandMaxY),
+		// Rows are processed in aligned groups of four pixels
+		startX = triangle.minX & ~3;
+
+#if OCCLUSION_SSE2
+	const __m128 laneOffsets = _mm_setr_ps(.5f, 1.5f, 2.5f, 3.5f);
+
+	const __m128
+		edgeA0 = _mm_set1_ps(triangle.edgeA[0]),
+		edgeA1 = _mm_set1_ps(triangle.edgeA[1]),
+		edgeA2 = _mm_set1_ps(triangle.edgeA[2]),
+		depthA = _mm_set1_ps(triangle.depthA),
+		zero   = _mm_setzero_ps();
+#endif
+
+	for (int y = startY; y <= endY; ++y)
+	{
+		const float centerY = static_cast<float>(y) + .5f;
+		float* const row = m_depth.data() + static_cast<size_t>(y) * Width;
+
+		const float
+			rowEdge0 = triangle.edgeB[0] * centerY + triangle.edgeC[0],
+			rowEdge1 = triangle.edgeB[1] * centerY + triangle.edgeC[1],
+			rowEdge2 = triangle.edgeB[2] * centerY + triangle.edgeC[2],
+			rowDepth = triangle.depthB * centerY + triangle.depthC;
+
+		for (int x = startX; x <= triangle.maxX; x += 4)
+		{
+#if OCCLUSION_SSE2
+			const __m128 centerX = _mm_add_ps(_mm_set1_ps(static_cast<float>(x)), laneOffsets);
+
+			const __m128
+				edge0 = _mm_add_ps(_mm_mul_ps(edgeA0, centerX), _mm_set1_ps(rowEdge0)),
+				edge1 = _mm_add_ps(_mm_mul_ps(edgeA1, centerX), _mm_set1_ps(rowEdge1)),
+				edge2 = _mm_add_ps(_mm_mul_ps(edgeA2, centerX), _mm_set1_ps(rowEdge2));
+
+			const __m128 inside = _mm_and_ps(
+				_mm_and_ps(_mm_cmpge_ps(edge0, zero), _mm_cmpge_ps(edge1, zero)), _mm_cmpge_ps(edge2, zero));
+
+			if (!_mm_movemask_ps(inside))
+				continue;
+
+			const __m128
+				depth   = _mm_add_ps(_mm_mul_ps(depthA, centerX), _mm_set1_ps(rowDepth)),
+				current = _mm_loadu_ps(row + x),
+				nearer  = _mm_min_ps(current, depth);
+
+			_mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(inside, nearer), _mm_andnot_ps(inside, current)));
+#else
+			for (int lane = 0; lane < 4; ++lane)
+			{
+				const float centerX = static_cast<float>(x + lane) + .5f;
+
+				if (triangle.edgeA[0] * centerX + rowEdge0 < 0.f ||
+					triangle.edgeA[1] * centerX + rowEdge1 < 0.f ||
+					triangle.edgeA[2] * centerX + rowEdge2 < 0.f)
+					continue;
+
+				row[x + lane] = std::min(row[x + lane], triangle.depthA * centerX + rowDepth);
+			}
+#endif
+		}
+	}
+}
+
+void OcclusionBuffer::updateTiles(const uint32_t band) noexcept
+{
+	constexpr uint32_t BandTiles = BandHeight / TileSize;
+
+	for (uint32_t tileY = band * BandTiles; tileY < (band + 1) * BandTiles; ++tileY)
+		for (uint32_t tileX = 0; tileX < TilesX; ++tileX)
+		{
+			float nearest = 1.f, farthest = 0.f;
+
+			for (uint32_t y = tileY * TileSize; y < (tileY + 1) * TileSize; ++y)
+			{
+				const float* const row = m_depth.data() + static_cast<size_t>(y) * Width + tileX * TileSize;
+
+				for (uint32_t x = 0; x < TileSize; ++x)
+				{
+					nearest = std::min(nearest, row[x]);
+					farthest = std::max(farthest, row[x]);
+				}
+			}
+
+			m_tileNearest[tileY * TilesX + tileX] = nearest;
+			m_tileFarthest[tileY * TilesX + tileX] = farthest;
+		}
+}
@@ -0,0 +1,350 @@
+#include "Rendering/DrawQueue.h"
+
+#include "Profiling/Profiler.h"
+#include "Rendering/Command/CommandList.hpp"
+#include "Rendering/Material.hpp"
+#include "Rendering/Mesh.h"
+#include "Rendering/ShaderProgram.h"
+
+#include <algorithm>
+#include <cmath>
+
+using KaputEngine::Rendering::DrawItem;
+using KaputEngine::Rendering::DrawQueue;
+using KaputEngine::Rendering::DrawStats;
+using KaputEngine::Rendering::EngineUniforms;
+using KaputEngine::Rendering::eRenderPass;
+using KaputEngine::Rendering::Material;
+using KaputEngine::Rendering::MaterialLayer;
+using KaputEngine::Rendering::Mesh;
+using KaputEngine::Rendering::ShaderProgram;
+using KaputEngine::Rendering::VertexQuantization;
+using KaputEngine::Rendering::Buffer::eRingTarget;
+using KaputEngine::Rendering::Buffer::RingBuffer;
+using KaputEngine::Rendering::Command::CommandList;
+
+using LibMath::Cartesian3f;
+using LibMath::Matrix4f;
+
+namespace
+{
+	// Key layout from the most significant bits
+	constexpr uint64_t
+		PassBits     = 2,
+		ProgramBits  = 14,
+		MaterialBits = 16,
+		MeshBits     = 16,
+		DepthBits    = 16;
+
+	static_assert(PassBits + ProgramBits + MaterialBits + MeshBits + DepthBits == 64);
+
+	constexpr uint64_t
+		DepthShift    = 0,
+		MeshShift     = DepthShift + DepthBits,
+		MaterialShift = MeshShift + MeshBits,
+		ProgramShift  = MaterialShift + MaterialBits,
+		PassShift     = ProgramShift + ProgramBits;
+
+	// Matrices are uploaded as std430 mat4 arrays
+	static_assert(sizeof(Matrix4f) == sizeof(float[16]));
+
+	constexpr uint64_t mask(const uint64_t bits) noexcept
+	{
+		return (uint64_t(1) << bits) - 1;
+	}
+}
+
+void DrawQueue::create(const unsigned int index)
+{
+	m_instanceBuffer.create(eRingTarget::STORAGE, MaxInstances * sizeof(Matrix4f), index);
+}
+
+void DrawQueue::reset(const Cartesian3f& viewPosition, const float viewDistance)
+{
+	m_items.clear();
+	m_order.clear();
+	m_batches.clear();
+	m_instances.clear();
+
+	m_programIndices.clear();
+	m_materialIndices.clear();
+	m_meshIndices.clear();
+
+	m_viewPosition = viewPosition;
+	m_viewDistance = viewDistance > 0.f ? viewDistance : 1.f;
+}
+
+void DrawQueue::push(const DrawItem& item)
+{
+	m_order.emplace_back(makeKey(item), static_cast<uint32_t>(m_items.size()));
+	m_items.push_back(item);
+}
+
+size_t DrawQueue::size() const noexcept
+{
+	return m_items.size();
+}
+
+bool DrawQueue::empty() const noexcept
+{
+	return m_items.empty();
+}
+
+void DrawQueue::record(CommandList& list, const std::span<RingBuffer* const> storageBuffers)
+{
+	PROFILE_FUNCTION();
+
+	m_stats = { };
+
+	if (m_items.empty())
+		return;
+
+	std::sort(m_order.begin(), m_order.end());
+	batch();
+
+	// Storage buffer bindings are context state shared by all programs
+	for (RingBuffer* const buffer : storageBuffers)
+	{
+		list.bindRingBuffer(*buffer);
+		++m_stats.bufferBinds;
+	}
+
+	const ShaderProgram* program = nullptr;
+	const Material* material = nullptr;
+	const Material* fallbackMaterial = nullptr;
+	const Mesh* mesh = nullptr;
+	uint8_t lod = 0;
+
+	const Cartesian3f* worldPosition = nullptr;
+	const VertexQuantization* quantization = nullptr;
+
+	// Value of the instanceOffset uniform of the current program
+	int instanceOffset = -1;
+	uint32_t chunk = 0;
+
+	if (!m_instances.empty())
+		uploadInstances(list, chunk);
+
+	for (const Batch& batch : m_batches)
+	{
+		const DrawItem& item = m_items[m_order[batch.first].second];
+		const EngineUniforms& uniforms = item.program->engineUniforms();
+
+		// Uniforms belong to the program and are resent after switching
+		if (item.program != program)
+		{
+			// Programs are left drawing from the model uniform for draws recorded outside of the queue
+			if (instanceOffset >= 0)
+				list.setUniform(program->engineUniforms().instanceOffset, -1);
+
+			program = item.program;
+			material = fallbackMaterial = nullptr;
+			worldPosition = nullptr;
+			quantization = nullptr;
+			instanceOffset = -1;
+
+			list.useProgram(*program);
+
+			++m_stats.programChanges;
+		}
+
+		if (item.material != material || item.fallbackMaterial != fallbackMaterial)
+		{
+			material = item.material;
+			fallbackMaterial = item.fallbackMaterial;
+
+			list.setUniform(uniforms.material, MaterialLayer
+			{
+				.primary  = *material,
+				.fallback = fallbackMaterial
+			});
+
+			++m_stats.materialChanges;
+		}
+
+		if (item.mesh != mesh || item.lod != lod)
+		{
+			mesh = item.mesh;
+			lod = item.lod;
+			list.bindVertexArray(mesh->attributes(), mesh->vertices(), mesh->elements(lod));
+
+			++m_stats.meshChanges;
+		}
+
+		// Most meshes share the identity mapping of float positions
+		if (!quantization || *quantization != mesh->quantization())
+		{
+			quantization = &mesh->quantization();
+
+			list.setUniform(uniforms.positionScale, quantization->scale);
+			list.setUniform(uniforms.positionOffset, quantization->offset);
+		}
+
+		if (batch.instanceOffset < 0)
+		{
+			if (instanceOffset >= 0)
+			{
+				instanceOffset = -1;
+				list.setUniform(uniforms.instanceOffset, instanceOffset);
+			}
+
+			if (!worldPosition || *worldPosition != item.worldPosition)
+			{
+				worldPosition = &item.worldPosition;
+				list.setUniform(uniforms.worldPosition, item.worldPosition);
+			}
+
+			list.setUniform(uniforms.model, item.model);
+			list.drawBoundElements(mesh->elements(lod));
+		}
+		else
+		{
+			// Later chunks go to the next region of the ring
+			if (batch.chunk != chunk)
+			{
+				chunk = batch.chunk;
+				uploadInstances(list, chunk);
+			}
+
+			if (batch.instanceOffset != instanceOffset)
+			{
+				instanceOffset = batch.instanceOffset;
+				list.setUniform(uniforms.instanceOffset, instanceOffset);
+			}
+
+			list.drawBoundElementsInstanced(mesh->elements(lod), static_cast<int>(batch.count));
+
+			if (batch.count > 1)
+			{
+				++m_stats.instancedDraws;
+				m_stats.instances += batch.count;
+			}
+		}
+
+		const uint32_t triangles = mesh->triangleCount(lod);
+
+		m_stats.trianglesDrawn += triangles * batch.count;
+		m_stats.trianglesSaved += (mesh->triangleCount() - triangles) * batch.count;
+
+		++m_stats.drawCalls;
+	}
+
+	if (instanceOffset >= 0)
+		list.setUniform(program->engineUniforms().instanceOffset, -1);
+
+	if (!storageBuffers.empty() || !m_instances.empty())
+		list.unbindStorageBuffer();
+
+	// Unsorted recording binds the program, material, mesh and every storage buffer for each draw
+	const uint32_t
+		unsorted = static_cast<uint32_t>(m_items.size()) * (3 + static_cast<uint32_t>(storageBuffers.size())),
+		sorted   = m_stats.programChanges + m_stats.materialChanges + m_stats.meshChanges + m_stats.bufferBinds;
+
+	m_stats.stateChangesSaved = unsorted > sorted ? unsorted - sorted : 0;
+}
+
+const DrawStats& DrawQueue::stats() const noexcept
+{
+	return m_stats;
+}
+
+uint64_t DrawQueue::makeKey(const DrawItem& item)
+{
+	const float* const translation = item.model.raw2D()[3];
+
+	const float
+		dx = translation[0] - m_viewPosition.raw()[0],
+		dy = translation[1] - m_viewPosition.raw()[1],
+		dz = translation[2] - m_viewPosition.raw()[2];
+
+	const float distance = std::clamp(std::sqrt(dx * dx + dy * dy + dz * dz) / m_viewDistance, 0.f, 1.f);
+	uint64_t depth = static_cast<uint64_t>(distance * static_cast<float>(mask(DepthBits)));
+
+	// Blended draws go back to front
+	if (item.pass == eRenderPass::TRANSLUCENT)
+		depth = mask(DepthBits) - depth;
+
+	return
+		(static_cast<uint64_t>(item.pass) & mask(PassBits)) << PassShift |
+		(stateIndex(m_programIndices, item.program) & mask(ProgramBits)) << ProgramShift |
+		(stateIndex(m_materialIndices, item.material) & mask(MaterialBits)) << MaterialShift |
+		// Each level of detail has its own index buffer
+		(stateIndex(m_meshIndices, &item.mesh->elements(item.lod)) & mask(MeshBits)) << MeshShift |
+		depth << DepthShift;
+}
+
+uint16_t DrawQueue::stateIndex(std::unordered_map<const void*, uint16_t>& indices, const void* const state)
+{
+	return indices.try_emplace(state, static_cast<uint16_t>(indices.size())).first->second;
+}
+
+bool DrawQueue::instanceable(const DrawItem& first, const DrawItem& second) noexcept
+{
+	return
+		first.pass == second.pass &&
+		first.program == second.program &&
+		first.material == second.material &&
+		first.fallbackMaterial == second.fallbackMaterial &&
+		first.mesh == second.mesh &&
+		first.lod == second.lod;
+}
+
+void DrawQueue::batch()
+{
+	m_batches.clear();
+	m_instances.clear();
+
+	// Instancing is unavailable without a context
+	const bool instancing = m_instanceBuffer.valid();
+
+	for (uint32_t first = 0; first < m_order.size();)
+	{
+		const DrawItem& item = m_items[m_order[first].second];
+
+		if (!instancing || !item.program->instanced())
+		{
+			m_batches.push_back({ .first = first, .count = 1, .instanceOffset = -1, .chunk = 0 });
+			++first;
+			continue;
+		}
+
+		// Single draws of instanced programs read their matrix from the instance buffer as well
+		uint32_t last = first + 1;
+
+		while (last < m_order.size() && instanceable(item, m_items[m_order[last].second]))
+			++last;
+
+		// Runs crossing the end of a chunk are split in two draws
+		while (first < last)
+		{
+			const uint32_t
+				packed = static_cast<uint32_t>(m_instances.size()),
+				cursor = packed % MaxInstances,
+				count  = std::min(last - first, MaxInstances - cursor);
+
+			m_batches.push_back(
+			{
+				.first          = first,
+				.count          = count,
+				.instanceOffset = static_cast<int>(cursor),
+				.chunk          = packed / MaxInstances
+			});
+
+			for (uint32_t i = first; i < first + count; ++i)
+				m_instances.push_back(m_items[m_order[i].second].model);
+
+			first += count;
+		}
+	}
+}
+
+void DrawQueue::uploadInstances(CommandList& list, const uint32_t chunk)
+{
+	const size_t
+		begin = static_cast<size_t>(chunk) * MaxInstances,
+		count = std::min<size_t>(MaxInstances, m_instances.size() - begin);
+
+	// Each chunk goes to its own slot of the ring, so earlier draws of the frame keep their matrices
+	list.uploadRingBuffer(m_instanceBuffer, count * sizeof(Matrix4f), m_instances.data() + begin);
+	++m_stats.bufferBinds;
+}
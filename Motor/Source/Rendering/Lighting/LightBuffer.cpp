@@ -1,9 +1,20 @@
 #include "Rendering/Lighting/LightBuffer.h"
 
-using KaputEngine::Rendering::Buffer::SharedBuffer;
+#include "Rendering/Command/CommandList.h"
+
+#include <cstring>
+#include <iostream>
+
+using KaputEngine::Rendering::Buffer::RingBuffer;
+using KaputEngine::Rendering::Command::CommandList;
 using KaputEngine::Rendering::Lighting::LightBuffer;
 
-const SharedBuffer& LightBuffer::buffer() const noexcept
+RingBuffer& LightBuffer::buffer() noexcept
+{
+	return m_buffer;
+}
+
+const RingBuffer& LightBuffer::buffer() const noexcept
 {
 	return m_buffer;
 }
@@ -11,4 +22,29 @@ const SharedBuffer& LightBuffer::buffer() const noexcept
 void LightBuffer::destroy()
 {
 	m_buffer.destroy();
+
+	m_data.clear();
+	m_dirty = false;
+}
+
+void LightBuffer::record(CommandList& list)
+{
+	if (!m_dirty || !m_buffer.valid())
+		return;
+
+	// Regions of the ring hold the whole content
+	list.uploadRingBuffer(m_buffer, m_data.size(), m_data.data());
+	m_dirty = false;
+}
+
+void LightBuffer::write(const size_t offset, const size_t size, _In_reads_bytes_(size) const void* const data)
+{
+	if (offset + size > m_data.size())
+	{
+		std::cerr << __FUNCTION__": Attempting to write outside of buffer bounds.\n";
+		return;
+	}
+
+	std::memcpy(m_data.data() + offset, data, size);
+	m_dirty = true;
 }
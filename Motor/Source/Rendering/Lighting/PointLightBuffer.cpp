@@ -1,7 +1,7 @@
 #include "Rendering/Lighting/PointLightBuffer.h"
 
 #include "Component/Lighting/PointLightComponent.h"
-#include "Rendering/Buffer/SharedBuffer.hpp"
+#include "Rendering/Lighting/LightBuffer.hpp"
 
 using KaputEngine::LightComponent;
 using KaputEngine::Rendering::Lighting::PointLightBuffer;
@@ -16,7 +16,7 @@ void PointLightBuffer::updateLight(const LightComponent& light) noexcept
 	if (!data.enabled)
 	{
 		// Only write disabled state, other data can be left unchanged
-		m_buffer.write(offset + offsetof(PointLightData, enabled), false);
+		write(offset + offsetof(PointLightData, enabled), false);
 		return;
 	}
 
@@ -26,5 +26,5 @@ void PointLightBuffer::updateLight(const LightComponent& light) noexcept
 		.position = pointLight.getWorldTransform().position
 	};
 
-	m_buffer.write(offset, item);
+	write(offset, item);
 }
@@ -1,31 +1,91 @@
+#include "Application.h"
 #include "Queue/Context.h"
-#include "Rendering/Buffer/VertexAttributeBuffer.hpp"
+#include "Rendering/Command/CommandList.hpp"
+#include "Rendering/DrawQueue.h"
 #include "Rendering/Material.h"
 #include "Rendering/Mesh.h"
+#include "Rendering/MeshOptimizer.h"
 #include "Rendering/ShaderProgram.hpp"
 #include "Rendering/Vertex.h"
 
 #include <assimp/mesh.h>
 #include <glad/glad.h>
 
+#include <algorithm>
+#include <limits>
+
+using KaputEngine::Rendering::DrawItem;
+using KaputEngine::Rendering::eMeshRetention;
+using KaputEngine::Rendering::eVertexFormat;
+using KaputEngine::Rendering::DrawQueue;
+using KaputEngine::Rendering::EngineUniforms;
 using KaputEngine::Rendering::Mesh;
+using KaputEngine::Rendering::MeshOptimizationStats;
+using KaputEngine::Rendering::MeshOptimizer;
+using KaputEngine::Rendering::PackedVertices;
+using KaputEngine::Rendering::Vertex;
+using KaputEngine::Rendering::VertexQuantization;
 
 using KaputEngine::TransformSource;
+using KaputEngine::Rendering::Command::CommandList;
+using KaputEngine::Rendering::Culling::Bounds;
 using KaputEngine::Rendering::Buffer::ElementBuffer;
 using KaputEngine::Rendering::Buffer::VertexAttributeBuffer;
 using KaputEngine::Rendering::Buffer::VertexBuffer;
 using KaputEngine::Resource::MeshResource;
 
+using LibMath::Cartesian3f;
 using LibMath::Matrix4f;
+using LibMath::Vector3f;
 using KaputEngine::Queue::ContextQueue;
 
 using std::cerr;
 
+namespace
+{
+	// Levels are not simplified below this many triangles
+	constexpr size_t LodMinTriangles = 64;
+
+	// Largest distance a level may move the surface, relative to the size of the mesh
+	constexpr float LodMaxError = .02f;
+
+	/// <summary>
+	/// Simplifies each level of detail from the previous one to half its triangles.
+	/// </summary>
+	/// <returns>Indices of the levels after the full mesh, stopping at the first level removing less than a quarter of the triangles</returns>
+	std::vector<std::vector<unsigned int>> simplifyLods(
+		const std::span<const Vertex> vertices, const std::vector<unsigned int>& indices, const uint8_t count)
+	{
+		std::vector<std::vector<unsigned int>> lods;
+
+		for (uint8_t lod = 1; lod < count; ++lod)
+		{
+			const std::vector<unsigned int>& previous = lods.empty() ? indices : lods.back();
+			const size_t previousTriangles = previous.size() / 3;
+
+			if (previousTriangles / 2 < LodMinTriangles)
+				break;
+
+			std::vector<unsigned int> simplified = previous;
+			MeshOptimizer::simplify(vertices, simplified, previousTriangles / 2, LodMaxError);
+
+			if (simplified.size() / 3 > previousTriangles * 3 / 4)
+				break;
+
+			static_cast<void>(MeshOptimizer::optimizeVertexCache(simplified, vertices.size()));
+			lods.push_back(std::move(simplified));
+		}
+
+		return lods;
+	}
+}
+
 Mesh::Mesh(const Mesh& parent) : m_parent(&parent) { }
 
 Mesh::Mesh(MeshResource& resource) : m_resource(&resource) { }
 
-_Success_(return) bool Mesh::init(const aiMesh& mesh, _In_opt_ const std::shared_ptr<Material>& mat)
+_Success_(return) bool Mesh::init(
+	const aiMesh& mesh, _In_opt_ const std::shared_ptr<Material>& mat, const eVertexFormat format, const uint8_t lods)
 {
 	m_material = mat;
 
@@ -35,17 +95,25 @@ _Success_(return) bool Mesh::init(const aiMesh& mesh, _In_opt_ const std::shared
 	vertices.reserve(mesh.mNumVertices);
 	indices.reserve(static_cast<size_t>(mesh.mNumFaces) * 3);
 
+	const bool
+		hasUV      = mesh.HasTextureCoords(0),
+		hasTangent = mesh.HasTangentsAndBitangents(),
+		hasColor   = mesh.HasVertexColors(0);
+
 	for (size_t i = 0; i < mesh.mNumVertices; ++i)
 	{
 		const aiVector3D
 			&pos       = mesh.mVertices[i],
 			&normal    = mesh.mNormals[i],
-			&uv        = mesh.mTextureCoords[0][i],
-			&tangent   = mesh.mTangents[i],
-			&bitangent = mesh.mBitangents[i];
+			uv         = hasUV ? mesh.mTextureCoords[0][i] : aiVector3D(),
+			tangent    = hasTangent ? mesh.mTangents[i] : aiVector3D(),
+			bitangent  = hasTangent ? mesh.mBitangents[i] : aiVector3D();
+
+		const aiColor4D color = hasColor ? mesh.mColors[0][i] : aiColor4D();
 
 		vertices.push_back(Vertex
 		{
+			.albedo    = { color.r, color.g, color.b, color.a },
 			.position  = { pos.x, pos.y, pos.z },
 			.textureUV = { uv.x, uv.y },
 			.normal    = { normal.x, normal.y, normal.z },
@@ -69,21 +137,90 @@ _Success_(return) bool Mesh::init(const aiMesh& mesh, _In_opt_ const std::shared
 		indices.emplace_back(face.mIndices[2]);
 	}
 
-	ContextQueue::instance().push([this, &vertices, &indices]()
+	m_optimizationStats = MeshOptimizer::optimize(vertices, indices);
+
+	const std::vector<std::vector<unsigned int>> lodIndices = simplifyLods(vertices, indices, lods);
+
+	upload(vertices, indices, format, hasColor, eMeshRetention::FULL, lodIndices);
+
+	return true;
+}
+
+void Mesh::init(const std::span<const Vertex> vertices, const std::span<const unsigned int> indices, const bool colors,
+	const eMeshRetention retention)
+{
+	upload(vertices, indices, eVertexFormat::COMPACT, colors, retention);
+}
+
+void Mesh::upload(const std::span<const Vertex> vertices, const std::span<const unsigned int> indices,
+	const eVertexFormat format, const bool colors, const eMeshRetention retention, const std::span<const std::vector<unsigned int>> lods)
+{
+	std::vector<Cartesian3f> positions;
+	positions.reserve(vertices.size());
+
+	for (const Vertex& vertex : vertices)
+		positions.push_back(vertex.position);
+
+	m_bounds = Bounds::fromPoints(positions.data(), positions.size());
+
+	m_retention = retention;
+	m_sourceVertices.clear();
+	m_sourceIndices.clear();
+	m_occluderPositions.clear();
+	m_occluderIndices.clear();
+
+	if (retention == eMeshRetention::FULL)
+	{
+		m_sourceVertices.assign(vertices.begin(), vertices.end());
+		m_sourceIndices.assign(indices.begin(), indices.end());
+	}
+
+	if (retention != eMeshRetention::NONE)
+	{
+		const std::span<const unsigned int> occluder = lods.empty() ? indices : std::span<const unsigned int>(lods.back());
+
+		// Vertices numbered in order of first use, skipping those only the finer levels reference
+		constexpr unsigned int Unused = std::numeric_limits<unsigned int>::max();
+		std::vector<unsigned int> remap(vertices.size(), Unused);
+
+		m_occluderIndices.reserve(occluder.size());
+
+		for (const unsigned int index : occluder)
+		{
+			if (remap[index] == Unused)
+			{
+				remap[index] = static_cast<unsigned int>(m_occluderPositions.size());
+				m_occluderPositions.push_back(positions[index]);
+			}
+
+			m_occluderIndices.push_back(remap[index]);
+		}
+
+		m_occluderPositions.shrink_to_fit();
+	}
+
+	m_colors = colors;
+
+	// No context to upload to, the mesh is never drawn
+	if (Application::headless())
+		return;
+
+	const PackedVertices packed = PackedVertices::pack(vertices, format, colors);
+	m_quantization = packed.quantization();
+
+	ContextQueue::instance().push([this, &packed, &indices, &lods]()
 	{
-		m_vertexBuffer.create(vertices.data(), vertices.size() * sizeof(Vertex));
+		m_vertexBuffer.create(packed.data(), static_cast<ptrdiff_t>(packed.size()));
 		m_elementBuffer.create(indices);
 
+		m_lodBuffers = std::vector<ElementBuffer>(lods.size());
+
+		for (size_t lod = 0; lod < lods.size(); ++lod)
+			m_lodBuffers[lod].create(lods[lod]);
+
 		m_vertexAttributeBuffer.create();
-		m_vertexAttributeBuffer.defineAttribute(0, &Vertex::albedo);
-		m_vertexAttributeBuffer.defineAttribute(1, &Vertex::position);
-		m_vertexAttributeBuffer.defineAttribute(2, &Vertex::textureUV);
-		m_vertexAttributeBuffer.defineAttribute(3, &Vertex::normal);
-		m_vertexAttributeBuffer.defineAttribute(4, &Vertex::tangent);
-		m_vertexAttributeBuffer.defineAttribute(5, &Vertex::bitangent);
+		packed.defineAttributes(m_vertexAttributeBuffer);
 	}).wait();
-
-	return true;
 }
 
 void Mesh::destroy()
@@ -91,6 +228,7 @@ void Mesh::destroy()
 	m_vertexBuffer.destroy();
 	m_vertexAttributeBuffer.destroy();
 	m_elementBuffer.destroy();
+	m_lodBuffers.clear();
 }
 
 VertexBuffer& Mesh::vertices() noexcept
@@ -111,6 +249,122 @@ const VertexAttributeBuffer& Mesh::attributes() const noexcept
 	return m_vertexAttributeBuffer;
 }
 
+const VertexQuantization& Mesh::quantization() const noexcept
+{
+	return m_quantization;
+}
+
+_Ret_maybenull_ const Material* Mesh::material() const noexcept
+{
+	return std::to_address(m_material);
+}
+
+eMeshRetention Mesh::retention() const noexcept
+{
+	return m_retention;
+}
+
+std::span<const Vertex> Mesh::sourceVertices() const noexcept
+{
+	return m_sourceVertices;
+}
+
+std::span<const unsigned int> Mesh::sourceIndices() const noexcept
+{
+	return m_sourceIndices;
+}
+
+void Mesh::releaseSource() const noexcept
+{
+	if (m_retention != eMeshRetention::FULL)
+		return;
+
+	m_retention = eMeshRetention::OCCLUDER;
+
+	// Swapped out, clearing would keep the capacity
+	std::vector<Vertex>().swap(m_sourceVertices);
+	std::vector<unsigned int>().swap(m_sourceIndices);
+}
+
+std::span<const Cartesian3f> Mesh::occluderPositions() const noexcept
+{
+	return m_occluderPositions;
+}
+
+std::span<const unsigned int> Mesh::occluderIndices() const noexcept
+{
+	return m_occluderIndices;
+}
+
+const MeshOptimizationStats& Mesh::optimizationStats() const noexcept
+{
+	return m_optimizationStats;
+}
+
+bool Mesh::hasColors() const noexcept
+{
+	return m_colors;
+}
+
+void Mesh::appendWorldGeometry(
+	std::vector<Vertex>& vertices, std::vector<unsigned int>& indices, const Matrix4f& model, const bool colors) const
+{
+	const float (&m)[4][4] = model.raw2D();
+
+	const Vector3f
+		x { m[0][0], m[0][1], m[0][2] },
+		y { m[1][0], m[1][1], m[1][2] },
+		z { m[2][0], m[2][1], m[2][2] };
+
+	// Columns of the cofactor matrix, the inverse transpose scaled by the determinant
+	const Vector3f
+		cofactorX = y.cross(z),
+		cofactorY = z.cross(x),
+		cofactorZ = x.cross(y);
+
+	// Mirroring matrices turn the triangles inside out
+	const bool mirrored = x.dot(cofactorX) < 0.f;
+	const float normalSign = mirrored ? -1.f : 1.f;
+
+	const auto direction = [](const Vector3f& vector) -> Vector3f
+	{
+		const float length = vector.magnitude();
+		return length > 0.f ? vector / length : vector;
+	};
+
+	const unsigned int offset = static_cast<unsigned int>(vertices.size());
+	vertices.reserve(vertices.size() + m_sourceVertices.size());
+
+	for (const Vertex& source : m_sourceVertices)
+	{
+		Vertex vertex = source;
+
+		for (int row = 0; row < 3; ++row)
+			vertex.position.raw()[row] =
+				m[0][row] * source.position.x() + m[1][row] * source.position.y() + m[2][row] * source.position.z() + m[3][row];
+
+		vertex.normal = direction(
+			(cofactorX * source.normal.x() + cofactorY * source.normal.y() + cofactorZ * source.normal.z()) * normalSign);
+		vertex.tangent = direction(x * source.tangent.x() + y * source.tangent.y() + z * source.tangent.z());
+		vertex.bitangent = direction(x * source.bitangent.x() + y * source.bitangent.y() + z * source.bitangent.z());
+
+		// Matches the attribute left disabled when uploading without colors
+		if (colors && !m_colors)
+			vertex.albedo = { 0.f, 0.f, 0.f, 1.f };
+
+		vertices.push_back(vertex);
+	}
+
+	indices.reserve(indices.size() + m_sourceIndices.size());
+
+	for (size_t i = 0; i < m_sourceIndices.size(); i += 3)
+	{
+		indices.push_back(offset + m_sourceIndices[i]);
+		indices.push_back(offset + m_sourceIndices[i + (mirrored ? 2 : 1)]);
+		indices.push_back(offset + m_sourceIndices[i + (mirrored ? 1 : 2)]);
+	}
+}
+
 ElementBuffer& Mesh::elements() noexcept
 {
 	return m_elementBuffer;
@@ -120,6 +374,24 @@ const ElementBuffer& Mesh::elements() const noexcept
 	return m_elementBuffer;
 }
 
+const ElementBuffer& Mesh::elements(const uint8_t lod) const noexcept
+{
+	if (!lod || m_lodBuffers.empty())
+		return m_elementBuffer;
+
+	return m_lodBuffers[std::min<size_t>(lod, m_lodBuffers.size()) - 1];
+}
+
+uint8_t Mesh::lodCount() const noexcept
+{
+	return static_cast<uint8_t>(m_lodBuffers.size() + 1);
+}
+
+uint32_t Mesh::triangleCount(const uint8_t lod) const noexcept
+{
+	return static_cast<uint32_t>(elements(lod).count() / 3);
+}
+
 void Mesh::draw() const
 {
 	if (!m_vertexBuffer.valid())
@@ -131,13 +403,30 @@ void Mesh::draw() const
 
 	ContextQueue::instance().push([this]
 	{
-		glDrawElements(GL_TRIANGLES, m_elementBuffer.count(), GL_UNSIGNED_INT, nullptr);
+		glDrawElements(GL_TRIANGLES, m_elementBuffer.count(), m_elementBuffer.indexType(), nullptr);
 	}).wait();
 }
 
 void Mesh::draw(const TransformSource& parent, const Material& material, const ShaderProgram& program) const
 {
-	if (!program.use())
+	if (!program.id())
+		return;
+
+	CommandList list;
+
+	list.useProgram(program);
+	record(list, parent, material, program);
+
+	ContextQueue::instance().push([&list]
+	{
+		list.submit();
+	}).wait();
+}
+
+void Mesh::record(CommandList& list,
+	const TransformSource& parent, const Material& material, const ShaderProgram& program) const
+{
+	if (!program.id())
 		return;
 
 	bool isRoot = !m_parent;
@@ -148,7 +437,11 @@ void Mesh::draw(const TransformSource& parent, const Material& material, const S
 		setTransformDirty();
 	}
 
-	program.setUniform("model", getWorldTransformMatrix());
+	const EngineUniforms& uniforms = program.engineUniforms();
+
+	list.setUniform(uniforms.model, getWorldTransformMatrix());
+	list.setUniform(uniforms.positionScale, m_quantization.scale);
+	list.setUniform(uniforms.positionOffset, m_quantization.offset);
 
 	MaterialLayer layer
 	{
@@ -156,12 +449,12 @@ void Mesh::draw(const TransformSource& parent, const Material& material, const S
 		.fallback = std::to_address(m_material)
 	};
 
-	program.setUniform("materialSampler.albedo.mode", layer);
+	list.setUniform(uniforms.material, layer);
 
-	draw();
+	list.drawElements(m_vertexAttributeBuffer, m_vertexBuffer, m_elementBuffer);
 
 	for (const Mesh& child : m_children)
-		child.draw(*this, material, program);
+		child.record(list, *this, material, program);
 
 	if (isRoot)
 	{
@@ -170,6 +463,35 @@ void Mesh::draw(const TransformSource& parent, const Material& material, const S
 	}
 }
 
+void Mesh::queue(DrawQueue& queue, const DrawItem& item, const Matrix4f& parent) const
+{
+	DrawItem draw = item;
+	draw.mesh = this;
+	draw.fallbackMaterial = std::to_address(m_material);
+	draw.model = parent * getLocalTransform().toMatrix();
+	draw.lod = std::min<uint8_t>(item.lod, lodCount() - 1);
+
+	queue.push(draw);
+
+	for (const Mesh& child : m_children)
+		child.queue(queue, item, draw.model);
+}
+
+const Bounds& Mesh::localBounds() const noexcept
+{
+	return m_bounds;
+}
+
+Bounds Mesh::bounds() const noexcept
+{
+	Bounds out = m_bounds;
+
+	for (const Mesh& child : m_children)
+		out.merge(child.bounds().transform(child.getLocalTransform().toMatrix()));
+
+	return out;
+}
+
 _Ret_maybenull_ MeshResource* Mesh::parentResource() noexcept
 {
 	return m_resource;
@@ -0,0 +1,613 @@
+#include "Rendering/MeshOptimizer.h"
+
+#include "Profiling/Profiler.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <unordered_map>
+
+using KaputEngine::Rendering::MeshOptimizationStats;
+using KaputEngine::Rendering::MeshOptimizer;
+using KaputEngine::Rendering::Vertex;
+
+using LibMath::Cartesian3f;
+using LibMath::Vector3f;
+
+namespace
+{
+	constexpr unsigned int Unused = std::numeric_limits<unsigned int>::max();
+
+	// Welding compares vertices as raw bytes
+	static_assert(sizeof(Vertex) == 18 * sizeof(float), "Vertex has padding.");
+
+	size_t hashVertex(const Vertex& vertex) noexcept
+	{
+		// FNV-1a
+		const unsigned char* const bytes = reinterpret_cast<const unsigned char*>(&vertex);
+		uint64_t hash = 14695981039346656037ull;
+
+		for (size_t i = 0; i < sizeof(Vertex); ++i)
+			hash = (hash ^ bytes[i]) * 1099511628211ull;
+
+		return static_cast<size_t>(hash);
+	}
+
+	Vector3f toVector(const Cartesian3f& point) noexcept
+	{
+		return { point.x(), point.y(), point.z() };
+	}
+
+	/// <summary>
+	/// Sum of squared distances to a set of planes, as the upper half of a symmetric 4x4 matrix.
+	/// </summary>
+	struct Quadric
+	{
+		double a2 = 0, ab = 0, ac = 0, ad = 0, b2 = 0, bc = 0, bd = 0, c2 = 0, cd = 0, d2 = 0;
+
+		void addPlane(const double a, const double b, const double c, const double d) noexcept
+		{
+			a2 += a * a; ab += a * b; ac += a * c; ad += a * d;
+			b2 += b * b; bc += b * c; bd += b * d;
+			c2 += c * c; cd += c * d;
+			d2 += d * d;
+		}
+
+		Quadric& operator+=(const Quadric& other) noexcept
+		{
+			a2 += other.a2; ab += other.ab; ac += other.ac; ad += other.ad;
+			b2 += other.b2; bc += other.bc; bd += other.bd;
+			c2 += other.c2; cd += other.cd;
+			d2 += other.d2;
+
+			return *this;
+		}
+
+		_NODISCARD double error(const Cartesian3f& point) const noexcept
+		{
+			const double x = point.x(), y = point.y(), z = point.z();
+
+			return x * x * a2 + y * y * b2 + z * z * c2 + d2
+				+ 2. * (x * y * ab + x * z * ac + y * z * bc + x * ad + y * bd + z * cd);
+		}
+	};
+
+	uint64_t edgeKey(const unsigned int a, const unsigned int b) noexcept
+	{
+		return a < b ? static_cast<uint64_t>(a) << 32 | b : static_cast<uint64_t>(b) << 32 | a;
+	}
+}
+
+MeshOptimizationStats MeshOptimizer::optimize(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices)
+{
+	PROFILE_FUNCTION();
+
+	MeshOptimizationStats stats
+	{
+		.verticesBefore = vertices.size(),
+		.acmrBefore     = acmr(indices, vertices.size())
+	};
+
+	weld(vertices, indices);
+
+	const std::vector<uint32_t> clusters = optimizeVertexCache(indices, vertices.size());
+
+	// Kept in cache order if sorting the clusters loses too many cache hits
+	const std::vector<unsigned int> cacheOrder = indices;
+	const float cacheAcmr = acmr(indices, vertices.size());
+
+	optimizeOverdraw(vertices, indices, clusters);
+
+	if (acmr(indices, vertices.size()) > cacheAcmr * OverdrawThreshold)
+		indices = cacheOrder;
+
+	optimizeVertexFetch(vertices, indices);
+
+	stats.verticesAfter = vertices.size();
+	stats.acmrAfter = acmr(indices, vertices.size());
+
+	return stats;
+}
+
+void MeshOptimizer::weld(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices)
+{
+	// Open addressing table of unique vertices, at most half full
+	size_t capacity = 1;
+
+	while (capacity < vertices.size() * 2)
+		capacity <<= 1;
+
+	const size_t mask = capacity - 1;
+
+	std::vector<unsigned int> table(capacity, Unused);
+	std::vector<unsigned int> remap(vertices.size());
+	std::vector<Vertex> unique;
+	unique.reserve(vertices.size());
+
+	for (size_t i = 0; i < vertices.size(); ++i)
+	{
+		size_t slot = hashVertex(vertices[i]) & mask;
+
+		while (table[slot] != Unused && std::memcmp(&unique[table[slot]], &vertices[i], sizeof(Vertex)))
+			slot = (slot + 1) & mask;
+
+		if (table[slot] == Unused)
+		{
+			table[slot] = static_cast<unsigned int>(unique.size());
+			unique.push_back(vertices[i]);
+		}
+
+		remap[i] = table[slot];
+	}
+
+	for (unsigned int& index : indices)
+		index = remap[index];
+
+	vertices = std::move(unique);
+}
+
+std::vector<uint32_t> MeshOptimizer::optimizeVertexCache(std::vector<unsigned int>& indices, const size_t vertexCount)
+{
+	std::vector<uint32_t> clusters;
+
+	if (indices.size() < 3)
+		return clusters;
+
+	// Triangles using each vertex, packed by vertex
+	std::vector<uint32_t> live(vertexCount, 0);
+
+	for (const unsigned int index : indices)
+		++live[index];
+
+	std::vector<uint32_t> adjacencyStart(vertexCount + 1, 0);
+
+	for (size_t v = 0; v < vertexCount; ++v)
+		adjacencyStart[v + 1] = adjacencyStart[v] + live[v];
+
+	std::vector<uint32_t> adjacency(indices.size());
+	std::vector<uint32_t> fill(adjacencyStart.begin(), adjacencyStart.end() - 1);
+
+	for (size_t i = 0; i < indices.size(); ++i)
+		adjacency[fill[indices[i]]++] = static_cast<uint32_t>(i / 3);
+
+	std::vector<uint32_t> cacheTime(vertexCount, 0);
+	std::vector<uint8_t> emitted(indices.size() / 3, 0);
+
+	// Recently used vertices to continue from when the fan runs out of triangles
+	std::vector<unsigned int> deadEnd;
+	std::vector<unsigned int> candidates;
+
+	std::vector<unsigned int> result;
+	result.reserve(indices.size());
+
+	uint32_t time = CacheSize + 1;
+	size_t cursor = 0;
+	int64_t fanning = 0;
+
+	clusters.push_back(0);
+
+	while (fanning >= 0)
+	{
+		candidates.clear();
+
+		for (uint32_t a = adjacencyStart[fanning]; a < adjacencyStart[fanning + 1]; ++a)
+		{
+			const uint32_t triangle = adjacency[a];
+
+			if (emitted[triangle])
+				continue;
+
+			for (uint8_t corner = 0; corner < 3; ++corner)
+			{
+				const unsigned int v = indices[triangle * 3 + corner];
+
+				result.push_back(v);
+				deadEnd.push_back(v);
+				candidates.push_back(v);
+
+				--live[v];
+
+				if (time - cacheTime[v] > CacheSize)
+					cacheTime[v] = time++;
+			}
+
+			emitted[triangle] = 1;
+		}
+
+		// Oldest vertex that stays in the cache while fanning its remaining triangles
+		int64_t next = -1, best = -1;
+
+		for (const unsigned int v : candidates)
+		{
+			if (!live[v])
+				continue;
+
+			const int64_t priority = time - cacheTime[v] + 2 * live[v] <= CacheSize ? time - cacheTime[v] : 0;
+
+			if (priority > best)
+			{
+				best = priority;
+				next = v;
+			}
+		}
+
+		if (next == -1)
+		{
+			while (!deadEnd.empty() && next == -1)
+			{
+				const unsigned int v = deadEnd.back();
+				deadEnd.pop_back();
+
+				if (live[v])
+					next = v;
+			}
+
+			for (; next == -1 && cursor < vertexCount; ++cursor)
+				if (live[cursor])
+					next = static_cast<int64_t>(cursor);
+
+			// Jumping out of the cache starts a new cluster
+			if (const uint32_t first = static_cast<uint32_t>(result.size() / 3);
+				next != -1 && first != clusters.back())
+				clusters.push_back(first);
+		}
+
+		fanning = next;
+	}
+
+	indices = std::move(result);
+
+	return clusters;
+}
+
+void MeshOptimizer::optimizeOverdraw(
+	const std::span<const Vertex> vertices, std::vector<unsigned int>& indices, const std::span<const uint32_t> clusters)
+{
+	if (clusters.size() < 2)
+		return;
+
+	struct Cluster
+	{
+		uint32_t first, count;
+		float key;
+	};
+
+	const uint32_t triangleCount = static_cast<uint32_t>(indices.size() / 3);
+
+	std::vector<Cluster> sorted;
+	sorted.reserve(clusters.size());
+
+	// Area weighted centroid and normal of each cluster
+	std::vector<Vector3f> centroids, normals;
+	centroids.reserve(clusters.size());
+	normals.reserve(clusters.size());
+
+	Vector3f meshCentroid { 0.f, 0.f, 0.f };
+	float meshArea = 0.f;
+
+	for (size_t c = 0; c < clusters.size(); ++c)
+	{
+		const uint32_t
+			first = clusters[c],
+			last  = c + 1 < clusters.size() ? clusters[c + 1] : triangleCount;
+
+		Vector3f centroid { 0.f, 0.f, 0.f }, normal { 0.f, 0.f, 0.f };
+		float area = 0.f;
+
+		for (uint32_t t = first; t < last; ++t)
+		{
+			const Vector3f
+				p0 = toVector(vertices[indices[t * 3]].position),
+				p1 = toVector(vertices[indices[t * 3 + 1]].position),
+				p2 = toVector(vertices[indices[t * 3 + 2]].position),
+				cross = (p1 - p0).cross(p2 - p0);
+
+			const float triangleArea = cross.magnitude() * .5f;
+
+			centroid += (p0 + p1 + p2) * (triangleArea / 3.f);
+			normal += cross;
+			area += triangleArea;
+		}
+
+		meshCentroid += centroid;
+		meshArea += area;
+
+		centroids.push_back(area > 0.f ? centroid / area : centroid);
+		normals.push_back(normal);
+		sorted.push_back({ .first = first, .count = last - first, .key = 0.f });
+	}
+
+	if (meshArea > 0.f)
+		meshCentroid /= meshArea;
+
+	// Clusters facing away from the center are more likely to occlude the others
+	for (size_t c = 0; c < sorted.size(); ++c)
+	{
+		const float length = normals[c].magnitude();
+
+		if (length > 0.f)
+			sorted[c].key = (centroids[c] - meshCentroid).dot(normals[c]) / length;
+	}
+
+	std::stable_sort(sorted.begin(), sorted.end(), [](const Cluster& left, const Cluster& right)
+	{
+		return left.key > right.key;
+	});
+
+	std::vector<unsigned int> result;
+	result.reserve(indices.size());
+
+	for (const Cluster& cluster : sorted)
+		result.insert(result.end(),
+			indices.begin() + cluster.first * 3, indices.begin() + (cluster.first + cluster.count) * 3);
+
+	indices = std::move(result);
+}
+
+void MeshOptimizer::optimizeVertexFetch(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices)
+{
+	std::vector<unsigned int> remap(vertices.size(), Unused);
+	unsigned int count = 0;
+
+	for (unsigned int& index : indices)
+	{
+		if (remap[index] == Unused)
+			remap[index] = count++;
+
+		index = remap[index];
+	}
+
+	std::vector<Vertex> ordered(count);
+
+	for (size_t v = 0; v < vertices.size(); ++v)
+		if (remap[v] != Unused)
+			ordered[remap[v]] = vertices[v];
+
+	vertices = std::move(ordered);
+}
+
+void MeshOptimizer::simplify(
+	const std::span<const Vertex> vertices, std::vector<unsigned int>& indices,
+	const size_t targetTriangles, const float maxError)
+{
+	PROFILE_FUNCTION();
+
+	if (indices.size() / 3 <= targetTriangles || vertices.empty())
+		return;
+
+	const size_t vertexCount = vertices.size();
+
+	// Vertices sharing a position split the surface attributes and must stay in place
+	std::vector<uint8_t> locked(vertexCount, 0);
+	{
+		std::unordered_map<uint64_t, unsigned int> firstAtPosition;
+		firstAtPosition.reserve(vertexCount);
+
+		for (size_t v = 0; v < vertexCount; ++v)
+		{
+			const Cartesian3f& position = vertices[v].position;
+
+			uint64_t hash = 14695981039346656037ull;
+			const unsigned char* const bytes = reinterpret_cast<const unsigned char*>(&position);
+
+			for (size_t i = 0; i < sizeof(Cartesian3f); ++i)
+				hash = (hash ^ bytes[i]) * 1099511628211ull;
+
+			const auto [it, inserted] = firstAtPosition.try_emplace(hash, static_cast<unsigned int>(v));
+
+			if (!inserted && vertices[it->second].position == position)
+				locked[v] = locked[it->second] = 1;
+		}
+	}
+
+	// Vertices on open edges keep the silhouette of borders and holes
+	{
+		std::unordered_map<uint64_t, uint32_t> edgeUses;
+		edgeUses.reserve(indices.size());
+
+		for (size_t t = 0; t < indices.size(); t += 3)
+			for (uint8_t corner = 0; corner < 3; ++corner)
+				++edgeUses[edgeKey(indices[t + corner], indices[t + (corner + 1) % 3])];
+
+		for (const auto& [key, uses] : edgeUses)
+			if (uses != 2)
+				locked[key >> 32] = locked[key & 0xffffffff] = 1;
+	}
+
+	std::vector<Quadric> quadrics(vertexCount);
+
+	Cartesian3f low = vertices.front().position, high = low;
+
+	for (const Vertex& vertex : vertices)
+		for (uint8_t axis = 0; axis < 3; ++axis)
+		{
+			low[axis]  = std::min(low[axis], vertex.position[axis]);
+			high[axis] = std::max(high[axis], vertex.position[axis]);
+		}
+
+	const double
+		extent   = (high - low).magnitude(),
+		maxCost  = static_cast<double>(maxError) * extent * static_cast<double>(maxError) * extent;
+
+	for (size_t t = 0; t < indices.size(); t += 3)
+	{
+		const Vector3f
+			p0 = toVector(vertices[indices[t]].position),
+			p1 = toVector(vertices[indices[t + 1]].position),
+			p2 = toVector(vertices[indices[t + 2]].position);
+
+		Vector3f normal = (p1 - p0).cross(p2 - p0);
+		const float length = normal.magnitude();
+
+		if (length == 0.f)
+			continue;
+
+		normal /= length;
+
+		Quadric plane;
+		plane.addPlane(normal.x(), normal.y(), normal.z(), -normal.dot(p0));
+
+		for (uint8_t corner = 0; corner < 3; ++corner)
+			quadrics[indices[t + corner]] += plane;
+	}
+
+	struct Collapse
+	{
+		double cost;
+		unsigned int from, to;
+	};
+
+	std::vector<Collapse> collapses;
+	std::vector<uint32_t> adjacencyStart(vertexCount + 1), adjacency, fill;
+	std::vector<uint8_t> touched(vertexCount);
+	std::vector<unsigned int> remap(vertexCount);
+
+	size_t triangleCount = indices.size() / 3;
+
+	while (triangleCount > targetTriangles)
+	{
+		// Triangles using each vertex
+		std::fill(adjacencyStart.begin(), adjacencyStart.end(), 0);
+
+		for (const unsigned int index : indices)
+			++adjacencyStart[index + 1];
+
+		for (size_t v = 0; v < vertexCount; ++v)
+			adjacencyStart[v + 1] += adjacencyStart[v];
+
+		adjacency.resize(indices.size());
+		fill.assign(adjacencyStart.begin(), adjacencyStart.end() - 1);
+
+		for (size_t i = 0; i < indices.size(); ++i)
+			adjacency[fill[indices[i]]++] = static_cast<uint32_t>(i / 3);
+
+		// Each edge considered in both directions, moving an unlocked vertex onto the other end
+		collapses.clear();
+
+		for (size_t t = 0; t < indices.size(); t += 3)
+			for (uint8_t corner = 0; corner < 3; ++corner)
+			{
+				const unsigned int
+					a = indices[t + corner],
+					b = indices[t + (corner + 1) % 3];
+
+				for (const auto [from, to] : { std::pair { a, b }, std::pair { b, a } })
+				{
+					if (locked[from])
+						continue;
+
+					Quadric merged = quadrics[from];
+					merged += quadrics[to];
+
+					if (const double cost = merged.error(vertices[to].position); cost <= maxCost)
+						collapses.push_back({ cost, from, to });
+				}
+			}
+
+		std::sort(collapses.begin(), collapses.end(), [](const Collapse& left, const Collapse& right)
+		{
+			return left.cost < right.cost;
+		});
+
+		std::fill(touched.begin(), touched.end(), 0);
+
+		for (size_t v = 0; v < vertexCount; ++v)
+			remap[v] = static_cast<unsigned int>(v);
+
+		size_t removed = 0;
+
+		for (const Collapse& collapse : collapses)
+		{
+			if (triangleCount - removed <= targetTriangles)
+				break;
+
+			// Collapses in a pass keep apart so the adjacency stays valid
+			if (touched[collapse.from] || touched[collapse.to])
+				continue;
+
+			bool flips = false;
+			uint32_t shared = 0;
+
+			for (uint32_t a = adjacencyStart[collapse.from]; a < adjacencyStart[collapse.from + 1] && !flips; ++a)
+			{
+				const unsigned int* const triangle = indices.data() + adjacency[a] * 3;
+
+				if (triangle[0] == collapse.to || triangle[1] == collapse.to || triangle[2] == collapse.to)
+				{
+					++shared;
+					continue;
+				}
+
+				Vector3f before[3], after[3];
+
+				for (uint8_t corner = 0; corner < 3; ++corner)
+				{
+					before[corner] = toVector(vertices[triangle[corner]].position);
+					after[corner]  = triangle[corner] == collapse.from ? toVector(vertices[collapse.to].position) : before[corner];
+				}
+
+				const Vector3f
+					normalBefore = (before[1] - before[0]).cross(before[2] - before[0]),
+					normalAfter  = (after[1] - after[0]).cross(after[2] - after[0]);
+
+				// Rejects triangles turning over or tilting past about 75 degrees, which folds them into slivers
+				flips = normalBefore.dot(normalAfter) <= .25f * normalBefore.magnitude() * normalAfter.magnitude();
+			}
+
+			if (flips)
+				continue;
+
+			remap[collapse.from] = collapse.to;
+			quadrics[collapse.to] += quadrics[collapse.from];
+			removed += shared;
+
+			for (uint32_t a = adjacencyStart[collapse.from]; a < adjacencyStart[collapse.from + 1]; ++a)
+				for (uint8_t corner = 0; corner < 3; ++corner)
+					touched[indices[adjacency[a] * 3 + corner]] = 1;
+		}
+
+		if (!removed)
+			break;
+
+		// Applies the collapses and drops the triangles left without area
+		size_t write = 0;
+
+		for (size_t t = 0; t < indices.size(); t += 3)
+		{
+			const unsigned int
+				i0 = remap[indices[t]],
+				i1 = remap[indices[t + 1]],
+				i2 = remap[indices[t + 2]];
+
+			if (i0 == i1 || i1 == i2 || i0 == i2)
+				continue;
+
+			indices[write++] = i0;
+			indices[write++] = i1;
+			indices[write++] = i2;
+		}
+
+		indices.resize(write);
+		triangleCount = indices.size() / 3;
+	}
+}
+
+float MeshOptimizer::acmr(const std::span<const unsigned int> indices, const size_t vertexCount)
+{
+	if (indices.size() < 3)
+		return 0.f;
+
+	// Miss count when each vertex entered the FIFO, zero if never loaded
+	std::vector<uint32_t> entered(vertexCount, 0);
+	uint32_t misses = 0;
+
+	for (const unsigned int index : indices)
+	{
+		if (entered[index] && misses - entered[index] < CacheSize)
+			continue;
+
+		entered[index] = ++misses;
+	}
+
+	return static_cast<float>(misses) / static_cast<float>(indices.size() / 3);
+}
@@ -1,4 +1,3 @@
-#include "Rendering/Buffer/VertexAttributeBuffer.hpp"
 #include "Rendering/Primitive.h"
 #include "Rendering/Vertex.h"
 
@@ -67,13 +66,7 @@ Sphere::Sphere(float radius, int sectors, int stacks)
 	}
 
 	this->m_radius = radius;
-	this->vertices().create(vertices.data(), (vertices.size() - 1) * sizeof(Vertex));
-	this->elements().create(indices);
-	this->attributes().create();
-	this->attributes().defineAttribute(0, &Vertex::albedo);
-	this->attributes().defineAttribute(1, &Vertex::position);
-	this->attributes().defineAttribute(2, &Vertex::textureUV);
-	this->attributes().defineAttribute(3, &Vertex::normal);
+	this->init(vertices, indices);
 }
 
 float Sphere::getRadius() const noexcept
@@ -142,13 +135,7 @@ Capsule::Capsule(float radius, float height, int sectors, int stacks)
 	this->m_height = height;
 	this->m_radius = radius;
 
-	this->vertices().create(vertices.data(), (vertices.size() - 1) * sizeof(Vertex));
-	this->elements().create(indices);
-	this->attributes().create();
-	this->attributes().defineAttribute(0, &Vertex::albedo);
-	this->attributes().defineAttribute(1, &Vertex::position);
-	this->attributes().defineAttribute(2, &Vertex::textureUV);
-	this->attributes().defineAttribute(3, &Vertex::normal);
+	this->init(vertices, indices);
 }
 
 float Capsule::getRadius() const noexcept
@@ -196,11 +183,5 @@ SecondCube::SecondCube(LibMath::Vector3f size)
 	};
 
 	this->m_size = size;
-	this->vertices().create(&vertarray, 8 * sizeof(Vertex));
-	this->elements().create(indices);
-	this->attributes().create();
-	this->attributes().defineAttribute(0, &Vertex::albedo);
-	this->attributes().defineAttribute(1, &Vertex::position);
-	this->attributes().defineAttribute(2, &Vertex::textureUV);
-	this->attributes().defineAttribute(3, &Vertex::normal);
+	this->init(vertarray, indices);
 }
@@ -0,0 +1,263 @@
+#include "Rendering/RenderThread.h"
+
+#include "Profiling/Profiler.h"
+#include "Queue/Context.h"
+#include "Rendering/Buffer/RingBuffer.h"
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <imgui/imgui.h>
+#include <imgui/imgui_impl_opengl3.h>
+
+#include <chrono>
+#include <iostream>
+
+using KaputEngine::Profiling::Profiler;
+using KaputEngine::Queue::ContextQueue;
+using KaputEngine::Rendering::RenderThread;
+using KaputEngine::Rendering::Buffer::RingBuffer;
+using KaputEngine::Rendering::Command::CommandList;
+
+using std::cerr;
+
+// Interval at which the idle render thread executes context actions while waiting for a frame
+static constexpr std::chrono::milliseconds IdleInterval(1);
+
+RenderThread RenderThread::m_inst;
+
+#pragma region Frame
+RenderThread::Frame::~Frame()
+{
+	releaseUI();
+}
+
+CommandList& RenderThread::Frame::commands() noexcept
+{
+	return m_commands;
+}
+
+const CommandList& RenderThread::Frame::commands() const noexcept
+{
+	return m_commands;
+}
+
+void RenderThread::Frame::captureUI(const ImDrawData& data)
+{
+	releaseUI();
+
+	// The draw lists are owned by the UI context and rebuilt next frame
+	m_ui = IM_NEW(ImDrawData)();
+	*m_ui = data;
+
+	for (ImDrawList*& list : m_ui->CmdLists)
+		list = list->CloneOutput();
+}
+
+void RenderThread::Frame::reset()
+{
+	m_commands.reset();
+	releaseUI();
+}
+
+void RenderThread::Frame::releaseUI() noexcept
+{
+	if (!m_ui)
+		return;
+
+	for (ImDrawList* list : m_ui->CmdLists)
+		IM_DELETE(list);
+
+	IM_DELETE(m_ui);
+	m_ui = nullptr;
+}
+#pragma endregion
+
+RenderThread::~RenderThread()
+{
+	stop();
+}
+
+RenderThread& RenderThread::instance() noexcept
+{
+	return m_inst;
+}
+
+_Success_(return) bool RenderThread::start(_In_ GLFWwindow* const window)
+{
+	if (m_running)
+	{
+		cerr << __FUNCTION__": Render thread already running.\n";
+		return false;
+	}
+
+	if (glfwGetCurrentContext() != window)
+	{
+		cerr << __FUNCTION__": The context of the window must be current on the calling thread.\n";
+		return false;
+	}
+
+	if (ImGui::GetCurrentContext())
+	{
+		// Platform windows are created and drawn from the main thread
+		ImGui::GetIO().ConfigFlags &= ~ImGuiConfigFlags_ViewportsEnable;
+	}
+
+	// Leave no pending action for the new owner that expects the current context
+	ContextQueue::instance().popAll();
+
+	m_window = window;
+	glfwMakeContextCurrent(nullptr);
+
+	{
+		// The thread waits for the ownership transfer before popping
+		std::scoped_lock lock(m_mutex);
+
+		m_running = true;
+		m_thread  = std::thread(&RenderThread::loop, this);
+
+		ContextQueue::instance().setOwner(m_thread.get_id());
+	}
+
+	if (ImGui::GetCurrentContext())
+		// Create the UI device objects on the render thread, the main thread only builds draw data
+		ContextQueue::instance().push([]
+		{
+			ImGui_ImplOpenGL3_NewFrame();
+		}).wait();
+
+	return true;
+}
+
+void RenderThread::stop()
+{
+	if (!m_running)
+		return;
+
+	{
+		std::scoped_lock lock(m_mutex);
+		m_running = false;
+	}
+
+	m_condition.notify_all();
+	m_thread.join();
+
+	ContextQueue::instance().setOwner(std::this_thread::get_id());
+	glfwMakeContextCurrent(m_window);
+
+	// Actions pushed after the render thread last emptied the queue
+	ContextQueue::instance().popAll();
+
+	for (Frame& frame : m_frames)
+		frame.reset();
+
+	m_window = nullptr;
+}
+
+bool RenderThread::running() const noexcept
+{
+	return m_running;
+}
+
+RenderThread::Frame& RenderThread::frame() noexcept
+{
+	return m_frames[m_recordIndex];
+}
+
+void RenderThread::present()
+{
+	if (!m_running)
+	{
+		cerr << __FUNCTION__": Render thread not running.\n";
+		return;
+	}
+
+	// Callbacks read their objects when drawn, which the next update would modify
+	const bool pipelined = !frame().commands().hasCallbacks();
+
+	{
+		std::unique_lock lock(m_mutex);
+		m_condition.wait(lock, [this] { return !m_busy; });
+
+		m_recordIndex ^= 1;
+		m_busy = true;
+	}
+
+	m_condition.notify_all();
+
+	if (!pipelined)
+		waitIdle();
+
+	// The render thread is done with the previous frame
+	m_frames[m_recordIndex].reset();
+}
+
+void RenderThread::waitIdle()
+{
+	if (!m_running)
+		return;
+
+	std::unique_lock lock(m_mutex);
+	m_condition.wait(lock, [this] { return !m_busy; });
+}
+
+void RenderThread::loop()
+{
+	{
+		// Wait for the queue ownership to be transferred
+		std::scoped_lock lock(m_mutex);
+	}
+
+	glfwMakeContextCurrent(m_window);
+	Profiler::instance().setThreadName("Render");
+
+	ContextQueue& queue = ContextQueue::instance();
+	std::unique_lock lock(m_mutex);
+
+	while (true)
+	{
+		// Keep executing context actions while waiting for a frame
+		while (!m_busy && m_running)
+		{
+			lock.unlock();
+			queue.popAll();
+			lock.lock();
+
+			if (!m_busy && m_running)
+				m_condition.wait_for(lock, IdleInterval);
+		}
+
+		// Stopped with no frame left to draw
+		if (!m_busy)
+			break;
+
+		const Frame& frame = m_frames[m_recordIndex ^ 1];
+		lock.unlock();
+
+		// Apply changes made during the update before drawing
+		queue.popAll();
+		draw(frame);
+
+		lock.lock();
+		m_busy = false;
+		m_condition.notify_all();
+	}
+
+	lock.unlock();
+
+	queue.popAll();
+	glfwMakeContextCurrent(nullptr);
+}
+
+void RenderThread::draw(const Frame& frame) const
+{
+	PROFILE_FUNCTION();
+
+	frame.m_commands.submit();
+
+	if (frame.m_ui)
+		ImGui_ImplOpenGL3_RenderDrawData(frame.m_ui);
+
+	RingBuffer::endFrame();
+	glfwSwapBuffers(m_window);
+}
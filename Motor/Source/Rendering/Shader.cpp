@@ -1,5 +1,6 @@
 #include "Rendering/Shader.h"
 
+#include "Application.h"
 #include "Queue/Context.h"
 
 #include "Text/String.h"
@@ -26,6 +27,9 @@ void Shader::create(const GLenum type, const string_view& source, const std::sto
 {
 	m_type = type;
 
+	if (Application::headless())
+		return;
+
 	ContextQueue::instance().push([this, &source, &stopToken]
 	{
 		if (stopToken.stop_requested())
@@ -72,10 +76,11 @@ void Shader::create(const GLenum type, const string_view& source, const std::sto
 
 void Shader::destroy()
 {
-	ContextQueue::instance().push([id = m_id]
-	{
-		glDeleteShader(id);
-	});
+	if (m_id)
+		ContextQueue::instance().post([id = m_id]
+		{
+			glDeleteShader(id);
+		});
 
 	m_id   = 0;
 	m_type = 0;
@@ -1,10 +1,13 @@
 #include "Rendering/ShaderProgram.hpp"
 
+#include "Application.h"
 #include "GameObject/Camera.h"
 #include "Queue/Context.h"
 #include "Rendering/Material.hpp"
 #include "Rendering/Shader.h"
 
+#include <algorithm>
+
 using namespace KaputEngine;
 using namespace KaputEngine::Rendering;
 
@@ -14,6 +17,7 @@ using KaputEngine::Queue::ContextQueue;
 using LibMath::Vector3f;
 using std::cerr;
 using std::string;
+using std::string_view;
 
 ShaderProgram::~ShaderProgram()
 {
@@ -26,6 +30,10 @@ void ShaderProgram::create(ShaderList&& shaders)
 {
 	m_shaders = std::move(shaders);
 
+	// Left invalid, use() fails and renderers skip it
+	if (Application::headless())
+		return;
+
 	ContextQueue::instance().push([this]
 	{
 		m_id = glCreateProgram();
@@ -45,18 +53,28 @@ void ShaderProgram::create(ShaderList&& shaders)
 			cerr << "ERROR::SHADER::PROGRAM::LINKING_FAILED\n" << infoLog << '\n';
 
 			destroy();
+			return;
 		}
+
+		m_reflection.reflect(m_id);
+		resolveEngineUniforms();
 	}).wait();
 }
 
 void ShaderProgram::destroy()
 {
-	ContextQueue::instance().push([id = m_id]
+	if (!m_id)
+		return;
+
+	ContextQueue::instance().post([id = m_id]
 	{
 		glDeleteProgram(id);
 	});
 
 	m_id = 0;
+
+	m_reflection.clear();
+	m_engineUniforms = { };
 }
 
 bool ShaderProgram::use() const
@@ -95,6 +113,56 @@ const unsigned int& ShaderProgram::id() const noexcept
 	return m_id;
 }
 
+bool ShaderProgram::instanced() const noexcept
+{
+	return m_reflection.storageBlock("instanceBuffer") != nullptr;
+}
+
+const ShaderReflection& ShaderProgram::reflection() const noexcept
+{
+	return m_reflection;
+}
+
+const EngineUniforms& ShaderProgram::engineUniforms() const noexcept
+{
+	return m_engineUniforms;
+}
+
+void ShaderProgram::resolveEngineUniforms()
+{
+	// Engine uniforms are optional, no report for the ones a program does not use
+	const auto resolve = [this]<typename T>(UniformHandle<T>& handle, const string_view name)
+	{
+		handle = UniformHandle<T>(m_reflection.location(name));
+	};
+
+	resolve(m_engineUniforms.model, "model");
+	resolve(m_engineUniforms.worldPosition, "worldPosition");
+	resolve(m_engineUniforms.material, "materialSampler.albedo.mode");
+	resolve(m_engineUniforms.instanceOffset, "instanceOffset");
+	resolve(m_engineUniforms.positionScale, "positionScale");
+	resolve(m_engineUniforms.positionOffset, "positionOffset");
+	resolve(m_engineUniforms.mvp, "MVP");
+	resolve(m_engineUniforms.pickingColor, "PickingColor");
+}
+
+void ShaderProgram::reportMissingUniform(const string_view name) const
+{
+	if (markMissing(name))
+		cerr << "Shader uniform \"" << name << "\" not found.\n";
+}
+
+_Success_(return) bool ShaderProgram::markMissing(const string_view name) const
+{
+	std::lock_guard lock(m_missingMutex);
+
+	if (std::find(m_missingUniforms.begin(), m_missingUniforms.end(), name) != m_missingUniforms.end())
+		return false;
+
+	m_missingUniforms.emplace_back(name);
+	return true;
+}
+
 #pragma region Uniforms
 void ShaderProgram::setUniform(
 	const UniformReference& uniform, _In_reads_(count) const Material* const values, const int count) const
@@ -178,6 +246,9 @@ void ShaderProgram::investigateUniform(const UniformReference& uniform, const st
 	{
 		string name = *str;
 
+		if (!markMissing(name))
+			return;
+
 		if (!name.ends_with(target))
 			cerr << "Shader uniform: \"" << name <<
 			"\": Struct or array uniforms set by name must reference the first primitive value. Expected: \"" <<
@@ -244,7 +315,7 @@ int ShaderProgram::getLocation(const UniformReference& uniform) const
 	case 0:
 		return std::get<int>(uniform);
 	case 1:
-		return glGetUniformLocation(m_id, std::get<const char*>(uniform));
+		return m_reflection.location(std::get<const char*>(uniform));
 	default:
 		return -1;
 	}
@@ -0,0 +1,152 @@
+#include "Rendering/ShaderReflection.h"
+
+#include <algorithm>
+#include <glad/glad.h>
+#include <iterator>
+
+using KaputEngine::Rendering::ShaderBlockInfo;
+using KaputEngine::Rendering::ShaderReflection;
+using KaputEngine::Rendering::ShaderUniformInfo;
+
+using std::string;
+using std::string_view;
+
+namespace
+{
+	/// <summary>
+	/// Removes the [0] suffix GL gives to array names so arrays are found by their plain name.
+	/// </summary>
+	_NODISCARD string_view stripArray(string_view name) noexcept
+	{
+		if (name.ends_with("[0]"))
+			name.remove_suffix(3);
+
+		return name;
+	}
+
+	_NODISCARD string resourceName(const GLuint program, const GLenum interface, const GLuint index, const GLint length)
+	{
+		// Length includes the null terminator
+		string name(length, '\0');
+		glGetProgramResourceName(program, interface, index, length, nullptr, name.data());
+		name.resize(length > 0 ? length - 1 : 0);
+
+		return name;
+	}
+
+	void reflectBlocks(const GLuint program, const GLenum interface, std::vector<ShaderBlockInfo>& out)
+	{
+		GLint count = 0;
+		glGetProgramInterfaceiv(program, interface, GL_ACTIVE_RESOURCES, &count);
+
+		constexpr GLenum props[] { GL_NAME_LENGTH, GL_BUFFER_BINDING, GL_BUFFER_DATA_SIZE };
+
+		out.reserve(count);
+
+		for (GLint i = 0; i < count; ++i)
+		{
+			GLint values[std::size(props)];
+			glGetProgramResourceiv(program, interface, i, std::size(props), props, std::size(values), nullptr, values);
+
+			out.push_back(
+			{
+				.name     = resourceName(program, interface, i, values[0]),
+				.binding  = values[1],
+				.dataSize = values[2]
+			});
+		}
+	}
+
+	template <typename T>
+	_NODISCARD _Ret_maybenull_ const T* findByName(const std::vector<T>& items, const string_view name) noexcept
+	{
+		const auto it = std::find_if(items.begin(), items.end(), [name](const T& item) { return item.name == name; });
+		return it != items.end() ? std::to_address(it) : nullptr;
+	}
+}
+
+void ShaderReflection::reflect(const unsigned int program)
+{
+	clear();
+
+	GLint count = 0;
+	glGetProgramInterfaceiv(program, GL_UNIFORM, GL_ACTIVE_RESOURCES, &count);
+
+	constexpr GLenum props[] { GL_NAME_LENGTH, GL_TYPE, GL_LOCATION, GL_ARRAY_SIZE, GL_BLOCK_INDEX };
+
+	m_uniforms.reserve(count);
+
+	for (GLint i = 0; i < count; ++i)
+	{
+		GLint values[std::size(props)];
+		glGetProgramResourceiv(program, GL_UNIFORM, i, std::size(props), props, std::size(values), nullptr, values);
+
+		// Members of uniform blocks have no location and are described by their block
+		if (values[4] != -1)
+			continue;
+
+		const string name = resourceName(program, GL_UNIFORM, i, values[0]);
+
+		m_uniforms.push_back(
+		{
+			.name      = string(stripArray(name)),
+			.location  = values[2],
+			.type      = static_cast<unsigned int>(values[1]),
+			.arraySize = values[3]
+		});
+	}
+
+	std::sort(m_uniforms.begin(), m_uniforms.end(),
+		[](const ShaderUniformInfo& a, const ShaderUniformInfo& b) { return a.name < b.name; });
+
+	reflectBlocks(program, GL_UNIFORM_BLOCK, m_uniformBlocks);
+	reflectBlocks(program, GL_SHADER_STORAGE_BLOCK, m_storageBlocks);
+}
+
+void ShaderReflection::clear() noexcept
+{
+	m_uniforms.clear();
+	m_uniformBlocks.clear();
+	m_storageBlocks.clear();
+}
+
+int ShaderReflection::location(const string_view name) const noexcept
+{
+	const ShaderUniformInfo* const info = uniform(name);
+	return info ? info->location : -1;
+}
+
+_Ret_maybenull_ const ShaderUniformInfo* ShaderReflection::uniform(string_view name) const noexcept
+{
+	name = stripArray(name);
+
+	const auto it = std::lower_bound(m_uniforms.begin(), m_uniforms.end(), name,
+		[](const ShaderUniformInfo& info, const string_view value) { return info.name < value; });
+
+	return it != m_uniforms.end() && it->name == name ? std::to_address(it) : nullptr;
+}
+
+_Ret_maybenull_ const ShaderBlockInfo* ShaderReflection::uniformBlock(const string_view name) const noexcept
+{
+	return findByName(m_uniformBlocks, name);
+}
+
+_Ret_maybenull_ const ShaderBlockInfo* ShaderReflection::storageBlock(const string_view name) const noexcept
+{
+	return findByName(m_storageBlocks, name);
+}
+
+const std::vector<ShaderUniformInfo>& ShaderReflection::uniforms() const noexcept
+{
+	return m_uniforms;
+}
+
+const std::vector<ShaderBlockInfo>& ShaderReflection::uniformBlocks() const noexcept
+{
+	return m_uniformBlocks;
+}
+
+const std::vector<ShaderBlockInfo>& ShaderReflection::storageBlocks() const noexcept
+{
+	return m_storageBlocks;
+}
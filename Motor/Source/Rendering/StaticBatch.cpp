@@ -0,0 +1,216 @@
+#include "Rendering/StaticBatch.h"
+
+#include "Component/RenderComponent.h"
+#include "GameObject/GameObject.h"
+#include "Profiling/Profiler.h"
+#include "Rendering/DrawQueue.h"
+#include "Rendering/Mesh.hpp"
+#include "Rendering/ShaderProgram.h"
+#include "Resource/Material.h"
+
+#include <cmath>
+#include <cstdint>
+#include <map>
+#include <ranges>
+#include <tuple>
+
+using KaputEngine::Camera;
+using KaputEngine::RenderComponent;
+using KaputEngine::Rendering::DrawItem;
+using KaputEngine::Rendering::DrawQueue;
+using KaputEngine::Rendering::eMeshRetention;
+using KaputEngine::Rendering::Material;
+using KaputEngine::Rendering::Mesh;
+using KaputEngine::Rendering::ShaderProgram;
+using KaputEngine::Rendering::StaticBatch;
+using KaputEngine::Rendering::Vertex;
+using KaputEngine::Rendering::Culling::Bounds;
+using KaputEngine::Rendering::Culling::Occluder;
+using KaputEngine::Resource::MaterialResource;
+
+using LibMath::Matrix4f;
+
+namespace
+{
+	// Program, material, fallback material and grid cell
+	using GroupKey = std::tuple<const ShaderProgram*, const Material*, const Material*, int, int, int>;
+}
+
+StaticBatch::StaticBatch(std::shared_ptr<const ShaderProgram> program, std::shared_ptr<const Material> material,
+	_In_opt_ const Material* const fallbackMaterial) :
+	m_program(std::move(program)),
+	m_material(std::move(material)),
+	m_fallbackMaterial(fallbackMaterial) { }
+
+std::vector<std::unique_ptr<StaticBatch>> StaticBatch::build(const std::span<RenderComponent* const> components)
+{
+	PROFILE_FUNCTION();
+
+	std::map<GroupKey, std::vector<Piece>> groups;
+	std::vector<RenderComponent*> merged;
+
+	for (RenderComponent* const component : components)
+	{
+		const std::shared_ptr<const Mesh>& mesh = component->mesh();
+		const std::shared_ptr<const ShaderProgram>& program = component->shaderProgram();
+
+		if (!mesh || !program)
+			continue;
+
+		// Released by an earlier build, the component keeps drawing itself
+		bool released = false;
+
+		mesh->forEachMesh(Matrix4f::Identity(), [&released](const Mesh& node, const Matrix4f&)
+		{
+			released |= node.retention() != eMeshRetention::FULL;
+		});
+
+		if (released)
+			continue;
+
+		const std::shared_ptr<const Material> material = component->material() ?
+			component->material() : MaterialResource::defaultMaterial()->dataPtr();
+
+		bool empty = true;
+
+		mesh->forEachMesh(component->parentObject()->getWorldTransformMatrix(),
+		[&](const Mesh& node, const Matrix4f& model)
+		{
+			if (node.sourceIndices().empty())
+				return;
+
+			empty = false;
+
+			const LibMath::Cartesian3f center = node.localBounds().transform(model).sphere.center;
+
+			const GroupKey key
+			{
+				std::to_address(program), std::to_address(material), node.material(),
+				static_cast<int>(std::floor(center.x() / CellSize)),
+				static_cast<int>(std::floor(center.y() / CellSize)),
+				static_cast<int>(std::floor(center.z() / CellSize))
+			};
+
+			groups[key].push_back({ .component = component, .mesh = &node, .model = model });
+		});
+
+		if (!empty)
+			merged.push_back(component);
+	}
+
+	std::vector<std::unique_ptr<StaticBatch>> batches;
+	batches.reserve(groups.size());
+
+	std::vector<Vertex> vertices;
+	std::vector<unsigned int> indices;
+
+	for (const std::vector<Piece>& pieces : groups | std::views::values)
+	{
+		const RenderComponent& first = *pieces.front().component;
+
+		std::unique_ptr<StaticBatch>& batch = batches.emplace_back(std::make_unique<StaticBatch>(
+			first.shaderProgram(),
+			first.material() ? first.material() : MaterialResource::defaultMaterial()->dataPtr(),
+			pieces.front().mesh->material()));
+
+		// Vertex colors are uploaded for the whole batch if any piece has them
+		bool colors = false;
+
+		for (const Piece& piece : pieces)
+			colors |= piece.mesh->hasColors();
+
+		vertices.clear();
+		indices.clear();
+
+		batch->m_pieces.reserve(pieces.size());
+
+		for (const Piece& piece : pieces)
+		{
+			const size_t firstIndex = indices.size();
+			piece.mesh->appendWorldGeometry(vertices, indices, piece.model, colors);
+
+			Piece& added = batch->m_pieces.emplace_back(piece);
+			added.firstIndex = static_cast<uint32_t>(firstIndex);
+			added.indexCount = static_cast<uint32_t>(indices.size() - firstIndex);
+
+			if (const std::shared_ptr<const Mesh>& source = piece.component->mesh();
+				batch->m_sources.empty() || batch->m_sources.back() != source)
+				batch->m_sources.push_back(source);
+		}
+
+		// Uploaded in piece order without reordering, so each piece keeps its range
+		batch->m_mesh.init(vertices, indices, colors, eMeshRetention::NONE);
+	}
+
+	// Only the occluder geometry is read once merged
+	for (const std::vector<Piece>& pieces : groups | std::views::values)
+		for (const Piece& piece : pieces)
+			piece.mesh->releaseSource();
+
+	for (RenderComponent* const component : merged)
+		component->setBatched(true);
+
+	return batches;
+}
+
+_Success_(return) bool StaticBatch::getWorldBounds(_Out_ Bounds& out) const
+{
+	out = m_mesh.localBounds();
+	return !m_pieces.empty() && !out.empty();
+}
+
+_Success_(return) bool StaticBatch::queue(DrawQueue& queue, const Camera&)
+{
+	// Nothing to draw, handled all the same
+	if (!m_program->id() || m_pieces.empty())
+		return true;
+
+	queue.push(DrawItem
+	{
+		.program          = std::to_address(m_program),
+		.material         = std::to_address(m_material),
+		.fallbackMaterial = m_fallbackMaterial,
+		.mesh             = &m_mesh,
+		.model            = Matrix4f::Identity(),
+		.worldPosition    = m_mesh.localBounds().sphere.center
+	});
+
+	return true;
+}
+
+void StaticBatch::appendOccluders(std::vector<Occluder>& out) const
+{
+	for (const Piece& piece : m_pieces)
+		if (piece.component->isOccluder() && !piece.mesh->occluderIndices().empty())
+			out.push_back({ .mesh = piece.mesh, .model = piece.model });
+}
+
+bool StaticBatch::remove(const RenderComponent& component)
+{
+	bool found = false;
+
+	for (const Piece& piece : m_pieces)
+		if (piece.component == &component)
+		{
+			m_mesh.elements().clearRange(piece.firstIndex, piece.indexCount);
+			found = true;
+		}
+
+	if (found)
+		std::erase_if(m_pieces, [&component](const Piece& piece)
+		{
+			return piece.component == &component;
+		});
+
+	return found;
+}
+
+const Mesh& StaticBatch::mesh() const noexcept
+{
+	return m_mesh;
+}
+
+size_t StaticBatch::pieceCount() const noexcept
+{
+	return m_pieces.size();
+}
@@ -0,0 +1,78 @@
+#include "Rendering/UniformBlocks.h"
+
+#include "Application.h"
+#include "GameObject/Camera.h"
+#include "Profiling/Profiler.h"
+#include "Rendering/Command/CommandList.h"
+
+using KaputEngine::Application;
+using KaputEngine::Camera;
+using KaputEngine::Rendering::FrameData;
+using KaputEngine::Rendering::UniformBlocks;
+using KaputEngine::Rendering::ViewData;
+using KaputEngine::Rendering::Buffer::eRingTarget;
+using KaputEngine::Rendering::Command::CommandList;
+
+using LibMath::Vector2i;
+
+void UniformBlocks::create()
+{
+	m_frameBuffer.create(eRingTarget::UNIFORM, sizeof(FrameData), FrameData::Binding);
+	m_viewBuffer.create(eRingTarget::UNIFORM, sizeof(ViewData), ViewData::Binding);
+
+	m_frameUploaded = false;
+}
+
+void UniformBlocks::destroy()
+{
+	m_frameBuffer.destroy();
+	m_viewBuffer.destroy();
+
+	m_frameUploaded = false;
+}
+
+void UniformBlocks::record(CommandList& list, const Camera& camera)
+{
+	PROFILE_FUNCTION();
+
+	// Not created without a context
+	if (!m_viewBuffer.valid())
+		return;
+
+	const Vector2i& size = Application::getWindow().getSize();
+
+	const FrameData frame
+	{
+		.time       = static_cast<float>(Application::getTime()),
+		.deltaTime  = static_cast<float>(Application::getDeltaTime()),
+		.resolution = { static_cast<float>(size.x()), static_cast<float>(size.y()) }
+	};
+
+	// Cameras recorded within the same frame share the frame data
+	if (!m_frameUploaded || frame != m_frame)
+	{
+		m_frame = frame;
+		m_frameUploaded = true;
+
+		list.uploadRingBuffer(m_frameBuffer, sizeof(FrameData), &m_frame);
+	}
+	else
+		list.bindRingBuffer(m_frameBuffer);
+
+	m_view.view           = camera.getViewMatrix();
+	m_view.projection     = camera.getProjectionMatrix();
+	m_view.viewProjection = camera.getViewProjectionMatrix();
+	m_view.position       = camera.getWorldTransform().position;
+
+	list.uploadRingBuffer(m_viewBuffer, sizeof(ViewData), &m_view);
+}
+
+const FrameData& UniformBlocks::frame() const noexcept
+{
+	return m_frame;
+}
+
+const ViewData& UniformBlocks::view() const noexcept
+{
+	return m_view;
+}
@@ -0,0 +1,276 @@
+#include "Rendering/Vertex.h"
+
+#include "Rendering/Buffer/VertexAttributeBuffer.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+using KaputEngine::Rendering::CompactVertex;
+using KaputEngine::Rendering::eVertexFormat;
+using KaputEngine::Rendering::HalfFloat;
+using KaputEngine::Rendering::PackedVertices;
+using KaputEngine::Rendering::QuantizedVertex;
+using KaputEngine::Rendering::Vertex;
+using KaputEngine::Rendering::VertexColor;
+using KaputEngine::Rendering::VertexQuantization;
+using KaputEngine::Rendering::Buffer::VertexAttributeBuffer;
+
+using LibMath::Cartesian3f;
+using LibMath::Vector3f;
+
+namespace
+{
+	template <typename T>
+	T normalizedInteger(const float value) noexcept
+	{
+		constexpr float Max = static_cast<float>(std::numeric_limits<T>::max());
+		constexpr float Min = std::is_signed_v<T> ? -1.f : 0.f;
+
+		return static_cast<T>(std::lround(std::clamp(value, Min, 1.f) * Max));
+	}
+
+	float signNotZero(const float value) noexcept
+	{
+		return value >= 0.f ? 1.f : -1.f;
+	}
+
+	/// <summary>
+	/// Projects a direction on an octahedron unfolded in the [-1, 1] square. Decoded by octDecode in Vertex.glsl.
+	/// </summary>
+	void octEncode(const Vector3f& direction, float& u, float& v) noexcept
+	{
+		const float sum = std::abs(direction.x()) + std::abs(direction.y()) + std::abs(direction.z());
+
+		// Degenerate directions decode as +Z
+		if (sum == 0.f)
+		{
+			u = v = 0.f;
+			return;
+		}
+
+		u = direction.x() / sum;
+		v = direction.y() / sum;
+
+		// The lower half is folded over the diagonals
+		if (direction.z() < 0.f)
+		{
+			const float foldedU = (1.f - std::abs(v)) * signNotZero(u);
+			v = (1.f - std::abs(u)) * signNotZero(v);
+			u = foldedU;
+		}
+	}
+
+	template <typename TVertex>
+	void packSurface(const Vertex& vertex, TVertex& out) noexcept
+	{
+		out.textureUV[0] = HalfFloat(vertex.textureUV.x());
+		out.textureUV[1] = HalfFloat(vertex.textureUV.y());
+
+		float u, v;
+
+		octEncode(vertex.normal, u, v);
+		out.normal[0] = normalizedInteger<int16_t>(u);
+		out.normal[1] = normalizedInteger<int16_t>(v);
+
+		octEncode(vertex.tangent, u, v);
+		out.tangent[0] = normalizedInteger<int8_t>(u);
+		out.tangent[1] = normalizedInteger<int8_t>(v);
+
+		// Handedness of the tangent space, the bitangent is rebuilt from the normal and tangent
+		out.tangent[2] = vertex.normal.cross(vertex.tangent).dot(vertex.bitangent) < 0.f ? -127 : 127;
+		out.tangent[3] = 0;
+	}
+
+	template <typename TVertex>
+	void defineVertexAttributes(VertexAttributeBuffer& attributes)
+	{
+		// Quantized positions are read normalized and mapped back by the position uniforms
+		attributes.defineAttribute(1, &TVertex::position, std::is_same_v<TVertex, QuantizedVertex>);
+		attributes.defineAttribute(2, &TVertex::textureUV);
+		attributes.defineAttribute(3, &TVertex::normal, true);
+		attributes.defineAttribute(4, &TVertex::tangent, true);
+	}
+}
+
+HalfFloat::HalfFloat(const float value) noexcept
+{
+	const uint32_t
+		single   = std::bit_cast<uint32_t>(value),
+		sign     = (single >> 16) & 0x8000,
+		exponent = (single >> 23) & 0xff;
+
+	uint32_t mantissa = single & 0x7fffff;
+
+	// Infinity and NaN
+	if (exponent == 0xff)
+	{
+		bits = static_cast<uint16_t>(sign | 0x7c00 | (mantissa ? 0x200 : 0));
+		return;
+	}
+
+	const int halfExponent = static_cast<int>(exponent) - 127 + 15;
+
+	if (halfExponent >= 0x1f)
+	{
+		// Too large, rounded to infinity
+		bits = static_cast<uint16_t>(sign | 0x7c00);
+	}
+	else if (halfExponent <= 0)
+	{
+		// Too small even for a subnormal half
+		if (halfExponent < -10)
+		{
+			bits = static_cast<uint16_t>(sign);
+			return;
+		}
+
+		mantissa |= 0x800000;
+
+		const uint32_t shift = static_cast<uint32_t>(14 - halfExponent);
+		uint32_t half = mantissa >> shift;
+
+		if ((mantissa >> (shift - 1)) & 1)
+			++half;
+
+		bits = static_cast<uint16_t>(sign | half);
+	}
+	else
+	{
+		// Rounding may carry into the exponent, which is still the correct result
+		uint32_t half = static_cast<uint32_t>(halfExponent) << 10 | mantissa >> 13;
+
+		if (mantissa & 0x1000)
+			++half;
+
+		bits = static_cast<uint16_t>(sign | half);
+	}
+}
+
+bool VertexQuantization::operator==(const VertexQuantization& other) const noexcept
+{
+	return scale == other.scale && offset == other.offset;
+}
+
+PackedVertices PackedVertices::pack(const std::span<const Vertex> vertices, const eVertexFormat format, const bool colors)
+{
+	PackedVertices out;
+	out.m_format = format;
+	out.m_colors = colors;
+
+	const size_t stride = format == eVertexFormat::QUANTIZED ? sizeof(QuantizedVertex) : sizeof(CompactVertex);
+
+	out.m_colorOffset = vertices.size() * stride;
+	out.m_data.resize(out.m_colorOffset + (colors ? vertices.size() * sizeof(VertexColor) : 0));
+
+	std::byte* const data = out.m_data.data();
+
+	switch (format)
+	{
+	case eVertexFormat::COMPACT:
+		for (size_t i = 0; i < vertices.size(); ++i)
+		{
+			CompactVertex vertex { .position = vertices[i].position };
+			packSurface(vertices[i], vertex);
+
+			std::memcpy(data + i * sizeof(CompactVertex), &vertex, sizeof(CompactVertex));
+		}
+		break;
+	case eVertexFormat::QUANTIZED:
+	{
+		Cartesian3f low, high;
+
+		if (!vertices.empty())
+			low = high = vertices.front().position;
+
+		for (const Vertex& vertex : vertices)
+			for (uint8_t axis = 0; axis < 3; ++axis)
+			{
+				low[axis]  = std::min(low[axis], vertex.position[axis]);
+				high[axis] = std::max(high[axis], vertex.position[axis]);
+			}
+
+		for (uint8_t axis = 0; axis < 3; ++axis)
+			out.m_quantization.scale[axis] = high[axis] - low[axis];
+
+		out.m_quantization.offset = low;
+
+		for (size_t i = 0; i < vertices.size(); ++i)
+		{
+			QuantizedVertex vertex { };
+
+			for (uint8_t axis = 0; axis < 3; ++axis)
+			{
+				const float extent = out.m_quantization.scale[axis];
+
+				// Flat axes keep every vertex on the offset
+				vertex.position[axis] = extent > 0.f ?
+					normalizedInteger<uint16_t>((vertices[i].position[axis] - low[axis]) / extent) : 0;
+			}
+
+			packSurface(vertices[i], vertex);
+
+			std::memcpy(data + i * sizeof(QuantizedVertex), &vertex, sizeof(QuantizedVertex));
+		}
+		break;
+	}
+	}
+
+	if (colors)
+		for (size_t i = 0; i < vertices.size(); ++i)
+		{
+			VertexColor color;
+
+			for (uint8_t channel = 0; channel < 4; ++channel)
+				color.albedo[channel] = normalizedInteger<uint8_t>(vertices[i].albedo.raw()[channel]);
+
+			std::memcpy(data + out.m_colorOffset + i * sizeof(VertexColor), &color, sizeof(VertexColor));
+		}
+
+	return out;
+}
+
+void PackedVertices::defineAttributes(VertexAttributeBuffer& attributes) const
+{
+	switch (m_format)
+	{
+	case eVertexFormat::COMPACT:
+		defineVertexAttributes<CompactVertex>(attributes);
+		break;
+	case eVertexFormat::QUANTIZED:
+		defineVertexAttributes<QuantizedVertex>(attributes);
+		break;
+	}
+
+	// Left disabled without colors, the shader reads the default (0, 0, 0, 1)
+	if (m_colors)
+		attributes.defineAttribute(0, &VertexColor::albedo, true, m_colorOffset);
+}
+
+const std::byte* PackedVertices::data() const noexcept
+{
+	return m_data.data();
+}
+
+size_t PackedVertices::size() const noexcept
+{
+	return m_data.size();
+}
+
+eVertexFormat PackedVertices::format() const noexcept
+{
+	return m_format;
+}
+
+const VertexQuantization& PackedVertices::quantization() const noexcept
+{
+	return m_quantization;
+}
+
+bool PackedVertices::hasColors() const noexcept
+{
+	return m_colors;
+}
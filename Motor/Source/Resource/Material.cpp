@@ -1,5 +1,6 @@
 #include "Resource/Material.hpp"
 
+#include "Profiling/Profiler.h"
 #include "Resource/Manager.hpp"
 #include "Resource/Texture.h"
 
@@ -29,6 +30,8 @@ std::future<void>& MaterialResource::load(string&& content, const eMultiThreadPo
 	return m_loadFuture = createFuture<void>(policy,
 	[this, content = std::move(content)](eMultiThreadPolicy) -> void
 	{
+		PROFILE_ZONE(Context);
+
 		if (m_stopSource.stop_requested())
 		{
 			m_loadState = eLoadState::UNLOADED;
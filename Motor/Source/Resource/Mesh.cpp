@@ -1,4 +1,5 @@
 #include "Rendering/Material.h"
+#include "Profiling/Profiler.h"
 #include "Resource/Manager.hpp"
 #include "Resource/Mesh.h"
 #include "Resource/Texture.h"
@@ -11,6 +12,7 @@
 
 using namespace KaputEngine::Text::Xml;
 
+using KaputEngine::Rendering::eVertexFormat;
 using KaputEngine::Rendering::Material;
 using KaputEngine::Rendering::Mesh;
 using KaputEngine::Resource::MeshResource;
@@ -37,6 +39,8 @@ std::future<void>& MeshResource::load(string&& content, const eMultiThreadPolicy
 	return m_loadFuture = createFuture<void>(policy,
 	[this, content = std::move(content)](eMultiThreadPolicy policy) -> void
 	{
+		PROFILE_ZONE(Context);
+
 		if (m_stopSource.stop_requested())
 		{
 			m_loadState = eLoadState::UNLOADED;
@@ -117,7 +121,7 @@ std::future<void>& MeshResource::load(string&& content, const eMultiThreadPolicy
 				assimpMesh.mMaterialIndex == -1 ? nullptr :
 				std::shared_ptr<Material>{ shared_from_this(), &m_materials[assimpMesh.mMaterialIndex] };
 
-			if (!mesh.init(assimpMesh, nullptr))
+			if (!mesh.init(assimpMesh, nullptr, m_vertexFormat, static_cast<uint8_t>(m_lods)))
 			{
 				cerr << Context << ": Failed to load Model resource.\n";
 				m_loadState = eLoadState::UNLOADED;
@@ -148,10 +152,48 @@ _Success_(return) bool MeshResource::deserializeMap(_In_ const XmlNode::Map& map
 		return false;
 	}
 
+	switch (string format; mapParse("VertexFormat", map, format))
+	{
+	case eMapParseResult::SUCCESS:
+		if (format == "Compact")
+			m_vertexFormat = eVertexFormat::COMPACT;
+		else if (format == "Quantized")
+			m_vertexFormat = eVertexFormat::QUANTIZED;
+		else
+		{
+			cerr << __FUNCTION__": Unknown VertexFormat \"" << format << "\".\n";
+			return false;
+		}
+		break;
+	case eMapParseResult::FAILURE:
+		cerr << __FUNCTION__": Failed to deserialize VertexFormat.\n";
+		return false;
+	}
+
+	switch (mapParse("Lods", map, m_lods))
+	{
+	case eMapParseResult::SUCCESS:
+		if (m_lods < 1 || m_lods > Mesh::MaxLods)
+		{
+			cerr << __FUNCTION__": Lods must be between 1 and " << static_cast<unsigned int>(Mesh::MaxLods) << ".\n";
+			return false;
+		}
+		break;
+	case eMapParseResult::FAILURE:
+		cerr << __FUNCTION__": Failed to deserialize Lods.\n";
+		return false;
+	}
+
 	return true;
 }
 
 void MeshResource::serializeValues(XmlSerializeContext& context) const
 {
 	context.value("Source", m_modelPath);
+
+	if (m_vertexFormat == eVertexFormat::QUANTIZED)
+		context.value("VertexFormat", "Quantized");
+
+	if (m_lods != Mesh::MaxLods)
+		context.value("Lods", m_lods);
 }
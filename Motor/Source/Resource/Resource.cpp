@@ -1,5 +1,6 @@
 #include "Resource/Resource.h"
 
+#include "Job/JobSystem.h"
 #include "Resource/Manager.h"
 #include "Text/String.h"
 #include "Text/Xml/Node.h"
@@ -140,6 +141,7 @@ _Success_(return) bool Resource::deserializeForLoad(const string& content)
 
 void Resource::waitLoad() const
 {
+	// Workers keep executing other jobs while waiting
 	if (processing())
-		m_loadFuture.wait();
+		Job::JobSystem::instance().wait(m_loadFuture);
 }
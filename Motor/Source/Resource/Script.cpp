@@ -1,5 +1,6 @@
 #include "Resource/Script.h"
 
+#include "Profiling/Profiler.h"
 #include "Resource/Manager.hpp"
 #include "Text/Xml/Context.hpp"
 #include "Text/Xml/Parser.hpp"
@@ -34,6 +35,8 @@ std::future<void>& ScriptResource::load(string&& content, const eMultiThreadPoli
 	return m_loadFuture = createFuture<void>(policy,
 	[this, content = std::move(content)](eMultiThreadPolicy)
 	{
+		PROFILE_ZONE(Context);
+
 		if (m_stopSource.stop_requested())
 		{
 			m_loadState = eLoadState::UNLOADED;
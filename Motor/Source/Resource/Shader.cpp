@@ -1,5 +1,6 @@
 #include "Resource/Shader.h"
 
+#include "Profiling/Profiler.h"
 #include "Resource/Manager.hpp"
 #include "Text/ShaderPreprocessor.h"
 #include "Text/Xml/Context.hpp"
@@ -35,6 +36,8 @@ std::future<void>& ShaderResource::load(string&& content, const eMultiThreadPoli
 	return m_loadFuture = createFuture<void>(policy,
 	[this, content = std::move(content)](eMultiThreadPolicy) -> void
 	{
+		PROFILE_ZONE(Context);
+
 		if (m_stopSource.stop_requested())
 		{
 			m_loadState = eLoadState::UNLOADED;
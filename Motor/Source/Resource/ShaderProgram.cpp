@@ -1,5 +1,6 @@
 #include "Resource/ShaderProgram.h"
 
+#include "Profiling/Profiler.h"
 #include "Resource/Manager.hpp"
 #include "Resource/Shader.h"
 #include "Text/Xml/Context.hpp"
@@ -29,8 +30,10 @@ std::future<void>& ShaderProgramResource::load(string&& content, const eMultiThr
 		return m_loadFuture;
 
 	return m_loadFuture = createFuture<void>(policy,
-	[this, content = std::move(content)](eMultiThreadPolicy) -> void
+	[this, content = std::move(content)](eMultiThreadPolicy policy) -> void
 	{
+		PROFILE_ZONE("ShaderProgramResource::load");
+
 		if (m_stopSource.stop_requested())
 		{
 			m_loadState = eLoadState::UNLOADED;
@@ -50,15 +53,22 @@ std::future<void>& ShaderProgramResource::load(string&& content, const eMultiThr
 			return;
 		}
 
-		int shaderIndex = 0;
 		ShaderProgram::ShaderList shaders;
+		std::vector<std::shared_ptr<ShaderResource>> shaderResources;
 
 		shaders.reserve(m_shaderPaths.size());
+		shaderResources.reserve(m_shaderPaths.size());
 
+		// Start every stage before waiting so they are preprocessed in parallel
 		for (const std::filesystem::path& path : m_shaderPaths)
 		{
-			const std::shared_ptr<ShaderResource> shader = ResourceManager::get<ShaderResource>(path, false);
-			shader->loadExisting(eMultiThreadPolicy::MONO_THREAD).wait();
+			const std::shared_ptr<ShaderResource>& shader = shaderResources.emplace_back(ResourceManager::get<ShaderResource>(path, false));
+			shader->loadExisting(policy);
+		}
+
+		for (const std::shared_ptr<ShaderResource>& shader : shaderResources)
+		{
+			shader->waitLoad();
 			shaders.emplace_back(shader->dataPtr());
 		}
 
@@ -1,5 +1,6 @@
 #include "Resource/Sound.h"
 
+#include "Profiling/Profiler.h"
 #include "Resource/Manager.hpp"
 #include "Text/Xml/Context.hpp"
 #include "Text/Xml/Parser.hpp"
@@ -31,6 +32,8 @@ std::future<void>& SoundResource::load(string&& content, const eMultiThreadPolic
 	return m_loadFuture = createFuture<void>(policy,
 	[this, content = std::move(content)](eMultiThreadPolicy) -> void
 	{
+		PROFILE_ZONE(Context);
+
 		if (m_stopSource.stop_requested())
 		{
 			m_loadState = eLoadState::UNLOADED;
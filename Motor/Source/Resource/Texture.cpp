@@ -2,6 +2,8 @@
 
 #include "Resource/Texture.h"
 
+#include "Application.h"
+#include "Profiling/Profiler.h"
 #include "Queue/Context.h"
 #include "Resource/Manager.hpp"
 #include "Text/Xml/Context.hpp"
@@ -51,6 +53,8 @@ std::future<void>& TextureResource::load(string&& content, const eMultiThreadPol
 	return m_loadFuture = createFuture<void>(policy,
 	[this, content = std::move(content)](eMultiThreadPolicy) -> void
 	{
+		PROFILE_ZONE(Context);
+
 		if (m_stopSource.stop_requested())
 		{
 			m_loadState = eLoadState::UNLOADED;
@@ -105,6 +109,14 @@ std::future<void>& TextureResource::load(string&& content, const eMultiThreadPol
 			return;
 		}
 
+		if (Application::headless())
+		{
+			// No context to upload to, the texture is never sampled
+			stbi_image_free(imageData);
+			m_loadState = eLoadState::LOADED;
+			return;
+		}
+
 		ContextQueue::instance().push([this, &size, imageData]() -> void
 		{
 			m_data.create(size, imageData);
@@ -128,6 +140,8 @@ std::future<void>& TextureResource::load(aiTexture&& texture, eMultiThreadPolicy
 	return m_loadFuture = createFuture<void>(policy,
 	[this, texture = std::move(texture)](eMultiThreadPolicy)
 	{
+		PROFILE_ZONE(Context);
+
 		if (m_stopSource.stop_requested())
 		{
 			m_loadState = eLoadState::UNLOADED;
@@ -160,6 +174,15 @@ std::future<void>& TextureResource::load(aiTexture&& texture, eMultiThreadPolicy
 		else
 			size = { (int)texture.mWidth, (int)texture.mHeight, 3 };
 
+		if (Application::headless())
+		{
+			if (compressed)
+				stbi_image_free(imageData);
+
+			m_loadState = eLoadState::LOADED;
+			return;
+		}
+
 		ContextQueue::instance().push([this, size, imageData, compressed]() -> void
 		{
 			if (m_stopSource.stop_requested())
@@ -1,9 +1,14 @@
 #include "Scene/Scene.h"
 
 #include "Component/Audio/AudioListenerComponent.h"
+#include "Component/RenderComponent.h"
 #include "GameObject/Camera.h"
+#include "Job/JobSystem.h"
+#include "Profiling/Profiler.h"
 #include "Queue/Context.h"
+#include "Rendering/Command/CommandList.hpp"
 #include "Rendering/Lighting/LightBuffer.hpp"
+#include "Rendering/RenderThread.h"
 #include "Text/Xml/Context.hpp"
 #include "Text/Xml/Parser.hpp"
 #include "Utils/RemoveVector.hpp"
@@ -16,11 +21,25 @@
 using namespace KaputEngine;
 using namespace KaputEngine::Text::Xml;
 
+using KaputEngine::Job::JobHandle;
+using KaputEngine::Job::JobSystem;
 using KaputEngine::Rendering::Color;
+using KaputEngine::Rendering::DrawStats;
+using KaputEngine::Rendering::RenderThread;
+using KaputEngine::Rendering::StaticBatch;
+using KaputEngine::Rendering::Buffer::RingBuffer;
+using KaputEngine::Rendering::Command::CommandList;
+using KaputEngine::Rendering::Culling::Bounds;
+using KaputEngine::Rendering::Culling::CullingStats;
+using KaputEngine::Rendering::Culling::Frustum;
 using KaputEngine::Rendering::Lighting::DirectionalLightBuffer;
 using KaputEngine::Rendering::Lighting::PointLightBuffer;
+using KaputEngine::Memory::SlabArena;
+using KaputEngine::Memory::SlabStats;
 using KaputEngine::Queue::ContextQueue;
 
+using LibMath::Matrix4f;
+
 using std::cerr;
 using std::ios;
 using std::filesystem::path;
@@ -57,6 +76,9 @@ _Success_(return) bool Scene::load(const path& path)
 
 	std::optional<XmlNode::Map> mapOp = document.toMap();
 
+	// Objects created by deserialization live in the scene arena
+	SlabArena::Scope arenaScope(std::to_address(m_arena));
+
 	if (!mapOp)
 	{
 		cerr << __FUNCTION__": Failed to deserialize Scene.\n";
@@ -91,6 +113,7 @@ bool Scene::save(const path& path, const bool indent) const
 }
 
 Scene::Scene():
+	m_arena(std::make_shared<SlabArena>()),
 	m_sceneRoot(*this),
 	m_updateQueue(IWorldUpdatable::createRemoveVector()),
 	m_renderQueue(IWorldRenderable::createRemoveVector()),
@@ -99,6 +122,18 @@ Scene::Scene():
 {
 	m_directionalLightBuffer.create(0);
 	m_pointLightBuffer.create(1);
+	m_drawQueue.create(2);
+	m_uniformBlocks.create();
+}
+
+Scene::~Scene()
+{
+	if (RenderThread& renderThread = RenderThread::instance(); renderThread.running())
+	{
+		// Recorded frames reference the ring buffers of the scene
+		renderThread.waitIdle();
+		renderThread.frame().commands().reset();
+	}
 }
 
 void Scene::start()
@@ -110,7 +145,15 @@ void Scene::start()
 	}
 
 	m_started = true;
+
+	SlabArena::Scope arenaScope(std::to_address(m_arena));
 	m_sceneRoot.start();
+
+	buildStaticBatches();
+
+	// Render components may have received their meshes after entering the scene
+	for (const GameObject* object : m_objectPool)
+		m_spatialIndex.refit(*object);
 }
 
 bool Scene::started() const noexcept
@@ -128,6 +171,79 @@ const SceneRoot& Scene::sceneRoot() const noexcept
 	return m_sceneRoot;
 }
 
+_Ret_maybenull_ ObjectBase* Scene::find(const Id& id) const
+{
+	if (std::shared_ptr<GameObject> object = findObject(id); object)
+		return std::to_address(object);
+
+	if (exclusive_weak_ptr<Component> component = findComponent(id); !component.expired())
+		return &*component;
+
+	return nullptr;
+}
+
+_Ret_maybenull_ std::shared_ptr<GameObject> Scene::findObject(const Id& id) const
+{
+	const auto it = m_objectIndex.find(id);
+	return it == m_objectIndex.end() ? nullptr : it->second.lock();
+}
+
+exclusive_weak_ptr<Component> Scene::findComponent(const Id& id) const
+{
+	const auto it = m_componentIndex.find(id);
+	return it == m_componentIndex.end() ? exclusive_weak_ptr<Component>() : it->second;
+}
+
+_Ret_maybenull_ GameObject* Scene::get(const Handle<GameObject> handle) const noexcept
+{
+	return m_objectPool.get(handle);
+}
+
+_Ret_maybenull_ Component* Scene::get(const Handle<Component> handle) const noexcept
+{
+	return m_componentPool.get(handle);
+}
+
+bool Scene::valid(const Handle<GameObject> handle) const noexcept
+{
+	return m_objectPool.valid(handle);
+}
+
+bool Scene::valid(const Handle<Component> handle) const noexcept
+{
+	return m_componentPool.valid(handle);
+}
+
+const HandlePool<GameObject>& Scene::objects() const noexcept
+{
+	return m_objectPool;
+}
+
+const HandlePool<Component>& Scene::components() const noexcept
+{
+	return m_componentPool;
+}
+
+SlabStats Scene::memoryStats() const
+{
+	return m_arena->stats();
+}
+
+TransformHierarchy& Scene::transforms() noexcept
+{
+	return m_transforms;
+}
+
+const TransformHierarchy& Scene::transforms() const noexcept
+{
+	return m_transforms;
+}
+
+const SpatialIndex& Scene::spatialIndex() const noexcept
+{
+	return m_spatialIndex;
+}
+
 std::weak_ptr<Camera> Scene::getPrimaryCamera() noexcept
 {
 	return m_camera;
@@ -155,13 +271,24 @@ std::vector<std::shared_ptr<UIObject>>& Scene::getHUD()
 
 void Scene::update(const double deltaTime)
 {
+	PROFILE_FUNCTION();
+
 	if (!this->started())
 		this->start();
 
+	// Objects created by scripts live in the scene arena
+	SlabArena::Scope arenaScope(std::to_address(m_arena));
+
 	this->m_physics.updatePhysics(deltaTime);
 
 	for (IWorldUpdatable& updatable : m_updateQueue)
 		updatable.update(deltaTime);
+
+	// Propagate the transforms changed during the update before recording the frame
+	m_transforms.update();
+
+	if (RenderThread::instance().running())
+		snapshot();
 }
 
 void Scene::render()
@@ -172,10 +299,148 @@ void Scene::render()
 
 void Scene::render(const Camera& camera)
 {
-	clearBackground();
+	PROFILE_FUNCTION();
+
+	m_commandList.reset();
+	record(m_commandList, camera);
+
+	ContextQueue::instance().push([this]
+	{
+		PROFILE_ZONE("Scene::submit");
+		m_commandList.submit();
+	}).wait();
+}
+
+void Scene::record(CommandList& list, const Camera& camera)
+{
+	PROFILE_FUNCTION();
+
+	const Matrix4f& viewProjection = camera.getViewProjectionMatrix();
+	const Frustum frustum(viewProjection);
+
+	m_occluders.clear();
+
+	for (const IWorldRenderable& renderable : m_renderQueue)
+		renderable.appendOccluders(m_occluders);
+
+	// Rasterized on the workers while the lights and uniforms are recorded and the renderables frustum culled
+	const JobHandle occlusion = m_occlusionBuffer.rasterize(viewProjection, frustum, m_occluders);
+
+	m_directionalLightBuffer.record(list);
+	m_pointLightBuffer.record(list);
+	m_uniformBlocks.record(list, camera);
+
+	list.clear(m_clearColor);
+
+	CullingStats stats;
+
+	m_drawQueue.reset(camera.getWorldTransform().position, WindowConfig::DEFAULT_FAR);
+	m_visible.clear();
 
 	for (IWorldRenderable& renderable : m_renderQueue)
-		renderable.render(camera);
+	{
+		Bounds bounds;
+
+		if (!renderable.getWorldBounds(bounds))
+		{
+			// Empty bounds are never occluded
+			m_visible.emplace_back(&renderable, Bounds());
+			continue;
+		}
+
+		if (!frustum.intersects(bounds))
+		{
+			++stats.culled;
+			continue;
+		}
+
+		m_visible.emplace_back(&renderable, bounds);
+	}
+
+	// Nothing left to overlap, the draws are queued only once tested against the buffer
+	JobSystem::instance().wait(occlusion);
+
+	for (const auto& [renderable, bounds] : m_visible)
+	{
+		// Skipped before recording any command
+		if (m_occlusionBuffer.occluded(bounds))
+		{
+			++stats.occluded;
+			continue;
+		}
+
+		++stats.visible;
+
+		// Renderables that cannot be sorted are recorded in place
+		if (!renderable->queue(m_drawQueue, camera))
+			renderable->record(list, camera);
+	}
+
+	m_cullingStats = stats;
+
+	RingBuffer* const lightBuffers[]
+	{
+		&m_directionalLightBuffer.buffer(),
+		&m_pointLightBuffer.buffer()
+	};
+
+	m_drawQueue.record(list, lightBuffers);
+}
+
+const CommandList& Scene::commandList() const noexcept
+{
+	return m_commandList;
+}
+
+const CullingStats& Scene::cullingStats() const noexcept
+{
+	return m_cullingStats;
+}
+
+const DrawStats& Scene::drawStats() const noexcept
+{
+	return m_drawQueue.stats();
+}
+
+const std::vector<std::unique_ptr<StaticBatch>>& Scene::staticBatches() const noexcept
+{
+	return m_staticBatches;
+}
+
+void Scene::buildStaticBatches()
+{
+	PROFILE_FUNCTION();
+
+	std::vector<RenderComponent*> components;
+
+	for (GameObject* const object : m_objectPool)
+	{
+		if (!object->isStatic())
+			continue;
+
+		object->forEachComponent<RenderComponent>([&components](RenderComponent& component)
+		{
+			if (component.getCanRender() && !component.batched())
+				components.push_back(&component);
+		});
+	}
+
+	if (components.empty())
+		return;
+
+	std::vector<std::unique_ptr<StaticBatch>> batches = StaticBatch::build(components);
+
+	for (std::unique_ptr<StaticBatch>& batch : batches)
+	{
+		m_renderQueue.push_back(*batch);
+		m_staticBatches.push_back(std::move(batch));
+	}
+}
+
+void Scene::snapshot()
+{
+	if (const std::shared_ptr<Camera> camera = m_camera.lock(); camera)
+		record(RenderThread::instance().frame().commands(), *camera);
 }
 
 Color& Scene::clearColor() noexcept
@@ -233,6 +498,42 @@ void Scene::destroy()
 	this->m_physics.destroy();
 }
 
+void Scene::index(GameObject& object)
+{
+	object.m_handle = m_objectPool.insert(object);
+	m_transforms.insert(object);
+	m_spatialIndex.insert(object);
+
+	// Objects not owned by a shared pointer such as the root cannot be referenced weakly
+	if (std::weak_ptr<GameObject> ptr = object.weak_from_this(); !ptr.expired())
+		m_objectIndex[object.id()] = std::move(ptr);
+}
+
+void Scene::index(Component& component)
+{
+	component.m_handle = m_componentPool.insert(component);
+	m_componentIndex[component.id()] = component.m_ptr;
+}
+
+void Scene::unindex(GameObject& object)
+{
+	m_transforms.erase(object);
+	m_spatialIndex.erase(object);
+
+	m_objectPool.erase(object.m_handle);
+	object.m_handle = { };
+
+	m_objectIndex.erase(object.id());
+}
+
+void Scene::unindex(Component& component)
+{
+	m_componentPool.erase(component.m_handle);
+	component.m_handle = { };
+
+	m_componentIndex.erase(component.id());
+}
+
 _Ret_notnull_ const char* Scene::xmlTypeName() const noexcept
 {
 	return "Scene";
@@ -316,7 +617,7 @@ _Success_(return) bool Scene::deserializeMap(_In_ const XmlNode::Map& map)
 			return false;
 		}
 
-		std::shared_ptr<GameObject> camObj = m_sceneRoot.findChild(*op);
+		std::shared_ptr<GameObject> camObj = findObject(*op);
 
 		if (!camObj)
 		{
@@ -0,0 +1,347 @@
+#include "Scene/Spatial/AabbTree.h"
+
+#include <algorithm>
+
+using KaputEngine::AabbTree;
+using KaputEngine::GameObject;
+using KaputEngine::Handle;
+using KaputEngine::Rendering::Culling::BoundingBox;
+
+namespace
+{
+	_NODISCARD BoundingBox merged(const BoundingBox& a, const BoundingBox& b) noexcept
+	{
+		BoundingBox out = a;
+		out.merge(b);
+
+		return out;
+	}
+
+	_NODISCARD float surfaceArea(const BoundingBox& box) noexcept
+	{
+		const float
+			x = box.max.raw()[0] - box.min.raw()[0],
+			y = box.max.raw()[1] - box.min.raw()[1],
+			z = box.max.raw()[2] - box.min.raw()[2];
+
+		return 2.f * (x * y + y * z + z * x);
+	}
+
+	_NODISCARD bool contains(const BoundingBox& outer, const BoundingBox& inner) noexcept
+	{
+		for (int i = 0; i < 3; ++i)
+			if (inner.min.raw()[i] < outer.min.raw()[i] || inner.max.raw()[i] > outer.max.raw()[i])
+				return false;
+
+		return true;
+	}
+}
+
+AabbTree::Proxy AabbTree::insert(const BoundingBox& box, const Handle<GameObject> object)
+{
+	const Proxy proxy = allocateNode();
+
+	Node& node = m_nodes[proxy];
+	node.box = fatten(box);
+	node.object = object;
+	node.height = 0;
+
+	insertLeaf(proxy);
+	++m_leafCount;
+
+	return proxy;
+}
+
+void AabbTree::erase(const Proxy proxy)
+{
+	removeLeaf(proxy);
+	freeNode(proxy);
+
+	--m_leafCount;
+}
+
+bool AabbTree::move(const Proxy proxy, const BoundingBox& box)
+{
+	const BoundingBox& fat = m_nodes[proxy].box;
+
+	// Also reinserted once much smaller than its fat box so shrinking objects do not keep stale volumes
+	if (contains(fat, box) && surfaceArea(fatten(box)) * 4.f >= surfaceArea(fat))
+		return false;
+
+	removeLeaf(proxy);
+	m_nodes[proxy].box = fatten(box);
+	insertLeaf(proxy);
+
+	return true;
+}
+
+void AabbTree::clear() noexcept
+{
+	m_nodes.clear();
+	m_root = NullNode;
+	m_freeList = NullNode;
+	m_leafCount = 0;
+}
+
+Handle<GameObject> AabbTree::object(const Proxy proxy) const noexcept
+{
+	return m_nodes[proxy].object;
+}
+
+const BoundingBox& AabbTree::box(const Proxy proxy) const noexcept
+{
+	return m_nodes[proxy].box;
+}
+
+float AabbTree::margin() const noexcept
+{
+	return m_margin;
+}
+
+void AabbTree::setMargin(const float margin) noexcept
+{
+	// Applies to leaves as they are reinserted
+	m_margin = margin;
+}
+
+size_t AabbTree::size() const noexcept
+{
+	return m_leafCount;
+}
+
+int32_t AabbTree::height() const noexcept
+{
+	return m_root == NullNode ? 0 : m_nodes[m_root].height;
+}
+
+AabbTree::Proxy AabbTree::allocateNode()
+{
+	if (m_freeList == NullNode)
+	{
+		m_nodes.emplace_back();
+		return static_cast<Proxy>(m_nodes.size() - 1);
+	}
+
+	const Proxy node = m_freeList;
+	m_freeList = m_nodes[node].parent;
+
+	m_nodes[node] = Node();
+
+	return node;
+}
+
+void AabbTree::freeNode(const Proxy node) noexcept
+{
+	m_nodes[node] = Node();
+	m_nodes[node].parent = m_freeList;
+
+	m_freeList = node;
+}
+
+void AabbTree::insertLeaf(const Proxy leaf)
+{
+	if (m_root == NullNode)
+	{
+		m_root = leaf;
+		m_nodes[leaf].parent = NullNode;
+		return;
+	}
+
+	const BoundingBox leafBox = m_nodes[leaf].box;
+
+	// Descend towards the sibling with the lowest surface area increase
+	Proxy index = m_root;
+
+	while (!m_nodes[index].isLeaf())
+	{
+		const Node& node = m_nodes[index];
+
+		const float
+			area = surfaceArea(node.box),
+			combinedArea = surfaceArea(merged(node.box, leafBox));
+
+		// Cost of making a new parent for this node and the leaf
+		const float cost = 2.f * combinedArea;
+
+		// Minimum cost of pushing the leaf further down
+		const float inheritanceCost = 2.f * (combinedArea - area);
+
+		const auto descendCost = [&](const Proxy child)
+		{
+			const Node& childNode = m_nodes[child];
+			const float childArea = surfaceArea(merged(leafBox, childNode.box));
+
+			return (childNode.isLeaf() ? childArea : childArea - surfaceArea(childNode.box)) + inheritanceCost;
+		};
+
+		const float
+			cost1 = descendCost(node.child1),
+			cost2 = descendCost(node.child2);
+
+		if (cost < cost1 && cost < cost2)
+			break;
+
+		index = cost1 < cost2 ? node.child1 : node.child2;
+	}
+
+	const Proxy sibling = index;
+	const Proxy oldParent = m_nodes[sibling].parent;
+
+	// May reallocate the nodes
+	const Proxy newParent = allocateNode();
+
+	Node& parent = m_nodes[newParent];
+	parent.parent = oldParent;
+	parent.box = merged(leafBox, m_nodes[sibling].box);
+	parent.height = m_nodes[sibling].height + 1;
+	parent.child1 = sibling;
+	parent.child2 = leaf;
+
+	if (oldParent == NullNode)
+		m_root = newParent;
+	else if (m_nodes[oldParent].child1 == sibling)
+		m_nodes[oldParent].child1 = newParent;
+	else
+		m_nodes[oldParent].child2 = newParent;
+
+	m_nodes[sibling].parent = newParent;
+	m_nodes[leaf].parent = newParent;
+
+	refit(newParent);
+}
+
+void AabbTree::removeLeaf(const Proxy leaf)
+{
+	if (leaf == m_root)
+	{
+		m_root = NullNode;
+		return;
+	}
+
+	const Proxy
+		parent = m_nodes[leaf].parent,
+		grandParent = m_nodes[parent].parent,
+		sibling = m_nodes[parent].child1 == leaf ? m_nodes[parent].child2 : m_nodes[parent].child1;
+
+	// The sibling takes the place of the parent
+	if (grandParent == NullNode)
+		m_root = sibling;
+	else if (m_nodes[grandParent].child1 == parent)
+		m_nodes[grandParent].child1 = sibling;
+	else
+		m_nodes[grandParent].child2 = sibling;
+
+	m_nodes[sibling].parent = grandParent;
+	m_nodes[leaf].parent = NullNode;
+
+	freeNode(parent);
+
+	if (grandParent != NullNode)
+		refit(grandParent);
+}
+
+void AabbTree::refit(Proxy node) noexcept
+{
+	while (node != NullNode)
+	{
+		node = balance(node);
+
+		Node& current = m_nodes[node];
+		const Node
+			&child1 = m_nodes[current.child1],
+			&child2 = m_nodes[current.child2];
+
+		current.height = 1 + std::max(child1.height, child2.height);
+		current.box = merged(child1.box, child2.box);
+
+		node = current.parent;
+	}
+}
+
+AabbTree::Proxy AabbTree::balance(const Proxy iA) noexcept
+{
+	Node& a = m_nodes[iA];
+
+	if (a.isLeaf() || a.height < 2)
+		return iA;
+
+	const Proxy
+		iB = a.child1,
+		iC = a.child2;
+
+	Node
+		&b = m_nodes[iB],
+		&c = m_nodes[iC];
+
+	const int32_t difference = c.height - b.height;
+
+	// Replaces A by its deeper child R, A keeping the shallower grandchild of R
+	const auto rotate = [this, iA, &a](const Proxy iR, Node& r, Proxy& aSlot, const Node& other)
+	{
+		const Proxy
+			iF = r.child1,
+			iG = r.child2;
+
+		Node
+			&f = m_nodes[iF],
+			&g = m_nodes[iG];
+
+		r.child1 = iA;
+		r.parent = a.parent;
+		a.parent = iR;
+
+		if (r.parent == NullNode)
+			m_root = iR;
+		else if (m_nodes[r.parent].child1 == iA)
+			m_nodes[r.parent].child1 = iR;
+		else
+			m_nodes[r.parent].child2 = iR;
+
+		const bool keepF = f.height > g.height;
+
+		const Proxy
+			iKept = keepF ? iF : iG,
+			iGiven = keepF ? iG : iF;
+
+		Node
+			&kept = m_nodes[iKept],
+			&given = m_nodes[iGiven];
+
+		r.child2 = iKept;
+		aSlot = iGiven;
+		given.parent = iA;
+
+		a.box = merged(other.box, given.box);
+		a.height = 1 + std::max(other.height, given.height);
+
+		r.box = merged(a.box, kept.box);
+		r.height = 1 + std::max(a.height, kept.height);
+	};
+
+	if (difference > 1)
+	{
+		rotate(iC, c, a.child2, b);
+		return iC;
+	}
+
+	if (difference < -1)
+	{
+		rotate(iB, b, a.child1, c);
+		return iB;
+	}
+
+	return iA;
+}
+
+BoundingBox AabbTree::fatten(const BoundingBox& box) const noexcept
+{
+	BoundingBox out = box;
+
+	for (int i = 0; i < 3; ++i)
+	{
+		out.min.raw()[i] -= m_margin;
+		out.max.raw()[i] += m_margin;
+	}
+
+	return out;
+}
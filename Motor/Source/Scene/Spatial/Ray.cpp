@@ -0,0 +1,81 @@
+#include "Scene/Spatial/Ray.h"
+
+#include <LibMath/Simd.h>
+
+#include <algorithm>
+
+using KaputEngine::Ray;
+using KaputEngine::RayCast;
+using KaputEngine::Rendering::Culling::BoundingBox;
+
+RayCast::RayCast(const Ray& ray) noexcept : m_ray(ray)
+{
+	for (int i = 0; i < 3; ++i)
+	{
+		m_origin[i] = ray.origin.raw()[i];
+
+		// Axis-parallel rays divide to infinities which the slab test handles
+		m_inverseDirection[i] = 1.f / ray.direction.raw()[i];
+	}
+
+	m_origin[3] = 0.f;
+	m_inverseDirection[3] = 1.f;
+}
+
+const Ray& RayCast::ray() const noexcept
+{
+	return m_ray;
+}
+
+_Success_(return)
+bool RayCast::intersects(const BoundingBox& box, const float maxDistance, _Out_ float& distance) const noexcept
+{
+	// With an origin of 0 and a direction of 1, the last lane gives the [0, maxDistance] range
+#if defined(LIBMATH_SIMD_SSE)
+	const __m128
+		origin  = _mm_load_ps(m_origin),
+		inverse = _mm_load_ps(m_inverseDirection),
+		min     = _mm_setr_ps(box.min.raw()[0], box.min.raw()[1], box.min.raw()[2], 0.f),
+		max     = _mm_setr_ps(box.max.raw()[0], box.max.raw()[1], box.max.raw()[2], maxDistance);
+
+	const __m128
+		t1 = _mm_mul_ps(_mm_sub_ps(min, origin), inverse),
+		t2 = _mm_mul_ps(_mm_sub_ps(max, origin), inverse);
+
+	__m128
+		entries = _mm_min_ps(t1, t2),
+		exits   = _mm_max_ps(t1, t2);
+
+	// Horizontal maximum of the entries and minimum of the exits
+	entries = _mm_max_ps(entries, _mm_shuffle_ps(entries, entries, _MM_SHUFFLE(1, 0, 3, 2)));
+	entries = _mm_max_ps(entries, _mm_shuffle_ps(entries, entries, _MM_SHUFFLE(2, 3, 0, 1)));
+	exits   = _mm_min_ps(exits, _mm_shuffle_ps(exits, exits, _MM_SHUFFLE(1, 0, 3, 2)));
+	exits   = _mm_min_ps(exits, _mm_shuffle_ps(exits, exits, _MM_SHUFFLE(2, 3, 0, 1)));
+
+	const float
+		closest  = _mm_cvtss_f32(entries),
+		furthest = _mm_cvtss_f32(exits);
+#else
+	const float
+		min[4] { box.min.raw()[0], box.min.raw()[1], box.min.raw()[2], 0.f },
+		max[4] { box.max.raw()[0], box.max.raw()[1], box.max.raw()[2], maxDistance };
+
+	float closest = -std::numeric_limits<float>::infinity(), furthest = std::numeric_limits<float>::infinity();
+
+	for (int i = 0; i < 4; ++i)
+	{
+		const float
+			t1 = (min[i] - m_origin[i]) * m_inverseDirection[i],
+			t2 = (max[i] - m_origin[i]) * m_inverseDirection[i];
+
+		closest = std::max(closest, std::min(t1, t2));
+		furthest = std::min(furthest, std::max(t1, t2));
+	}
+#endif
+
+	if (closest > furthest)
+		return false;
+
+	distance = closest;
+	return true;
+}
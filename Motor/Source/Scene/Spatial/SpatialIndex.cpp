@@ -0,0 +1,73 @@
+#include "Scene/Spatial/SpatialIndex.h"
+
+#include "Component/RenderComponent.h"
+#include "GameObject/GameObject.hpp"
+
+using KaputEngine::AabbTree;
+using KaputEngine::GameObject;
+using KaputEngine::RenderComponent;
+using KaputEngine::SpatialIndex;
+using KaputEngine::Rendering::Culling::BoundingBox;
+using KaputEngine::Rendering::Culling::Bounds;
+
+void SpatialIndex::insert(const GameObject& object)
+{
+	const uint32_t slot = object.handle().index;
+
+	if (slot >= m_proxies.size())
+		m_proxies.resize(slot + 1, AabbTree::NullNode);
+
+	if (m_proxies[slot] != AabbTree::NullNode)
+		m_tree.erase(m_proxies[slot]);
+
+	m_proxies[slot] = m_tree.insert(computeBounds(object), object.handle());
+}
+
+void SpatialIndex::erase(const GameObject& object)
+{
+	const AabbTree::Proxy node = proxy(object);
+
+	if (node == AabbTree::NullNode)
+		return;
+
+	m_tree.erase(node);
+	m_proxies[object.handle().index] = AabbTree::NullNode;
+}
+
+void SpatialIndex::refit(const GameObject& object)
+{
+	if (const AabbTree::Proxy node = proxy(object); node != AabbTree::NullNode)
+		m_tree.move(node, computeBounds(object));
+}
+
+bool SpatialIndex::contains(const GameObject& object) const noexcept
+{
+	return proxy(object) != AabbTree::NullNode;
+}
+
+const AabbTree& SpatialIndex::tree() const noexcept
+{
+	return m_tree;
+}
+
+BoundingBox SpatialIndex::computeBounds(const GameObject& object)
+{
+	BoundingBox box;
+
+	object.forEachComponent<RenderComponent>([&box](const RenderComponent& render)
+	{
+		if (Bounds bounds; render.getCanRender() && render.getWorldBounds(bounds))
+			box.merge(bounds.box);
+	});
+
+	if (box.empty())
+		box.merge(object.getWorldTransform().position);
+
+	return box;
+}
+
+AabbTree::Proxy SpatialIndex::proxy(const GameObject& object) const noexcept
+{
+	const uint32_t slot = object.handle().index;
+	return slot < m_proxies.size() ? m_proxies[slot] : AabbTree::NullNode;
+}
@@ -0,0 +1,291 @@
+#include "Scene/Transform/Hierarchy.h"
+
+#include "GameObject/GameObject.h"
+#include "Profiling/Profiler.h"
+
+using KaputEngine::GameObject;
+using KaputEngine::Transform;
+using KaputEngine::TransformHierarchy;
+
+using LibMath::Matrix4f;
+
+namespace
+{
+	template <typename T>
+	void permute(std::vector<T>& values, const std::vector<uint32_t>& order)
+	{
+		std::vector<T> result;
+		result.reserve(order.size());
+
+		for (const uint32_t index : order)
+			result.push_back(std::move(values[index]));
+
+		values = std::move(result);
+	}
+}
+
+void TransformHierarchy::insert(GameObject& object)
+{
+	const uint32_t slot = object.m_handle.index;
+	const uint32_t index = static_cast<uint32_t>(m_objects.size());
+
+	if (slot >= m_nodes.size())
+		m_nodes.resize(slot + 1, InvalidNode);
+
+	m_nodes[slot] = index;
+
+	// Appended after its parent which is already in the scene
+	m_objects.push_back(&object);
+	m_parents.push_back(parentNode(object));
+	m_local.push_back(object.m_localTransform);
+	m_world.push_back(object.m_localTransform);
+	m_matrices.push_back(Matrix4f::Identity());
+	m_versions.push_back(0);
+	m_parentVersions.push_back(0);
+	m_localDirty.push_back(true);
+
+	changed();
+}
+
+void TransformHierarchy::erase(const GameObject& object)
+{
+	const uint32_t index = node(object);
+
+	if (index == InvalidNode)
+		return;
+
+	// Left in place until the next rebuild to keep the order
+	m_objects[index] = nullptr;
+	m_nodes[object.m_handle.index] = InvalidNode;
+
+	m_hasErased = true;
+	changed();
+}
+
+void TransformHierarchy::reparent(const GameObject& object)
+{
+	const uint32_t index = node(object);
+
+	if (index == InvalidNode)
+		return;
+
+	const uint32_t parent = parentNode(object);
+
+	m_parents[index] = parent;
+	m_localDirty[index] = true;
+
+	if (parent != InvalidNode && parent > index)
+		m_orderBroken = true;
+
+	changed();
+}
+
+void TransformHierarchy::markDirty(const GameObject& object)
+{
+	const uint32_t index = node(object);
+
+	if (index == InvalidNode)
+		return;
+
+	m_local[index] = object.m_localTransform;
+	m_localDirty[index] = true;
+
+	changed();
+}
+
+void TransformHierarchy::update()
+{
+	PROFILE_FUNCTION();
+
+	if (m_clean)
+		return;
+
+	if (m_hasErased || m_orderBroken)
+		rebuild();
+
+	const uint32_t changeCount = m_changeCount;
+
+	for (uint32_t i = 0; i < m_objects.size(); ++i)
+		refresh(i);
+
+	// Changes made by objects reacting to the pass are left for the next one
+	m_clean = m_changeCount == changeCount;
+}
+
+void TransformHierarchy::resolve(const GameObject& object)
+{
+	if (m_clean)
+		return;
+
+	if (m_hasErased || m_orderBroken)
+		rebuild();
+
+	if (const uint32_t index = node(object); index != InvalidNode)
+		resolveNode(index);
+}
+
+bool TransformHierarchy::contains(const GameObject& object) const noexcept
+{
+	return node(object) != InvalidNode;
+}
+
+uint32_t TransformHierarchy::version(const GameObject& object) const noexcept
+{
+	const uint32_t index = node(object);
+	return index == InvalidNode ? 0 : m_versions[index];
+}
+
+size_t TransformHierarchy::size() const noexcept
+{
+	return m_objects.size();
+}
+
+uint32_t TransformHierarchy::node(const GameObject& object) const noexcept
+{
+	const uint32_t slot = object.m_handle.index;
+	return slot < m_nodes.size() ? m_nodes[slot] : InvalidNode;
+}
+
+uint32_t TransformHierarchy::parentNode(const GameObject& object) const noexcept
+{
+	const GameObject* const parent = object.m_parent;
+
+	// Parents outside of the hierarchy such as the scene root are read through the object
+	return parent && parent->m_scene == object.m_scene ? node(*parent) : InvalidNode;
+}
+
+void TransformHierarchy::resolveNode(const uint32_t node)
+{
+	if (const uint32_t parent = m_parents[node]; parent != InvalidNode)
+		resolveNode(parent);
+
+	refresh(node);
+}
+
+void TransformHierarchy::refresh(const uint32_t node)
+{
+	GameObject* const object = m_objects[node];
+
+	if (!object)
+		return;
+
+	const uint32_t parent = m_parents[node];
+
+	if (parent == InvalidNode)
+	{
+		// Moving an outer parent marks its children in the hierarchy dirty
+		if (!m_localDirty[node])
+			return;
+
+		const GameObject* const outer = object->m_parent;
+		m_world[node] = outer ? m_local[node].combine(outer->getWorldTransform()) : m_local[node];
+	}
+	else
+	{
+		if (!m_localDirty[node] && m_parentVersions[node] == m_versions[parent])
+			return;
+
+		m_world[node] = m_local[node].combine(m_world[parent]);
+		m_parentVersions[node] = m_versions[parent];
+	}
+
+	m_matrices[node] = m_world[node].toMatrix();
+	m_localDirty[node] = false;
+	++m_versions[node];
+
+	object->applyWorldTransform(m_world[node], m_matrices[node]);
+
+	// Objects deriving their world transform such as cameras pass it on to their children
+	m_world[node] = object->getWorldTransformUnsafe();
+}
+
+void TransformHierarchy::rebuild()
+{
+	PROFILE_FUNCTION();
+
+	const uint32_t count = static_cast<uint32_t>(m_objects.size());
+
+	std::vector<uint32_t> order;
+	order.reserve(count);
+
+	if (!m_orderBroken)
+	{
+		// Dropping erased nodes keeps parents first
+		for (uint32_t i = 0; i < count; ++i)
+			if (m_objects[i])
+				order.push_back(i);
+	}
+	else
+	{
+		const auto liveParent = [this](const uint32_t i) -> uint32_t
+		{
+			const uint32_t parent = m_parents[i];
+			return parent != InvalidNode && m_objects[parent] ? parent : InvalidNode;
+		};
+
+		// Children of each node packed by parent
+		std::vector<uint32_t> childStart(count + 1, 0);
+		std::vector<uint32_t> children(count);
+
+		for (uint32_t i = 0; i < count; ++i)
+			if (const uint32_t parent = liveParent(i); m_objects[i] && parent != InvalidNode)
+				++childStart[parent + 1];
+
+		for (uint32_t i = 0; i < count; ++i)
+			childStart[i + 1] += childStart[i];
+
+		std::vector<uint32_t> cursor(childStart.begin(), childStart.end() - 1);
+
+		for (uint32_t i = 0; i < count; ++i)
+			if (const uint32_t parent = liveParent(i); m_objects[i] && parent != InvalidNode)
+				children[cursor[parent]++] = i;
+
+		// Depth-first from the top-level nodes
+		std::vector<uint32_t> stack;
+
+		for (uint32_t i = count; i-- > 0;)
+			if (m_objects[i] && liveParent(i) == InvalidNode)
+				stack.push_back(i);
+
+		while (!stack.empty())
+		{
+			const uint32_t i = stack.back();
+			stack.pop_back();
+
+			order.push_back(i);
+
+			for (uint32_t c = childStart[i + 1]; c-- > childStart[i];)
+				stack.push_back(children[c]);
+		}
+	}
+
+	std::vector<uint32_t> remap(count, InvalidNode);
+
+	for (uint32_t i = 0; i < order.size(); ++i)
+		remap[order[i]] = i;
+
+	for (uint32_t& parent : m_parents)
+		if (parent != InvalidNode)
+			parent = remap[parent];
+
+	permute(m_objects, order);
+	permute(m_parents, order);
+	permute(m_local, order);
+	permute(m_world, order);
+	permute(m_matrices, order);
+	permute(m_versions, order);
+	permute(m_parentVersions, order);
+	permute(m_localDirty, order);
+
+	for (uint32_t i = 0; i < m_objects.size(); ++i)
+		m_nodes[m_objects[i]->m_handle.index] = i;
+
+	m_hasErased = false;
+	m_orderBroken = false;
+}
+
+void TransformHierarchy::changed() noexcept
+{
+	++m_changeCount;
+	m_clean = false;
+}
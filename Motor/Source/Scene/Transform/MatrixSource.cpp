@@ -11,8 +11,16 @@ const LibMath::Matrix4f& MatrixTransformSource::getWorldTransformMatrix() const
 
 void MatrixTransformSource::updateWorldTransform() const noexcept
 {
-    if (m_dirtyTransform)
-        TransformSource::updateWorldTransform();
+    // The matrix only changes with the world transform
+    if (!m_dirtyTransform)
+        return;
 
+    TransformSource::updateWorldTransform();
+    m_worldTransformMatrix = m_worldTransform.toMatrix();
+}
+
+void MatrixTransformSource::setWorldTransform(const Transform& transform) noexcept
+{
+    TransformSource::setWorldTransform(transform);
     m_worldTransformMatrix = m_worldTransform.toMatrix();
 }
@@ -31,26 +31,26 @@ const Transform& TransformSource::getLocalTransform() const noexcept
 
 void TransformSource::setLocalTransform(const Transform& transform) noexcept
 {
-    setTransformDirty();
     m_localTransform = transform;
+    setTransformDirty();
 }
 
 void TransformSource::setLocalPosition(const Cartesian3f& position) noexcept
 {
-    setTransformDirty();
     m_localTransform.position = position;
+    setTransformDirty();
 }
 
 void TransformSource::setLocalRotation(const Rotorf& rotation) noexcept
 {
-    setTransformDirty();
     m_localTransform.rotation = rotation;
+    setTransformDirty();
 }
 
 void TransformSource::setLocalScale(const Vector3f& scale) noexcept
 {
-    setTransformDirty();
     m_localTransform.scale = scale;
+    setTransformDirty();
 }
 
 const Transform& TransformSource::getWorldTransform() const noexcept
@@ -2,6 +2,9 @@
 
 #include "Application.h"
 #include "GameObject/Camera.h"
+#include "Queue/Context.h"
+#include "Rendering/Buffer/RingBuffer.h"
+#include "Rendering/RenderThread.h"
 #include "Scene/Scene.h"
 
 #include <LibMath/MathArray/Utilities.h>
@@ -15,6 +18,10 @@
 
 using namespace KaputEngine;
 
+using KaputEngine::Queue::ContextQueue;
+using KaputEngine::Rendering::RenderThread;
+using KaputEngine::Rendering::Buffer::RingBuffer;
+
 using std::cerr;
 
 using LibMath::Vector2i;
@@ -125,7 +132,10 @@ void PrimaryWindow::setScale(const Vector2i& size) noexcept
 {
     m_size = size;
 
-    glViewport(0, 0, size.x(), size.y());
+    ContextQueue::instance().push([size]
+    {
+        glViewport(0, 0, size.x(), size.y());
+    }).wait();
 
     if (this->m_scene != nullptr)
     {
@@ -151,12 +161,13 @@ void PrimaryWindow::window_close_callBack(GLFWwindow* window)
 
 bool PrimaryWindow::shouldClose() const noexcept
 {
-    return glfwWindowShouldClose(m_windowHandle) || m_shouldClose;
+    return m_shouldClose || (m_windowHandle && glfwWindowShouldClose(m_windowHandle));
 }
 
 void PrimaryWindow::update()
 {
-    Application::audio().updateTracking();
+    if (!Application::headless())
+        Application::audio().updateTracking();
 
     if (m_scene)
     {
@@ -172,8 +183,14 @@ void PrimaryWindow::render()
     if (!this->m_docking)
         this->renderBackgroundWindow();
 
-    if (m_scene)
+    if (!m_scene)
+        return;
+
+    if (RenderThread& renderThread = RenderThread::instance(); !renderThread.running())
         m_scene->render();
+    else if (renderThread.frame().commands().empty())
+        // No snapshot taken by the update, such as when paused
+        m_scene->snapshot();
 }
 
 _Ret_maybenull_ std::shared_ptr<Scene>& PrimaryWindow::currentScene() noexcept
@@ -222,7 +239,15 @@ void PrimaryWindow::renderBackgroundWindow()
 void PrimaryWindow::glUpdate()
 {
     glfwPollEvents();
-    glfwSwapBuffers(m_windowHandle);
+
+    if (RenderThread& renderThread = RenderThread::instance(); renderThread.running())
+        // Swapped by the render thread once drawn
+        renderThread.present();
+    else
+    {
+        RingBuffer::endFrame();
+        glfwSwapBuffers(m_windowHandle);
+    }
 }
 
 void PrimaryWindow::setDockSpace(const bool update)
@@ -242,8 +267,16 @@ void PrimaryWindow::setCursorStatus(bool hidden)
 
 void PrimaryWindow::destroy()
 {
-    this->m_scene->destroy();
-    this->m_scene.reset();
+    if (this->m_scene)
+    {
+        this->m_scene->destroy();
+        this->m_scene.reset();
+    }
+
+    // Headless, no window or UI was created
+    if (!this->m_windowHandle)
+        return;
+
     delete this->m_backgroundWindow;
     ImGui_ImplOpenGL3_Shutdown();
     ImGui_ImplGlfw_Shutdown();
@@ -258,6 +291,8 @@ void PrimaryWindow::setClose(bool value)
     else
     {
         m_shouldClose = false;
-        glfwSetWindowShouldClose(m_windowHandle, GLFW_FALSE);
+
+        if (m_windowHandle)
+            glfwSetWindowShouldClose(m_windowHandle, GLFW_FALSE);
     }
 }
@@ -0,0 +1,54 @@
+#include "Application.h"
+#include "Scene/Scene.h"
+
+#include <cstdlib>
+#include <iostream>
+
+using namespace KaputEngine;
+
+using std::cerr;
+
+/// <summary>
+/// Loads a scene and ticks it without a window or rendering context.
+/// </summary>
+/// <remarks>
+/// Usage: KaputServer &lt;scene.kscene&gt; [tick rate] [tick count]
+/// A tick rate of 0 ticks as fast as possible. Without a tick count, runs until the scene quits.
+/// </remarks>
+int main(int argc, char** argv)
+{
+	if (argc < 2)
+	{
+		cerr << "Usage: KaputServer <scene.kscene> [tick rate] [tick count]\n";
+		return 1;
+	}
+
+	const double tickRate = argc > 2 ? std::strtod(argv[2], nullptr) : Application::tickRate();
+	const unsigned long long tickCount = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 0;
+
+	if (!Application::initHeadless(tickRate))
+		return 1;
+
+	std::shared_ptr<Scene> scene = std::make_shared<Scene>();
+
+	if (!scene->load(argv[1]))
+	{
+		cerr << "Failed to load scene " << argv[1] << ".\n";
+		Application::cleanup();
+
+		return 1;
+	}
+
+	Application::getWindow().currentScene() = scene;
+
+	if (tickCount)
+		Application::postUpdate = [tickCount, ticks = 0ull]() mutable
+		{
+			if (++ticks >= tickCount)
+				Application::quit();
+		};
+
+	Application::run();
+
+	return 0;
+}
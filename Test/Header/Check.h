@@ -0,0 +1,25 @@
+#pragma once
+
+#include <iostream>
+
+namespace KaputEngine::Test
+{
+	/// <summary>
+	/// Number of failed checks, returned by the test executables so CTest reports them
+	/// </summary>
+	inline int failures = 0;
+
+	inline void check(const bool condition, const char* const expression, const char* const file, const int line)
+	{
+		if (condition)
+			return;
+
+		std::cerr << file << '(' << line << "): Check failed: " << expression << '\n';
+		++failures;
+	}
+}
+
+/// <summary>
+/// Reports a failed condition with its location without stopping the test.
+/// </summary>
+#define KAPUT_CHECK(condition) KaputEngine::Test::check(static_cast<bool>(condition), #condition, __FILE__, __LINE__)
@@ -0,0 +1,354 @@
+#include "Check.h"
+
+#include "Scene/Spatial/AabbTree.h"
+
+#include <LibMath/Matrix.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace KaputEngine;
+
+using KaputEngine::Rendering::Culling::BoundingBox;
+using KaputEngine::Rendering::Culling::BoundingSphere;
+using KaputEngine::Rendering::Culling::Frustum;
+
+using LibMath::Cartesian3f;
+using LibMath::Matrix4f;
+
+namespace
+{
+	constexpr size_t ObjectCount = 2'000;
+	constexpr int RoundCount = 20;
+	constexpr int QueryCount = 20;
+
+	constexpr float WorldSize = 100.f;
+
+	using Random = std::mt19937;
+
+	/// <summary>
+	/// Object of the reference list, indexed the same as the handle given to the tree.
+	/// </summary>
+	struct Entry
+	{
+		BoundingBox box;
+		AabbTree::Proxy proxy = AabbTree::NullNode;
+	};
+
+	_NODISCARD Handle<GameObject> handle(const size_t index)
+	{
+		return { static_cast<uint32_t>(index), 0 };
+	}
+
+	_NODISCARD BoundingBox randomBox(Random& random, const float worldSize = WorldSize)
+	{
+		std::uniform_real_distribution<float> position(-worldSize / 2.f, worldSize / 2.f), size(.1f, 2.f);
+
+		const Cartesian3f center { position(random), position(random), position(random) };
+		const float x = size(random), y = size(random), z = size(random);
+
+		return { { center.x() - x, center.y() - y, center.z() - z }, { center.x() + x, center.y() + y, center.z() + z } };
+	}
+
+	_NODISCARD BoundingBox offset(const BoundingBox& box, const float x, const float y, const float z)
+	{
+		return { { box.min.x() + x, box.min.y() + y, box.min.z() + z }, { box.max.x() + x, box.max.y() + y, box.max.z() + z } };
+	}
+
+	_NODISCARD bool same(const BoundingBox& a, const BoundingBox& b)
+	{
+		for (int i = 0; i < 3; ++i)
+			if (a.min.raw()[i] != b.min.raw()[i] || a.max.raw()[i] != b.max.raw()[i])
+				return false;
+
+		return true;
+	}
+
+	/// <summary>
+	/// OpenGL projection with a 90 degree field of view looking down -Z from a position.
+	/// </summary>
+	_NODISCARD Matrix4f viewProjection(const float x, const float y, const float z)
+	{
+		constexpr float near = .1f, far = 40.f;
+
+		Matrix4f projection = Matrix4f::Identity();
+		float (&data)[4][4] = projection.raw2D();
+
+		data[2][2] = -(far + near) / (far - near);
+		data[2][3] = -1.f;
+		data[3][2] = -(2.f * far * near) / (far - near);
+		data[3][3] = 0.f;
+
+		Matrix4f view = Matrix4f::Identity();
+
+		view.raw2D()[3][0] = -x;
+		view.raw2D()[3][1] = -y;
+		view.raw2D()[3][2] = -z;
+
+		return projection * view;
+	}
+
+	/// <summary>
+	/// Compares the objects found by a tree query to those whose fat box passes the test.
+	/// </summary>
+	template <typename Test, typename Query>
+	void checkQuery(const AabbTree& tree, const std::vector<Entry>& entries, Test&& test, Query&& query)
+	{
+		std::vector<uint32_t> expected, found;
+
+		for (size_t i = 0; i < entries.size(); ++i)
+			if (entries[i].proxy != AabbTree::NullNode && test(tree.box(entries[i].proxy)))
+				expected.push_back(static_cast<uint32_t>(i));
+
+		query([&found](const Handle<GameObject> object)
+		{
+			found.push_back(object.index);
+			return true;
+		});
+
+		std::ranges::sort(found);
+
+		KAPUT_CHECK(found == expected);
+	}
+
+	void checkQueries(const AabbTree& tree, const std::vector<Entry>& entries, Random& random)
+	{
+		std::uniform_real_distribution<float> position(-WorldSize / 2.f - 10.f, WorldSize / 2.f + 10.f), radius(0.f, 15.f), direction(-1.f, 1.f);
+
+		size_t alive = 0;
+		bool contained = true;
+
+		for (const Entry& entry : entries)
+		{
+			if (entry.proxy == AabbTree::NullNode)
+				continue;
+
+			++alive;
+			contained &= tree.object(entry.proxy) == handle(&entry - entries.data());
+
+			const BoundingBox& fat = tree.box(entry.proxy);
+
+			for (int i = 0; i < 3; ++i)
+				contained &= fat.min.raw()[i] <= entry.box.min.raw()[i] && entry.box.max.raw()[i] <= fat.max.raw()[i];
+		}
+
+		KAPUT_CHECK(tree.size() == alive);
+		KAPUT_CHECK(contained);
+
+		for (int query = 0; query < QueryCount; ++query)
+		{
+			const BoundingBox box = randomBox(random);
+			const BoundingBox large { box.min, { box.max.x() + radius(random), box.max.y() + radius(random), box.max.z() + radius(random) } };
+
+			checkQuery(tree, entries,
+				[&large](const BoundingBox& fat) { return fat.intersects(large); },
+				[&](auto&& func) { tree.query(large, func); });
+
+			const BoundingSphere sphere { { position(random), position(random), position(random) }, radius(random) };
+
+			checkQuery(tree, entries,
+				[&sphere](const BoundingBox& fat) { return fat.intersects(sphere); },
+				[&](auto&& func) { tree.query(sphere, func); });
+
+			const Frustum frustum(viewProjection(position(random), position(random), position(random)));
+
+			checkQuery(tree, entries,
+				[&frustum](const BoundingBox& fat) { return frustum.intersects(fat); },
+				[&](auto&& func) { tree.query(frustum, func); });
+
+			const Ray ray
+			{
+				{ position(random), position(random), position(random) },
+				{ direction(random), direction(random), direction(random) },
+				WorldSize
+			};
+
+			const RayCast cast(ray);
+
+			// Every hit, the function keeping the max distance
+			checkQuery(tree, entries,
+				[&cast](const BoundingBox& fat)
+				{
+					float distance;
+					return cast.intersects(fat, cast.ray().maxDistance, distance);
+				},
+				[&](auto&& func)
+				{
+					tree.raycast(ray, [&func, &ray](const Handle<GameObject> object, float)
+					{
+						func(object);
+						return ray.maxDistance;
+					});
+				});
+
+			// Closest hit, the function shortening the cast
+			float expectedClosest = std::numeric_limits<float>::infinity();
+
+			for (const Entry& entry : entries)
+			{
+				float distance;
+
+				if (entry.proxy != AabbTree::NullNode && cast.intersects(tree.box(entry.proxy), ray.maxDistance, distance))
+					expectedClosest = std::min(expectedClosest, distance);
+			}
+
+			float closest = std::numeric_limits<float>::infinity();
+
+			tree.raycast(ray, [&closest](Handle<GameObject>, const float distance)
+			{
+				closest = std::min(closest, distance);
+				return distance;
+			});
+
+			KAPUT_CHECK(closest == expectedClosest);
+		}
+	}
+
+	/// <summary>
+	/// Height allowed for a tree of a number of leaves, twice that of a perfectly balanced tree.
+	/// </summary>
+	_NODISCARD int32_t heightBound(const size_t leafCount)
+	{
+		return 2 * static_cast<int32_t>(std::ceil(std::log2(static_cast<double>(leafCount))));
+	}
+
+	/// <summary>
+	/// Queries match a brute force search over the fat boxes through random inserts, moves and removals.
+	/// </summary>
+	void testRandom()
+	{
+		Random random(42);
+		std::uniform_real_distribution<float> nudge(-.05f, .05f), jump(-10.f, 10.f), unit(0.f, 1.f);
+
+		AabbTree tree;
+		std::vector<Entry> entries;
+
+		for (size_t i = 0; i < ObjectCount; ++i)
+		{
+			Entry& entry = entries.emplace_back();
+			entry.box = randomBox(random);
+			entry.proxy = tree.insert(entry.box, handle(i));
+		}
+
+		checkQueries(tree, entries, random);
+
+		for (int round = 0; round < RoundCount; ++round)
+		{
+			for (size_t i = 0; i < entries.size(); ++i)
+			{
+				Entry& entry = entries[i];
+				const float action = unit(random);
+
+				if (entry.proxy == AabbTree::NullNode)
+				{
+					// Removed objects come back in a new place
+					if (action < .2f)
+					{
+						entry.box = randomBox(random);
+						entry.proxy = tree.insert(entry.box, handle(i));
+					}
+				}
+				else if (action < .05f)
+				{
+					tree.erase(entry.proxy);
+					entry.proxy = AabbTree::NullNode;
+				}
+				else if (action < .25f)
+				{
+					// Small moves stay in the fat box
+					const BoundingBox moved = offset(entry.box, nudge(random), nudge(random), nudge(random));
+					const BoundingBox before = tree.box(entry.proxy);
+
+					if (!tree.move(entry.proxy, moved))
+						KAPUT_CHECK(same(tree.box(entry.proxy), before));
+
+					entry.box = moved;
+				}
+				else if (action < .35f)
+				{
+					// Far enough along X to leave the fat box
+					const float x = (unit(random) < .5f ? -1.f : 1.f) * (1.f + 9.f * unit(random));
+
+					entry.box = offset(entry.box, x, jump(random), jump(random));
+					KAPUT_CHECK(tree.move(entry.proxy, entry.box));
+				}
+			}
+
+			checkQueries(tree, entries, random);
+			KAPUT_CHECK(tree.height() <= heightBound(tree.size()));
+		}
+
+		// Removing everything leaves an empty tree
+		for (Entry& entry : entries)
+			if (entry.proxy != AabbTree::NullNode)
+			{
+				tree.erase(entry.proxy);
+				entry.proxy = AabbTree::NullNode;
+			}
+
+		KAPUT_CHECK(tree.size() == 0);
+		KAPUT_CHECK(tree.height() == 0);
+
+		bool empty = true;
+		tree.query(BoundingBox { { -WorldSize, -WorldSize, -WorldSize }, { WorldSize, WorldSize, WorldSize } }, [&empty](Handle<GameObject>)
+		{
+			empty = false;
+			return true;
+		});
+
+		KAPUT_CHECK(empty);
+	}
+
+	/// <summary>
+	/// Inserting sorted boxes, which would build a list without rotations, keeps the tree logarithmic.
+	/// </summary>
+	void testSortedInserts()
+	{
+		constexpr size_t count = 4'096;
+
+		AabbTree tree;
+		std::vector<AabbTree::Proxy> proxies;
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			const float x = static_cast<float>(i) * 2.f;
+			proxies.push_back(tree.insert({ { x, 0, 0 }, { x + 1.f, 1.f, 1.f } }, handle(i)));
+		}
+
+		KAPUT_CHECK(tree.height() <= heightBound(count));
+
+		// Removing every other box from one end keeps it balanced as well
+		for (size_t i = 0; i < count / 2; ++i)
+			tree.erase(proxies[i * 2]);
+
+		KAPUT_CHECK(tree.size() == count / 2);
+		KAPUT_CHECK(tree.height() <= heightBound(count / 2));
+
+		// Stopping a query early
+		size_t calls = 0;
+		tree.query(BoundingBox { { 0, 0, 0 }, { count * 2.f, 1.f, 1.f } }, [&calls](Handle<GameObject>)
+		{
+			return ++calls < 10;
+		});
+
+		KAPUT_CHECK(calls == 10);
+	}
+}
+
+/// <summary>
+/// Checks the queries of the bounding volume hierarchy against a brute force search and its height against its size.
+/// </summary>
+/// <remarks>Usage: KaputAabbTreeTest</remarks>
+int main()
+{
+	testRandom();
+	testSortedInserts();
+
+	if (Test::failures)
+		std::cerr << Test::failures << " checks failed.\n";
+
+	return Test::failures ? 1 : 0;
+}
@@ -0,0 +1,263 @@
+#include "Check.h"
+
+#include "Rendering/Culling/Frustum.h"
+
+#include <LibMath/Matrix.h>
+
+#include <cmath>
+#include <cstdint>
+#include <numbers>
+#include <random>
+
+using KaputEngine::Rendering::Culling::BoundingBox;
+using KaputEngine::Rendering::Culling::BoundingSphere;
+using KaputEngine::Rendering::Culling::Bounds;
+using KaputEngine::Rendering::Culling::Frustum;
+using KaputEngine::Rendering::Culling::Plane;
+
+using LibMath::Cartesian3f;
+using LibMath::Matrix4f;
+using LibMath::Vector3f;
+
+using namespace KaputEngine;
+
+namespace
+{
+	constexpr float Near = 1.f;
+	constexpr float Far = 10.f;
+
+	_NODISCARD bool near(const float a, const float b)
+	{
+		return std::abs(a - b) < 1e-5f;
+	}
+
+	_NODISCARD bool near(const Cartesian3f& a, const Cartesian3f& b)
+	{
+		return near(a.x(), b.x()) && near(a.y(), b.y()) && near(a.z(), b.z());
+	}
+
+	_NODISCARD bool near(const Plane& plane, const Cartesian3f& normal, const float distance)
+	{
+		return
+			near(plane.normal[0], normal.x()) &&
+			near(plane.normal[1], normal.y()) &&
+			near(plane.normal[2], normal.z()) &&
+			near(plane.distance, distance);
+	}
+
+	/// <summary>
+	/// OpenGL projection with a 90 degree field of view and a square aspect, so the side planes are at 45 degrees.
+	/// </summary>
+	_NODISCARD Matrix4f projection()
+	{
+		Matrix4f matrix = Matrix4f::Identity();
+		float (&data)[4][4] = matrix.raw2D();
+
+		data[2][2] = -(Far + Near) / (Far - Near);
+		data[2][3] = -1.f;
+		data[3][2] = -(2.f * Far * Near) / (Far - Near);
+		data[3][3] = 0.f;
+
+		return matrix;
+	}
+
+	_NODISCARD Matrix4f translation(const float x, const float y, const float z)
+	{
+		Matrix4f matrix = Matrix4f::Identity();
+
+		matrix.raw2D()[3][0] = x;
+		matrix.raw2D()[3][1] = y;
+		matrix.raw2D()[3][2] = z;
+
+		return matrix;
+	}
+
+	/// <summary>
+	/// Rotation about the Z axis, counterclockwise looking down the axis.
+	/// </summary>
+	_NODISCARD Matrix4f rotationZ(const float angle)
+	{
+		Matrix4f matrix = Matrix4f::Identity();
+		float (&data)[4][4] = matrix.raw2D();
+
+		data[0][0] = std::cos(angle);
+		data[0][1] = std::sin(angle);
+		data[1][0] = -std::sin(angle);
+		data[1][1] = std::cos(angle);
+
+		return matrix;
+	}
+
+	_NODISCARD Matrix4f scale(const float x, const float y, const float z)
+	{
+		Matrix4f matrix = Matrix4f::Identity();
+
+		matrix.raw2D()[0][0] = x;
+		matrix.raw2D()[1][1] = y;
+		matrix.raw2D()[2][2] = z;
+
+		return matrix;
+	}
+
+	_NODISCARD Cartesian3f transformPoint(const Matrix4f& matrix, const Cartesian3f& point)
+	{
+		const float (&m)[4][4] = matrix.raw2D();
+
+		return
+		{
+			m[0][0] * point.x() + m[1][0] * point.y() + m[2][0] * point.z() + m[3][0],
+			m[0][1] * point.x() + m[1][1] * point.y() + m[2][1] * point.z() + m[3][1],
+			m[0][2] * point.x() + m[1][2] * point.y() + m[2][2] * point.z() + m[3][2]
+		};
+	}
+
+	/// <summary>
+	/// The planes of a camera at the origin looking down -Z, normalized and pointing inside.
+	/// </summary>
+	void testPlaneExtraction()
+	{
+		const Frustum frustum(projection());
+		const auto& planes = frustum.planes();
+
+		const float side = 1.f / std::numbers::sqrt2_v<float>;
+
+		KAPUT_CHECK(near(planes[Frustum::LEFT], { side, 0, -side }, 0));
+		KAPUT_CHECK(near(planes[Frustum::RIGHT], { -side, 0, -side }, 0));
+		KAPUT_CHECK(near(planes[Frustum::BOTTOM], { 0, side, -side }, 0));
+		KAPUT_CHECK(near(planes[Frustum::TOP], { 0, -side, -side }, 0));
+		KAPUT_CHECK(near(planes[Frustum::NEAR_PLANE], { 0, 0, -1 }, -Near));
+		KAPUT_CHECK(near(planes[Frustum::FAR_PLANE], { 0, 0, 1 }, Far));
+
+		// Moving the camera moves the planes with it
+		const Frustum moved(projection() * translation(-5, 0, 0));
+
+		KAPUT_CHECK(near(moved.planes()[Frustum::LEFT], { side, 0, -side }, -5 * side));
+		KAPUT_CHECK(near(moved.planes()[Frustum::NEAR_PLANE].signedDistance({ 5, 0, -Near }), 0));
+		KAPUT_CHECK(near(moved.planes()[Frustum::FAR_PLANE].signedDistance({ 0, 0, -Far }), 0));
+	}
+
+	void testBoxes()
+	{
+		const Frustum frustum(projection());
+
+		// Inside
+		KAPUT_CHECK(frustum.intersects(BoundingBox { { -1, -1, -6 }, { 1, 1, -4 } }));
+
+		// Outside, past each kind of plane
+		KAPUT_CHECK(!frustum.intersects(BoundingBox { { -20, -1, -6 }, { -15, 1, -4 } }));
+		KAPUT_CHECK(!frustum.intersects(BoundingBox { { -1, 15, -6 }, { 1, 20, -4 } }));
+		KAPUT_CHECK(!frustum.intersects(BoundingBox { { -1, -1, -.5f }, { 1, 1, 2 } }));
+		KAPUT_CHECK(!frustum.intersects(BoundingBox { { -1, -1, -20 }, { 1, 1, -12 } }));
+
+		// Straddling the left, near and far planes
+		KAPUT_CHECK(frustum.intersects(BoundingBox { { -6, -1, -6 }, { -4, 1, -4 } }));
+		KAPUT_CHECK(frustum.intersects(BoundingBox { { -1, -1, -1.5f }, { 1, 1, 0 } }));
+		KAPUT_CHECK(frustum.intersects(BoundingBox { { -1, -1, -12 }, { 1, 1, -8 } }));
+
+		// Containing the whole frustum
+		KAPUT_CHECK(frustum.intersects(BoundingBox { { -100, -100, -100 }, { 100, 100, 100 } }));
+	}
+
+	void testSpheres()
+	{
+		const Frustum frustum(projection());
+
+		KAPUT_CHECK(frustum.intersects(BoundingSphere { { 0, 0, -5 }, 1 }));
+
+		// 2 / sqrt(2) from the left plane
+		KAPUT_CHECK(!frustum.intersects(BoundingSphere { { -7, 0, -5 }, 1 }));
+		KAPUT_CHECK(frustum.intersects(BoundingSphere { { -7, 0, -5 }, 2 }));
+
+		KAPUT_CHECK(!frustum.intersects(BoundingSphere { { 0, 0, 3 }, 1 }));
+		KAPUT_CHECK(frustum.intersects(BoundingSphere { { 0, 0, 0 }, 1.5f }));
+		KAPUT_CHECK(!frustum.intersects(BoundingSphere { { 0, 0, -12 }, 1.5f }));
+
+		// Empty bounds are never culled
+		KAPUT_CHECK(frustum.intersects(Bounds()));
+
+		// Bounds are visible only when both their sphere and their box are
+		const Bounds bounds = Bounds::fromBox({ { -6, -1, -6 }, { -4, 1, -4 } });
+		KAPUT_CHECK(frustum.intersects(bounds));
+		KAPUT_CHECK(!frustum.intersects(Bounds::fromBox({ { -20, -1, -6 }, { -15, 1, -4 } })));
+	}
+
+	void testTransform()
+	{
+		const Bounds bounds = Bounds::fromBox({ { -1, -2, -3 }, { 1, 2, 3 } });
+
+		// A quarter turn swaps the X and Y extents
+		const Bounds quarter = bounds.transform(rotationZ(std::numbers::pi_v<float> / 2.f));
+
+		KAPUT_CHECK(near(quarter.box.min, { -2, -1, -3 }));
+		KAPUT_CHECK(near(quarter.box.max, { 2, 1, 3 }));
+		KAPUT_CHECK(near(quarter.sphere.radius, bounds.sphere.radius));
+
+		// An eighth of a turn grows both to the projection of the rotated extents
+		const Bounds eighth = bounds.transform(rotationZ(std::numbers::pi_v<float> / 4.f));
+		const float diagonal = 3.f / std::numbers::sqrt2_v<float>;
+
+		KAPUT_CHECK(near(eighth.box.max, { diagonal, diagonal, 3 }));
+
+		// Scaled then moved
+		const Bounds cube = Bounds::fromBox({ { -1, -1, -1 }, { 1, 1, 1 } });
+		const Bounds scaled = cube.transform(translation(10, 0, 0) * scale(2, 3, 4));
+
+		KAPUT_CHECK(near(scaled.box.min, { 8, -3, -4 }));
+		KAPUT_CHECK(near(scaled.box.max, { 12, 3, 4 }));
+		KAPUT_CHECK(near(scaled.sphere.center, { 10, 0, 0 }));
+		KAPUT_CHECK(near(scaled.sphere.radius, 4.f * cube.sphere.radius));
+
+		// Whatever the rotation and scale, the transformed corners stay inside both volumes
+		std::mt19937 random(42);
+		std::uniform_real_distribution<float> angle(0.f, 2.f * std::numbers::pi_v<float>), size(.1f, 5.f), offset(-10.f, 10.f);
+
+		for (int i = 0; i < 100; ++i)
+		{
+			const Matrix4f matrix =
+				translation(offset(random), offset(random), offset(random)) *
+				rotationZ(angle(random)) *
+				scale(size(random), size(random), size(random));
+
+			const Bounds transformed = bounds.transform(matrix);
+			bool contained = true;
+
+			for (uint8_t corner = 0; corner < 8; ++corner)
+			{
+				const Cartesian3f point = transformPoint(matrix,
+				{
+					corner & 1 ? bounds.box.max.x() : bounds.box.min.x(),
+					corner & 2 ? bounds.box.max.y() : bounds.box.min.y(),
+					corner & 4 ? bounds.box.max.z() : bounds.box.min.z()
+				});
+
+				for (int axis = 0; axis < 3; ++axis)
+					contained &=
+						point.raw()[axis] >= transformed.box.min.raw()[axis] - 1e-4f &&
+						point.raw()[axis] <= transformed.box.max.raw()[axis] + 1e-4f;
+
+				const Vector3f fromCenter = point - transformed.sphere.center;
+				contained &= fromCenter.x() * fromCenter.x() + fromCenter.y() * fromCenter.y() + fromCenter.z() * fromCenter.z() <=
+					transformed.sphere.radius * transformed.sphere.radius * (1.f + 1e-4f);
+			}
+
+			KAPUT_CHECK(contained);
+		}
+	}
+}
+
+/// <summary>
+/// Checks the frustum plane extraction and the box, sphere and bounds tests used by the culling pass, without a context.
+/// </summary>
+/// <remarks>Usage: KaputFrustumTest</remarks>
+int main()
+{
+	testPlaneExtraction();
+	testBoxes();
+	testSpheres();
+	testTransform();
+
+	if (Test::failures)
+		std::cerr << Test::failures << " checks failed.\n";
+
+	return Test::failures ? 1 : 0;
+}
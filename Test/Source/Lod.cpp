@@ -0,0 +1,233 @@
+#include "Check.h"
+
+#include "Component/RenderComponent.h"
+#include "Rendering/Mesh.h"
+#include "Rendering/MeshOptimizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using namespace KaputEngine;
+
+using KaputEngine::Rendering::Mesh;
+using KaputEngine::Rendering::MeshOptimizer;
+using KaputEngine::Rendering::Vertex;
+
+using LibMath::Vector3f;
+
+namespace
+{
+	constexpr unsigned int GridSize = 32;
+
+	// Column of the grid split in two vertices with different UVs
+	constexpr unsigned int SeamColumn = GridSize / 2;
+
+	/// <summary>
+	/// Grid of quads on the XZ plane bent into a gentle wave, facing up, with a UV seam along a column.
+	/// </summary>
+	/// <param name="seam">Second copy of each vertex of the seam column, used by the quads on its right</param>
+	void makeGrid(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices, std::vector<unsigned int>& seam)
+	{
+		const auto vertexAt = [](const unsigned int x, const unsigned int z)
+		{
+			Vertex vertex;
+
+			vertex.position =
+			{
+				static_cast<float>(x),
+				.5f * std::sin(static_cast<float>(x) * .3f) * std::cos(static_cast<float>(z) * .2f),
+				static_cast<float>(z)
+			};
+
+			vertex.textureUV = { static_cast<float>(x) / GridSize, static_cast<float>(z) / GridSize };
+			vertex.normal = { 0.f, 1.f, 0.f };
+
+			return vertex;
+		};
+
+		for (unsigned int z = 0; z <= GridSize; ++z)
+			for (unsigned int x = 0; x <= GridSize; ++x)
+				vertices.push_back(vertexAt(x, z));
+
+		for (unsigned int z = 0; z <= GridSize; ++z)
+		{
+			Vertex copy = vertexAt(SeamColumn, z);
+			copy.textureUV = { 0.f, copy.textureUV.y() };
+
+			seam.push_back(static_cast<unsigned int>(vertices.size()));
+			vertices.push_back(copy);
+		}
+
+		const auto index = [&seam](const unsigned int x, const unsigned int z, const bool rightOfSeam)
+		{
+			return x == SeamColumn && rightOfSeam ? seam[z] : z * (GridSize + 1) + x;
+		};
+
+		for (unsigned int z = 0; z < GridSize; ++z)
+			for (unsigned int x = 0; x < GridSize; ++x)
+			{
+				const bool right = x >= SeamColumn;
+
+				const unsigned int
+					corner = index(x, z, right),
+					next   = index(x + 1, z, right),
+					below  = index(x, z + 1, right),
+					across = index(x + 1, z + 1, right);
+
+				indices.insert(indices.end(), { corner, below, next, next, below, across });
+			}
+	}
+
+	_NODISCARD bool used(const std::vector<unsigned int>& indices, const unsigned int vertex)
+	{
+		return std::ranges::find(indices, vertex) != indices.end();
+	}
+
+	/// <summary>
+	/// Each level has fewer triangles than the last, facing the same way, with the border and seam vertices kept.
+	/// </summary>
+	void testSimplify()
+	{
+		std::vector<Vertex> vertices;
+		std::vector<unsigned int> indices, seam;
+
+		makeGrid(vertices, indices, seam);
+
+		std::vector<unsigned int> border;
+
+		for (unsigned int i = 0; i <= GridSize; ++i)
+			border.insert(border.end(),
+			{
+				i,
+				GridSize * (GridSize + 1) + i,
+				i * (GridSize + 1),
+				i * (GridSize + 1) + GridSize
+			});
+
+		std::vector<unsigned int> level = indices;
+
+		for (uint8_t lod = 1; lod < Mesh::MaxLods; ++lod)
+		{
+			const size_t triangles = level.size() / 3;
+
+			MeshOptimizer::simplify(vertices, level, triangles / 2, .05f);
+
+			KAPUT_CHECK(level.size() % 3 == 0);
+			KAPUT_CHECK(level.size() / 3 < triangles);
+			KAPUT_CHECK(level.size() / 3 >= triangles / 2);
+
+			bool kept = true;
+
+			for (const unsigned int vertex : border)
+				kept &= used(level, vertex);
+
+			// Both sides of the seam
+			for (unsigned int z = 0; z <= GridSize; ++z)
+				kept &= used(level, z * (GridSize + 1) + SeamColumn) && used(level, seam[z]);
+
+			KAPUT_CHECK(kept);
+
+			bool up = true;
+
+			for (size_t t = 0; t < level.size(); t += 3)
+			{
+				const LibMath::Cartesian3f
+					&p0 = vertices[level[t]].position,
+					&p1 = vertices[level[t + 1]].position,
+					&p2 = vertices[level[t + 2]].position;
+
+				const Vector3f
+					edge1 { p1.x() - p0.x(), p1.y() - p0.y(), p1.z() - p0.z() },
+					edge2 { p2.x() - p0.x(), p2.y() - p0.y(), p2.z() - p0.z() };
+
+				up &= edge1.cross(edge2).y() > 0.f;
+			}
+
+			KAPUT_CHECK(up);
+		}
+
+		// Already under the target
+		std::vector<unsigned int> unchanged = indices;
+		MeshOptimizer::simplify(vertices, unchanged, indices.size() / 3, .05f);
+
+		KAPUT_CHECK(unchanged == indices);
+	}
+
+	/// <summary>
+	/// Sizes well past a threshold select the matching level whatever the current one.
+	/// </summary>
+	void testLodThresholds()
+	{
+		constexpr uint8_t lodCount = Mesh::MaxLods;
+
+		for (uint8_t current = 0; current < lodCount; ++current)
+		{
+			KAPUT_CHECK(RenderComponent::selectLod(1.f, current, lodCount) == 0);
+			KAPUT_CHECK(RenderComponent::selectLod(.4f, current, lodCount) == 1);
+			KAPUT_CHECK(RenderComponent::selectLod(.2f, current, lodCount) == 2);
+			KAPUT_CHECK(RenderComponent::selectLod(.05f, current, lodCount) == 3);
+		}
+
+		// Clamped to the levels of the mesh
+		KAPUT_CHECK(RenderComponent::selectLod(.05f, 0, 2) == 1);
+		KAPUT_CHECK(RenderComponent::selectLod(1.f, 3, 1) == 0);
+		KAPUT_CHECK(RenderComponent::selectLod(.2f, 3, 2) == 1);
+	}
+
+	/// <summary>
+	/// A size oscillating around a threshold within the hysteresis keeps the level it started with.
+	/// </summary>
+	void testLodHysteresis()
+	{
+		constexpr uint8_t lodCount = Mesh::MaxLods;
+		constexpr float inside = RenderComponent::LodHysteresis * .9f, outside = RenderComponent::LodHysteresis * 1.1f;
+
+		for (uint8_t threshold = 0; threshold + 1 < lodCount; ++threshold)
+		{
+			const float size = RenderComponent::LodScreenSizes[threshold];
+
+			for (const uint8_t start : { threshold, static_cast<uint8_t>(threshold + 1) })
+			{
+				uint8_t lod = start;
+				bool stable = true;
+
+				for (int frame = 0; frame < 100; ++frame)
+				{
+					const float screenSize = size * (frame % 2 ? 1.f + inside : 1.f - inside);
+
+					lod = RenderComponent::selectLod(screenSize, lod, lodCount);
+					stable &= lod == start;
+				}
+
+				KAPUT_CHECK(stable);
+			}
+
+			// Leaving the band switches level once, then stays
+			uint8_t lod = RenderComponent::selectLod(size * (1.f - outside), threshold, lodCount);
+			KAPUT_CHECK(lod == threshold + 1);
+
+			lod = RenderComponent::selectLod(size * (1.f - inside), lod, lodCount);
+			KAPUT_CHECK(lod == threshold + 1);
+
+			lod = RenderComponent::selectLod(size * (1.f + outside), lod, lodCount);
+			KAPUT_CHECK(lod == threshold);
+		}
+	}
+}
+
+/// <summary>
+/// Checks the simplification of the levels of detail and the selection of a level from the projected size.
+/// </summary>
+/// <remarks>Usage: KaputLodTest</remarks>
+int main()
+{
+	testSimplify();
+	testLodThresholds();
+	testLodHysteresis();
+
+	if (Test::failures)
+		std::cerr << Test::failures << " checks failed.\n";
+
+	return Test::failures ? 1 : 0;
+}
@@ -0,0 +1,284 @@
+#include "Check.h"
+
+#include "Rendering/Buffer/ElementBuffer.h"
+#include "Rendering/MeshOptimizer.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace KaputEngine;
+
+using KaputEngine::Rendering::MeshOptimizationStats;
+using KaputEngine::Rendering::MeshOptimizer;
+using KaputEngine::Rendering::Vertex;
+using KaputEngine::Rendering::Buffer::ElementBuffer;
+
+namespace
+{
+	using Triangle = std::array<std::array<float, 3>, 3>;
+
+	/// <summary>
+	/// Flat grid of quads on the XZ plane, each made of two triangles facing up, in row order.
+	/// </summary>
+	void makeGrid(const unsigned int size, std::vector<Vertex>& vertices, std::vector<unsigned int>& indices)
+	{
+		vertices.clear();
+		indices.clear();
+
+		for (unsigned int z = 0; z <= size; ++z)
+			for (unsigned int x = 0; x <= size; ++x)
+			{
+				Vertex& vertex = vertices.emplace_back();
+
+				vertex.position = { static_cast<float>(x), 0.f, static_cast<float>(z) };
+				vertex.textureUV = { static_cast<float>(x) / size, static_cast<float>(z) / size };
+				vertex.normal = { 0.f, 1.f, 0.f };
+			}
+
+		for (unsigned int z = 0; z < size; ++z)
+			for (unsigned int x = 0; x < size; ++x)
+			{
+				const unsigned int
+					corner = z * (size + 1) + x,
+					right  = corner + 1,
+					below  = corner + size + 1,
+					across = below + 1;
+
+				indices.insert(indices.end(), { corner, below, right, right, below, across });
+			}
+	}
+
+	/// <summary>
+	/// Shuffles the order of the triangles, keeping the order of their corners.
+	/// </summary>
+	void shuffleTriangles(std::vector<unsigned int>& indices, std::mt19937& random)
+	{
+		std::vector<std::array<unsigned int, 3>> triangles(indices.size() / 3);
+
+		std::memcpy(triangles.data(), indices.data(), indices.size() * sizeof(unsigned int));
+		std::ranges::shuffle(triangles, random);
+		std::memcpy(indices.data(), triangles.data(), indices.size() * sizeof(unsigned int));
+	}
+
+	/// <summary>
+	/// Triangles by the positions of their corners, each starting from its smallest corner to keep the winding, in sorted order.
+	/// </summary>
+	_NODISCARD std::vector<Triangle> triangleSet(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices)
+	{
+		std::vector<Triangle> triangles;
+
+		for (size_t t = 0; t < indices.size(); t += 3)
+		{
+			Triangle triangle;
+
+			for (uint8_t corner = 0; corner < 3; ++corner)
+			{
+				const Vertex& vertex = vertices[indices[t + corner]];
+				triangle[corner] = { vertex.position.x(), vertex.position.y(), vertex.position.z() };
+			}
+
+			std::ranges::rotate(triangle, std::ranges::min_element(triangle));
+			triangles.push_back(triangle);
+		}
+
+		std::ranges::sort(triangles);
+
+		return triangles;
+	}
+
+	/// <summary>
+	/// Only vertices equal in every attribute are merged, and each corner keeps its attributes.
+	/// </summary>
+	void testWeld()
+	{
+		std::vector<Vertex> quad;
+		std::vector<unsigned int> quadIndices;
+
+		makeGrid(1, quad, quadIndices);
+
+		// Unindexed quad, its shared corners written twice
+		std::vector<Vertex> vertices;
+
+		for (const unsigned int index : quadIndices)
+			vertices.push_back(quad[index]);
+
+		// Copies of the first corner differing by one attribute each, then two exact copies
+		Vertex uv = quad[0], normal = quad[0], position = quad[0], color = quad[0];
+
+		uv.textureUV = { .5f, 0.f };
+		normal.normal = { 0.f, 0.f, 1.f };
+		position.position = { 1e-6f, 0.f, 0.f };
+		color.albedo.r = .5f;
+
+		vertices.insert(vertices.end(), { uv, normal, position, color, quad[0], quad[0] });
+
+		std::vector<unsigned int> indices(vertices.size());
+
+		for (unsigned int i = 0; i < indices.size(); ++i)
+			indices[i] = i;
+
+		const std::vector<Vertex> before = vertices;
+
+		MeshOptimizer::weld(vertices, indices);
+
+		// The 4 corners of the quad and the 4 altered copies
+		KAPUT_CHECK(vertices.size() == 8);
+
+		bool kept = true, merged = true;
+
+		for (size_t i = 0; i < indices.size(); ++i)
+		{
+			kept &= !std::memcmp(&vertices[indices[i]], &before[i], sizeof(Vertex));
+
+			for (size_t j = 0; j < indices.size(); ++j)
+				merged &= (indices[i] == indices[j]) == !std::memcmp(&before[i], &before[j], sizeof(Vertex));
+		}
+
+		KAPUT_CHECK(kept);
+		KAPUT_CHECK(merged);
+	}
+
+	/// <summary>
+	/// Every reordering step, alone and chained, keeps the same triangles with the same winding.
+	/// </summary>
+	void testReorders()
+	{
+		std::mt19937 random(42);
+
+		std::vector<Vertex> vertices;
+		std::vector<unsigned int> indices;
+
+		makeGrid(32, vertices, indices);
+		shuffleTriangles(indices, random);
+
+		const std::vector<Triangle> expected = triangleSet(vertices, indices);
+
+		std::vector<unsigned int> cache = indices;
+		const std::vector<uint32_t> clusters = MeshOptimizer::optimizeVertexCache(cache, vertices.size());
+
+		KAPUT_CHECK(triangleSet(vertices, cache) == expected);
+		KAPUT_CHECK(!clusters.empty() && clusters.front() == 0 && std::ranges::is_sorted(clusters));
+
+		std::vector<unsigned int> overdraw = cache;
+		MeshOptimizer::optimizeOverdraw(vertices, overdraw, clusters);
+
+		KAPUT_CHECK(triangleSet(vertices, overdraw) == expected);
+
+		std::vector<Vertex> fetchVertices = vertices;
+		std::vector<unsigned int> fetch = overdraw;
+		MeshOptimizer::optimizeVertexFetch(fetchVertices, fetch);
+
+		KAPUT_CHECK(fetchVertices.size() == vertices.size());
+		KAPUT_CHECK(triangleSet(fetchVertices, fetch) == expected);
+
+		// First use order
+		unsigned int next = 0;
+		bool ordered = true;
+
+		for (const unsigned int index : fetch)
+		{
+			ordered &= index <= next;
+			next = std::max(next, index + 1);
+		}
+
+		KAPUT_CHECK(ordered);
+
+		std::vector<Vertex> optimizedVertices = vertices;
+		std::vector<unsigned int> optimized = indices;
+		static_cast<void>(MeshOptimizer::optimize(optimizedVertices, optimized));
+
+		KAPUT_CHECK(triangleSet(optimizedVertices, optimized) == expected);
+	}
+
+	/// <summary>
+	/// Tipsify lowers the miss ratio of a grid whether its triangles start in row order or shuffled.
+	/// </summary>
+	void testAcmr()
+	{
+		std::mt19937 random(42);
+
+		std::vector<Vertex> vertices;
+		std::vector<unsigned int> indices;
+
+		makeGrid(64, vertices, indices);
+
+		for (const bool shuffled : { false, true })
+		{
+			std::vector<unsigned int> reordered = indices;
+
+			if (shuffled)
+				shuffleTriangles(reordered, random);
+
+			const float before = MeshOptimizer::acmr(reordered, vertices.size());
+			static_cast<void>(MeshOptimizer::optimizeVertexCache(reordered, vertices.size()));
+			const float after = MeshOptimizer::acmr(reordered, vertices.size());
+
+			KAPUT_CHECK(after <= before);
+
+			// Each vertex of a large grid is shared by 2 triangles on average, so 0.5 is the floor
+			KAPUT_CHECK(after >= .5f && after < 1.f);
+
+			std::vector<Vertex> optimizedVertices = vertices;
+			std::vector<unsigned int> optimized = indices;
+
+			if (shuffled)
+				shuffleTriangles(optimized, random);
+
+			const MeshOptimizationStats stats = MeshOptimizer::optimize(optimizedVertices, optimized);
+
+			KAPUT_CHECK(stats.verticesBefore == vertices.size() && stats.verticesAfter == vertices.size());
+			KAPUT_CHECK(stats.acmrAfter <= stats.acmrBefore);
+			KAPUT_CHECK(stats.acmrAfter == MeshOptimizer::acmr(optimized, optimizedVertices.size()));
+		}
+
+		// Every vertex is a miss the first time, and a triangle list of unshared vertices misses every one
+		const unsigned int separate[] { 0, 1, 2, 3, 4, 5 };
+		KAPUT_CHECK(MeshOptimizer::acmr(separate, 6) == 3.f);
+	}
+
+	/// <summary>
+	/// Indices switch to 32 bits once they address more than 65536 vertices.
+	/// </summary>
+	void testIndexWidth()
+	{
+		std::vector<unsigned int> indices { 0, 1, 65535 };
+
+		KAPUT_CHECK(ElementBuffer::fitsShortIndices({ }));
+		KAPUT_CHECK(ElementBuffer::fitsShortIndices(indices));
+
+		indices.push_back(65536);
+		KAPUT_CHECK(!ElementBuffer::fitsShortIndices(indices));
+
+		// Welded and reordered meshes stay within the 16 bit range they were built in
+		std::vector<Vertex> vertices;
+		makeGrid(255, vertices, indices);
+
+		KAPUT_CHECK(vertices.size() == 65536);
+
+		static_cast<void>(MeshOptimizer::optimize(vertices, indices));
+		KAPUT_CHECK(ElementBuffer::fitsShortIndices(indices));
+
+		makeGrid(256, vertices, indices);
+		KAPUT_CHECK(!ElementBuffer::fitsShortIndices(indices));
+	}
+}
+
+/// <summary>
+/// Checks the welding, the triangle and vertex reorderings and the cache miss ratio of the mesh optimizer.
+/// </summary>
+/// <remarks>Usage: KaputMeshOptimizerTest</remarks>
+int main()
+{
+	testWeld();
+	testReorders();
+	testAcmr();
+	testIndexWidth();
+
+	if (Test::failures)
+		std::cerr << Test::failures << " checks failed.\n";
+
+	return Test::failures ? 1 : 0;
+}
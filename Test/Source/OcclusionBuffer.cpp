@@ -0,0 +1,175 @@
+#include "Check.h"
+
+#include "Application.h"
+#include "Job/JobSystem.h"
+#include "Rendering/Culling/OcclusionBuffer.h"
+#include "Rendering/Mesh.h"
+#include "Window/WindowConfig.h"
+
+#include <cmath>
+#include <vector>
+
+using namespace KaputEngine;
+
+using KaputEngine::Job::JobSystem;
+using KaputEngine::Rendering::Mesh;
+using KaputEngine::Rendering::Vertex;
+using KaputEngine::Rendering::Culling::BoundingBox;
+using KaputEngine::Rendering::Culling::Frustum;
+using KaputEngine::Rendering::Culling::OcclusionBuffer;
+using KaputEngine::Rendering::Culling::Occluder;
+
+using LibMath::Matrix4f;
+
+namespace
+{
+	/// <summary>
+	/// Projection of the default camera placed at the origin and looking down -Z, so the view is the identity.
+	/// </summary>
+	_NODISCARD Matrix4f viewProjection()
+	{
+		Matrix4f projection = Matrix4f::Identity();
+
+		const float
+			aspect        = static_cast<float>(WindowConfig::DEFAULT_WIDTH) / WindowConfig::DEFAULT_HEIGHT,
+			near          = WindowConfig::DEFAULT_NEAR,
+			far           = WindowConfig::DEFAULT_FAR,
+			tanHalfFovy   = std::tan(WindowConfig::DEFAULT_FOV / 2.f);
+
+		float (&data)[4][4] = projection.raw2D();
+
+		data[0][0] = 1.f / (aspect * tanHalfFovy);
+		data[1][1] = 1.f / tanHalfFovy;
+		data[2][2] = -(far + near) / (far - near);
+		data[2][3] = -1.f;
+		data[3][2] = -(2.f * far * near) / (far - near);
+		data[3][3] = 0.f;
+
+		return projection;
+	}
+
+	/// <summary>
+	/// Square facing the camera, centered on the origin of the mesh.
+	/// </summary>
+	void initQuad(Mesh& mesh, const float halfSize)
+	{
+		std::vector<Vertex> vertices(4);
+
+		vertices[0].position = { -halfSize, -halfSize, 0 };
+		vertices[1].position = {  halfSize, -halfSize, 0 };
+		vertices[2].position = {  halfSize,  halfSize, 0 };
+		vertices[3].position = { -halfSize,  halfSize, 0 };
+
+		const unsigned int indices[] { 0, 1, 2, 0, 2, 3 };
+
+		mesh.init(vertices, indices);
+	}
+
+	_NODISCARD Matrix4f translation(const float x, const float y, const float z)
+	{
+		Matrix4f matrix = Matrix4f::Identity();
+
+		matrix.raw2D()[3][0] = x;
+		matrix.raw2D()[3][1] = y;
+		matrix.raw2D()[3][2] = z;
+
+		return matrix;
+	}
+
+	/// <summary>
+	/// Checks the boxes against a 4x4 wall 10 units in front of the camera, hiding everything within 2 units of the view axis at twice the distance.
+	/// </summary>
+	void checkWall(const OcclusionBuffer& buffer)
+	{
+		KAPUT_CHECK(buffer.triangleCount() == 2);
+
+		// Fully behind the wall
+		KAPUT_CHECK(buffer.occluded(BoundingBox { { -1, -1, -22 }, { 1, 1, -20 } }));
+
+		// Straddling the edge of the wall, the right half is in view
+		KAPUT_CHECK(!buffer.occluded(BoundingBox { { 2, -1, -22 }, { 6, 1, -20 } }));
+
+		// Beside the wall
+		KAPUT_CHECK(!buffer.occluded(BoundingBox { { 5, -1, -22 }, { 7, 1, -20 } }));
+
+		// In front of the wall
+		KAPUT_CHECK(!buffer.occluded(BoundingBox { { -1, -1, -6 }, { 1, 1, -4 } }));
+
+		// Crossing the wall
+		KAPUT_CHECK(!buffer.occluded(BoundingBox { { -1, -1, -12 }, { 1, 1, -8 } }));
+
+		// Pixels in the middle of the screen hold the wall, the corners are left cleared
+		KAPUT_CHECK(buffer.depth(OcclusionBuffer::Width / 2, OcclusionBuffer::Height / 2) < 1.f);
+		KAPUT_CHECK(buffer.depth(0, 0) == 1.f);
+	}
+
+	/// <summary>
+	/// A box behind a large occluder is hidden, while one partly past its edge is not.
+	/// </summary>
+	void testWall()
+	{
+		Mesh wall;
+		initQuad(wall, 2.f);
+
+		const Occluder occluders[] { { &wall, translation(0, 0, -10) } };
+
+		const Matrix4f matrix = viewProjection();
+		const Frustum frustum(matrix);
+
+		OcclusionBuffer buffer;
+
+		buffer.rasterizeNow(matrix, frustum, occluders);
+		checkWall(buffer);
+
+		// The banded jobs fill the same buffer
+		JobSystem::instance().wait(buffer.rasterize(matrix, frustum, occluders));
+		checkWall(buffer);
+	}
+
+	/// <summary>
+	/// Nothing is hidden by occluders outside of the view or by an empty buffer.
+	/// </summary>
+	void testNoOccluder()
+	{
+		Mesh wall;
+		initQuad(wall, 2.f);
+
+		const Matrix4f matrix = viewProjection();
+		const Frustum frustum(matrix);
+
+		const BoundingBox box { { -1, -1, -22 }, { 1, 1, -20 } };
+
+		OcclusionBuffer buffer;
+
+		buffer.rasterizeNow(matrix, frustum, { });
+		KAPUT_CHECK(!buffer.occluded(box));
+
+		// Behind the camera
+		const Occluder behind[] { { &wall, translation(0, 0, 10) } };
+
+		buffer.rasterizeNow(matrix, frustum, behind);
+
+		KAPUT_CHECK(buffer.triangleCount() == 0);
+		KAPUT_CHECK(!buffer.occluded(box));
+	}
+}
+
+/// <summary>
+/// Checks the software occlusion buffer against boxes hidden, partly hidden and unhidden by a wall.
+/// </summary>
+/// <remarks>Usage: KaputOcclusionBufferTest</remarks>
+int main()
+{
+	if (!Application::initHeadless(0))
+		return 1;
+
+	testWall();
+	testNoOccluder();
+
+	Application::cleanup();
+
+	if (Test::failures)
+		std::cerr << Test::failures << " checks failed.\n";
+
+	return Test::failures ? 1 : 0;
+}
@@ -0,0 +1,201 @@
+#include "Check.h"
+
+#include "Application.h"
+#include "Component/RenderComponent.h"
+#include "GameObject/GameObject.hpp"
+#include "Rendering/Culling/OcclusionBuffer.h"
+#include "Rendering/Mesh.h"
+#include "Rendering/StaticBatch.h"
+#include "Scene/Scene.h"
+
+#include <memory>
+#include <vector>
+
+using namespace KaputEngine;
+
+using KaputEngine::Rendering::eMeshRetention;
+using KaputEngine::Rendering::Material;
+using KaputEngine::Rendering::Mesh;
+using KaputEngine::Rendering::StaticBatch;
+using KaputEngine::Rendering::Vertex;
+using KaputEngine::Rendering::Culling::Bounds;
+using KaputEngine::Rendering::Culling::Occluder;
+
+namespace
+{
+	/// <summary>
+	/// Unit square on the XY plane.
+	/// </summary>
+	_NODISCARD std::shared_ptr<const Mesh> makeQuad()
+	{
+		std::vector<Vertex> vertices(4);
+
+		vertices[0].position = { 0, 0, 0 };
+		vertices[1].position = { 1, 0, 0 };
+		vertices[2].position = { 1, 1, 0 };
+		vertices[3].position = { 0, 1, 0 };
+
+		const unsigned int indices[] { 0, 1, 2, 0, 2, 3 };
+
+		std::shared_ptr<Mesh> mesh = std::make_shared<Mesh>();
+		mesh->init(vertices, indices);
+
+		return mesh;
+	}
+
+	/// <summary>
+	/// Object of the scene drawing a mesh, all within the same batching cell.
+	/// </summary>
+	_NODISCARD std::shared_ptr<GameObject> add(Scene& scene, const std::shared_ptr<const Mesh>& mesh, const float x, const bool isStatic = true)
+	{
+		std::shared_ptr<GameObject> object = GameObject::create<GameObject>();
+
+		object->setStatic(isStatic);
+		object->setLocalPosition({ x, 0, 0 });
+		object->attachTo(&scene.sceneRoot(), true);
+		object->addComponent<RenderComponent>(mesh, std::shared_ptr<Material>());
+
+		return object;
+	}
+
+	_NODISCARD RenderComponent& render(GameObject& object)
+	{
+		return *object.getComponent<RenderComponent>();
+	}
+
+	_NODISCARD size_t occluderCount(const StaticBatch& batch)
+	{
+		std::vector<Occluder> occluders;
+		batch.appendOccluders(occluders);
+
+		return occluders.size();
+	}
+
+	/// <summary>
+	/// Merged meshes keep their occluder geometry only, and the batch keeps none.
+	/// </summary>
+	void testRetention()
+	{
+		const std::shared_ptr<const Mesh> mesh = makeQuad();
+
+		KAPUT_CHECK(mesh->retention() == eMeshRetention::FULL);
+		KAPUT_CHECK(mesh->sourceVertices().size() == 4 && mesh->sourceIndices().size() == 6);
+		KAPUT_CHECK(mesh->occluderPositions().size() == 4 && mesh->occluderIndices().size() == 6);
+
+		Scene scene;
+
+		const std::shared_ptr a = add(scene, mesh, 0);
+		const std::shared_ptr b = add(scene, mesh, 2);
+		const std::shared_ptr moving = add(scene, mesh, 4, false);
+
+		scene.start();
+
+		KAPUT_CHECK(scene.staticBatches().size() == 1);
+
+		if (scene.staticBatches().size() != 1)
+			return;
+
+		const StaticBatch& batch = *scene.staticBatches().front();
+
+		KAPUT_CHECK(batch.pieceCount() == 2);
+		KAPUT_CHECK(render(*a).batched() && render(*b).batched());
+		KAPUT_CHECK(!render(*moving).batched());
+
+		KAPUT_CHECK(mesh->retention() == eMeshRetention::OCCLUDER);
+		KAPUT_CHECK(mesh->sourceVertices().empty() && mesh->sourceIndices().empty());
+		KAPUT_CHECK(mesh->occluderPositions().size() == 4 && mesh->occluderIndices().size() == 6);
+
+		KAPUT_CHECK(batch.mesh().retention() == eMeshRetention::NONE);
+		KAPUT_CHECK(batch.mesh().sourceVertices().empty() && batch.mesh().occluderIndices().empty());
+
+		// Released meshes are drawn by their components in scenes started later
+		Scene later;
+
+		const std::shared_ptr c = add(later, mesh, 0);
+		later.start();
+
+		KAPUT_CHECK(later.staticBatches().empty());
+		KAPUT_CHECK(!render(*c).batched() && render(*c).getCanRender());
+	}
+
+	/// <summary>
+	/// Disabling a merged component, destroying it or its object removes it from the batch, and it draws itself once enabled again.
+	/// </summary>
+	void testRemoval()
+	{
+		Scene scene;
+
+		const std::shared_ptr a = add(scene, makeQuad(), 0);
+		const std::shared_ptr b = add(scene, makeQuad(), 2);
+		const std::shared_ptr c = add(scene, makeQuad(), 4);
+		const std::shared_ptr d = add(scene, makeQuad(), 6);
+
+		render(*a).setOccluder(true);
+		render(*b).setOccluder(true);
+
+		scene.start();
+
+		KAPUT_CHECK(scene.staticBatches().size() == 1);
+
+		if (scene.staticBatches().size() != 1)
+			return;
+
+		const StaticBatch& batch = *scene.staticBatches().front();
+		Bounds bounds;
+
+		KAPUT_CHECK(batch.pieceCount() == 4);
+		KAPUT_CHECK(occluderCount(batch) == 2);
+
+		// Occluders toggled after the build are followed
+		render(*c).setOccluder(true);
+		KAPUT_CHECK(occluderCount(batch) == 3);
+
+		render(*a).setCanRender(false);
+
+		KAPUT_CHECK(batch.pieceCount() == 3);
+		KAPUT_CHECK(!render(*a).batched());
+		KAPUT_CHECK(occluderCount(batch) == 2);
+
+		render(*a).setCanRender(true);
+
+		KAPUT_CHECK(batch.pieceCount() == 3);
+		KAPUT_CHECK(!render(*a).batched() && render(*a).getCanRender());
+
+		// Unbatching directly
+		render(*b).setBatched(false);
+
+		KAPUT_CHECK(batch.pieceCount() == 2);
+		KAPUT_CHECK(occluderCount(batch) == 1);
+
+		c->destroy();
+
+		KAPUT_CHECK(batch.pieceCount() == 1);
+		KAPUT_CHECK(occluderCount(batch) == 0);
+		KAPUT_CHECK(batch.getWorldBounds(bounds));
+
+		render(*d).destroy();
+
+		KAPUT_CHECK(batch.pieceCount() == 0);
+		KAPUT_CHECK(!batch.getWorldBounds(bounds));
+	}
+}
+
+/// <summary>
+/// Checks the geometry kept by merged meshes and the removal of components from their static batch.
+/// </summary>
+/// <remarks>Usage: KaputStaticBatchTest</remarks>
+int main()
+{
+	if (!Application::initHeadless(0))
+		return 1;
+
+	testRetention();
+	testRemoval();
+
+	Application::cleanup();
+
+	if (Test::failures)
+		std::cerr << Test::failures << " checks failed.\n";
+
+	return Test::failures ? 1 : 0;
+}
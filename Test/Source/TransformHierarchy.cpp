@@ -0,0 +1,173 @@
+#include "Check.h"
+
+#include "Application.h"
+#include "GameObject/GameObject.h"
+#include "Scene/Scene.h"
+
+using namespace KaputEngine;
+
+using LibMath::Cartesian3f;
+
+namespace
+{
+	_NODISCARD bool near(const Cartesian3f& a, const Cartesian3f& b)
+	{
+		return (a - b).magnitudeSquared() < 1e-6f;
+	}
+
+	_NODISCARD std::shared_ptr<GameObject> add(GameObject& parent, const Cartesian3f& position)
+	{
+		std::shared_ptr<GameObject> object = GameObject::create<GameObject>();
+
+		object->setLocalPosition(position);
+		object->attachTo(&parent, true);
+
+		return object;
+	}
+
+	/// <summary>
+	/// A moved parent carries its descendants along in a single pass.
+	/// </summary>
+	void testPropagation()
+	{
+		Scene scene;
+		TransformHierarchy& transforms = scene.transforms();
+
+		const std::shared_ptr a = add(scene.sceneRoot(), { 1, 0, 0 });
+		const std::shared_ptr b = add(*a, { 0, 2, 0 });
+		const std::shared_ptr c = add(*b, { 0, 0, 3 });
+
+		transforms.update();
+		KAPUT_CHECK(near(c->getWorldTransform().position, { 1, 2, 3 }));
+
+		const uint32_t version = c->transformVersion();
+
+		a->setLocalPosition({ 5, 0, 0 });
+		transforms.update();
+
+		KAPUT_CHECK(near(b->getWorldTransform().position, { 5, 2, 0 }));
+		KAPUT_CHECK(near(c->getWorldTransform().position, { 5, 2, 3 }));
+		KAPUT_CHECK(c->transformVersion() != version);
+
+		// Nothing moved, the pass leaves the nodes alone
+		const uint32_t stillVersion = c->transformVersion();
+		transforms.update();
+
+		KAPUT_CHECK(c->transformVersion() == stillVersion);
+	}
+
+	/// <summary>
+	/// Attaching to a parent stored after the child restores the parent-first order before the pass.
+	/// </summary>
+	void testReparentToLaterNode()
+	{
+		Scene scene;
+		TransformHierarchy& transforms = scene.transforms();
+
+		const std::shared_ptr a = add(scene.sceneRoot(), { 1, 0, 0 });
+		const std::shared_ptr b = add(*a, { 0, 2, 0 });
+
+		// Created last, so stored after a and b
+		const std::shared_ptr later = add(scene.sceneRoot(), { 10, 0, 0 });
+
+		transforms.update();
+
+		// Keeps the local transform, moving a and its child under the later node
+		a->attachTo(later.get(), true);
+		transforms.update();
+
+		KAPUT_CHECK(near(a->getWorldTransform().position, { 11, 0, 0 }));
+		KAPUT_CHECK(near(b->getWorldTransform().position, { 11, 2, 0 }));
+
+		// A single pass must reach the children through the new order
+		later->setLocalPosition({ 20, 0, 0 });
+		transforms.update();
+
+		KAPUT_CHECK(near(a->getWorldTransform().position, { 21, 0, 0 }));
+		KAPUT_CHECK(near(b->getWorldTransform().position, { 21, 2, 0 }));
+
+		// Keeps the world transform, so the local one is recomputed against the new parent
+		const std::shared_ptr last = add(scene.sceneRoot(), { 0, 0, -4 });
+
+		b->attachTo(last.get());
+		transforms.update();
+
+		KAPUT_CHECK(near(b->getWorldTransform().position, { 21, 2, 0 }));
+		KAPUT_CHECK(near(b->getLocalTransform().position, { 21, 2, 4 }));
+
+		last->setLocalPosition({ 0, 0, 0 });
+		transforms.update();
+
+		KAPUT_CHECK(near(b->getWorldTransform().position, { 21, 2, 4 }));
+		KAPUT_CHECK(near(a->getWorldTransform().position, { 21, 0, 0 }));
+	}
+
+	/// <summary>
+	/// Erased nodes are compacted without losing the parents of the nodes stored after them.
+	/// </summary>
+	void testErasedParent()
+	{
+		Scene scene;
+		TransformHierarchy& transforms = scene.transforms();
+
+		const std::shared_ptr first = add(scene.sceneRoot(), { 0, 5, 0 });
+		const std::shared_ptr child = add(*first, { 1, 0, 0 });
+		const std::shared_ptr parent = add(scene.sceneRoot(), { 0, 0, 2 });
+		const std::shared_ptr grandChild = add(*parent, { 3, 0, 0 });
+
+		transforms.update();
+
+		const size_t size = transforms.size();
+
+		// The former parent leaves the scene after its child moved away, keeping its world transform
+		child->attachTo(parent.get());
+		first->destroy();
+
+		parent->setLocalPosition({ 0, 0, 7 });
+		transforms.update();
+
+		KAPUT_CHECK(transforms.size() == size - 1);
+		KAPUT_CHECK(!transforms.contains(*first));
+		KAPUT_CHECK(near(child->getWorldTransform().position, { 1, 5, 5 }));
+		KAPUT_CHECK(near(grandChild->getWorldTransform().position, { 3, 0, 7 }));
+
+		// Erasing and breaking the order in the same frame
+		const std::shared_ptr later = add(scene.sceneRoot(), { 100, 0, 0 });
+		transforms.update();
+
+		grandChild->destroy();
+		parent->attachTo(later.get(), true);
+		transforms.update();
+
+		KAPUT_CHECK(transforms.size() == size - 1);
+		KAPUT_CHECK(!transforms.contains(*grandChild));
+		KAPUT_CHECK(near(child->getWorldTransform().position, { 101, 5, 5 }));
+
+		later->setLocalPosition({ 200, 0, 0 });
+		transforms.update();
+
+		KAPUT_CHECK(near(parent->getWorldTransform().position, { 200, 0, 7 }));
+		KAPUT_CHECK(near(child->getWorldTransform().position, { 201, 5, 5 }));
+	}
+}
+
+/// <summary>
+/// Checks the flattened scene transform pass, including the rebuilds after erasing and reparenting nodes.
+/// </summary>
+/// <remarks>Usage: KaputTransformHierarchyTest</remarks>
+int main()
+{
+	if (!Application::initHeadless(0))
+		return 1;
+
+	testPropagation();
+	testReparentToLaterNode();
+	testErasedParent();
+
+	Application::cleanup();
+
+	if (Test::failures)
+		std::cerr << Test::failures << " checks failed.\n";
+
+	return Test::failures ? 1 : 0;
+}